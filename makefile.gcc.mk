@@ -24,6 +24,7 @@ MBCS_TESTS_DIR=mbcs_tests
 
 MBCH5_LS_DIR=mbc_h5tools/mbch5ls
 MBCH5_EXP_DIR=mbc_h5tools/mbch5exp
+MBCH5_BENCH_DIR=mbc_h5tools/mbch5bench
 
 MBCSH5_LS_DIR=mbcs_h5tools/mbcsh5ls
 
@@ -37,7 +38,7 @@ build:  mbc_libs mbc_h5tools mbcs_h5tools
 
 mbc_libs: mbc_static_lib mbc_static_lib_tests mbc_dynamic_lib mbc_dynamic_lib_tests mbcs_lib mbcs_lib_tests
 
-mbc_h5tools: mbc_h5ls mbc_h5exp
+mbc_h5tools: mbc_h5ls mbc_h5exp mbc_h5bench
 
 mbcs_h5tools: mbcs_h5ls
 
@@ -50,6 +51,7 @@ clean_obj:
 	rm -rf ./$(MBCDLL_TESTS_DIR)/$(OBJ_DIR)
 	rm -rf ./$(MBCH5_LS_DIR)/$(OBJ_DIR)
 	rm -rf ./$(MBCH5_EXP_DIR)/$(OBJ_DIR)
+	rm -rf ./$(MBCH5_BENCH_DIR)/$(OBJ_DIR)
 
 clean_bin:
 	rm -rf ./$(MBC_DIR)/$(LIB_DIR)
@@ -58,6 +60,7 @@ clean_bin:
 	rm -rf ./$(MBCDLL_TESTS_DIR)/$(BIN_DIR)
 	rm -rf ./$(MBCH5_LS_DIR)/$(BIN_DIR)
 	rm -rf ./$(MBCH5_EXP_DIR)/$(BIN_DIR)
+	rm -rf ./$(MBCH5_BENCH_DIR)/$(BIN_DIR)
 
 mbc_static_lib:
 	mkdir -p $(MBC_DIR)/$(LIB_DIR)
@@ -125,6 +128,14 @@ mbc_h5exp: mbc_static_lib
 	# ./$(MBCH5_EXP_DIR)/$(BIN_DIR)/mbch5exp ./$(MBCH5_EXP_DIR)/tests/foo.h5
 	# ./$(MBCH5_EXP_DIR)/$(BIN_DIR)/mbch5exp ./$(MBCH5_EXP_DIR)/tests/nonexistent.h5
 
+mbc_h5bench: mbc_static_lib
+	mkdir -p $(MBCH5_BENCH_DIR)/$(BIN_DIR)
+	make -C ./$(MBCH5_BENCH_DIR) -f $(MKFILE) BUILD=release >>./$(MBCH5_BENCH_DIR)/$(BIN_DIR)/mbch5bench.make.log   2>>./$(MBCH5_BENCH_DIR)/$(BIN_DIR)/mbch5bench.make.err
+	make -C ./$(MBCH5_BENCH_DIR) -f $(MKFILE) BUILD=debug   >>./$(MBCH5_BENCH_DIR)/$(BIN_DIR)/mbch5bench_d.make.log 2>>./$(MBCH5_BENCH_DIR)/$(BIN_DIR)/mbch5bench_d.make.err
+	# to run manually:
+	# ./$(MBCH5_BENCH_DIR)/$(BIN_DIR)/mbch5bench --help
+	# ./$(MBCH5_BENCH_DIR)/$(BIN_DIR)/mbch5bench contention -t 8
+
 mbcs_h5ls: mbcs_lib
 	mkdir -p $(MBCSH5_LS_DIR)/$(BIN_DIR)
 	make -C ./$(MBCSH5_LS_DIR) -f $(MKFILE) BUILD=release >>./$(MBCSH5_LS_DIR)/$(BIN_DIR)/mbcsh5ls.make.log   2>>./$(MBCSH5_LS_DIR)/$(BIN_DIR)/mbcsh5ls.make.err
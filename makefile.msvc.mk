@@ -13,6 +13,7 @@ MBCS_TESTS_DIR=mbcs_tests
 
 MBCH5_LS_DIR=mbc_h5tools\mbch5ls
 MBCH5_EXP_DIR=mbc_h5tools\mbch5exp
+MBCH5_BENCH_DIR=mbc_h5tools\mbch5bench
 
 MBCSH5_LS_DIR=mbcs_h5tools\mbcsh5ls
 
@@ -24,7 +25,7 @@ build:  mbc_libs mbc_h5tools mbcs_h5tools
 
 mbc_libs: mbc_static_lib mbc_static_lib_tests mbc_dynamic_lib mbc_dynamic_lib_tests mbcs_lib mbcs_lib_tests
 
-mbc_h5tools: mbc_h5ls mbc_h5exp
+mbc_h5tools: mbc_h5ls mbc_h5exp mbc_h5bench
 
 mbcs_h5tools: mbcs_h5ls
 
@@ -132,6 +133,18 @@ mbc_h5exp: mbc_static_lib
 	rem .\$(MBCH5_EXP_DIR)\$(BIN_DIR)\mbch5exp_mt.exe .\$(MBCH5_EXP_DIR)\tests\foo.h5
 	rem .\$(MBCH5_EXP_DIR)\$(BIN_DIR)\mbch5exp_mt.exe .\$(MBCH5_EXP_DIR)\tests\nonexistent.h5
 
+mbc_h5bench: mbc_static_lib
+	cd $(MBCH5_BENCH_DIR)
+	if not exist $(BIN_DIR) mkdir $(BIN_DIR)
+	nmake /nologo /f $(MKFILE) RUNTIME=MT  >>$(BIN_DIR)\mbch5bench_mt.nmake.log
+	nmake /nologo /f $(MKFILE) RUNTIME=MD  >>$(BIN_DIR)\mbch5bench_md.nmake.log
+	nmake /nologo /f $(MKFILE) RUNTIME=MTd >>$(BIN_DIR)\mbch5bench_mtd.nmake.log
+	nmake /nologo /f $(MKFILE) RUNTIME=MDd >>$(BIN_DIR)\mbch5bench_mdd.nmake.log
+	cd ../..
+	rem to run manually:
+	rem .\$(MBCH5_BENCH_DIR)\$(BIN_DIR)\mbch5bench_mt.exe --help
+	rem .\$(MBCH5_BENCH_DIR)\$(BIN_DIR)\mbch5bench_mt.exe contention -t 8
+
 mbcs_h5ls: mbcs_lib
 	cd $(MBCSH5_LS_DIR)
 	if not exist $(BIN_DIR) mkdir $(BIN_DIR)
@@ -1,8 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <cstring>
 #include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
 #include <vector>
 
 #ifndef _HDF5_H
@@ -936,6 +943,9 @@ namespace mbc::h5 {
         //! The bid size.
         double bidSize_;
 
+        //! The bits of the fields in the field mask of a projection fetch.
+        static constexpr unsigned ticksField{ 0x01 }, askPriceField{ 0x02 }, bidPriceField{ 0x04 }, askSizeField{ 0x08 }, bidSizeField{ 0x10 };
+
         //! Are both quote ask/bid price and size identical to an \p other quote item.
         //! \param other A quote item to compare to.
         //! \return A boolean indicating the identity.
@@ -965,6 +975,9 @@ namespace mbc::h5 {
         //! The bid price.
         double bidPrice_;
 
+        //! The bits of the fields in the field mask of a projection fetch.
+        static constexpr unsigned ticksField{ 0x01 }, askPriceField{ 0x02 }, bidPriceField{ 0x04 };
+
         //! Are both quote ask/bid price identical to an \p other quote item.
         //! \param other A quote item to compare to.
         //! \return A boolean indicating the identity.
@@ -994,6 +1007,9 @@ namespace mbc::h5 {
         //! The trade volume.
         double volume_;
 
+        //! The bits of the fields in the field mask of a projection fetch.
+        static constexpr unsigned ticksField{ 0x01 }, priceField{ 0x02 }, volumeField{ 0x04 };
+
         //! Are both trade price and volume identical to an \p other trade item.
         //! \param other A trade item to compare to.
         //! \return A boolean indicating the identity.
@@ -1020,6 +1036,9 @@ namespace mbc::h5 {
         //! The trade price.
         double price_;
 
+        //! The bits of the fields in the field mask of a projection fetch.
+        static constexpr unsigned ticksField{ 0x01 }, priceField{ 0x02 };
+
         //! Is trade price identical to an \p other trade item.
         //! \param other A trade item to compare to.
         //! \return A boolean indicating the identity.
@@ -1058,6 +1077,9 @@ namespace mbc::h5 {
         //! The volume.
         double volume_;
 
+        //! The bits of the fields in the field mask of a projection fetch.
+        static constexpr unsigned ticksField{ 0x01 }, openField{ 0x02 }, highField{ 0x04 }, lowField{ 0x08 }, closeField{ 0x10 }, volumeField{ 0x20 };
+
         //! Are both ohlcv prices and volume identical to an \p other ohlcv item.
         //! \param other An ohlcv item to compare to.
         //! \return A boolean indicating the identity.
@@ -1093,6 +1115,9 @@ namespace mbc::h5 {
         //! The closing price.
         double close_;
 
+        //! The bits of the fields in the field mask of a projection fetch.
+        static constexpr unsigned ticksField{ 0x01 }, openField{ 0x02 }, highField{ 0x04 }, lowField{ 0x08 }, closeField{ 0x10 };
+
         //! Are ohlc prices identical to an \p other ohlc item.
         //! \param other An ohlc item to compare to.
         //! \return A boolean indicating the identity.
@@ -1119,6 +1144,9 @@ namespace mbc::h5 {
         //! The value.
         double value_;
 
+        //! The bits of the fields in the field mask of a projection fetch.
+        static constexpr unsigned ticksField{ 0x01 }, valueField{ 0x02 };
+
         //! Is scalar value identical to an \p other scalar item.
         //! \param other A scalar item to compare to.
         //! \return A boolean indicating the identity.
@@ -1139,6 +1167,7 @@ namespace mbc::h5 {
     // Forward declarations.
     class Instrument;
     class Data;
+    class TickIndex;
     class QuoteData;
     class QuotePriceOnlyData;
     class TradeData;
@@ -1424,12 +1453,97 @@ namespace mbc::h5 {
     //! If the second argument is \c true, the message is an error.
     typedef void(*ErrorLogger)(const char*, bool) noexcept;
 
+    //! The HDF5 filter identifier of the CompressionCodec::TimeSeries codec, stored in every dataset written with it.
+    //! It is taken from the range 256 to 511 HDF5 leaves to the filters not registered with The HDF Group, so an application reading
+    //! these datasets without mbc must register the codec under this identifier, and must not use it for a filter of its own.
+    constexpr int timeSeriesFilterId{ 333 };
+
+    //! The compression codec of a dataset.
+    enum class CompressionCodec
+    {
+        //! The optional byte shuffle followed by the deflate.
+        Deflate = 0,
+        //! The built-in time series codec: the delta encoded ticks and the decimal delta or XOR encoded doubles, bit-packed in blocks.
+        //! Decompresses several times faster than the deflate; the datasets can only be read by the applications linking mbc.
+        TimeSeries = 1
+    };
+
+    //! The expected access pattern of a dataset, which sizes its derived chunk cache and sets the chunk preemption policy.
+    enum class DataAccessPattern
+    {
+        //! The library default preemption policy, the derived cache holds 16 chunks.
+        Default = 0,
+        //! The lookups of the ticks and the short fetches all over the data, the derived cache holds 64 chunks evicted in the least recently used order.
+        Random = 1,
+        //! The scans of the data from the start to the end, the derived cache holds 2 chunks and evicts the fully read ones first.
+        //! A scan reads every chunk once, so the cache only keeps the chunk split by the boundary of a page for the next page.
+        Sequential = 2
+    };
+
+    //! The layout and the compression of a dataset, applied when the dataset is created, and its chunk cache, applied whenever it is opened.
+    struct DatasetCreationOptions
+    {
+        //! The number of data items in a chunk, the unit of the storage and the compression.
+        hsize_t chunkRows_{ 1024 * 20 };
+
+        //! The deflate compression level from 1 to 9.
+        unsigned deflateLevel_{ 9 };
+
+        //! Reorders the bytes of the chunk before the compression, which usually compresses numbers better.
+        bool shuffle_{ true };
+
+        //! Compresses the chunks; if false, the chunks are stored as they are and the other compression settings are ignored.
+        bool compress_{ true };
+
+        //! The compression codec; the deflate level and the shuffle settings apply to the deflate codec only.
+        CompressionCodec codec_{ CompressionCodec::Deflate };
+
+        //! Stores every field in a dataset of its own, under a group named after the data, instead of a single dataset of items.
+        //! Scans of a few fields read only their datasets and every field is compressed on its own. The existing data keeps its layout.
+        bool columnar_{ false };
+
+        //! Stores the items in a time-ordered list of segment datasets mapped by a virtual dataset named after the data, instead of a single dataset.
+        //! A prepend or an insert writes the new items to a segment of their own instead of rewriting all the items after them,
+        //! and Data::compact coalesces the small segments. Applies to the compound layout only. An existing data opened with it switches to it
+        //! when its head is trimmed, so that the trim rewrites no row.
+        bool segmented_{ false };
+
+        //! The number of the slots of the chunk cache hash table, preferably a prime about 100 times the number of the chunks the cache holds.
+        //! 0 derives it from the cache size and the chunk size.
+        size_t chunkCacheSlots_{ 12421 };
+
+        //! The size in bytes of the chunk cache of every dataset of the data, taken from the process-wide chunk cache budget of the File.
+        //! 0 derives it from the chunk size of the dataset and the access pattern.
+        size_t chunkCacheBytes_{ 16 * 1024 * 1024 };
+
+        //! The expected access pattern, which sizes the derived chunk cache and sets the chunk preemption policy.
+        DataAccessPattern accessPattern_{ DataAccessPattern::Default };
+
+        //! Creates the zone maps of the chunks next to a created data. The existing data without them gets them from Data::buildZones only.
+        bool zoneMaps_{ true };
+    };
+
+    //! The bounds of the metadata cache corking of a writable file. The corked cache keeps all metadata in memory instead of writing
+    //! the evicted entries, and a background thread flushes it when either bound is reached.
+    struct CorkOptions
+    {
+        //! The size in bytes of the metadata cache which makes the flush evict the flushed entries down to half of it, 0 for no size bound.
+        size_t maximumBytes_{ 64 * 1024 * 1024 };
+
+        //! The longest time in milliseconds the metadata stays in memory only, 0 for no time bound.
+        unsigned flushMilliseconds_{ 5000 };
+    };
+
     //! Encapsulates the access to a h5 file.
+    //! Every File, Instrument and Data object has its own lock: read operations take it shared, write operations take it exclusive.
+    //! An object does not lock its parents, so an instrument may be moved, renamed or deleted while its data is in use;
+    //! the data holds the group of its instrument open and finds its datasets through it, not through the path it was opened with.
+    //! The calls into the HDF5 library itself are serialized process-wide, the enumeration and collect callbacks are invoked outside of that lock.
     class File final
     {
     public:
         //! Constructs a new instance.
-        File(const char* filePath, hid_t fileId, bool readOnly = true);
+        File(const char* filePath, hid_t fileId, bool readOnly = true, bool swmr = false);
 
         //! Destructs the instance.
         ~File() noexcept;
@@ -1487,12 +1601,38 @@ namespace mbc::h5 {
         //! Flushes the h5 file.
         void flush() const;
 
+        //! The size in bytes of the metadata cache of the h5 file.
+        [[nodiscard]] size_t metadataCacheBytes() const;
+
+        //! The number of the metadata cache flushes made by the bounded corking.
+        [[nodiscard]] hsize_t corkFlushes() const
+        {
+            return corkFlushes_.load(std::memory_order_relaxed);
+        }
+
         //! Opens an instrument.
         //! \param instrumentPath The instrument path to open.
         //! \param createNonexistent Create the instrument if it does not exist; works for writable h5 files only.
         //! \return A shared pointer to an instrument object.
         std::shared_ptr<Instrument> openInstrument(const char* instrumentPath, bool createNonexistent = false);
 
+        //! The default creation options of the datasets created by the instruments opened afterwards.
+        [[nodiscard]] DatasetCreationOptions datasetCreationOptions() const;
+
+        //! Sets the default creation options of the datasets created by the instruments opened afterwards.
+        void setDatasetCreationOptions(const DatasetCreationOptions& options);
+
+        //! The process-wide limit in bytes of the chunk caches of all open datasets, 0 for no limit.
+        static size_t chunkCacheBudget();
+
+        //! Sets the process-wide limit in bytes of the chunk caches of all open datasets, 0 for no limit.
+        //! The datasets opened when the budget is spent get the bytes left only, but still a cache of a chunk, which may take the total
+        //! over the limit by a chunk per dataset; the open datasets keep their caches.
+        static void setChunkCacheBudget(size_t bytes);
+
+        //! The bytes of the chunk caches of the open datasets, which are taken from the budget.
+        static size_t chunkCacheBytes();
+
         //! Deletes an object with all descending objects from the h5 file.
         //! \param objectPath The object path to delete.
         //! \param deleteEmptyParentPath Delete the parent path if empty.
@@ -1514,21 +1654,47 @@ namespace mbc::h5 {
         //! Opens a h5 file for reading.
         //! \param filePath The h5 file path to open.
         //! \param fileDriver The file driver to use.
+        //! \param swmr Open for the single-writer/multiple-reader access, to follow the data appended by a process writing the file.
         //! \return A shared pointer to a read-only h5 file object.
-        static std::shared_ptr<File> openReadOnly(const char* filePath, FileDriver fileDriver = FileDriver::Sec2);
+        static std::shared_ptr<File> openReadOnly(const char* filePath, FileDriver fileDriver = FileDriver::Sec2, bool swmr = false);
 
         //! Opens a h5 file for both reading and writing.
         //! \param filePath The h5 file path to open.
         //! \param createNonexistent Create file if it does not exist.
         //! \param fileDriver The file driver to use.
         //! \param corkTheCache If you have memory to spare, you could "cork the cache" until you reached a suitable point to update the metadata in the file, and call flush.
+        //! \param swmr Open for the single-writer/multiple-reader access, the items added are flushed so that the SWMR readers see them.
+        //! The SWMR readers only see the datasets which existed when they opened the file, and expect the items to be appended, not inserted or deleted.
+        //! The writer must open the file before the readers. Every flush compresses the whole last chunk, so the small chunks and the time series codec keep the latency low.
+        //! \return A shared pointer to a writable h5 file object.
+        static std::shared_ptr<File> openReadWrite(const char* filePath, bool createNonexistent, FileDriver fileDriver = FileDriver::Sec2, bool corkTheCache = false, bool swmr = false);
+
+        //! Opens a h5 file for both reading and writing with the metadata cache corked within bounds.
+        //! The metadata stays in memory until the cache grows past the size bound or the time bound passes, then a background thread flushes it.
+        //! The thread takes the library only when no writer holds it, and evicts the flushed entries, which writes nothing, until the cache is back within the bound.
+        //! \param filePath The h5 file path to open.
+        //! \param createNonexistent Create file if it does not exist.
+        //! \param fileDriver The file driver to use.
+        //! \param corkOptions The bounds of the corking; with no bounds the cache stays corked until the file is flushed, as with corkTheCache.
+        //! \param swmr Open for the single-writer/multiple-reader access.
         //! \return A shared pointer to a writable h5 file object.
-        static std::shared_ptr<File> openReadWrite(const char* filePath, bool createNonexistent, FileDriver fileDriver = FileDriver::Sec2, bool corkTheCache = false);
+        static std::shared_ptr<File> openReadWrite(const char* filePath, bool createNonexistent, FileDriver fileDriver, const CorkOptions& corkOptions, bool swmr = false);
  
     private:
+        //! Flushes the corked metadata cache when a bound is reached, until the file is closed. Runs on the background thread.
+        void flushCorked(CorkOptions corkOptions);
+
+        mutable std::shared_mutex mutex_;
         std::string filePath_;
+        DatasetCreationOptions datasetCreationOptions_;
         hid_t fileId_;
         bool readOnly_;
+        bool swmr_;
+        std::atomic<hsize_t> corkFlushes_{ 0 };
+        bool stopCorking_{ false };
+        std::mutex corkMutex_;
+        std::condition_variable wakeCorking_;
+        std::thread corkThread_;
     };
 
     //! Encapsulates the access to an instrument.
@@ -1541,7 +1707,7 @@ namespace mbc::h5 {
         void operator=(const Instrument&&) = delete;
 
         //! Constructs a new instance.
-        Instrument(const char* instrumentPath, hid_t groupId, bool readOnly, std::string filePath);
+        Instrument(const char* instrumentPath, hid_t groupId, bool readOnly, std::string filePath, const DatasetCreationOptions& datasetCreationOptions = DatasetCreationOptions(), bool swmr = false);
 
         //! Destructs the instance.
         ~Instrument();
@@ -1563,21 +1729,45 @@ namespace mbc::h5 {
         //! \return A shared pointer to a h5::QuoteData object.
         [[nodiscard]] std::shared_ptr<QuoteData> openQuoteData(bool createNonexistent = false) const;
 
+        //! Opens an instrument's quote data.
+        //! \param createNonexistent Create the data if it does not exist; works for writable h5 files only.
+        //! \param options The layout and the compression of the data if it is created.
+        //! \return A shared pointer to a h5::QuoteData object.
+        [[nodiscard]] std::shared_ptr<QuoteData> openQuoteData(bool createNonexistent, const DatasetCreationOptions& options) const;
+
         //! Opens an instrument's price-only quote data.
         //! \param createNonexistent Create the data if it does not exist; works for writable h5 files only.
         //! \return A shared pointer to a h5::QuotePriceOnlyData object.
         [[nodiscard]] std::shared_ptr<QuotePriceOnlyData> openQuotePriceOnlyData(bool createNonexistent = false) const;
 
+        //! Opens an instrument's price-only quote data.
+        //! \param createNonexistent Create the data if it does not exist; works for writable h5 files only.
+        //! \param options The layout and the compression of the data if it is created.
+        //! \return A shared pointer to a h5::QuotePriceOnlyData object.
+        [[nodiscard]] std::shared_ptr<QuotePriceOnlyData> openQuotePriceOnlyData(bool createNonexistent, const DatasetCreationOptions& options) const;
+
         //! Opens an instrument's trade data.
         //! \param createNonexistent Create the data if it does not exist; works for writable h5 files only.
         //! \return A shared pointer to a h5::TradeData object.
         [[nodiscard]] std::shared_ptr<TradeData> openTradeData(bool createNonexistent = false) const;
 
+        //! Opens an instrument's trade data.
+        //! \param createNonexistent Create the data if it does not exist; works for writable h5 files only.
+        //! \param options The layout and the compression of the data if it is created.
+        //! \return A shared pointer to a h5::TradeData object.
+        [[nodiscard]] std::shared_ptr<TradeData> openTradeData(bool createNonexistent, const DatasetCreationOptions& options) const;
+
         //! Opens an instrument's price-only trade data.
         //! \param createNonexistent Create the data if it does not exist; works for writable h5 files only.
         //! \return A shared pointer to a h5::TradePriceOnlyData object.
         [[nodiscard]] std::shared_ptr<TradePriceOnlyData> openTradePriceOnlyData(bool createNonexistent = false) const;
 
+        //! Opens an instrument's price-only trade data.
+        //! \param createNonexistent Create the data if it does not exist; works for writable h5 files only.
+        //! \param options The layout and the compression of the data if it is created.
+        //! \return A shared pointer to a h5::TradePriceOnlyData object.
+        [[nodiscard]] std::shared_ptr<TradePriceOnlyData> openTradePriceOnlyData(bool createNonexistent, const DatasetCreationOptions& options) const;
+
         //! Opens an instrument's ohlcv data.
         //! \param kind A kind of the data to open.
         //! \param timeFrame A time frame of the data to open.
@@ -1585,6 +1775,14 @@ namespace mbc::h5 {
         //! \return A shared pointer to a h5::OhlcvData object.
         [[nodiscard]] std::shared_ptr<OhlcvData> openOhlcvData(OhlcvKind kind, DataTimeFrame timeFrame, bool createNonexistent = false) const;
 
+        //! Opens an instrument's ohlcv data.
+        //! \param kind A kind of the data to open.
+        //! \param timeFrame A time frame of the data to open.
+        //! \param createNonexistent Create the data if it does not exist; works for writable h5 files only.
+        //! \param options The layout and the compression of the data if it is created.
+        //! \return A shared pointer to a h5::OhlcvData object.
+        [[nodiscard]] std::shared_ptr<OhlcvData> openOhlcvData(OhlcvKind kind, DataTimeFrame timeFrame, bool createNonexistent, const DatasetCreationOptions& options) const;
+
         //! Opens an instrument's price-only ohlcv data.
         //! \param kind A kind of the data to open.
         //! \param timeFrame A time frame of the data to open.
@@ -1592,6 +1790,14 @@ namespace mbc::h5 {
         //! \return A shared pointer to a h5::OhlcvPriceOnlyData object.
         [[nodiscard]] std::shared_ptr<OhlcvPriceOnlyData> openOhlcvPriceOnlyData(OhlcvKind kind, DataTimeFrame timeFrame, bool createNonexistent = false) const;
 
+        //! Opens an instrument's price-only ohlcv data.
+        //! \param kind A kind of the data to open.
+        //! \param timeFrame A time frame of the data to open.
+        //! \param createNonexistent Create the data if it does not exist; works for writable h5 files only.
+        //! \param options The layout and the compression of the data if it is created.
+        //! \return A shared pointer to a h5::OhlcvPriceOnlyData object.
+        [[nodiscard]] std::shared_ptr<OhlcvPriceOnlyData> openOhlcvPriceOnlyData(OhlcvKind kind, DataTimeFrame timeFrame, bool createNonexistent, const DatasetCreationOptions& options) const;
+
         //! Opens an adjusted instrument's ohlcv data.
         //! \param kind A kind of the data to open.
         //! \param timeFrame A time frame of the data to open.
@@ -1599,6 +1805,14 @@ namespace mbc::h5 {
         //! \return A shared pointer to a h5::OhlcvData object.
         [[nodiscard]] std::shared_ptr<OhlcvData> openOhlcvAdjustedData(OhlcvKind kind, DataTimeFrame timeFrame, bool createNonexistent = false) const;
 
+        //! Opens an adjusted instrument's ohlcv data.
+        //! \param kind A kind of the data to open.
+        //! \param timeFrame A time frame of the data to open.
+        //! \param createNonexistent Create the data if it does not exist; works for writable h5 files only.
+        //! \param options The layout and the compression of the data if it is created.
+        //! \return A shared pointer to a h5::OhlcvData object.
+        [[nodiscard]] std::shared_ptr<OhlcvData> openOhlcvAdjustedData(OhlcvKind kind, DataTimeFrame timeFrame, bool createNonexistent, const DatasetCreationOptions& options) const;
+
         //! Opens an adjusted instrument's price-only ohlcv data.
         //! \param kind A kind of the data to open.
         //! \param timeFrame A time frame of the data to open.
@@ -1606,30 +1820,499 @@ namespace mbc::h5 {
         //! \return A shared pointer to a h5::OhlcvPriceOnlyData object.
         [[nodiscard]] std::shared_ptr<OhlcvPriceOnlyData> openOhlcvAdjustedPriceOnlyData(OhlcvKind kind, DataTimeFrame timeFrame, bool createNonexistent = false) const;
 
+        //! Opens an adjusted instrument's price-only ohlcv data.
+        //! \param kind A kind of the data to open.
+        //! \param timeFrame A time frame of the data to open.
+        //! \param createNonexistent Create the data if it does not exist; works for writable h5 files only.
+        //! \param options The layout and the compression of the data if it is created.
+        //! \return A shared pointer to a h5::OhlcvPriceOnlyData object.
+        [[nodiscard]] std::shared_ptr<OhlcvPriceOnlyData> openOhlcvAdjustedPriceOnlyData(OhlcvKind kind, DataTimeFrame timeFrame, bool createNonexistent, const DatasetCreationOptions& options) const;
+
         //! Opens an instrument's scalar data.
         //! \param timeFrame A time frame of the data to open.
         //! \param createNonexistent Create the data if it does not exist; works for writable h5 files only.
         //! \return A shared pointer to a h5::ScalarData object.
         [[nodiscard]] std::shared_ptr<ScalarData> openScalarData(DataTimeFrame timeFrame, bool createNonexistent = false) const;
 
+        //! Opens an instrument's scalar data.
+        //! \param timeFrame A time frame of the data to open.
+        //! \param createNonexistent Create the data if it does not exist; works for writable h5 files only.
+        //! \param options The layout and the compression of the data if it is created.
+        //! \return A shared pointer to a h5::ScalarData object.
+        [[nodiscard]] std::shared_ptr<ScalarData> openScalarData(DataTimeFrame timeFrame, bool createNonexistent, const DatasetCreationOptions& options) const;
+
     private:
         friend class Data;
 
         [[nodiscard]] static int compareDataset(const void* first, const void* second) noexcept;
 
-        [[nodiscard]] inline std::shared_ptr<OhlcvData> openOhlcvData(OhlcvKind kind, DataTimeFrame timeFrame, bool adjusted, bool createNonexistent) const;
-        [[nodiscard]] inline std::shared_ptr<OhlcvPriceOnlyData> openOhlcvPriceOnlyData(OhlcvKind kind, DataTimeFrame timeFrame, bool adjusted, bool createNonexistent) const;
+        [[nodiscard]] inline std::shared_ptr<OhlcvData> openOhlcvData(OhlcvKind kind, DataTimeFrame timeFrame, bool adjusted, bool createNonexistent, const DatasetCreationOptions& options) const;
+        [[nodiscard]] inline std::shared_ptr<OhlcvPriceOnlyData> openOhlcvPriceOnlyData(OhlcvKind kind, DataTimeFrame timeFrame, bool adjusted, bool createNonexistent, const DatasetCreationOptions& options) const;
 
+        mutable std::shared_mutex mutex_;
         std::string filePath_;
         std::string instrumentPath_;
+        DatasetCreationOptions datasetCreationOptions_;
         hid_t groupId_;
         bool readOnly_;
+        bool swmr_;
     };
 
     template <typename T> using Collect = std::function<void(const T*, hsize_t)>;
 
+    //! The number of data items and the date and time ticks of the first and the last of them.
+    struct DataSummary
+    {
+        //! The number of data items.
+        hsize_t count_;
+
+        //! The date and time ticks of the first data item, 0 if there are no items.
+        long long firstTicks_;
+
+        //! The date and time ticks of the last data item, 0 if there are no items.
+        long long lastTicks_;
+    };
+
+    //! The statistics of the reads made by the fetches of a data.
+    struct DataReadStatistics
+    {
+        //! The number of dataset reads.
+        hsize_t reads_;
+
+        //! The number of data items read.
+        hsize_t items_;
+
+        //! The number of dataset chunks the reads touched.
+        //! Every touch decompresses the chunk unless the chunk is found in the chunk cache.
+        hsize_t chunks_;
+    };
+
+    //! The zone map of a run of consecutive data items up to the size of a dataset chunk, the summary of the data items in it.
+    //! The fields are the fields of the data item following the ticks, in the order of the item: the ask price first for a quote,
+    //! the open price first for an ohlcv, the price first for a trade and the value for a scalar.
+    struct DataZone
+    {
+        //! The maximal number of the fields following the ticks.
+        static constexpr unsigned maximumFields{ 7 };
+
+        //! The number of data items in the zone. The appends fill the zones up to the number of items in a chunk,
+        //! the prepends, the inserts and the deletes leave the shorter zones around the changed items.
+        hsize_t count_;
+
+        //! The date and time ticks of the first data item in the zone.
+        long long firstTicks_;
+
+        //! The date and time ticks of the last data item in the zone.
+        long long lastTicks_;
+
+        //! The minimal values of the fields, the unused fields are zero.
+        double minimum_[maximumFields];
+
+        //! The maximal values of the fields, the unused fields are zero.
+        double maximum_[maximumFields];
+
+        //! The sums of the values of the fields, the unused fields are zero.
+        double sum_[maximumFields];
+    };
+
+    //! A segment of the data in the segmented layout, a range of rows of a dataset of its own.
+    //! The segments follow each other in the time order and the last one grows with the appended items.
+    struct DataSegment
+    {
+        //! The path of the dataset holding the segment.
+        std::string datasetPath_;
+
+        //! The index of the first data item of the segment in the data.
+        hsize_t offset_;
+
+        //! The index of the first row of the segment in its dataset.
+        hsize_t rowOffset_;
+
+        //! The number of data items in the segment.
+        hsize_t count_;
+    };
+
+    //! Selects what an aggregation over a range of data items computes besides the count and the first and the last items.
+    struct AggregateSpec
+    {
+        //! The mask of the field bits of the fields to compute the minimum, the maximum and the sum of, e.g. Trade::priceField | Trade::volumeField.
+        unsigned fields_{ 0 };
+
+        //! Computes the volume-weighted average price. Applies to the trade data only.
+        bool volumeWeighted_{ false };
+
+        //! Computes the time-weighted average mid price and spread. Applies to the quote data only.
+        bool timeWeighted_{ false };
+    };
+
+    //! The aggregates of a range of data items, computed inside the library a chunk at a time.
+    //! The fields are indexed by their position after the ticks, as in DataZone.
+    struct DataAggregate
+    {
+        //! The number of data items in the range.
+        hsize_t count_;
+
+        //! The date and time ticks of the first data item in the range.
+        long long firstTicks_;
+
+        //! The date and time ticks of the last data item in the range.
+        long long lastTicks_;
+
+        //! The fields of the first data item in the range, the unused fields are zero.
+        double first_[DataZone::maximumFields];
+
+        //! The fields of the last data item in the range, the unused fields are zero.
+        double last_[DataZone::maximumFields];
+
+        //! The minimal values of the selected fields, the other fields are zero.
+        double minimum_[DataZone::maximumFields];
+
+        //! The maximal values of the selected fields, the other fields are zero.
+        double maximum_[DataZone::maximumFields];
+
+        //! The sums of the values of the selected fields, the other fields are zero.
+        double sum_[DataZone::maximumFields];
+
+        //! The sum of the prices times the volumes divided by the sum of the volumes, zero if the volumes sum to zero or not requested.
+        double volumeWeightedPrice_;
+
+        //! The mid price averaged over the time every quote holds until the next one, or the mid price of the last quote if the quotes span no time.
+        double timeWeightedMid_;
+
+        //! The ask price minus the bid price averaged like the time-weighted mid price.
+        double timeWeightedSpread_;
+    };
+
+    //! The comparison enumeration of a predicate term.
+    enum class PredicateComparison
+    {
+        //! The value is less than the term value.
+        Less = 0,
+        //! The value is less than or equal to the term value.
+        LessOrEqual = 1,
+        //! The value is greater than the term value.
+        Greater = 2,
+        //! The value is greater than or equal to the term value.
+        GreaterOrEqual = 3,
+        //! The value equals the term value.
+        Equal = 4,
+        //! The value does not equal the term value.
+        NotEqual = 5,
+        //! The value is between the term value and the upper term value, both inclusive.
+        Between = 6
+    };
+
+    //! A term of a data predicate, comparing a field of a data item, or the difference of two fields, with constants.
+    struct PredicateTerm
+    {
+        //! The field bit of the compared field, e.g. Trade::volumeField; the ticks cannot be compared.
+        unsigned field_{ 0 };
+
+        //! The field bit of the field subtracted from the compared one, e.g. Quote::bidPriceField, or zero to compare the field itself.
+        unsigned subtractedField_{ 0 };
+
+        //! The comparison of the value with the term value.
+        PredicateComparison comparison_{ PredicateComparison::Equal };
+
+        //! The term value, the lower bound of the Between comparison.
+        double value_{ 0 };
+
+        //! The upper bound of the Between comparison.
+        double upperValue_{ 0 };
+    };
+
+    //! A filter of data items, matching the items satisfying all its terms. A predicate without terms matches every item.
+    struct DataPredicate
+    {
+        //! The terms of the predicate.
+        std::vector<PredicateTerm> terms_;
+    };
+
+    //! The downsampling method enumeration. The charted value of an item is the mid price of a quote, the price of a trade,
+    //! the closing price of an ohlcv and the value of a scalar; the envelope of an ohlcv follows its lowest and highest prices.
+    enum class DownsamplingMethod
+    {
+        //! Every n-th item starting from the first one.
+        EveryNth = 0,
+        //! The items with the lowest and the highest charted values in every bucket, in their order; two points per bucket.
+        MinMaxEnvelope = 1,
+        //! The largest-triangle-three-buckets: the first and the last items, and the item of every bucket
+        //! forming the largest triangle with the item chosen in the previous bucket and the average of the next bucket.
+        LargestTriangleThreeBuckets = 2
+    };
+
+    //! The selected fields of fetched items, stored as separate columns, each contiguous and aligned to Projection::alignment bytes.
+    //! The storage is reused by the subsequent fetches into the same projection.
+    class Projection final
+    {
+    public:
+        //! The alignment in bytes of every column.
+        static constexpr size_t alignment{ 64 };
+
+        //! The maximal number of fields in an item.
+        static constexpr unsigned maximumFields{ 8 };
+
+        //! Constructs an empty instance.
+        Projection() = default;
+        Projection(const Projection&) = delete;
+        Projection(const Projection&&) = delete;
+        void operator=(const Projection&) = delete;
+        void operator=(const Projection&&) = delete;
+
+        //! The number of items in every column.
+        [[nodiscard]] hsize_t count() const
+        {
+            return count_;
+        }
+
+        //! The mask of the fields the columns hold.
+        [[nodiscard]] unsigned fields() const
+        {
+            return fields_;
+        }
+
+        //! The time ticks column, or a null pointer if the time ticks were not fetched.
+        [[nodiscard]] const long long* ticks() const
+        {
+            return reinterpret_cast<const long long*>(columns_[0]);
+        }
+
+        //! The column of a field following the time ticks, or a null pointer if the field was not fetched.
+        //! \param field The bit of the field, for instance Quote::bidPriceField.
+        [[nodiscard]] const double* column(unsigned field) const;
+
+    private:
+        friend class Data;
+
+        //! Makes room for the columns of the selected fields.
+        //! \param fields The mask of the selected fields.
+        //! \param count The number of items in every column.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool reserve(unsigned fields, hsize_t count);
+
+        struct Deleter
+        {
+            void operator()(unsigned char* storage) const;
+        };
+
+        std::unique_ptr<unsigned char[], Deleter> storage_;
+        size_t storageBytes_{ 0 };
+        unsigned char* columns_[maximumFields]{};
+        hsize_t count_{ 0 };
+        unsigned fields_{ 0 };
+    };
+
+    //! Pulls a range of stored items page by page. The pages are aligned to the dataset chunks,
+    //! and the next page is read on a background thread while the current one is processed.
+    //! A reverse cursor yields the pages from the last one to the first one, the items of a page stay in their stored order.
+    //! The cursor keeps its data alive; once the data is closed, reading the next page fails.
+    template <typename T> class Cursor final
+    {
+    public:
+        Cursor(const Cursor&) = delete;
+        Cursor(const Cursor&&) = delete;
+        void operator=(const Cursor&) = delete;
+        void operator=(const Cursor&&) = delete;
+
+        //! Destructs the instance.
+        ~Cursor();
+
+        //! Gets the next page of items.
+        //! The previous page is released and must not be accessed anymore.
+        //! \param page A pointer to the first item of the page, valid until the next call.
+        //! \param count The number of items in the page, 0 if there are no more pages.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool next(const T*& page, hsize_t& count);
+
+        //! The index of the first item of the current page.
+        [[nodiscard]] hsize_t index() const
+        {
+            return pageIndex_;
+        }
+
+        //! Stops reading ahead and releases the page buffers.
+        void close();
+
+    private:
+        friend class Data;
+
+        //! Constructs a new instance and starts reading ahead.
+        Cursor(std::shared_ptr<const Data> data, hsize_t index, hsize_t count, hsize_t pageRows, hsize_t chunkRows, bool reverse);
+
+        //! Reads the pages into the free buffers until the range is exhausted or the cursor is closed.
+        void readAhead();
+
+        const std::shared_ptr<const Data> data_;
+        std::vector<T> pages_[2];
+        hsize_t pageOffsets_[2]{ 0, 0 };
+        hsize_t pageCounts_[2]{ 0, 0 };
+        bool pageFilled_[2]{ false, false };
+        hsize_t offset_;
+        hsize_t end_;
+        hsize_t pageRows_;
+        hsize_t chunkRows_;
+        bool reverse_;
+        hsize_t pageIndex_{ 0 };
+        unsigned long long produced_{ 0 };
+        unsigned long long consumed_{ 0 };
+        bool holding_{ false };
+        bool stop_{ false };
+        bool done_{ false };
+        bool failed_{ false };
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::thread thread_;
+    };
+
+    //! What an appender does when its queue is full.
+    enum class AppenderOverflow
+    {
+        //! Waits until the background thread frees enough room in the queue.
+        Block = 0,
+        //! Rejects the items which do not fit into the queue.
+        Reject = 1
+    };
+
+    //! The queueing and the flushing policy of an appender.
+    struct AppenderOptions
+    {
+        //! The number of items the queue can hold.
+        hsize_t capacity_{ 1024 * 80 };
+
+        //! The queue is flushed when it holds at least this number of items, 0 means the number of rows in a dataset chunk.
+        hsize_t flushItems_{ 0 };
+
+        //! The queue is flushed when its oldest item has been waiting this long, 0 flushes by the number of items only.
+        unsigned flushMilliseconds_{ 100 };
+
+        //! What to do when the queue is full.
+        AppenderOverflow overflow_{ AppenderOverflow::Block };
+
+        //! The duplicate time ticks policy of the flushes.
+        DuplicateTimeTicks duplicateTimeTicks_{ DuplicateTimeTicks::Fail };
+    };
+
+    //! The statistics of an appender.
+    struct AppenderStatistics
+    {
+        //! The number of items currently waiting in the queue.
+        hsize_t queueDepth_;
+
+        //! The number of items accepted into the queue.
+        hsize_t appended_;
+
+        //! The number of items rejected because the queue was full or the appender was closed.
+        hsize_t rejected_;
+
+        //! The number of items written to the dataset.
+        hsize_t flushed_;
+
+        //! The number of items the flushes failed to write.
+        hsize_t failed_;
+
+        //! The number of flushes.
+        hsize_t flushes_;
+
+        //! The duration of the last flush in microseconds.
+        long long lastFlushMicroseconds_;
+
+        //! The longest duration of a flush in microseconds.
+        long long maximumFlushMicroseconds_;
+    };
+
+    //! Accumulates the items added one by one in a lock-free queue and writes them to the data in batches from a background thread.
+    //! A single thread at a time may append; the items must have increasing ticks, also across the calls.
+    //! The appender keeps its data alive; once the data is closed, the flushes fail and count their items as failed.
+    template <typename T> class Appender final
+    {
+    public:
+        Appender(const Appender&) = delete;
+        Appender(const Appender&&) = delete;
+        void operator=(const Appender&) = delete;
+        void operator=(const Appender&&) = delete;
+
+        //! Destructs the instance, flushing the queued items.
+        ~Appender();
+
+        //! Queues an item.
+        //! \param item The item to queue.
+        //! \return A boolean indicating if the item was queued.
+        bool append(const T& item);
+
+        //! Queues an array of items.
+        //! \param items A pointer to an array of items.
+        //! \param count The number of items in the array.
+        //! \return A boolean indicating if all items were queued; the items which did not fit into the queue are rejected.
+        bool append(const T* items, hsize_t count);
+
+        //! Writes the queued items and waits until they are written.
+        //! \return A boolean indicating if all flushes so far succeeded.
+        bool flush();
+
+        //! Writes the queued items and stops the background thread, the subsequent appends are rejected.
+        void close();
+
+        //! The number of items currently waiting in the queue.
+        [[nodiscard]] hsize_t queueDepth() const
+        {
+            return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+        }
+
+        //! The statistics of the appender.
+        [[nodiscard]] AppenderStatistics statistics() const;
+
+    private:
+        friend class Data;
+
+        //! Constructs a new instance and starts the background thread.
+        Appender(std::shared_ptr<const Data> data, const AppenderOptions& options, hsize_t flushItems);
+
+        //! Writes the queue in batches until the appender is closed.
+        void writeBehind();
+
+        //! Writes all items queued so far. Called on the background thread only.
+        void writeQueued();
+
+        const std::shared_ptr<const Data> data_;
+        std::vector<T> ring_;
+        std::vector<T> batch_;
+        const hsize_t flushItems_;
+        const std::chrono::milliseconds flushInterval_;
+        const AppenderOverflow overflow_;
+        const DuplicateTimeTicks duplicateTimeTicks_;
+        std::atomic<unsigned long long> head_{ 0 };
+        std::atomic<unsigned long long> tail_{ 0 };
+        std::atomic<unsigned long long> flushRequests_{ 0 };
+        std::atomic<hsize_t> appended_{ 0 };
+        std::atomic<hsize_t> rejected_{ 0 };
+        std::atomic<hsize_t> flushed_{ 0 };
+        std::atomic<hsize_t> failed_{ 0 };
+        std::atomic<hsize_t> flushes_{ 0 };
+        std::atomic<long long> lastFlushMicroseconds_{ 0 };
+        std::atomic<long long> maximumFlushMicroseconds_{ 0 };
+        unsigned long long flushesDone_{ 0 };
+        std::atomic<bool> closed_{ false };
+        bool stop_{ false };
+        mutable std::mutex mutex_;
+        std::condition_variable wakeWriter_;
+        std::condition_variable wakeAppender_;
+        std::thread thread_;
+    };
+
+    //! The datasets holding the items of a data, each with the memory type its part of the items is transferred with.
+    //! A compound dataset is a single column transferred with the native type of the items. In the columnar layout every field
+    //! is a dataset of its own, transferred with a type of the size of the item holding that field only, so that every column
+    //! reads or writes its field in the same item buffer and the other fields of the buffer are kept.
+    struct DatasetColumns : std::vector<std::pair<hid_t, hid_t>>
+    {
+        using std::vector<std::pair<hid_t, hid_t>>::vector;
+
+        //! The number of the rows trimmed from the head of the datasets, which precede the first item until the data is compacted.
+        hsize_t head_{ 0 };
+    };
+
     //! Encapsulates the access to the instrument's data.
-    class Data
+    class Data : public std::enable_shared_from_this<Data>
     {
     public:
         Data(const Data&) = delete;
@@ -1655,6 +2338,47 @@ namespace mbc::h5 {
         //! The number of data items.
         [[nodiscard]] hsize_t count() const;
 
+        //! The number of data items and the date and time ticks of the first and the last of them.
+        //! The values are cached and kept up to date by the writes made through this instance. The repeated calls check the cached values
+        //! against the item count of the dataset, which reads no chunk, and read them again after another instance of the data has changed it.
+        [[nodiscard]] DataSummary summary() const;
+
+        //! The statistics of the reads made by the fetches and the cursors of this instance.
+        [[nodiscard]] DataReadStatistics readStatistics() const;
+
+        //! Resets the read statistics to zero.
+        void resetReadStatistics() const;
+
+        //! Fetches the zone maps of the data items, which are stored next to the dataset and kept up to date by the writes made through this instance.
+        //! A writable data rebuilds the outdated zone maps on the first access, a read-only data with outdated zone maps and a data without them fail.
+        //! \param zones The zone maps in the order of the items, the first one starting at the first item and every next one after the previous one.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchZones(std::vector<DataZone>& zones) const;
+
+        //! Builds the zone maps of a data stored without them, creating their dataset next to it. The writes maintain them from then on.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool buildZones() const;
+
+        //! Fetches the segments of the data in the segmented layout in the time order, the data in the other layouts makes a single segment.
+        //! \param segments The segments.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchSegments(std::vector<DataSegment>& segments) const;
+
+        //! Coalesces every run of adjacent segments holding fewer items than the threshold into a single segment, rewriting the items of the runs only.
+        //! The segments left after trimming the head are rewritten without the trimmed rows. The data in the compound layout moves its items over
+        //! the rows trimmed from its head, which are dropped then. Does nothing for the data in the columnar layout.
+        //! \param segmentRows The threshold number of items, the maximal value coalesces all segments into one.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool compact(hsize_t segmentRows) const;
+
+        //! Drops the rows preallocated by the appends, so that the dataset holds the items only.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool shrinkToFit() const;
+
+        //! Refreshes the metadata of the dataset and drops the cached summary, so that a SWMR reader sees the items the writer has flushed since.
+        //! \return A boolean indicating the success of the operation.
+        bool refresh() const;
+
         //! The maximal size in bytes of the read buffer, 0 means unlimited.
         [[nodiscard]] hsize_t maximumReadBufferBytes() const
         {
@@ -1679,16 +2403,125 @@ namespace mbc::h5 {
             defaultMaximumReadBufferBytes_ = value;
         }
 
-        //! Converts ticks to an index.
-        //! \param ticks The ticks to convert.
-        //! \param index The index of the ticks.
-        //! \param match If the index matches the ticks exactly or is a lower neighbor.
-        //! \return A boolean indicating the success of the operation.
-        virtual bool ticksIndex(long long ticks, hsize_t& index, bool& match) const = 0;
+        //! The number of threads decompressing the chunks of a read spanning several chunks, 0 means the number of hardware threads.
+        //! The default of 1 reads through the HDF5 filter pipeline and the chunk cache, which decompresses one chunk at a time.
+        //! The parallel reads bypass the chunk cache, so they apply to the reads larger than the chunk cache only.
+        //! A read never spans more chunks than the read buffer holds, so a scan decompresses in parallel only if the buffer holds several chunks.
+        [[nodiscard]] unsigned decompressionThreads() const
+        {
+            return decompressionThreads_;
+        }
 
-        //! Converts a ticks range to an index range.
-        //! \param ticksFrom The first ticks of the range.
-        //! \param ticksTo The last ticks of the range.
+        //! Sets the number of threads decompressing the chunks of a read spanning several chunks, 0 means the number of hardware threads.
+        void setDecompressionThreads(const unsigned value)
+        {
+            decompressionThreads_ = value;
+        }
+
+        //! The default number of threads decompressing the chunks of a read spanning several chunks, 0 means the number of hardware threads.
+        static unsigned defaultDecompressionThreads()
+        {
+            return defaultDecompressionThreads_;
+        }
+
+        //! Sets the default number of threads decompressing the chunks of a read spanning several chunks, 0 means the number of hardware threads.
+        static void setDefaultDecompressionThreads(const unsigned value)
+        {
+            defaultDecompressionThreads_ = value;
+        }
+
+        //! The number of threads compressing the whole chunks an append adds, 0 means the number of hardware threads.
+        //! A value of 1 writes through the HDF5 filter pipeline, which compresses one chunk at a time.
+        [[nodiscard]] unsigned compressionThreads() const
+        {
+            return compressionThreads_;
+        }
+
+        //! Sets the number of threads compressing the whole chunks an append adds, 0 means the number of hardware threads.
+        void setCompressionThreads(const unsigned value)
+        {
+            compressionThreads_ = value;
+        }
+
+        //! The default number of threads compressing the whole chunks an append adds, 0 means the number of hardware threads.
+        static unsigned defaultCompressionThreads()
+        {
+            return defaultCompressionThreads_;
+        }
+
+        //! Sets the default number of threads compressing the whole chunks an append adds, 0 means the number of hardware threads.
+        static void setDefaultCompressionThreads(const unsigned value)
+        {
+            defaultCompressionThreads_ = value;
+        }
+
+        //! The size in bytes of the chunk caches of the datasets of the data, taken from the process-wide chunk cache budget.
+        [[nodiscard]] size_t chunkCacheBytes() const
+        {
+            return chunkCacheBytes_;
+        }
+
+        //! The maximal size in bytes of the in-memory tick index, 0 disables the index.
+        [[nodiscard]] hsize_t maximumTickIndexBytes() const
+        {
+            return maximumTickIndexBytes_;
+        }
+
+        //! Sets the maximal size in bytes of the in-memory tick index, 0 disables the index.
+        void setMaximumTickIndexBytes(const hsize_t value)
+        {
+            maximumTickIndexBytes_ = value;
+        }
+
+        //! The default maximal size in bytes of the in-memory tick index, 0 disables the index.
+        static hsize_t defaultMaximumTickIndexBytes()
+        {
+            return defaultMaximumTickIndexBytes_;
+        }
+
+        //! Sets the default maximal size in bytes of the in-memory tick index, 0 disables the index.
+        static void setDefaultMaximumTickIndexBytes(const hsize_t value)
+        {
+            defaultMaximumTickIndexBytes_ = value;
+        }
+
+        //! Whether the appends preallocate rows, growing the dataset in whole chunks ahead of the items and keeping the item count in an attribute,
+        //! so that a run of small appends resizes the dataset rarely. Applies to the data in the compound and the columnar layouts written without SWMR.
+        //! The preallocated rows are dropped before any other write and when the data is closed or shrunk to fit.
+        //! The attribute is written when the dataset grows and on a flush, the other readers see the appends in between after the flush.
+        [[nodiscard]] bool preallocate() const
+        {
+            return preallocate_;
+        }
+
+        //! Sets whether the appends preallocate rows.
+        void setPreallocate(const bool value)
+        {
+            preallocate_ = value;
+        }
+
+        //! The default of whether the appends preallocate rows.
+        static bool defaultPreallocate()
+        {
+            return defaultPreallocate_;
+        }
+
+        //! Sets the default of whether the appends preallocate rows.
+        static void setDefaultPreallocate(const bool value)
+        {
+            defaultPreallocate_ = value;
+        }
+
+        //! Converts ticks to an index.
+        //! \param ticks The ticks to convert.
+        //! \param index The index of the ticks.
+        //! \param match If the index matches the ticks exactly or is a lower neighbor.
+        //! \return A boolean indicating the success of the operation.
+        virtual bool ticksIndex(long long ticks, hsize_t& index, bool& match) const = 0;
+
+        //! Converts a ticks range to an index range.
+        //! \param ticksFrom The first ticks of the range.
+        //! \param ticksTo The last ticks of the range.
         //! \param indexFrom The index of the first item in the range.
         //! \param indexTo The index of the last item in the range.
         //! \param matchFrom If the index of the first item in the range matches the ticks exactly or is a lower neighbor.
@@ -1698,6 +2531,8 @@ namespace mbc::h5 {
 
     private:
         friend class Instrument;
+        template <typename T> friend class Cursor;
+        template <typename T> friend class Appender;
         friend class QuoteData;
         friend class QuotePriceOnlyData;
         friend class TradeData;
@@ -1742,6 +2577,204 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         template <typename T> [[nodiscard]] bool addData(const T* input, hsize_t inputCount, DuplicateTimeTicks duplicateTimeTicks, bool verbose) const;
 
+        //! Writes an array of increasing input data to the dataset. The caller must hold the data lock and the library lock, which is released while the appended chunks are compressed.
+        //! \param input A pointer to an array of input items.
+        //! \param inputCount A number of items in the array.
+        //! \param duplicateTimeTicks The duplicate time tick policy.
+        //! \param verbose Trace information messages.
+        //! \param libraryLock The held library lock.
+        //! \return A boolean indicating the success of the operation.
+        template <typename T> [[nodiscard]] bool addDataNoLock(const T* input, hsize_t inputCount, DuplicateTimeTicks duplicateTimeTicks, bool verbose, std::unique_lock<std::mutex>& libraryLock) const;
+
+        //! Merges an array of increasing input data starting before the last stored item into the data in the segmented layout.
+        //! Only the stored items within the time range of the input are read, they are written with the input to a new segment.
+        //! The caller must hold the exclusive data lock and the library lock, which is released while the chunks are compressed.
+        //! \param input A pointer to an array of input items.
+        //! \param inputCount A number of items in the array.
+        //! \param duplicateTimeTicks The duplicate time tick policy.
+        //! \param verbose Trace information messages.
+        //! \param libraryLock The held library lock.
+        //! \return A boolean indicating the success of the operation.
+        template <typename T> [[nodiscard]] bool spliceDataNoLock(const T* input, hsize_t inputCount, DuplicateTimeTicks duplicateTimeTicks, bool verbose, std::unique_lock<std::mutex>& libraryLock) const;
+
+        //! Gets the number of the items from the dataset, for the index ranges which must not be clamped by a cached count.
+        //! The caller must hold the data lock, but not the library lock.
+        //! \param itemCount The number of the items.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool countNoLock(hsize_t& itemCount) const;
+
+        //! Gets the cached summary, if the item count of the dataset still matches it, or reads it from the dataset.
+        //! The caller must hold the data lock, but not the library lock.
+        //! \param summary The summary.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool summaryNoLock(DataSummary& summary) const;
+
+        //! The number of rows in a dataset chunk. The caller must hold the library lock.
+        [[nodiscard]] hsize_t chunkRowsNoLock() const;
+
+        //! Reads a range of rows, decompressing the chunks on several threads if the range spans several chunks and the filters allow.
+        //! The caller must hold the data lock and the library lock, which is released while the chunks are decompressed.
+        //! \param itemOffset The index of the first item to read.
+        //! \param itemCount The number of items to read.
+        //! \param itemBuffer The buffer receiving the items.
+        //! \param libraryLock The held library lock.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool readItemsNoLock(hsize_t itemOffset, hsize_t itemCount, void* itemBuffer, std::unique_lock<std::mutex>& libraryLock) const;
+
+        //! Reads a range of rows of a dataset of the data, the rows of the data itself or of a segment.
+        //! The caller must hold the data lock and the library lock, which is released while the chunks are decompressed.
+        //! \param datasetId The dataset to read.
+        //! \param rowOffset The index of the first row to read.
+        //! \param rowCount The number of rows to read.
+        //! \param itemBuffer The buffer receiving the items.
+        //! \param libraryLock The held library lock.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool readRowsNoLock(hid_t datasetId, hsize_t rowOffset, hsize_t rowCount, void* itemBuffer, std::unique_lock<std::mutex>& libraryLock) const;
+
+        //! Appends items after the last row, compressing the whole chunks they fill on several threads if the filters allow.
+        //! The caller must hold the exclusive data lock and the library lock, which is released while the chunks are compressed.
+        //! \param itemCount The number of items to append.
+        //! \param itemBuffer The items to append.
+        //! \param libraryLock The held library lock.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool appendItemsNoLock(hsize_t itemCount, const void* itemBuffer, std::unique_lock<std::mutex>& libraryLock) const;
+
+        //! Appends items after the last row of a dataset of the data, the data itself or the last segment. A failed append leaves the rows as they were.
+        //! The caller must hold the exclusive data lock and the library lock, which is released while the chunks are compressed.
+        //! \param datasetId The dataset to append to.
+        //! \param itemCount The number of items to append.
+        //! \param itemBuffer The items to append.
+        //! \param libraryLock The held library lock.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool appendRowsNoLock(hid_t datasetId, hsize_t itemCount, const void* itemBuffer, std::unique_lock<std::mutex>& libraryLock) const;
+
+        //! Gets the number of the items, which is kept in an attribute while the dataset has preallocated rows. The caller must hold the data lock and the library lock.
+        //! \param itemCount The number of the items.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool countRowsNoLock(hsize_t& itemCount) const;
+
+        //! Drops the preallocated rows and the item count attribute. The caller must hold the exclusive data lock and the library lock.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool shrinkNoLock() const;
+
+        //! Writes the item count kept in memory since the last append growing the dataset to its attribute.
+        //! The caller must hold the data lock and the library lock.
+        void storeItemCountNoLock() const;
+
+        //! Loads the segments from the mapping of the virtual dataset unless they are loaded, and opens their datasets.
+        //! The caller must hold the data lock and the library lock.
+        //! \return A boolean indicating whether the data is in the segmented layout.
+        [[nodiscard]] bool segmentedNoLock() const;
+
+        //! Replaces a range of rows of the data in the segmented layout with a new segment, the other segments are not rewritten.
+        //! The caller must hold the exclusive data lock and the library lock.
+        //! \param itemOffset The index of the first replaced row.
+        //! \param replacedCount The number of the replaced rows, zero inserts the segment before the row.
+        //! \param segmentId The dataset of the new segment, which is taken over, or a negative value to delete the replaced rows.
+        //! \param segmentPath The path of the dataset of the new segment.
+        //! \param segmentCount The number of the rows of the new segment.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool spliceSegmentsNoLock(hsize_t itemOffset, hsize_t replacedCount, hid_t segmentId, const std::string& segmentPath, hsize_t segmentCount) const;
+
+        //! Maps the segments by a new virtual dataset replacing the current one, and deletes the segment datasets no longer mapped.
+        //! The caller must hold the exclusive data lock and the library lock.
+        //! \param segments The segments in the time order.
+        //! \param segmentIds The datasets of the segments, which are taken over.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool remapSegmentsNoLock(std::vector<DataSegment>& segments, std::vector<hid_t>& segmentIds) const;
+
+        //! Deletes a range of rows and updates the zone maps. Trimming the head of the data in the compound layout opened with the segmented option
+        //! maps it in the segmented layout starting after the trimmed rows, other data in the compound layout moves its head past them.
+        //! Either way no row is rewritten, except by the SWMR writers, which move the rows after the trimmed ones.
+        //! The caller must hold the exclusive data lock and the library lock.
+        //! \param itemOffset The index of the first deleted row.
+        //! \param itemCount The number of the deleted rows.
+        //! \param itemSize The size of an item.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool deleteRowsNoLock(hsize_t itemOffset, hsize_t itemCount, size_t itemSize) const;
+
+        //! Moves the head of the dataset of the data in the compound layout past the first items and stores it in an attribute of the dataset.
+        //! The trimmed rows are kept until the compaction, trimming all items empties the dataset instead.
+        //! The caller must hold the exclusive data lock and the library lock.
+        //! \param itemCount The number of the trimmed items.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool trimHeadNoLock(hsize_t itemCount) const;
+
+        //! Maps the dataset of the data in the compound layout as the single segment of the segmented layout, without rewriting the items.
+        //! The caller must hold the exclusive data lock and the library lock.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool mapSegmentsNoLock() const;
+
+        //! Creates an empty segment dataset with the creation properties of the last segment.
+        //! The caller must hold the exclusive data lock and the library lock.
+        //! \param datasetPath The path of the created dataset.
+        //! \return The created dataset or a negative value if the operation failed.
+        [[nodiscard]] hid_t createSegmentNoLock(std::string& datasetPath) const;
+
+        //! Loads the stored zone maps unless they are loaded, rebuilding the outdated ones from the stored items if asked and the data is writable.
+        //! The caller must hold the data lock and the library lock.
+        //! \param build Rebuild the outdated zone maps.
+        //! \return A boolean indicating whether the zone maps are available.
+        [[nodiscard]] bool loadZonesNoLock(bool build) const;
+
+        //! Gets the path the data has now, which differs from the one it was opened with if its instrument has been moved or renamed since.
+        //! The caller must hold the data lock and the library lock.
+        //! \param path The path of the data.
+        //! \return A boolean indicating the success of the operation, false if its instrument has been deleted.
+        [[nodiscard]] bool pathNoLock(std::string& path) const;
+
+        //! Opens or creates the dataset of the zone maps with a chunk cache taken from the budget. The caller must hold the data lock and the library lock.
+        //! \param create Create the dataset instead of opening the existing one.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool openZonesNoLock(bool create) const;
+
+        //! Stores the zone maps changed since they were last stored. The caller must hold the data lock and the library lock.
+        void storeZonesNoLock() const;
+
+        //! Extends the loaded zone maps with the appended items. The changes are stored on a flush.
+        //! The caller must hold the exclusive data lock and the library lock.
+        //! \param appendedItems The appended items.
+        //! \param appendedCount The number of the appended items.
+        void appendZonesNoLock(const void* appendedItems, hsize_t appendedCount) const;
+
+        //! Replaces the loaded zone maps of the items a write has replaced with the ones of the written items, reading the written items and
+        //! the rest of the zones they split, and moves the zone maps after them along. The changes are stored on a flush.
+        //! The caller must hold the exclusive data lock and the library lock.
+        //! \param itemOffset The index of the first replaced item.
+        //! \param replacedCount The number of the replaced items, zero for an insert.
+        //! \param writtenCount The number of the items written in their place, zero for a delete.
+        void spliceZonesNoLock(hsize_t itemOffset, hsize_t replacedCount, hsize_t writtenCount) const;
+
+        //! Drops the loaded and the stored zone maps from the zone holding an item on, so that the next read rebuilds them.
+        //! The caller must hold the exclusive data lock and the library lock.
+        //! \param itemOffset The index of the first item the write may have changed.
+        void dropZonesNoLock(hsize_t itemOffset) const;
+
+        //! Seeds a cold tick index from the first ticks of the chunks in the zone maps, so that it is not built by reading every chunk.
+        //! The caller must hold the data lock and the library lock.
+        void seedTickIndexNoLock() const;
+
+        //! Adds a read of a range of rows to the read statistics.
+        //! \param itemOffset The index of the first item read.
+        //! \param itemCount The number of items read.
+        //! \param chunkRows The number of rows in a dataset chunk.
+        void countReadNoLock(hsize_t itemOffset, hsize_t itemCount, hsize_t chunkRows) const;
+
+        //! Refreshes the dataset. The caller must hold the exclusive data lock.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool refreshNoLock() const;
+
+        //! Refreshes the data and fetches the items after a specified index.
+        //! \param collect A callback to fetch data into.
+        //! \param index The index of the first item to fetch, updated to the number of stored items.
+        //! \return A boolean indicating the success of the operation.
+        template <typename T> [[nodiscard]] bool followData(const Collect<T>& collect, hsize_t& index) const;
+
+        //! Reads the summary from the dataset and caches it. The caller must hold the data lock.
+        //! \param summary The summary.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool loadSummaryNoLock(DataSummary& summary) const;
+
         //! Writes a list of input data to the dataset.
         //! \param input A vector of input items.
         //! \param duplicateTimeTicks The duplicate time tick policy.
@@ -1756,14 +2789,56 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         template <typename T> [[nodiscard]] bool fetchData(Collect<T> collect, long long ticksFrom, long long ticksTo) const;
 
-        //! Fetches a range of stored data from the dataset without locking.
+        //! Converts a ticks range to the offset and the count of the items in it. The caller must hold the data lock.
+        //! \param ticksFrom The first ticks of the range, 0 means the first item.
+        //! \param ticksTo The last ticks of the range, 0 means the last item.
+        //! \param itemOffset The index of the first item in the range.
+        //! \param itemCount The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        template <typename T> [[nodiscard]] bool tickRangeToIndexRangeNoLock(long long ticksFrom, long long ticksTo, hsize_t& itemOffset, hsize_t& itemCount) const;
+
+        //! Fetches a range of stored data from the dataset. The caller must hold the data lock.
         //! \param collect A callback to fetch data into.
         //! \param ticksFrom The first ticks of the range.
         //! \param ticksTo The last ticks of the range.
         //! \return A boolean indicating the success of the operation.
         template <typename T> [[nodiscard]] bool fetchDataNoLock(Collect<T> collect, long long ticksFrom, long long ticksTo) const;
 
-        //! Converts ticks to an index without locking.
+        //! Reads a range of rows page by page and passes the pages to a callback. The caller must hold the data lock.
+        //! The pages are limited by the maximal size of the read buffer and aligned to the dataset chunks.
+        //! \param collect A callback to fetch data into.
+        //! \param itemOffset The index of the first item in the range.
+        //! \param itemCount The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        template <typename T> [[nodiscard]] bool collectItemsNoLock(const Collect<T>& collect, hsize_t itemOffset, hsize_t itemCount) const;
+
+        //! Fetches the items of a range of stored data matching a predicate.
+        //! \param collect A callback to fetch the matching data into.
+        //! \param ticksFrom The first ticks of the range.
+        //! \param ticksTo The last ticks of the range.
+        //! \param predicate The predicate the fetched items match.
+        //! \return A boolean indicating the success of the operation.
+        template <typename T> [[nodiscard]] bool fetchDataWhere(Collect<T> collect, long long ticksFrom, long long ticksTo, const DataPredicate& predicate) const;
+
+        //! Reads a range of rows page by page and passes the rows matching a predicate to a callback. The caller must hold the data lock.
+        //! The chunks the zone maps show to hold no matching row are not read, the pages otherwise follow collectItemsNoLock.
+        //! \param collect A callback to fetch the matching data into.
+        //! \param itemOffset The index of the first item in the range.
+        //! \param itemCount The number of items in the range.
+        //! \param predicate The predicate the fetched items match.
+        //! \return A boolean indicating the success of the operation.
+        template <typename T> [[nodiscard]] bool collectMatchingItemsNoLock(const Collect<T>& collect, hsize_t itemOffset, hsize_t itemCount, const DataPredicate& predicate) const;
+
+        //! Fetches a range of stored data downsampled to a number of points in a single streaming pass.
+        //! \param collect A callback to fetch the chosen data into.
+        //! \param ticksFrom The first ticks of the range.
+        //! \param ticksTo The last ticks of the range.
+        //! \param targetPoints The maximal number of the fetched items.
+        //! \param method The downsampling method.
+        //! \return A boolean indicating the success of the operation.
+        template <typename T> [[nodiscard]] bool fetchDownsampledData(Collect<T> collect, long long ticksFrom, long long ticksTo, hsize_t targetPoints, DownsamplingMethod method) const;
+
+        //! Converts ticks to an index. The caller must hold the data lock.
         //! \param ticks The ticks to convert.
         //! \param index The index of the ticks.
         //! \param match If the index matches the ticks exactly or is a lower neighbor.
@@ -1794,18 +2869,147 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         template <typename T> [[nodiscard]] bool fetchFromIndexRange(Collect<T> collect, hsize_t index, hsize_t count) const;
 
+        //! Fetches the last stored items under a single lock, reading only the chunks holding them.
+        //! \param collect A callback to fetch data into.
+        //! \param count The number of the last items, all items if there are fewer of them.
+        //! \return A boolean indicating the success of the operation.
+        template <typename T> [[nodiscard]] bool fetchLastItems(Collect<T> collect, hsize_t count) const;
+
+        //! Fetches the selected fields of a range of stored data into the columns of a projection.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the selected fields.
+        //! \param ticksFrom The first ticks of the range.
+        //! \param ticksTo The last ticks of the range.
+        //! \return A boolean indicating the success of the operation.
+        template <typename T> [[nodiscard]] bool fetchTickRangeIntoProjection(Projection& projection, unsigned fields, long long ticksFrom, long long ticksTo) const;
+
+        //! Fetches the selected fields of a range of stored data into the columns of a projection.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the selected fields.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeIntoProjection(Projection& projection, unsigned fields, hsize_t index, hsize_t count) const;
+
+        //! Reads the selected fields of a range of rows into the columns of a projection. The caller must hold the data lock.
+        //! \param projection The projection to read data into.
+        //! \param fields The mask of the selected fields.
+        //! \param itemOffset The index of the first item to read.
+        //! \param itemCount The number of items to read.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool projectItemsNoLock(Projection& projection, unsigned fields, hsize_t itemOffset, hsize_t itemCount) const;
+
+        //! Aggregates a range of stored data.
+        //! \param aggregate The aggregates to compute.
+        //! \param ticksFrom The first ticks of the range.
+        //! \param ticksTo The last ticks of the range.
+        //! \param spec Selects the aggregates to compute; the weighted ones must apply to the data type.
+        //! \return A boolean indicating the success of the operation.
+        template <typename T> [[nodiscard]] bool aggregateFromTickRange(DataAggregate& aggregate, long long ticksFrom, long long ticksTo, const AggregateSpec& spec) const;
+
+        //! Aggregates a range of rows, streaming the needed fields a chunk at a time and using the zone maps for the whole chunks where they suffice.
+        //! The caller must hold the data lock.
+        //! \param aggregate The aggregates to compute.
+        //! \param spec Selects the aggregates to compute.
+        //! \param itemOffset The index of the first item to aggregate.
+        //! \param itemCount The number of items to aggregate.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool aggregateItemsNoLock(DataAggregate& aggregate, const AggregateSpec& spec, hsize_t itemOffset, hsize_t itemCount) const;
+
+        //! Fetches a range of stored data straight into a caller-provided buffer.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param ticksFrom The first ticks of the range.
+        //! \param ticksTo The last ticks of the range.
+        //! \return A boolean indicating the success of the operation.
+        template <typename T> [[nodiscard]] bool fetchTickRangeIntoBuffer(T* buffer, hsize_t capacity, hsize_t& written, long long ticksFrom, long long ticksTo) const;
+
+        //! Fetches a range of stored data straight into a caller-provided buffer.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        template <typename T> [[nodiscard]] bool fetchIndexRangeIntoBuffer(T* buffer, hsize_t capacity, hsize_t& written, hsize_t index, hsize_t count) const;
+
+        //! Opens a cursor over a range of stored data.
+        //! \param ticksFrom The first ticks of the range.
+        //! \param ticksTo The last ticks of the range.
+        //! \param reverse Yields the pages from the last one to the first one.
+        //! \return A cursor or an empty pointer if the operation failed.
+        template <typename T> [[nodiscard]] std::shared_ptr<Cursor<T>> cursorFromTickRange(long long ticksFrom, long long ticksTo, bool reverse) const;
+
+        //! Opens a cursor over a range of stored data.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \param reverse Yields the pages from the last one to the first one.
+        //! \return A cursor or an empty pointer if the operation failed.
+        template <typename T> [[nodiscard]] std::shared_ptr<Cursor<T>> cursorFromIndexRange(hsize_t index, hsize_t count, bool reverse) const;
+
+        //! Opens a cursor over the items in a range of rows. The caller must hold the data lock.
+        //! \param itemOffset The index of the first item in the range.
+        //! \param itemCount The number of items in the range.
+        //! \param reverse Yields the pages from the last one to the first one.
+        //! \return A cursor or an empty pointer if the operation failed.
+        template <typename T> [[nodiscard]] std::shared_ptr<Cursor<T>> cursorNoLock(hsize_t itemOffset, hsize_t itemCount, bool reverse) const;
+
+        //! Opens a write-behind appender.
+        //! \param options The queueing and the flushing policy.
+        //! \return An appender or an empty pointer if the data is read-only or the options are invalid.
+        template <typename T> [[nodiscard]] std::shared_ptr<Appender<T>> appender(const AppenderOptions& options) const;
+
         static hsize_t defaultMaximumReadBufferBytes_;
+        static hsize_t defaultMaximumTickIndexBytes_;
+        static unsigned defaultDecompressionThreads_;
+        static unsigned defaultCompressionThreads_;
+        static bool defaultPreallocate_;
+        //! The maximal number of chunks preallocated ahead of the items.
+        static constexpr hsize_t maximumPreallocatedChunks{ 64 };
         hsize_t  maximumReadBufferBytes_;
+        hsize_t  maximumTickIndexBytes_;
+        unsigned decompressionThreads_;
+        unsigned compressionThreads_;
+        bool preallocate_;
+        mutable size_t chunkCacheBytes_;
+        DatasetCreationOptions options_;
+        mutable std::shared_mutex mutex_;
+        mutable std::unique_ptr<TickIndex> tickIndex_;
+        mutable std::atomic<bool> summaryCached_;
+        mutable std::atomic<hsize_t> summaryCount_;
+        mutable std::atomic<long long> summaryFirstTicks_;
+        mutable std::atomic<long long> summaryLastTicks_;
+        mutable std::atomic<hsize_t> chunkRows_;
+        mutable std::atomic<hsize_t> readCount_;
+        mutable std::atomic<hsize_t> readItemCount_;
+        mutable std::atomic<hsize_t> readChunkCount_;
         std::string filePath_;
         std::string datasetPath_;
         std::string name_;
-        hid_t datasetId_;
+        hid_t groupId_;
+        mutable hid_t datasetId_;
         hid_t nativeTypeId_;
         hid_t standardTypeId_;
+        mutable DatasetColumns columns_;
+        mutable std::vector<DataZone> zones_;
+        mutable hid_t zonesId_;
+        mutable size_t zonesStored_;
+        mutable bool zonesLoaded_;
+        mutable bool zonesValid_;
+        mutable std::vector<DataSegment> segments_;
+        mutable std::vector<hid_t> segmentIds_;
+        mutable bool segmentsLoaded_;
+        mutable hsize_t itemCount_;
+        mutable bool itemCountTracked_;
+        mutable bool itemCountChanged_;
         bool readOnly_;
+        bool swmr_;
     };
 
     typedef Collect<Quote> CollectQuote;
+    typedef Cursor<Quote> QuoteCursor;
+    typedef Appender<Quote> QuoteAppender;
 
     //! Encapsulates the access to the instrument's h5::Quote data.
     class QuoteData final : public Data
@@ -1844,6 +3048,25 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         [[nodiscard]] bool fetchTickRange(const CollectQuote& collect, long long from, long long to) const;
 
+        //! Fetches the items of a specified range matching a predicate, so that the other items never reach the callback.
+        //! The chunks the zone maps show to hold no matching item are not read at all.
+        //! \param collect A callback to fetch the matching data into.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param predicate The terms over the Quote field bits the fetched items satisfy.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeWhere(const CollectQuote& collect, long long from, long long to, const DataPredicate& predicate) const;
+
+        //! Fetches a specified range of stored items downsampled for charting, computed in a single streaming pass over the range.
+        //! All items in the range are fetched if there are no more of them than the target points.
+        //! \param collect A callback to fetch the chosen data into.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param targetPoints The maximal number of the fetched items: at least one for every n-th item, two for the envelope and three for the largest triangles.
+        //! \param method The downsampling method.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchDownsampled(const CollectQuote& collect, long long from, long long to, hsize_t targetPoints, DownsamplingMethod method) const;
+
         //! Fetches a specified range of stored items.
         //! \param collect A callback to fetch data into.
         //! \param index The index of the first item in the range.
@@ -1851,6 +3074,96 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         [[nodiscard]] bool fetchIndexRange(const CollectQuote& collect, hsize_t index, hsize_t count) const;
 
+        //! Fetches the last stored items in a single locked call, reading only the chunks holding them.
+        //! \param collect A callback to fetch data into.
+        //! \param count The number of the last items, all items if there are fewer of them.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchLast(const CollectQuote& collect, hsize_t count) const;
+
+        //! Fetches a specified range of stored items straight into a caller-provided buffer.
+        //! If the range holds more items than the buffer capacity, only the first ones are fetched.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeInto(Quote* buffer, hsize_t capacity, hsize_t& written, long long from, long long to) const;
+
+        //! Fetches a specified range of stored items straight into a caller-provided buffer.
+        //! If the range holds more items than the buffer capacity, only the first ones are fetched.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeInto(Quote* buffer, hsize_t capacity, hsize_t& written, hsize_t index, hsize_t count) const;
+
+        //! Fetches the selected fields of a specified range of stored items into separate columns, so that the other fields are never copied.
+        //! Each field is read by itself, a chunk at a time, so a chunk is decompressed once if it fits in the chunk cache.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the Quote field bits to fetch.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeProjection(Projection& projection, unsigned fields, long long from, long long to) const;
+
+        //! Fetches the selected fields of a specified range of stored items into separate columns, so that the other fields are never copied.
+        //! Each field is read by itself, a chunk at a time, so a chunk is decompressed once if it fits in the chunk cache.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the Quote field bits to fetch.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeProjection(Projection& projection, unsigned fields, hsize_t index, hsize_t count) const;
+
+        //! Aggregates a specified range of stored items inside the library, a chunk at a time, without copying the items out.
+        //! The whole chunks in the range are taken from the zone maps unless a weighted aggregate is requested.
+        //! The time-weighted average mid price and spread are computed if the specification asks for them.
+        //! \param aggregate The aggregates of the range.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param spec The mask of the Quote field bits to compute the minimum, the maximum and the sum of, and the weighted aggregates to compute.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool aggregateTickRange(DataAggregate& aggregate, long long from, long long to, const AggregateSpec& spec) const;
+
+        //! Opens a cursor over a specified range of stored items.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<QuoteCursor> openTickRangeCursor(long long from, long long to) const;
+
+        //! Opens a cursor over a specified range of stored items.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<QuoteCursor> openIndexRangeCursor(hsize_t index, hsize_t count) const;
+
+        //! Opens a cursor yielding the pages of a specified range of stored items from the last one to the first one.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<QuoteCursor> openTickRangeReverseCursor(long long from, long long to) const;
+
+        //! Opens a cursor yielding the pages of a specified range of stored items from the last one to the first one.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<QuoteCursor> openIndexRangeReverseCursor(hsize_t index, hsize_t count) const;
+
+        //! Refreshes the data and fetches the items appended after a specified index, then advances the index past them.
+        //! Lets a SWMR reader follow a live dataset: starting from zero, the repeated calls return every item once.
+        //! \param index The index of the first item to fetch, updated to the number of stored items.
+        //! \param collect A callback to fetch data into.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool followFrom(hsize_t& index, const CollectQuote& collect) const;
+
+        //! Opens a write-behind appender which queues the items and adds them to the data in batches from a background thread.
+        //! \param options The queueing and the flushing policy.
+        //! \return An appender or an empty pointer if the data is read-only or the options are invalid.
+        [[nodiscard]] std::shared_ptr<QuoteAppender> openAppender(const AppenderOptions& options = AppenderOptions()) const;
+
         //! Converts ticks to a nearest index.
         //! \param ticks The ticks to convert.
         //! \param index The index of the ticks.
@@ -1916,6 +3229,8 @@ namespace mbc::h5 {
     };
 
     typedef Collect<QuotePriceOnly> CollectQuotePriceOnly;
+    typedef Cursor<QuotePriceOnly> QuotePriceOnlyCursor;
+    typedef Appender<QuotePriceOnly> QuotePriceOnlyAppender;
 
     //! Encapsulates the access to the instrument's h5::QuotePriceOnly data.
     class QuotePriceOnlyData final : public Data
@@ -1954,6 +3269,25 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         [[nodiscard]] bool fetchTickRange(const CollectQuotePriceOnly& collect, long long from, long long to) const;
 
+        //! Fetches the items of a specified range matching a predicate, so that the other items never reach the callback.
+        //! The chunks the zone maps show to hold no matching item are not read at all.
+        //! \param collect A callback to fetch the matching data into.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param predicate The terms over the QuotePriceOnly field bits the fetched items satisfy.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeWhere(const CollectQuotePriceOnly& collect, long long from, long long to, const DataPredicate& predicate) const;
+
+        //! Fetches a specified range of stored items downsampled for charting, computed in a single streaming pass over the range.
+        //! All items in the range are fetched if there are no more of them than the target points.
+        //! \param collect A callback to fetch the chosen data into.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param targetPoints The maximal number of the fetched items: at least one for every n-th item, two for the envelope and three for the largest triangles.
+        //! \param method The downsampling method.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchDownsampled(const CollectQuotePriceOnly& collect, long long from, long long to, hsize_t targetPoints, DownsamplingMethod method) const;
+
         //! Fetches a specified range of stored items.
         //! \param collect A callback to fetch data into.
         //! \param index The index of the first item in the range.
@@ -1961,6 +3295,96 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         [[nodiscard]] bool fetchIndexRange(const CollectQuotePriceOnly& collect, hsize_t index, hsize_t count) const;
 
+        //! Fetches the last stored items in a single locked call, reading only the chunks holding them.
+        //! \param collect A callback to fetch data into.
+        //! \param count The number of the last items, all items if there are fewer of them.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchLast(const CollectQuotePriceOnly& collect, hsize_t count) const;
+
+        //! Fetches a specified range of stored items straight into a caller-provided buffer.
+        //! If the range holds more items than the buffer capacity, only the first ones are fetched.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeInto(QuotePriceOnly* buffer, hsize_t capacity, hsize_t& written, long long from, long long to) const;
+
+        //! Fetches a specified range of stored items straight into a caller-provided buffer.
+        //! If the range holds more items than the buffer capacity, only the first ones are fetched.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeInto(QuotePriceOnly* buffer, hsize_t capacity, hsize_t& written, hsize_t index, hsize_t count) const;
+
+        //! Fetches the selected fields of a specified range of stored items into separate columns, so that the other fields are never copied.
+        //! Each field is read by itself, a chunk at a time, so a chunk is decompressed once if it fits in the chunk cache.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the QuotePriceOnly field bits to fetch.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeProjection(Projection& projection, unsigned fields, long long from, long long to) const;
+
+        //! Fetches the selected fields of a specified range of stored items into separate columns, so that the other fields are never copied.
+        //! Each field is read by itself, a chunk at a time, so a chunk is decompressed once if it fits in the chunk cache.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the QuotePriceOnly field bits to fetch.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeProjection(Projection& projection, unsigned fields, hsize_t index, hsize_t count) const;
+
+        //! Aggregates a specified range of stored items inside the library, a chunk at a time, without copying the items out.
+        //! The whole chunks in the range are taken from the zone maps unless a weighted aggregate is requested.
+        //! The time-weighted average mid price and spread are computed if the specification asks for them.
+        //! \param aggregate The aggregates of the range.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param spec The mask of the QuotePriceOnly field bits to compute the minimum, the maximum and the sum of, and the weighted aggregates to compute.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool aggregateTickRange(DataAggregate& aggregate, long long from, long long to, const AggregateSpec& spec) const;
+
+        //! Opens a cursor over a specified range of stored items.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<QuotePriceOnlyCursor> openTickRangeCursor(long long from, long long to) const;
+
+        //! Opens a cursor over a specified range of stored items.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<QuotePriceOnlyCursor> openIndexRangeCursor(hsize_t index, hsize_t count) const;
+
+        //! Opens a cursor yielding the pages of a specified range of stored items from the last one to the first one.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<QuotePriceOnlyCursor> openTickRangeReverseCursor(long long from, long long to) const;
+
+        //! Opens a cursor yielding the pages of a specified range of stored items from the last one to the first one.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<QuotePriceOnlyCursor> openIndexRangeReverseCursor(hsize_t index, hsize_t count) const;
+
+        //! Refreshes the data and fetches the items appended after a specified index, then advances the index past them.
+        //! Lets a SWMR reader follow a live dataset: starting from zero, the repeated calls return every item once.
+        //! \param index The index of the first item to fetch, updated to the number of stored items.
+        //! \param collect A callback to fetch data into.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool followFrom(hsize_t& index, const CollectQuotePriceOnly& collect) const;
+
+        //! Opens a write-behind appender which queues the items and adds them to the data in batches from a background thread.
+        //! \param options The queueing and the flushing policy.
+        //! \return An appender or an empty pointer if the data is read-only or the options are invalid.
+        [[nodiscard]] std::shared_ptr<QuotePriceOnlyAppender> openAppender(const AppenderOptions& options = AppenderOptions()) const;
+
         //! Converts ticks to a nearest index.
         //! \param ticks The ticks to convert.
         //! \param index The index of the ticks.
@@ -2025,6 +3449,8 @@ namespace mbc::h5 {
     };
 
     typedef Collect<Trade> CollectTrade;
+    typedef Cursor<Trade> TradeCursor;
+    typedef Appender<Trade> TradeAppender;
 
     //! Encapsulates the access to the instrument's h5::Trade data.
     class TradeData final : public Data
@@ -2063,6 +3489,25 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         [[nodiscard]] bool fetchTickRange(const CollectTrade& collect, long long from, long long to) const;
 
+        //! Fetches the items of a specified range matching a predicate, so that the other items never reach the callback.
+        //! The chunks the zone maps show to hold no matching item are not read at all.
+        //! \param collect A callback to fetch the matching data into.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param predicate The terms over the Trade field bits the fetched items satisfy.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeWhere(const CollectTrade& collect, long long from, long long to, const DataPredicate& predicate) const;
+
+        //! Fetches a specified range of stored items downsampled for charting, computed in a single streaming pass over the range.
+        //! All items in the range are fetched if there are no more of them than the target points.
+        //! \param collect A callback to fetch the chosen data into.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param targetPoints The maximal number of the fetched items: at least one for every n-th item, two for the envelope and three for the largest triangles.
+        //! \param method The downsampling method.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchDownsampled(const CollectTrade& collect, long long from, long long to, hsize_t targetPoints, DownsamplingMethod method) const;
+
         //! Fetches a specified range of stored items.
         //! \param collect A callback to fetch data into.
         //! \param index The index of the first item in the range.
@@ -2070,6 +3515,96 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         [[nodiscard]] bool fetchIndexRange(const CollectTrade& collect, hsize_t index, hsize_t count) const;
 
+        //! Fetches the last stored items in a single locked call, reading only the chunks holding them.
+        //! \param collect A callback to fetch data into.
+        //! \param count The number of the last items, all items if there are fewer of them.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchLast(const CollectTrade& collect, hsize_t count) const;
+
+        //! Fetches a specified range of stored items straight into a caller-provided buffer.
+        //! If the range holds more items than the buffer capacity, only the first ones are fetched.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeInto(Trade* buffer, hsize_t capacity, hsize_t& written, long long from, long long to) const;
+
+        //! Fetches a specified range of stored items straight into a caller-provided buffer.
+        //! If the range holds more items than the buffer capacity, only the first ones are fetched.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeInto(Trade* buffer, hsize_t capacity, hsize_t& written, hsize_t index, hsize_t count) const;
+
+        //! Fetches the selected fields of a specified range of stored items into separate columns, so that the other fields are never copied.
+        //! Each field is read by itself, a chunk at a time, so a chunk is decompressed once if it fits in the chunk cache.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the Trade field bits to fetch.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeProjection(Projection& projection, unsigned fields, long long from, long long to) const;
+
+        //! Fetches the selected fields of a specified range of stored items into separate columns, so that the other fields are never copied.
+        //! Each field is read by itself, a chunk at a time, so a chunk is decompressed once if it fits in the chunk cache.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the Trade field bits to fetch.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeProjection(Projection& projection, unsigned fields, hsize_t index, hsize_t count) const;
+
+        //! Aggregates a specified range of stored items inside the library, a chunk at a time, without copying the items out.
+        //! The whole chunks in the range are taken from the zone maps unless a weighted aggregate is requested.
+        //! The volume-weighted average price is computed if the specification asks for it.
+        //! \param aggregate The aggregates of the range.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param spec The mask of the Trade field bits to compute the minimum, the maximum and the sum of, and the weighted aggregates to compute.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool aggregateTickRange(DataAggregate& aggregate, long long from, long long to, const AggregateSpec& spec) const;
+
+        //! Opens a cursor over a specified range of stored items.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<TradeCursor> openTickRangeCursor(long long from, long long to) const;
+
+        //! Opens a cursor over a specified range of stored items.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<TradeCursor> openIndexRangeCursor(hsize_t index, hsize_t count) const;
+
+        //! Opens a cursor yielding the pages of a specified range of stored items from the last one to the first one.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<TradeCursor> openTickRangeReverseCursor(long long from, long long to) const;
+
+        //! Opens a cursor yielding the pages of a specified range of stored items from the last one to the first one.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<TradeCursor> openIndexRangeReverseCursor(hsize_t index, hsize_t count) const;
+
+        //! Refreshes the data and fetches the items appended after a specified index, then advances the index past them.
+        //! Lets a SWMR reader follow a live dataset: starting from zero, the repeated calls return every item once.
+        //! \param index The index of the first item to fetch, updated to the number of stored items.
+        //! \param collect A callback to fetch data into.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool followFrom(hsize_t& index, const CollectTrade& collect) const;
+
+        //! Opens a write-behind appender which queues the items and adds them to the data in batches from a background thread.
+        //! \param options The queueing and the flushing policy.
+        //! \return An appender or an empty pointer if the data is read-only or the options are invalid.
+        [[nodiscard]] std::shared_ptr<TradeAppender> openAppender(const AppenderOptions& options = AppenderOptions()) const;
+
         //! Converts ticks to a nearest index.
         //! \param ticks The ticks to convert.
         //! \param index The index of the ticks.
@@ -2134,6 +3669,8 @@ namespace mbc::h5 {
     };
 
     typedef Collect<TradePriceOnly> CollectTradePriceOnly;
+    typedef Cursor<TradePriceOnly> TradePriceOnlyCursor;
+    typedef Appender<TradePriceOnly> TradePriceOnlyAppender;
 
     //! Encapsulates the access to the instrument's h5::TradePriceOnly data.
     class TradePriceOnlyData final : public Data
@@ -2172,6 +3709,25 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         [[nodiscard]] bool fetchTickRange(const CollectTradePriceOnly& collect, long long from, long long to) const;
 
+        //! Fetches the items of a specified range matching a predicate, so that the other items never reach the callback.
+        //! The chunks the zone maps show to hold no matching item are not read at all.
+        //! \param collect A callback to fetch the matching data into.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param predicate The terms over the TradePriceOnly field bits the fetched items satisfy.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeWhere(const CollectTradePriceOnly& collect, long long from, long long to, const DataPredicate& predicate) const;
+
+        //! Fetches a specified range of stored items downsampled for charting, computed in a single streaming pass over the range.
+        //! All items in the range are fetched if there are no more of them than the target points.
+        //! \param collect A callback to fetch the chosen data into.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param targetPoints The maximal number of the fetched items: at least one for every n-th item, two for the envelope and three for the largest triangles.
+        //! \param method The downsampling method.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchDownsampled(const CollectTradePriceOnly& collect, long long from, long long to, hsize_t targetPoints, DownsamplingMethod method) const;
+
         //! Fetches a specified range of stored items.
         //! \param collect A callback to fetch data into.
         //! \param index The index of the first item in the range.
@@ -2179,6 +3735,95 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         [[nodiscard]] bool fetchIndexRange(const CollectTradePriceOnly& collect, hsize_t index, hsize_t count) const;
 
+        //! Fetches the last stored items in a single locked call, reading only the chunks holding them.
+        //! \param collect A callback to fetch data into.
+        //! \param count The number of the last items, all items if there are fewer of them.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchLast(const CollectTradePriceOnly& collect, hsize_t count) const;
+
+        //! Fetches a specified range of stored items straight into a caller-provided buffer.
+        //! If the range holds more items than the buffer capacity, only the first ones are fetched.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeInto(TradePriceOnly* buffer, hsize_t capacity, hsize_t& written, long long from, long long to) const;
+
+        //! Fetches a specified range of stored items straight into a caller-provided buffer.
+        //! If the range holds more items than the buffer capacity, only the first ones are fetched.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeInto(TradePriceOnly* buffer, hsize_t capacity, hsize_t& written, hsize_t index, hsize_t count) const;
+
+        //! Fetches the selected fields of a specified range of stored items into separate columns, so that the other fields are never copied.
+        //! Each field is read by itself, a chunk at a time, so a chunk is decompressed once if it fits in the chunk cache.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the TradePriceOnly field bits to fetch.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeProjection(Projection& projection, unsigned fields, long long from, long long to) const;
+
+        //! Fetches the selected fields of a specified range of stored items into separate columns, so that the other fields are never copied.
+        //! Each field is read by itself, a chunk at a time, so a chunk is decompressed once if it fits in the chunk cache.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the TradePriceOnly field bits to fetch.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeProjection(Projection& projection, unsigned fields, hsize_t index, hsize_t count) const;
+
+        //! Aggregates a specified range of stored items inside the library, a chunk at a time, without copying the items out.
+        //! The whole chunks in the range are taken from the zone maps unless a weighted aggregate is requested.
+        //! \param aggregate The aggregates of the range.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param spec The mask of the TradePriceOnly field bits to compute the minimum, the maximum and the sum of, and the weighted aggregates to compute.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool aggregateTickRange(DataAggregate& aggregate, long long from, long long to, const AggregateSpec& spec) const;
+
+        //! Opens a cursor over a specified range of stored items.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<TradePriceOnlyCursor> openTickRangeCursor(long long from, long long to) const;
+
+        //! Opens a cursor over a specified range of stored items.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<TradePriceOnlyCursor> openIndexRangeCursor(hsize_t index, hsize_t count) const;
+
+        //! Opens a cursor yielding the pages of a specified range of stored items from the last one to the first one.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<TradePriceOnlyCursor> openTickRangeReverseCursor(long long from, long long to) const;
+
+        //! Opens a cursor yielding the pages of a specified range of stored items from the last one to the first one.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<TradePriceOnlyCursor> openIndexRangeReverseCursor(hsize_t index, hsize_t count) const;
+
+        //! Refreshes the data and fetches the items appended after a specified index, then advances the index past them.
+        //! Lets a SWMR reader follow a live dataset: starting from zero, the repeated calls return every item once.
+        //! \param index The index of the first item to fetch, updated to the number of stored items.
+        //! \param collect A callback to fetch data into.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool followFrom(hsize_t& index, const CollectTradePriceOnly& collect) const;
+
+        //! Opens a write-behind appender which queues the items and adds them to the data in batches from a background thread.
+        //! \param options The queueing and the flushing policy.
+        //! \return An appender or an empty pointer if the data is read-only or the options are invalid.
+        [[nodiscard]] std::shared_ptr<TradePriceOnlyAppender> openAppender(const AppenderOptions& options = AppenderOptions()) const;
+
         //! Converts ticks to a nearest index.
         //! \param ticks The ticks to convert.
         //! \param index The index of the ticks.
@@ -2243,6 +3888,8 @@ namespace mbc::h5 {
     };
 
     typedef Collect<Ohlcv> CollectOhlcv;
+    typedef Cursor<Ohlcv> OhlcvCursor;
+    typedef Appender<Ohlcv> OhlcvAppender;
 
     //! Encapsulates the access to the instrument's h5::Ohlcv data.
     class OhlcvData final : public Data
@@ -2281,6 +3928,25 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         [[nodiscard]] bool fetchTickRange(const CollectOhlcv& collect, long long from, long long to) const;
 
+        //! Fetches the items of a specified range matching a predicate, so that the other items never reach the callback.
+        //! The chunks the zone maps show to hold no matching item are not read at all.
+        //! \param collect A callback to fetch the matching data into.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param predicate The terms over the Ohlcv field bits the fetched items satisfy.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeWhere(const CollectOhlcv& collect, long long from, long long to, const DataPredicate& predicate) const;
+
+        //! Fetches a specified range of stored items downsampled for charting, computed in a single streaming pass over the range.
+        //! All items in the range are fetched if there are no more of them than the target points.
+        //! \param collect A callback to fetch the chosen data into.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param targetPoints The maximal number of the fetched items: at least one for every n-th item, two for the envelope and three for the largest triangles.
+        //! \param method The downsampling method.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchDownsampled(const CollectOhlcv& collect, long long from, long long to, hsize_t targetPoints, DownsamplingMethod method) const;
+
         //! Fetches a specified range of stored items.
         //! \param collect A callback to fetch data into.
         //! \param index The index of the first item in the range.
@@ -2288,6 +3954,95 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         [[nodiscard]] bool fetchIndexRange(const CollectOhlcv& collect, hsize_t index, hsize_t count) const;
 
+        //! Fetches the last stored items in a single locked call, reading only the chunks holding them.
+        //! \param collect A callback to fetch data into.
+        //! \param count The number of the last items, all items if there are fewer of them.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchLast(const CollectOhlcv& collect, hsize_t count) const;
+
+        //! Fetches a specified range of stored items straight into a caller-provided buffer.
+        //! If the range holds more items than the buffer capacity, only the first ones are fetched.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeInto(Ohlcv* buffer, hsize_t capacity, hsize_t& written, long long from, long long to) const;
+
+        //! Fetches a specified range of stored items straight into a caller-provided buffer.
+        //! If the range holds more items than the buffer capacity, only the first ones are fetched.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeInto(Ohlcv* buffer, hsize_t capacity, hsize_t& written, hsize_t index, hsize_t count) const;
+
+        //! Fetches the selected fields of a specified range of stored items into separate columns, so that the other fields are never copied.
+        //! Each field is read by itself, a chunk at a time, so a chunk is decompressed once if it fits in the chunk cache.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the Ohlcv field bits to fetch.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeProjection(Projection& projection, unsigned fields, long long from, long long to) const;
+
+        //! Fetches the selected fields of a specified range of stored items into separate columns, so that the other fields are never copied.
+        //! Each field is read by itself, a chunk at a time, so a chunk is decompressed once if it fits in the chunk cache.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the Ohlcv field bits to fetch.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeProjection(Projection& projection, unsigned fields, hsize_t index, hsize_t count) const;
+
+        //! Aggregates a specified range of stored items inside the library, a chunk at a time, without copying the items out.
+        //! The whole chunks in the range are taken from the zone maps unless a weighted aggregate is requested.
+        //! \param aggregate The aggregates of the range.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param spec The mask of the Ohlcv field bits to compute the minimum, the maximum and the sum of, and the weighted aggregates to compute.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool aggregateTickRange(DataAggregate& aggregate, long long from, long long to, const AggregateSpec& spec) const;
+
+        //! Opens a cursor over a specified range of stored items.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<OhlcvCursor> openTickRangeCursor(long long from, long long to) const;
+
+        //! Opens a cursor over a specified range of stored items.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<OhlcvCursor> openIndexRangeCursor(hsize_t index, hsize_t count) const;
+
+        //! Opens a cursor yielding the pages of a specified range of stored items from the last one to the first one.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<OhlcvCursor> openTickRangeReverseCursor(long long from, long long to) const;
+
+        //! Opens a cursor yielding the pages of a specified range of stored items from the last one to the first one.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<OhlcvCursor> openIndexRangeReverseCursor(hsize_t index, hsize_t count) const;
+
+        //! Refreshes the data and fetches the items appended after a specified index, then advances the index past them.
+        //! Lets a SWMR reader follow a live dataset: starting from zero, the repeated calls return every item once.
+        //! \param index The index of the first item to fetch, updated to the number of stored items.
+        //! \param collect A callback to fetch data into.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool followFrom(hsize_t& index, const CollectOhlcv& collect) const;
+
+        //! Opens a write-behind appender which queues the items and adds them to the data in batches from a background thread.
+        //! \param options The queueing and the flushing policy.
+        //! \return An appender or an empty pointer if the data is read-only or the options are invalid.
+        [[nodiscard]] std::shared_ptr<OhlcvAppender> openAppender(const AppenderOptions& options = AppenderOptions()) const;
+
         //! Converts ticks to a nearest index.
         //! \param ticks The ticks to convert.
         //! \param index The index of the ticks.
@@ -2352,6 +4107,8 @@ namespace mbc::h5 {
     };
 
     typedef Collect<OhlcvPriceOnly> CollectOhlcvPriceOnly;
+    typedef Cursor<OhlcvPriceOnly> OhlcvPriceOnlyCursor;
+    typedef Appender<OhlcvPriceOnly> OhlcvPriceOnlyAppender;
 
     //! Encapsulates the access to the instrument's h5::OhlcvPriceOnly data.
     class OhlcvPriceOnlyData final : public Data
@@ -2390,6 +4147,25 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         [[nodiscard]] bool fetchTickRange(const CollectOhlcvPriceOnly& collect, long long from, long long to) const;
 
+        //! Fetches the items of a specified range matching a predicate, so that the other items never reach the callback.
+        //! The chunks the zone maps show to hold no matching item are not read at all.
+        //! \param collect A callback to fetch the matching data into.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param predicate The terms over the OhlcvPriceOnly field bits the fetched items satisfy.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeWhere(const CollectOhlcvPriceOnly& collect, long long from, long long to, const DataPredicate& predicate) const;
+
+        //! Fetches a specified range of stored items downsampled for charting, computed in a single streaming pass over the range.
+        //! All items in the range are fetched if there are no more of them than the target points.
+        //! \param collect A callback to fetch the chosen data into.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param targetPoints The maximal number of the fetched items: at least one for every n-th item, two for the envelope and three for the largest triangles.
+        //! \param method The downsampling method.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchDownsampled(const CollectOhlcvPriceOnly& collect, long long from, long long to, hsize_t targetPoints, DownsamplingMethod method) const;
+
         //! Fetches a specified range of stored items.
         //! \param collect A callback to fetch data into.
         //! \param index The index of the first item in the range.
@@ -2397,6 +4173,95 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         [[nodiscard]] bool fetchIndexRange(const CollectOhlcvPriceOnly& collect, hsize_t index, hsize_t count) const;
 
+        //! Fetches the last stored items in a single locked call, reading only the chunks holding them.
+        //! \param collect A callback to fetch data into.
+        //! \param count The number of the last items, all items if there are fewer of them.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchLast(const CollectOhlcvPriceOnly& collect, hsize_t count) const;
+
+        //! Fetches a specified range of stored items straight into a caller-provided buffer.
+        //! If the range holds more items than the buffer capacity, only the first ones are fetched.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeInto(OhlcvPriceOnly* buffer, hsize_t capacity, hsize_t& written, long long from, long long to) const;
+
+        //! Fetches a specified range of stored items straight into a caller-provided buffer.
+        //! If the range holds more items than the buffer capacity, only the first ones are fetched.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeInto(OhlcvPriceOnly* buffer, hsize_t capacity, hsize_t& written, hsize_t index, hsize_t count) const;
+
+        //! Fetches the selected fields of a specified range of stored items into separate columns, so that the other fields are never copied.
+        //! Each field is read by itself, a chunk at a time, so a chunk is decompressed once if it fits in the chunk cache.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the OhlcvPriceOnly field bits to fetch.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeProjection(Projection& projection, unsigned fields, long long from, long long to) const;
+
+        //! Fetches the selected fields of a specified range of stored items into separate columns, so that the other fields are never copied.
+        //! Each field is read by itself, a chunk at a time, so a chunk is decompressed once if it fits in the chunk cache.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the OhlcvPriceOnly field bits to fetch.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeProjection(Projection& projection, unsigned fields, hsize_t index, hsize_t count) const;
+
+        //! Aggregates a specified range of stored items inside the library, a chunk at a time, without copying the items out.
+        //! The whole chunks in the range are taken from the zone maps unless a weighted aggregate is requested.
+        //! \param aggregate The aggregates of the range.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param spec The mask of the OhlcvPriceOnly field bits to compute the minimum, the maximum and the sum of, and the weighted aggregates to compute.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool aggregateTickRange(DataAggregate& aggregate, long long from, long long to, const AggregateSpec& spec) const;
+
+        //! Opens a cursor over a specified range of stored items.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<OhlcvPriceOnlyCursor> openTickRangeCursor(long long from, long long to) const;
+
+        //! Opens a cursor over a specified range of stored items.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<OhlcvPriceOnlyCursor> openIndexRangeCursor(hsize_t index, hsize_t count) const;
+
+        //! Opens a cursor yielding the pages of a specified range of stored items from the last one to the first one.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<OhlcvPriceOnlyCursor> openTickRangeReverseCursor(long long from, long long to) const;
+
+        //! Opens a cursor yielding the pages of a specified range of stored items from the last one to the first one.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<OhlcvPriceOnlyCursor> openIndexRangeReverseCursor(hsize_t index, hsize_t count) const;
+
+        //! Refreshes the data and fetches the items appended after a specified index, then advances the index past them.
+        //! Lets a SWMR reader follow a live dataset: starting from zero, the repeated calls return every item once.
+        //! \param index The index of the first item to fetch, updated to the number of stored items.
+        //! \param collect A callback to fetch data into.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool followFrom(hsize_t& index, const CollectOhlcvPriceOnly& collect) const;
+
+        //! Opens a write-behind appender which queues the items and adds them to the data in batches from a background thread.
+        //! \param options The queueing and the flushing policy.
+        //! \return An appender or an empty pointer if the data is read-only or the options are invalid.
+        [[nodiscard]] std::shared_ptr<OhlcvPriceOnlyAppender> openAppender(const AppenderOptions& options = AppenderOptions()) const;
+
         //! Converts ticks to a nearest index.
         //! \param ticks The ticks to convert.
         //! \param index The index of the ticks.
@@ -2461,6 +4326,8 @@ namespace mbc::h5 {
     };
 
     typedef Collect<Scalar> CollectScalar;
+    typedef Cursor<Scalar> ScalarCursor;
+    typedef Appender<Scalar> ScalarAppender;
 
     //! Encapsulates the access to the instrument's h5::Scalar data.
     class ScalarData final : public Data
@@ -2499,6 +4366,25 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         [[nodiscard]] bool fetchTickRange(const CollectScalar& collect, long long from, long long to) const;
 
+        //! Fetches the items of a specified range matching a predicate, so that the other items never reach the callback.
+        //! The chunks the zone maps show to hold no matching item are not read at all.
+        //! \param collect A callback to fetch the matching data into.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param predicate The terms over the Scalar field bits the fetched items satisfy.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeWhere(const CollectScalar& collect, long long from, long long to, const DataPredicate& predicate) const;
+
+        //! Fetches a specified range of stored items downsampled for charting, computed in a single streaming pass over the range.
+        //! All items in the range are fetched if there are no more of them than the target points.
+        //! \param collect A callback to fetch the chosen data into.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param targetPoints The maximal number of the fetched items: at least one for every n-th item, two for the envelope and three for the largest triangles.
+        //! \param method The downsampling method.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchDownsampled(const CollectScalar& collect, long long from, long long to, hsize_t targetPoints, DownsamplingMethod method) const;
+
         //! Fetches a specified range of stored items.
         //! \param collect A callback to fetch data into.
         //! \param index The index of the first item in the range.
@@ -2506,6 +4392,95 @@ namespace mbc::h5 {
         //! \return A boolean indicating the success of the operation.
         [[nodiscard]] bool fetchIndexRange(const CollectScalar& collect, hsize_t index, hsize_t count) const;
 
+        //! Fetches the last stored items in a single locked call, reading only the chunks holding them.
+        //! \param collect A callback to fetch data into.
+        //! \param count The number of the last items, all items if there are fewer of them.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchLast(const CollectScalar& collect, hsize_t count) const;
+
+        //! Fetches a specified range of stored items straight into a caller-provided buffer.
+        //! If the range holds more items than the buffer capacity, only the first ones are fetched.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeInto(Scalar* buffer, hsize_t capacity, hsize_t& written, long long from, long long to) const;
+
+        //! Fetches a specified range of stored items straight into a caller-provided buffer.
+        //! If the range holds more items than the buffer capacity, only the first ones are fetched.
+        //! \param buffer A buffer to fetch data into.
+        //! \param capacity The number of items the buffer can hold.
+        //! \param written The number of items written into the buffer.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeInto(Scalar* buffer, hsize_t capacity, hsize_t& written, hsize_t index, hsize_t count) const;
+
+        //! Fetches the selected fields of a specified range of stored items into separate columns, so that the other fields are never copied.
+        //! Each field is read by itself, a chunk at a time, so a chunk is decompressed once if it fits in the chunk cache.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the Scalar field bits to fetch.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchTickRangeProjection(Projection& projection, unsigned fields, long long from, long long to) const;
+
+        //! Fetches the selected fields of a specified range of stored items into separate columns, so that the other fields are never copied.
+        //! Each field is read by itself, a chunk at a time, so a chunk is decompressed once if it fits in the chunk cache.
+        //! \param projection The projection to fetch data into.
+        //! \param fields The mask of the Scalar field bits to fetch.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool fetchIndexRangeProjection(Projection& projection, unsigned fields, hsize_t index, hsize_t count) const;
+
+        //! Aggregates a specified range of stored items inside the library, a chunk at a time, without copying the items out.
+        //! The whole chunks in the range are taken from the zone maps unless a weighted aggregate is requested.
+        //! \param aggregate The aggregates of the range.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \param spec The mask of the Scalar field bits to compute the minimum, the maximum and the sum of, and the weighted aggregates to compute.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool aggregateTickRange(DataAggregate& aggregate, long long from, long long to, const AggregateSpec& spec) const;
+
+        //! Opens a cursor over a specified range of stored items.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<ScalarCursor> openTickRangeCursor(long long from, long long to) const;
+
+        //! Opens a cursor over a specified range of stored items.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<ScalarCursor> openIndexRangeCursor(hsize_t index, hsize_t count) const;
+
+        //! Opens a cursor yielding the pages of a specified range of stored items from the last one to the first one.
+        //! \param from A beginning date and time.
+        //! \param to An ending date and time.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<ScalarCursor> openTickRangeReverseCursor(long long from, long long to) const;
+
+        //! Opens a cursor yielding the pages of a specified range of stored items from the last one to the first one.
+        //! \param index The index of the first item in the range.
+        //! \param count The number of items in the range.
+        //! \return A cursor or an empty pointer if the operation failed.
+        [[nodiscard]] std::shared_ptr<ScalarCursor> openIndexRangeReverseCursor(hsize_t index, hsize_t count) const;
+
+        //! Refreshes the data and fetches the items appended after a specified index, then advances the index past them.
+        //! Lets a SWMR reader follow a live dataset: starting from zero, the repeated calls return every item once.
+        //! \param index The index of the first item to fetch, updated to the number of stored items.
+        //! \param collect A callback to fetch data into.
+        //! \return A boolean indicating the success of the operation.
+        [[nodiscard]] bool followFrom(hsize_t& index, const CollectScalar& collect) const;
+
+        //! Opens a write-behind appender which queues the items and adds them to the data in batches from a background thread.
+        //! \param options The queueing and the flushing policy.
+        //! \return An appender or an empty pointer if the data is read-only or the options are invalid.
+        [[nodiscard]] std::shared_ptr<ScalarAppender> openAppender(const AppenderOptions& options = AppenderOptions()) const;
+
         //! Converts ticks to a nearest index.
         //! \param ticks The ticks to convert.
         //! \param index The index of the ticks.
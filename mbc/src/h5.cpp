@@ -1,8 +1,14 @@
 #include <atomic>
+#include <chrono>
 #include <mutex>
 #include "hdf5.h"
+#include "zlib.h"
 #include "h5.h"
 #include <algorithm>
+#include <cmath>
+#include <deque>
+#include <new>
+#include <type_traits>
 
 namespace mbc::h5
 {
@@ -22,6 +28,10 @@ namespace mbc::h5
     static const char* volumeTypeName = "Volume";
     static const char* priceTypeName = "Price";
     static const char* valueTypeName = "Value";
+    static const char* zonesNameSuffix = ".zones";
+    static const char* segmentNameInfix = ".segment.";
+    static const char* itemCountAttributeName = "Item count";
+    static const char* headCountAttributeName = "Head count";
 
     // ----------------------------------------------------------------------
     // Tracers
@@ -332,6 +342,51 @@ namespace mbc::h5
         traceDataError("flush", datasetPath, filePath);
     }
 
+    //! Error: Failed to refresh the dataset "{datasetPath}" from the file "{filePath}"
+    static void traceDataRefreshError(const std::string& datasetPath, const std::string& filePath)
+    {
+        traceDataError("refresh", datasetPath, filePath);
+    }
+
+    //! Error: Failed to update the zone maps of the dataset "{datasetPath}" from the file "{filePath}"
+    static void traceDataZonesError(const std::string& datasetPath, const std::string& filePath)
+    {
+        traceDataError("update the zone maps of", datasetPath, filePath);
+    }
+
+    //! Error: Failed to load the segments of the dataset "{datasetPath}" from the file "{filePath}"
+    static void traceDataLoadSegmentsError(const std::string& datasetPath, const std::string& filePath)
+    {
+        traceDataError("load the segments of", datasetPath, filePath);
+    }
+
+    //! Error: Failed to splice the segments of the dataset "{datasetPath}" from the file "{filePath}"
+    static bool traceDataSpliceSegmentsError(const std::string& datasetPath, const std::string& filePath)
+    {
+        traceDataError("splice the segments of", datasetPath, filePath);
+        return false;
+    }
+
+    //! Error: Failed to reclaim the trimmed rows of the dataset "{datasetPath}" from the file "{filePath}"
+    static bool traceDataCompactError(const std::string& datasetPath, const std::string& filePath)
+    {
+        traceDataError("reclaim the trimmed rows of", datasetPath, filePath);
+        return false;
+    }
+
+    //! Error: Failed to update the item count of the dataset "{datasetPath}" from the file "{filePath}"
+    static void traceDataItemCountError(const std::string& datasetPath, const std::string& filePath)
+    {
+        traceDataError("update the item count of", datasetPath, filePath);
+    }
+
+    //! Error: Failed to shrink the preallocated rows of the dataset "{datasetPath}" from the file "{filePath}"
+    static bool traceDataShrinkError(const std::string& datasetPath, const std::string& filePath)
+    {
+        traceDataError("shrink the preallocated rows of", datasetPath, filePath);
+        return false;
+    }
+
     //! Error: Failed to close the native type of the dataset "{datasetPath}" from the file "{filePath}"
     static void traceDataCloseNativeTypeError(const std::string& datasetPath, const std::string& filePath)
     {
@@ -870,11 +925,514 @@ namespace mbc::h5
         return type;
     }
 
+    // ----------------------------------------------------------------------
+    // Time series filter
+    // ----------------------------------------------------------------------
+
+    // The version of the codec, stored in the client data of the filter of a dataset and in the header of every chunk.
+    static constexpr unsigned char timeSeriesFilterVersion{ 1 };
+
+    // The chunk header: the version byte, the mode byte and the 32-bit little-endian number of records.
+    static constexpr size_t timeSeriesHeaderBytes{ 6 };
+    static constexpr unsigned char timeSeriesModeRaw{ 0 };
+    static constexpr unsigned char timeSeriesModeEncoded{ 1 };
+
+    // The column encodings. A column is a kind byte, an optional parameter byte and the bit-packed values.
+    static constexpr unsigned char timeSeriesKindDelta{ 1 };
+    static constexpr unsigned char timeSeriesKindDeltaOfDelta{ 2 };
+    static constexpr unsigned char timeSeriesKindDecimal{ 3 };
+    static constexpr unsigned char timeSeriesKindXor{ 4 };
+    static constexpr unsigned char timeSeriesKindBitsDelta{ 5 };
+
+    // The values are bit-packed in blocks, each block is prefixed by a single bit width byte.
+    static constexpr size_t timeSeriesBlockValues{ 128 };
+
+    static const double timeSeriesPowersOf10[]{ 1., 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9 };
+    static constexpr unsigned timeSeriesNoDecimalExponent{ sizeof(timeSeriesPowersOf10) / sizeof(timeSeriesPowersOf10[0]) };
+
+    static uint64_t zigzagEncode(const int64_t value)
+    {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+    static int64_t zigzagDecode(const uint64_t value)
+    {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    static unsigned bitWidth(uint64_t value)
+    {
+        unsigned width = 0;
+        while (0 != value)
+        {
+            ++width;
+            value >>= 1;
+        }
+        return width;
+    }
+
+    static unsigned blockBitWidth(const uint64_t* values, const size_t count)
+    {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < count; ++i)
+            bits |= values[i];
+        return bitWidth(bits);
+    }
+
+    static size_t packedBytes(const uint64_t* values, const size_t count)
+    {
+        size_t bytes = 0;
+        for (size_t i = 0; i < count; i += timeSeriesBlockValues)
+        {
+            const size_t n = std::min(timeSeriesBlockValues, count - i);
+            bytes += 1 + (n * blockBitWidth(values + i, n) + 7) / 8;
+        }
+        return bytes;
+    }
+
+    static unsigned char* pack(const uint64_t* values, const size_t count, unsigned char* out)
+    {
+        for (size_t i = 0; i < count; i += timeSeriesBlockValues)
+        {
+            const size_t n = std::min(timeSeriesBlockValues, count - i);
+            const unsigned width = blockBitWidth(values + i, n);
+            *out++ = static_cast<unsigned char>(width);
+            if (0 == width)
+                continue;
+
+            uint64_t accumulator = 0;
+            unsigned bits = 0;
+            for (size_t j = 0; j < n; ++j)
+            {
+                uint64_t value = values[i + j];
+                unsigned valueWidth = width;
+                if (56 < valueWidth)
+                {
+                    // Flush the lower half first, so the accumulator never overflows.
+                    accumulator |= (value & 0xFFFFFFFFULL) << bits;
+                    bits += 32;
+                    while (8 <= bits)
+                    {
+                        *out++ = static_cast<unsigned char>(accumulator);
+                        accumulator >>= 8;
+                        bits -= 8;
+                    }
+                    value >>= 32;
+                    valueWidth -= 32;
+                }
+                accumulator |= value << bits;
+                bits += valueWidth;
+                while (8 <= bits)
+                {
+                    *out++ = static_cast<unsigned char>(accumulator);
+                    accumulator >>= 8;
+                    bits -= 8;
+                }
+            }
+            if (0 != bits)
+                *out++ = static_cast<unsigned char>(accumulator);
+        }
+        return out;
+    }
+
+    static const unsigned char* unpack(const unsigned char* in, const unsigned char* end, const size_t count, uint64_t* values)
+    {
+        for (size_t i = 0; i < count; i += timeSeriesBlockValues)
+        {
+            const size_t n = std::min(timeSeriesBlockValues, count - i);
+            if (in >= end)
+                return nullptr;
+            const unsigned width = *in++;
+            if (64 < width)
+                return nullptr;
+            if (0 == width)
+            {
+                std::fill(values + i, values + i + n, 0);
+                continue;
+            }
+            if (static_cast<size_t>(end - in) < (n * width + 7) / 8)
+                return nullptr;
+
+            uint64_t accumulator = 0;
+            unsigned bits = 0;
+            for (size_t j = 0; j < n; ++j)
+            {
+                unsigned valueWidth = width;
+                uint64_t low = 0;
+                unsigned shift = 0;
+                if (56 < valueWidth)
+                {
+                    while (32 > bits)
+                    {
+                        accumulator |= static_cast<uint64_t>(*in++) << bits;
+                        bits += 8;
+                    }
+                    low = accumulator & 0xFFFFFFFFULL;
+                    accumulator >>= 32;
+                    bits -= 32;
+                    valueWidth -= 32;
+                    shift = 32;
+                }
+                while (valueWidth > bits)
+                {
+                    accumulator |= static_cast<uint64_t>(*in++) << bits;
+                    bits += 8;
+                }
+                const uint64_t high = 64 == valueWidth ? accumulator : accumulator & ((1ULL << valueWidth) - 1);
+                accumulator = 64 == valueWidth ? 0 : accumulator >> valueWidth;
+                bits -= valueWidth;
+                values[i + j] = low | (high << shift);
+            }
+        }
+        return in;
+    }
+
+    // Returns the smallest power of 10 exponent which scales all values to exact integers,
+    // or timeSeriesNoDecimalExponent if the values are not decimal.
+    static unsigned decimalExponent(const double* values, const size_t count)
+    {
+        unsigned exponent = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const double value = values[i];
+            if (0. == value && std::signbit(value))
+                return timeSeriesNoDecimalExponent;
+            for (;;)
+            {
+                const double scale = timeSeriesPowersOf10[exponent];
+                const double scaled = value * scale;
+                // The NaN and infinity values fail the first comparison.
+                if (9007199254740992. > std::fabs(scaled) && static_cast<double>(static_cast<int64_t>(std::nearbyint(scaled))) / scale == value)
+                    break;
+                if (timeSeriesNoDecimalExponent == ++exponent)
+                    return timeSeriesNoDecimalExponent;
+            }
+        }
+        return exponent;
+    }
+
+    // The records are packed little-endian structures of the 64-bit integer ticks followed by the 64-bit doubles,
+    // or of the 64-bit doubles only if there are no ticks. The ticks column is delta or delta-of-delta encoded, whichever packs smaller.
+    // The double columns are delta encoded as scaled integers if all values in the chunk are decimal,
+    // otherwise their bit patterns are XOR-ed with or subtracted from the previous ones, whichever packs smaller.
+    static size_t timeSeriesEncode(const unsigned char* in, const size_t count, const size_t fields, const bool ticks, unsigned char* out)
+    {
+        // Every column is encoded in two ways where applicable, the one which packs smaller is stored.
+        const size_t recordSize = fields * 8;
+        std::vector<uint64_t> first(count);
+        std::vector<uint64_t> second(count);
+        std::vector<double> column(count);
+        unsigned char* p = out;
+
+        if (ticks)
+        {
+            int64_t previousTicks = 0, previousDelta = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                int64_t value;
+                std::memcpy(&value, in + i * recordSize, 8);
+                const int64_t delta = value - previousTicks;
+                first[i] = zigzagEncode(delta);
+                second[i] = zigzagEncode(delta - previousDelta);
+                previousTicks = value;
+                previousDelta = delta;
+            }
+            const bool deltaOfDelta = packedBytes(second.data(), count) < packedBytes(first.data(), count);
+            *p++ = deltaOfDelta ? timeSeriesKindDeltaOfDelta : timeSeriesKindDelta;
+            p = pack(deltaOfDelta ? second.data() : first.data(), count, p);
+        }
+
+        for (size_t k = ticks ? 1 : 0; k < fields; ++k)
+        {
+            for (size_t i = 0; i < count; ++i)
+                std::memcpy(&column[i], in + i * recordSize + k * 8, 8);
+            const unsigned exponent = decimalExponent(column.data(), count);
+            if (timeSeriesNoDecimalExponent != exponent)
+            {
+                const double scale = timeSeriesPowersOf10[exponent];
+                int64_t previous = 0;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    const int64_t value = static_cast<int64_t>(std::nearbyint(column[i] * scale));
+                    first[i] = zigzagEncode(value - previous);
+                    previous = value;
+                }
+                *p++ = timeSeriesKindDecimal;
+                *p++ = static_cast<unsigned char>(exponent);
+                p = pack(first.data(), count, p);
+            }
+            else
+            {
+                // The close values of the same sign and exponent differ in the low mantissa bits only,
+                // their bit patterns subtract to smaller numbers than they XOR to if the low bits are noisy.
+                uint64_t previous = 0;
+                for (size_t i = 0; i < count; ++i)
+                {
+                    uint64_t value;
+                    std::memcpy(&value, &column[i], 8);
+                    first[i] = value ^ previous;
+                    second[i] = zigzagEncode(static_cast<int64_t>(value - previous));
+                    previous = value;
+                }
+                const bool bitsDelta = packedBytes(second.data(), count) < packedBytes(first.data(), count);
+                *p++ = bitsDelta ? timeSeriesKindBitsDelta : timeSeriesKindXor;
+                p = pack(bitsDelta ? second.data() : first.data(), count, p);
+            }
+        }
+        return static_cast<size_t>(p - out);
+    }
+
+    static bool timeSeriesDecode(const unsigned char* in, const size_t bytes, const size_t count, const size_t fields, unsigned char* out)
+    {
+        const size_t recordSize = fields * 8;
+        const unsigned char* p = in;
+        const unsigned char* const end = in + bytes;
+        std::vector<uint64_t> values(count);
+        for (size_t k = 0; k < fields; ++k)
+        {
+            if (p >= end)
+                return false;
+            const unsigned char kind = *p++;
+            unsigned exponent = 0;
+            if (timeSeriesKindDecimal == kind)
+            {
+                if (p >= end)
+                    return false;
+                exponent = *p++;
+                if (timeSeriesNoDecimalExponent <= exponent)
+                    return false;
+            }
+            p = unpack(p, end, count, values.data());
+            if (nullptr == p)
+                return false;
+
+            unsigned char* o = out + k * 8;
+            switch (kind)
+            {
+            case timeSeriesKindDelta:
+            {
+                int64_t ticks = 0;
+                for (size_t i = 0; i < count; ++i, o += recordSize)
+                {
+                    ticks += zigzagDecode(values[i]);
+                    std::memcpy(o, &ticks, 8);
+                }
+                break;
+            }
+            case timeSeriesKindDeltaOfDelta:
+            {
+                int64_t ticks = 0, delta = 0;
+                for (size_t i = 0; i < count; ++i, o += recordSize)
+                {
+                    delta += zigzagDecode(values[i]);
+                    ticks += delta;
+                    std::memcpy(o, &ticks, 8);
+                }
+                break;
+            }
+            case timeSeriesKindDecimal:
+            {
+                const double scale = timeSeriesPowersOf10[exponent];
+                int64_t scaled = 0;
+                for (size_t i = 0; i < count; ++i, o += recordSize)
+                {
+                    scaled += zigzagDecode(values[i]);
+                    const double value = static_cast<double>(scaled) / scale;
+                    std::memcpy(o, &value, 8);
+                }
+                break;
+            }
+            case timeSeriesKindBitsDelta:
+            {
+                uint64_t bits = 0;
+                for (size_t i = 0; i < count; ++i, o += recordSize)
+                {
+                    bits += static_cast<uint64_t>(zigzagDecode(values[i]));
+                    std::memcpy(o, &bits, 8);
+                }
+                break;
+            }
+            case timeSeriesKindXor:
+            {
+                uint64_t bits = 0;
+                for (size_t i = 0; i < count; ++i, o += recordSize)
+                {
+                    bits ^= values[i];
+                    std::memcpy(o, &bits, 8);
+                }
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+        return p == end;
+    }
+
+    // Returns the size of the buffer the encoding of a chunk needs, 0 if the chunk cannot be encoded.
+    static size_t timeSeriesEncodedBytesBound(const size_t nbytes, const size_t recordSize)
+    {
+        const size_t count = nbytes / recordSize;
+        if (0 != nbytes % recordSize || 0 != recordSize % 8 || 0xFFFFFFFFULL < count)
+            return 0;
+
+        // Every column takes at most two kind bytes, a width byte per block and 8 bytes per value.
+        const size_t blocks = (count + timeSeriesBlockValues - 1) / timeSeriesBlockValues;
+        return timeSeriesHeaderBytes + recordSize / 8 * (2 + blocks + count * 8);
+    }
+
+    // Encodes a chunk into a buffer of timeSeriesEncodedBytesBound() bytes, returns the encoded size.
+    static size_t timeSeriesEncodeChunk(const unsigned char* in, const size_t nbytes, const size_t recordSize, const bool ticks, unsigned char* out)
+    {
+        const size_t count = nbytes / recordSize;
+        out[0] = timeSeriesFilterVersion;
+        out[2] = static_cast<unsigned char>(count);
+        out[3] = static_cast<unsigned char>(count >> 8);
+        out[4] = static_cast<unsigned char>(count >> 16);
+        out[5] = static_cast<unsigned char>(count >> 24);
+        size_t outBytes = timeSeriesEncode(in, count, recordSize / 8, ticks, out + timeSeriesHeaderBytes);
+        if (outBytes < nbytes)
+            out[1] = timeSeriesModeEncoded;
+        else
+        {
+            // Incompressible chunks are stored as they are.
+            out[1] = timeSeriesModeRaw;
+            std::memcpy(out + timeSeriesHeaderBytes, in, nbytes);
+            outBytes = nbytes;
+        }
+        return outBytes + timeSeriesHeaderBytes;
+    }
+
+    // Returns the number of bytes an encoded chunk decodes to, 0 if the chunk header is not valid.
+    static size_t timeSeriesDecodedBytes(const unsigned char* in, const size_t nbytes, const size_t recordSize)
+    {
+        if (timeSeriesHeaderBytes > nbytes || timeSeriesFilterVersion != in[0])
+            return 0;
+        const size_t count = static_cast<size_t>(in[2]) | static_cast<size_t>(in[3]) << 8 | static_cast<size_t>(in[4]) << 16 | static_cast<size_t>(in[5]) << 24;
+        return count * recordSize;
+    }
+
+    // Decodes an encoded chunk into a buffer of timeSeriesDecodedBytes() bytes.
+    static bool timeSeriesDecodeChunk(const unsigned char* in, const size_t nbytes, const size_t recordSize, unsigned char* out)
+    {
+        const size_t outBytes = timeSeriesDecodedBytes(in, nbytes, recordSize);
+        if (0 == outBytes || 0 != recordSize % 8)
+            return false;
+        if (timeSeriesModeRaw == in[1])
+        {
+            if (nbytes - timeSeriesHeaderBytes != outBytes)
+                return false;
+            std::memcpy(out, in + timeSeriesHeaderBytes, outBytes);
+            return true;
+        }
+        return timeSeriesModeEncoded == in[1] && timeSeriesDecode(in + timeSeriesHeaderBytes, nbytes - timeSeriesHeaderBytes, outBytes / recordSize, recordSize / 8, out);
+    }
+
+    static htri_t timeSeriesCanApply(hid_t /*dcpl_id*/, const hid_t type_id, hid_t /*space_id*/)
+    {
+        // The codec reads the memory directly, so only the packed little-endian 8-byte fields are accepted.
+        if (H5T_COMPOUND != H5Tget_class(type_id))
+            return 0;
+        const int members = H5Tget_nmembers(type_id);
+        if (1 > members || static_cast<size_t>(members) * 8 != H5Tget_size(type_id))
+            return 0;
+        for (int i = 0; i < members; ++i)
+        {
+            if (static_cast<size_t>(i) * 8 != H5Tget_member_offset(type_id, static_cast<unsigned>(i)))
+                return 0;
+            const hid_t member = H5Tget_member_type(type_id, static_cast<unsigned>(i));
+            const H5T_class_t memberClass = H5Tget_class(member);
+            const bool valid = 8 == H5Tget_size(member) && H5T_ORDER_LE == H5Tget_order(member) && (H5T_FLOAT == memberClass || (0 == i && H5T_INTEGER == memberClass));
+            H5Tclose(member);
+            if (!valid)
+                return 0;
+        }
+        return 1;
+    }
+
+    // Sets the client data of the filter of a created dataset: the record size in bytes, whether the records have a ticks field, and the codec version,
+    // so that a later version of the codec can tell the datasets written by this one.
+    static herr_t timeSeriesSetLocal(const hid_t dcpl_id, const hid_t type_id, hid_t)
+    {
+        unsigned int flags;
+        size_t cd_nelmts{ 0 };
+        if (0 > H5Pget_filter_by_id2(dcpl_id, timeSeriesFilterId, &flags, &cd_nelmts, nullptr, 0, nullptr, nullptr))
+            return -1;
+        const hid_t firstMember = H5Tget_member_type(type_id, 0);
+        if (0 > firstMember)
+            return -1;
+        const bool ticks = H5T_INTEGER == H5Tget_class(firstMember);
+        H5Tclose(firstMember);
+        const unsigned int cd_values[3]{ static_cast<unsigned int>(H5Tget_size(type_id)), ticks ? 1U : 0U, timeSeriesFilterVersion };
+        return H5Pmodify_filter(dcpl_id, timeSeriesFilterId, flags, 3, cd_values);
+    }
+
+    // The first client data value is the record size in bytes. The optional second one is zero if the records have no ticks field,
+    // the single field datasets of the columnar layout hold the doubles only. The optional third one is the codec version,
+    // the datasets written before it was stored are of the first version.
+    static size_t timeSeriesFilter(const unsigned int flags, const size_t cd_nelmts, const unsigned int cd_values[], const size_t nbytes, size_t* buf_size, void** buf)
+    {
+        if (1 > cd_nelmts || 0 == cd_values[0] || 0 != cd_values[0] % 8 || (2 < cd_nelmts && timeSeriesFilterVersion < cd_values[2]))
+            return 0;
+        const size_t recordSize = cd_values[0];
+        const bool ticks = 2 > cd_nelmts || 0 != cd_values[1];
+        const auto in = static_cast<const unsigned char*>(*buf);
+        unsigned char* out;
+        size_t outBytes;
+        try
+        {
+            if (0 != (flags & H5Z_FLAG_REVERSE))
+            {
+                outBytes = timeSeriesDecodedBytes(in, nbytes, recordSize);
+                if (0 == outBytes)
+                    return 0;
+                out = static_cast<unsigned char*>(H5allocate_memory(outBytes, false));
+                if (nullptr == out)
+                    return 0;
+                if (!timeSeriesDecodeChunk(in, nbytes, recordSize, out))
+                {
+                    H5free_memory(out);
+                    return 0;
+                }
+            }
+            else
+            {
+                const size_t boundBytes = timeSeriesEncodedBytesBound(nbytes, recordSize);
+                if (0 == boundBytes)
+                    return 0;
+                out = static_cast<unsigned char*>(H5allocate_memory(boundBytes, false));
+                if (nullptr == out)
+                    return 0;
+                outBytes = timeSeriesEncodeChunk(in, nbytes, recordSize, ticks, out);
+            }
+        }
+        catch (...)
+        {
+            return 0;
+        }
+        H5free_memory(*buf);
+        *buf = out;
+        *buf_size = outBytes;
+        return outBytes;
+    }
+
+    static bool timeSeriesFilterRegister()
+    {
+        // Called under the library lock.
+        static bool registered{ false };
+        if (!registered)
+        {
+            const H5Z_class2_t filterClass{ H5Z_CLASS_T_VERS, timeSeriesFilterId, 1, 1, "mbc time series", timeSeriesCanApply, timeSeriesSetLocal, timeSeriesFilter };
+            registered = 0 <= H5Zregister(&filterClass);
+        }
+        return registered;
+    }
+
     // ----------------------------------------------------------------------
     // Operations
     // ----------------------------------------------------------------------
 
-    static hid_t fileOpen(const char* fileName, const bool readWrite, const bool createNonexistent, const FileDriver fileDriver, const bool corkThCache)
+    static hid_t fileOpen(const char* fileName, const bool readWrite, const bool createNonexistent, const FileDriver fileDriver, const bool corkThCache, const bool swmr)
     {
         const hid_t fapl_id = H5Pcreate(H5P_FILE_ACCESS);
         // [Hdf-forum] Preventing file corruption from power loss, Tue Jun 8 23:27:23 EDT 2010.
@@ -895,7 +1453,7 @@ namespace mbc::h5
         // Uncomment for metadata cache logging
         // H5Pset_mdc_log_options(fapl_id, true, "h5.mdc.log", true);
 
-        // Set file access property list to allow the latest file format.
+        // Set file access property list to allow the latest file format, it is also required by the SWMR access.
         H5Pset_libver_bounds(fapl_id, H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
 
         // fileDriver = FileDriver::Log;
@@ -938,7 +1496,9 @@ namespace mbc::h5
         // Turn off error handling.
         H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr);
 
-        hid_t file = H5Fopen(fileName, readWrite ? H5F_ACC_RDWR : H5F_ACC_RDONLY, fapl_id); // TODO: H5F_ACC_RDWR | H5F_ACC_SWMR_WRITE : H5F_ACC_RDONLY | H5F_ACC_SWMR_READ
+        // The single-writer/multiple-reader access lets the reading processes follow the writing one without reopening the file.
+        const unsigned swmrFlags = swmr ? (readWrite ? H5F_ACC_SWMR_WRITE : H5F_ACC_SWMR_READ) : 0U;
+        hid_t file = H5Fopen(fileName, (readWrite ? H5F_ACC_RDWR : H5F_ACC_RDONLY) | swmrFlags, fapl_id);
 
         // Restore previous error handler.
         H5Eset_auto2(H5E_DEFAULT, oldFunc, oldClientData);
@@ -947,13 +1507,34 @@ namespace mbc::h5
         {
             const hid_t fcpl_id = H5Pcreate(H5P_FILE_CREATE);
             H5Pset_sizes(fcpl_id, 8, 8); // TODO: or 16?
-            file = H5Fcreate(fileName, H5F_ACC_EXCL, fcpl_id, fapl_id); // TODO: H5F_ACC_EXCL | H5F_ACC_DEBUG in debug mode
+            file = H5Fcreate(fileName, H5F_ACC_EXCL | swmrFlags, fcpl_id, fapl_id); // TODO: H5F_ACC_EXCL | H5F_ACC_DEBUG in debug mode
             H5Pclose(fcpl_id);
         }
         H5Pclose(fapl_id);
         return file;
     }
 
+    // Corks the metadata cache of an open file, or lets it evict the entries down to the given size.
+    static bool fileCork(const hid_t fileId, const bool cork, const size_t cacheBytes)
+    {
+        H5AC_cache_config_t mdc_config;
+        mdc_config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+        if (0 > H5Fget_mdc_config(fileId, &mdc_config))
+            return false;
+        mdc_config.evictions_enabled = !cork;
+        mdc_config.incr_mode = H5C_incr__off;
+        mdc_config.decr_mode = H5C_decr__off;
+        mdc_config.flash_incr_mode = H5C_flash_incr__off;
+        if (!cork)
+        {
+            mdc_config.set_initial_size = true;
+            mdc_config.initial_size = std::max(cacheBytes, static_cast<size_t>(1024)); // The smallest cache size of the library.
+            mdc_config.min_size = std::min(mdc_config.min_size, mdc_config.initial_size);
+            mdc_config.max_size = std::max(mdc_config.max_size, mdc_config.initial_size);
+        }
+        return 0 <= H5Fset_mdc_config(fileId, &mdc_config);
+    }
+
     static hid_t groupOpen(const char* instrumentPath, const hid_t fileId, const bool readWrite, const bool createNonexistent)
     {
         // Save old error handler.
@@ -989,12 +1570,92 @@ namespace mbc::h5
         const char* name_;
     } DatasetTraits;
 
-    static hid_t datasetOpen(const char* datasetName, const hid_t groupId, const hid_t externalType, const bool readWrite, const bool createNonexistent)
+    // The process-wide limit of the chunk caches of the open datasets, 0 for no limit, and the bytes taken from it.
+    static std::atomic<size_t> theChunkCacheBudget{ 0 };
+    static std::atomic<size_t> theChunkCacheBytes{ 0 };
+
+    // Returns the size in bytes of a chunk of the dataset, or 0 if the dataset is not chunked.
+    static size_t datasetChunkBytes(const hid_t datasetId)
+    {
+        size_t chunkBytes{ 0 };
+        const hid_t dcpl_id = H5Dget_create_plist(datasetId);
+        hsize_t dims[1];
+        if (0 <= dcpl_id && H5D_CHUNKED == H5Pget_layout(dcpl_id) && 1 == H5Pget_chunk(dcpl_id, 1, dims))
+        {
+            const hid_t typeId = H5Dget_type(datasetId);
+            if (0 <= typeId)
+            {
+                chunkBytes = static_cast<size_t>(dims[0]) * H5Tget_size(typeId);
+                H5Tclose(typeId);
+            }
+        }
+        if (0 <= dcpl_id)
+            H5Pclose(dcpl_id);
+        return chunkBytes;
+    }
+
+    // Returns the chunk cache bytes of a closed dataset to the budget.
+    static void chunkCacheRelease(const size_t bytes)
+    {
+        theChunkCacheBytes.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    // Sets the chunk cache of the dataset access properties, of the sizes of the options or of the ones derived from the chunk size,
+    // and takes its bytes from the budget, which may leave less than asked for but not less than a chunk. Returns the bytes taken.
+    static size_t chunkCacheSet(const hid_t dapl_id, const DatasetCreationOptions& options, const size_t chunkBytes)
+    {
+        size_t bytes = options.chunkCacheBytes_;
+        double w0 = H5D_CHUNK_CACHE_W0_DEFAULT;
+        if (DataAccessPattern::Random == options.accessPattern_)
+            w0 = 0.;
+        else if (DataAccessPattern::Sequential == options.accessPattern_)
+            w0 = 1.;
+        if (0 == bytes)
+        {
+            // A scan reads every chunk once, a chunk a page covers in whole is not read again. The cache only keeps the chunk split by
+            // the boundary of a page for the next page, which two chunks do with the fully read ones evicted first; more would only take budget.
+            const size_t chunks = DataAccessPattern::Random == options.accessPattern_ ? 64 : DataAccessPattern::Sequential == options.accessPattern_ ? 2 : 16;
+            bytes = chunks * chunkBytes;
+        }
+        const size_t budget = theChunkCacheBudget.load(std::memory_order_relaxed);
+        if (0 < budget)
+        {
+            // A cache without room for a chunk would decompress a whole chunk for every read of a single item, so the spent budget
+            // still leaves a chunk, unless less has been asked for.
+            const size_t asked = bytes;
+            const size_t used = theChunkCacheBytes.load(std::memory_order_relaxed);
+            bytes = used < budget ? std::min(bytes, budget - used) : 0;
+            bytes = std::max(bytes, std::min(asked, chunkBytes));
+        }
+        size_t slots = options.chunkCacheSlots_;
+        if (0 == slots)
+        {
+            // A prime about 100 times the number of the chunks the cache holds keeps the collisions rare.
+            const size_t chunks = 0 < chunkBytes ? std::max(bytes / chunkBytes, static_cast<size_t>(1)) : 1;
+            slots = std::min(std::max(chunks * 100 + 1, static_cast<size_t>(521)), static_cast<size_t>(1024 * 1024 + 1)) | 1;
+            const auto prime = [](const size_t n)
+            {
+                for (size_t d = 3; d * d <= n; d += 2)
+                    if (0 == n % d)
+                        return false;
+                return true;
+            };
+            while (!prime(slots))
+                slots += 2;
+        }
+        if (0 > H5Pset_chunk_cache(dapl_id, slots, bytes, w0))
+            return 0;
+        theChunkCacheBytes.fetch_add(bytes, std::memory_order_relaxed);
+        return bytes;
+    }
+
+    static hid_t datasetOpen(const char* datasetName, const hid_t groupId, const hid_t externalType, const bool readWrite, const bool createNonexistent, const DatasetCreationOptions& options, size_t& chunkCacheBytes)
     {
         // Modify the dataset access properties.
+        // The cache sizes derived from the chunk size of an existing dataset are known after it is opened, so it is opened again with them.
         const hid_t dapl_id = H5Pcreate(H5P_DATASET_ACCESS);
-
-        H5Pset_chunk_cache(dapl_id, 12421, 16 * 1024 * 1024, H5D_CHUNK_CACHE_W0_DEFAULT);
+        const bool derived = 0 == options.chunkCacheBytes_ || 0 == options.chunkCacheSlots_;
+        chunkCacheBytes = derived ? 0 : chunkCacheSet(dapl_id, options, 0);
 
         // Save old error handler.
         herr_t(*oldFunc)(hid_t, void*);
@@ -1004,12 +1665,26 @@ namespace mbc::h5
         // Turn off error handling.
         H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr);
 
-        hid_t dataset_id = H5Dopen2(groupId, datasetName, dapl_id);
+        // The filter must be known both to read the existing datasets and to create new ones.
+        timeSeriesFilterRegister();
+        hid_t dataset_id = H5Dopen2(groupId, datasetName, derived ? H5P_DEFAULT : dapl_id);
+        if (0 <= dataset_id && (derived || chunkCacheBytes < options.chunkCacheBytes_))
+        {
+            // The explicit sizes cut by the budget are set again with the chunk size known, which keeps a chunk in the cache.
+            const size_t chunkBytes = datasetChunkBytes(dataset_id);
+            if (0 < chunkBytes && (derived || chunkCacheBytes < std::min(options.chunkCacheBytes_, chunkBytes)))
+            {
+                H5Dclose(dataset_id);
+                chunkCacheRelease(chunkCacheBytes);
+                chunkCacheBytes = chunkCacheSet(dapl_id, options, chunkBytes);
+                dataset_id = H5Dopen2(groupId, datasetName, dapl_id);
+            }
+        }
 
         // Restore previous error handler.
         H5Eset_auto2(H5E_DEFAULT, oldFunc, oldClientData);
 
-        if (0 > dataset_id && readWrite && createNonexistent)
+        if (0 > dataset_id && readWrite && createNonexistent && 0 < options.chunkRows_ && (!options.compress_ || CompressionCodec::TimeSeries == options.codec_ || (0 < options.deflateLevel_ && 9 >= options.deflateLevel_)))
         {
             // Create a simple dataspace with unlimited size.
             hsize_t dims[1] = { 0 };
@@ -1021,11 +1696,26 @@ namespace mbc::h5
 
             // The values of the dims_chunk array define the size of the chunks to store the raw data.
             // The unit of measure for dim values is dataset elements.
-            hsize_t dims_chunk[1] = { 1024 * 20 };
+            hsize_t dims_chunk[1] = { options.chunkRows_ };
+            const size_t chunkBytes = static_cast<size_t>(options.chunkRows_) * H5Tget_size(externalType);
+            if (derived || chunkCacheBytes < std::min(options.chunkCacheBytes_, chunkBytes))
+            {
+                chunkCacheRelease(chunkCacheBytes);
+                chunkCacheBytes = chunkCacheSet(dapl_id, options, chunkBytes);
+            }
             H5Pset_layout(dcpl_id, H5D_CHUNKED);
             H5Pset_chunk(dcpl_id, 1, dims_chunk);
-            H5Pset_shuffle(dcpl_id);
-            H5Pset_deflate(dcpl_id, 9); // TODO: review, standard is 6
+            if (options.compress_ && CompressionCodec::TimeSeries == options.codec_)
+            {
+                // The client data of the filter is set from the type of the created dataset.
+                H5Pset_filter(dcpl_id, timeSeriesFilterId, H5Z_FLAG_MANDATORY, 0, nullptr);
+            }
+            else if (options.compress_)
+            {
+                if (options.shuffle_)
+                    H5Pset_shuffle(dcpl_id);
+                H5Pset_deflate(dcpl_id, options.deflateLevel_);
+            }
 
             // Create the dataset.
             dataset_id = H5Dcreate2(groupId, datasetName, externalType, space_id, H5P_DEFAULT, dcpl_id, dapl_id); // H5P_DEFAULT
@@ -1033,31 +1723,370 @@ namespace mbc::h5
             H5Pclose(dcpl_id);
         }
         H5Pclose(dapl_id);
+
+        // The virtual datasets of the segmented layout have no chunk cache of their own.
+        if (0 < chunkCacheBytes && (0 > dataset_id || 0 == datasetChunkBytes(dataset_id)))
+        {
+            chunkCacheRelease(chunkCacheBytes);
+            chunkCacheBytes = 0;
+        }
         return dataset_id;
     }
 
-    static bool nativeTypeFailed(DatasetTraits& datasetTraits)
+    // Returns the name of the dataset of a field in the columnar layout.
+    static const char* columnName(const char* memberName)
     {
-        datasetTraits.standardType_ = -1;
-        return false;
+        static const char* const names[][2]{
+            { timeTicksTypeName, "ticks" }, { askPriceTypeName, "askPrice" }, { bidPriceTypeName, "bidPrice" }, { askSizeTypeName, "askSize" },
+            { bidSizeTypeName, "bidSize" }, { openingPriceTypeName, "open" }, { highestPriceTypeName, "high" }, { lowestPriceTypeName, "low" },
+            { closingPriceTypeName, "close" }, { volumeTypeName, "volume" }, { priceTypeName, "price" }, { valueTypeName, "value" } };
+        for (const auto& name : names)
+            if (0 == strcmp(memberName, name[0]))
+                return name[1];
+        return memberName;
     }
 
-    static bool standardTypeFailed(DatasetTraits& datasetTraits)
+    static hid_t closeColumns(DatasetColumns& columns)
     {
-        H5Tclose(datasetTraits.nativeType_);
-        datasetTraits.nativeType_ = -1;
-        return false;
+        for (const auto& column : columns)
+        {
+            H5Dclose(column.first);
+            H5Tclose(column.second);
+        }
+        columns.clear();
+        return -1;
     }
 
-    static bool makeOhlcv(DatasetTraits& datasetTraits, const char* name)
+    // ----------------------------------------------------------------------
+    // Segments
+    // ----------------------------------------------------------------------
+
+    static bool isSegmentName(const char* name)
     {
-        datasetTraits.name_ = name;
-        datasetTraits.nativeType_ = makeNativeType_Ohlcv();
-        if (0 > datasetTraits.nativeType_)
-            return nativeTypeFailed(datasetTraits);
-        datasetTraits.standardType_ = makeStandardType_Ohlcv();
-        if (0 > datasetTraits.standardType_)
-            return standardTypeFailed(datasetTraits);
+        return nullptr != strstr(name, segmentNameInfix);
+    }
+
+    // Creates a virtual dataset mapping the rows of the segments one after another and links it in place of the current one.
+    // The last segment is mapped up to the end of its dataset, so that the virtual dataset grows with the items appended to it.
+    static hid_t segmentsCreate(const hid_t locId, const char* name, const hid_t standardTypeId, const std::vector<DataSegment>& segments)
+    {
+        hsize_t dims[1] = { 0 };
+        hsize_t max_dims[1] = { H5S_UNLIMITED };
+        for (const auto& segment : segments)
+            dims[0] += segment.count_;
+        const hid_t virtualSpace_id = H5Screate_simple(1, dims, max_dims);
+        const hid_t dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+        bool status = 0 <= virtualSpace_id && 0 <= dcpl_id && !segments.empty();
+        for (size_t i = 0; status && i < segments.size(); ++i)
+        {
+            const DataSegment& segment = segments[i];
+            const bool last = i + 1 == segments.size();
+            hsize_t sourceDims[1] = { segment.rowOffset_ + segment.count_ };
+            hsize_t sourceOffsets[1] = { segment.rowOffset_ };
+            hsize_t offsets[1] = { segment.offset_ };
+            hsize_t counts[1] = { last ? H5S_UNLIMITED : 1 };
+            hsize_t blocks[1] = { last ? 1 : segment.count_ };
+            const hid_t sourceSpace_id = H5Screate_simple(1, sourceDims, max_dims);
+            status = 0 <= sourceSpace_id
+                && 0 <= H5Sselect_hyperslab(sourceSpace_id, H5S_SELECT_SET, sourceOffsets, nullptr, counts, blocks)
+                && 0 <= H5Sselect_hyperslab(virtualSpace_id, H5S_SELECT_SET, offsets, nullptr, counts, blocks)
+                && 0 <= H5Pset_virtual(dcpl_id, virtualSpace_id, ".", segment.datasetPath_.c_str(), sourceSpace_id);
+            if (0 <= sourceSpace_id)
+                H5Sclose(sourceSpace_id);
+        }
+
+        // The new dataset is created anonymous and linked under the name once it is complete.
+        hid_t datasetId = status ? H5Dcreate_anon(locId, standardTypeId, virtualSpace_id, dcpl_id, H5P_DEFAULT) : -1;
+        if (0 <= datasetId && ((0 < H5Lexists(locId, name, H5P_DEFAULT) && 0 > H5Ldelete(locId, name, H5P_DEFAULT))
+            || 0 > H5Olink(datasetId, locId, name, H5P_DEFAULT, H5P_DEFAULT)))
+        {
+            H5Dclose(datasetId);
+            datasetId = -1;
+        }
+        if (0 <= dcpl_id)
+            H5Pclose(dcpl_id);
+        if (0 <= virtualSpace_id)
+            H5Sclose(virtualSpace_id);
+        return datasetId;
+    }
+
+    // Reads the segments from the mapping of a virtual dataset in the order of their offsets.
+    // The count of the last segment is left zero, since it spans the rest of its dataset.
+    static bool segmentsRead(const hid_t datasetId, std::vector<DataSegment>& segments)
+    {
+        segments.clear();
+        const hid_t dcpl_id = H5Dget_create_plist(datasetId);
+        size_t mappings{ 0 };
+        bool status = 0 <= dcpl_id && H5D_VIRTUAL == H5Pget_layout(dcpl_id) && 0 <= H5Pget_virtual_count(dcpl_id, &mappings) && 0 < mappings;
+        for (size_t i = 0; status && i < mappings; ++i)
+        {
+            const hid_t virtualSpace_id = H5Pget_virtual_vspace(dcpl_id, i);
+            const hid_t sourceSpace_id = H5Pget_virtual_srcspace(dcpl_id, i);
+            const ssize_t length = H5Pget_virtual_dsetname(dcpl_id, i, nullptr, 0);
+            hsize_t offsets[1], strides[1], counts[1], blocks[1], sourceOffsets[1];
+            status = 0 <= virtualSpace_id && 0 <= sourceSpace_id && 0 < length
+                && 0 <= H5Sget_regular_hyperslab(sourceSpace_id, sourceOffsets, strides, counts, blocks)
+                && 0 <= H5Sget_regular_hyperslab(virtualSpace_id, offsets, strides, counts, blocks);
+            if (status)
+            {
+                std::vector<char> path(static_cast<size_t>(length) + 1);
+                status = 0 <= H5Pget_virtual_dsetname(dcpl_id, i, path.data(), path.size());
+                segments.push_back({ path.data(), offsets[0], sourceOffsets[0], H5S_UNLIMITED == counts[0] ? 0 : counts[0] * blocks[0] });
+            }
+            if (0 <= sourceSpace_id)
+                H5Sclose(sourceSpace_id);
+            if (0 <= virtualSpace_id)
+                H5Sclose(virtualSpace_id);
+        }
+        if (0 <= dcpl_id)
+            H5Pclose(dcpl_id);
+        std::sort(segments.begin(), segments.end(), [](const DataSegment& a, const DataSegment& b) { return a.offset_ < b.offset_; });
+        return status;
+    }
+
+    // Closes a handle of a segment dataset, the last one returns the chunk cache of the dataset to the budget and takes its bytes from the given ones.
+    static bool segmentClose(const hid_t segmentId, size_t& chunkCacheBytes)
+    {
+        if (1 == H5Iget_ref(segmentId))
+        {
+            const hid_t dapl_id = H5Dget_access_plist(segmentId);
+            size_t slots, bytes{ 0 };
+            double w0;
+            if (0 <= dapl_id && 0 <= H5Pget_chunk_cache(dapl_id, &slots, &bytes, &w0))
+            {
+                bytes = std::min(bytes, chunkCacheBytes);
+                chunkCacheRelease(bytes);
+                chunkCacheBytes -= bytes;
+            }
+            if (0 <= dapl_id)
+                H5Pclose(dapl_id);
+        }
+        return 0 <= H5Dclose(segmentId);
+    }
+
+    // Closes a segment dataset which has not been mapped and deletes it.
+    static void segmentDrop(const hid_t segmentId, const std::string& segmentPath, size_t& chunkCacheBytes)
+    {
+        const hid_t fileId = H5Iget_file_id(segmentId);
+        segmentClose(segmentId, chunkCacheBytes);
+        if (0 <= fileId)
+        {
+            H5Ldelete(fileId, segmentPath.c_str(), H5P_DEFAULT);
+            H5Fclose(fileId);
+        }
+    }
+
+    static hid_t zoneType(const bool standard)
+    {
+        const hsize_t dims[1]{ DataZone::maximumFields };
+        const size_t arrayBytes = 8 * DataZone::maximumFields;
+        const hid_t arrayType = H5Tarray_create2(standard ? H5T_IEEE_F64LE : H5T_NATIVE_DOUBLE, 1, dims);
+        hid_t type = H5Tcreate(H5T_COMPOUND, standard ? 24 + 3 * arrayBytes : sizeof(DataZone));
+        const bool status = 0 <= arrayType && 0 <= type
+            && 0 <= H5Tinsert(type, "Count", standard ? 0 : HOFFSET(DataZone, count_), standard ? H5T_STD_U64LE : H5T_NATIVE_HSIZE)
+            && 0 <= H5Tinsert(type, "First time ticks", standard ? 8 : HOFFSET(DataZone, firstTicks_), standard ? H5T_STD_I64LE : H5T_NATIVE_LLONG)
+            && 0 <= H5Tinsert(type, "Last time ticks", standard ? 16 : HOFFSET(DataZone, lastTicks_), standard ? H5T_STD_I64LE : H5T_NATIVE_LLONG)
+            && 0 <= H5Tinsert(type, "Minimum", standard ? 24 : HOFFSET(DataZone, minimum_), arrayType)
+            && 0 <= H5Tinsert(type, "Maximum", standard ? 24 + arrayBytes : HOFFSET(DataZone, maximum_), arrayType)
+            && 0 <= H5Tinsert(type, "Sum", standard ? 24 + 2 * arrayBytes : HOFFSET(DataZone, sum_), arrayType);
+        if (0 <= arrayType)
+            H5Tclose(arrayType);
+        if (!status && 0 <= type)
+        {
+            H5Tclose(type);
+            type = -1;
+        }
+        return type;
+    }
+
+    // The number of the zone maps in a chunk of their dataset.
+    static constexpr hsize_t zonesChunkRows{ 256 };
+
+    // The zone maps of a data are stored in a dataset next to it, a zone map per chunk makes a small dataset, a few hundred of them fit in a chunk.
+    static hid_t zonesCreate(const hid_t locationId, const std::string& zonesName, const hid_t dapl_id)
+    {
+        hsize_t dims[1] = { 0 };
+        hsize_t max_dims[1] = { H5S_UNLIMITED };
+        hsize_t dims_chunk[1] = { zonesChunkRows };
+        const hid_t space_id = H5Screate_simple(1, dims, max_dims);
+        const hid_t dcpl_id = H5Pcreate(H5P_DATASET_CREATE);
+        H5Pset_chunk(dcpl_id, 1, dims_chunk);
+        H5Pset_shuffle(dcpl_id);
+        H5Pset_deflate(dcpl_id, 6);
+        hid_t zonesId{ -1 };
+        const hid_t type = zoneType(true);
+        if (0 <= type)
+        {
+            zonesId = H5Dcreate2(locationId, zonesName.c_str(), type, space_id, H5P_DEFAULT, dcpl_id, dapl_id);
+            H5Tclose(type);
+        }
+        H5Sclose(space_id);
+        H5Pclose(dcpl_id);
+        return zonesId;
+    }
+
+    // Creates the access properties of a zone maps dataset, with a chunk cache derived from its chunk size for the access pattern of the data
+    // and taken from the budget. The explicit cache sizes of the data are meant for its items and are not applied to the small dataset.
+    static hid_t zonesAccess(const DatasetCreationOptions& options, size_t& chunkCacheBytes)
+    {
+        chunkCacheBytes = 0;
+        const hid_t dapl_id = H5Pcreate(H5P_DATASET_ACCESS);
+        const hid_t type = zoneType(true);
+        if (0 <= dapl_id && 0 <= type)
+        {
+            DatasetCreationOptions derived{ options };
+            derived.chunkCacheBytes_ = 0;
+            derived.chunkCacheSlots_ = 0;
+            chunkCacheBytes = chunkCacheSet(dapl_id, derived, static_cast<size_t>(zonesChunkRows) * H5Tget_size(type));
+        }
+        if (0 <= type)
+            H5Tclose(type);
+        return dapl_id;
+    }
+
+    // Creates the data in the segmented layout, a virtual dataset named after the data mapping a single empty segment dataset next to it.
+    static hid_t segmentedDataCreate(const DatasetTraits& datasetTraits, const hid_t groupId, const DatasetCreationOptions& options)
+    {
+        char groupPath[1024];
+        const ssize_t length = H5Iget_name(groupId, groupPath, sizeof(groupPath));
+        if (0 >= length || static_cast<size_t>(length) >= sizeof(groupPath))
+            return -1;
+        const std::string segmentName = std::string(datasetTraits.name_) + segmentNameInfix + "0";
+        size_t chunkCacheBytes;
+        const hid_t segmentId = datasetOpen(segmentName.c_str(), groupId, datasetTraits.standardType_, true, true, options, chunkCacheBytes);
+        if (0 > segmentId)
+            return -1;
+        std::string segmentPath{ groupPath };
+        if ('/' != segmentPath.back())
+            segmentPath.append("/");
+        segmentPath.append(segmentName);
+        const std::vector<DataSegment> segments{ { segmentPath, 0, 0, 0 } };
+        const hid_t datasetId = segmentsCreate(groupId, datasetTraits.name_, datasetTraits.standardType_, segments);
+        if (0 > datasetId)
+        {
+            segmentDrop(segmentId, segmentPath, chunkCacheBytes);
+            return -1;
+        }
+        segmentClose(segmentId, chunkCacheBytes);
+        return datasetId;
+    }
+
+    // Opens the data of an instrument, which is either a single dataset of items or, in the columnar layout,
+    // a group of the same name holding a dataset per field. The nonexistent data is created in the layout of the options.
+    // Returns the dataset of the items or of the ticks field, the columns receive all datasets with their memory types
+    // and the chunk cache bytes receive the bytes of their chunk caches taken from the budget.
+    static hid_t dataOpen(const DatasetTraits& datasetTraits, const hid_t groupId, const bool readWrite, const bool createNonexistent, const DatasetCreationOptions& options,
+        DatasetColumns& columns, size_t& chunkCacheBytes)
+    {
+        columns.clear();
+        chunkCacheBytes = 0;
+
+        // Save old error handler.
+        herr_t(*oldFunc)(hid_t, void*);
+        void* oldClientData;
+        H5Eget_auto2(H5E_DEFAULT, &oldFunc, &oldClientData);
+
+        // Turn off error handling.
+        H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr);
+
+        hid_t columnGroupId = H5Gopen2(groupId, datasetTraits.name_, H5P_DEFAULT);
+
+        // Restore previous error handler.
+        H5Eset_auto2(H5E_DEFAULT, oldFunc, oldClientData);
+
+        // Only the created data gets the zone maps, the existing one keeps the datasets it has.
+        const std::string zonesName = std::string(datasetTraits.name_) + zonesNameSuffix;
+        bool created{ false };
+        if (0 > columnGroupId)
+        {
+            hid_t datasetId = datasetOpen(datasetTraits.name_, groupId, datasetTraits.standardType_, readWrite, false, options, chunkCacheBytes);
+            if (0 > datasetId && readWrite && createNonexistent && !options.columnar_)
+            {
+                datasetId = options.segmented_ ? segmentedDataCreate(datasetTraits, groupId, options)
+                    : datasetOpen(datasetTraits.name_, groupId, datasetTraits.standardType_, true, true, options, chunkCacheBytes);
+                const hid_t zonesId = 0 <= datasetId && options.zoneMaps_ ? zonesCreate(groupId, zonesName, H5P_DEFAULT) : -1;
+                if (0 <= zonesId)
+                    H5Dclose(zonesId);
+            }
+            if (0 <= datasetId)
+            {
+                columns.emplace_back(datasetId, datasetTraits.nativeType_);
+                return datasetId;
+            }
+            if (!readWrite || !createNonexistent || !options.columnar_)
+                return -1;
+            columnGroupId = H5Gcreate2(groupId, datasetTraits.name_, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+            if (0 > columnGroupId)
+                return -1;
+            created = true;
+        }
+
+        // Every field dataset holds a compound of this field only, so that it converts to and from the items by the field name.
+        const int members = H5Tget_nmembers(datasetTraits.nativeType_);
+        const size_t itemSize = H5Tget_size(datasetTraits.nativeType_);
+        for (int m = 0; m < members; ++m)
+        {
+            const auto member = static_cast<unsigned>(m);
+            char* name = H5Tget_member_name(datasetTraits.nativeType_, member);
+            const hid_t nativeMember = H5Tget_member_type(datasetTraits.nativeType_, member);
+            const hid_t standardMember = H5Tget_member_type(datasetTraits.standardType_, member);
+            const hid_t memoryType = H5Tcreate(H5T_COMPOUND, itemSize);
+            const hid_t fileType = H5Tcreate(H5T_COMPOUND, 8);
+            const bool status = nullptr != name && 0 <= nativeMember && 0 <= standardMember && 0 <= memoryType && 0 <= fileType
+                && 0 <= H5Tinsert(memoryType, name, H5Tget_member_offset(datasetTraits.nativeType_, member), nativeMember)
+                && 0 <= H5Tinsert(fileType, name, 0, standardMember);
+            size_t columnCacheBytes{ 0 };
+            const hid_t datasetId = status ? datasetOpen(columnName(name), columnGroupId, fileType, readWrite, createNonexistent, options, columnCacheBytes) : -1;
+            chunkCacheBytes += columnCacheBytes;
+            if (0 <= datasetId)
+                columns.emplace_back(datasetId, memoryType);
+            else if (0 <= memoryType)
+                H5Tclose(memoryType);
+            if (0 <= fileType)
+                H5Tclose(fileType);
+            if (0 <= standardMember)
+                H5Tclose(standardMember);
+            if (0 <= nativeMember)
+                H5Tclose(nativeMember);
+            if (nullptr != name)
+                H5free_memory(name);
+            if (0 > datasetId)
+            {
+                H5Gclose(columnGroupId);
+                chunkCacheRelease(chunkCacheBytes);
+                chunkCacheBytes = 0;
+                return closeColumns(columns);
+            }
+        }
+        H5Gclose(columnGroupId);
+        const hid_t zonesId = created && options.zoneMaps_ ? zonesCreate(groupId, zonesName, H5P_DEFAULT) : -1;
+        if (0 <= zonesId)
+            H5Dclose(zonesId);
+        return columns.empty() ? -1 : columns.front().first;
+    }
+
+    static bool nativeTypeFailed(DatasetTraits& datasetTraits)
+    {
+        datasetTraits.standardType_ = -1;
+        return false;
+    }
+
+    static bool standardTypeFailed(DatasetTraits& datasetTraits)
+    {
+        H5Tclose(datasetTraits.nativeType_);
+        datasetTraits.nativeType_ = -1;
+        return false;
+    }
+
+    static bool makeOhlcv(DatasetTraits& datasetTraits, const char* name)
+    {
+        datasetTraits.name_ = name;
+        datasetTraits.nativeType_ = makeNativeType_Ohlcv();
+        if (0 > datasetTraits.nativeType_)
+            return nativeTypeFailed(datasetTraits);
+        datasetTraits.standardType_ = makeStandardType_Ohlcv();
+        if (0 > datasetTraits.standardType_)
+            return standardTypeFailed(datasetTraits);
         return true;
     }
 
@@ -2359,6 +3388,41 @@ namespace mbc::h5
         return 0 <= H5Sclose(space_id);
     }
 
+    // Gets the path an open group has now, the library follows the moves and the renames of the group and of the groups above it.
+    static bool groupPath(const hid_t groupId, std::string& path)
+    {
+        const ssize_t length = H5Iget_name(groupId, nullptr, 0);
+        if (0 >= length)
+            return false; // The group has been deleted.
+        std::vector<char> name(static_cast<size_t>(length) + 1);
+        if (0 >= H5Iget_name(groupId, name.data(), name.size()))
+            return false;
+        path.assign(name.data(), static_cast<size_t>(length));
+        return true;
+    }
+
+    // Moves the paths of the segments next to the given path of their data.
+    static void segmentsRebase(const std::string& dataPath, std::vector<DataSegment>& segments)
+    {
+        const size_t length = dataPath.find_last_of('/');
+        for (auto& segment : segments)
+            segment.datasetPath_.replace(0, segment.datasetPath_.find_last_of('/'), dataPath, 0, length);
+    }
+
+    static hsize_t datasetChunkRows(const hid_t datasetId)
+    {
+        hsize_t chunkRows{ 1024 * 20 };
+        const hid_t dcpl_id = H5Dget_create_plist(datasetId);
+        if (0 <= dcpl_id)
+        {
+            hsize_t dims_chunk[1];
+            if (H5D_CHUNKED == H5Pget_layout(dcpl_id) && 1 == H5Pget_chunk(dcpl_id, 1, dims_chunk) && 0 < dims_chunk[0])
+                chunkRows = dims_chunk[0];
+            H5Pclose(dcpl_id);
+        }
+        return chunkRows;
+    }
+
     static bool writeItem(const hid_t datasetId, const hid_t nativeTypeId, const hsize_t itemOffset, const void* itemBuffer)
     {
         // Get the dataspace handle.
@@ -2394,6 +3458,41 @@ namespace mbc::h5
         return 0 <= H5Sclose(memorySpace_id);
     }
 
+    static bool writeItemRange(const hid_t datasetId, const hid_t nativeTypeId, const hsize_t itemOffset, const hsize_t itemCount, const void* itemBuffer)
+    {
+        // Get the dataspace handle.
+        const hid_t space_id = H5Dget_space(datasetId);
+        if (0 > space_id)
+            return false;
+
+        // Define a hyperslab in the dataset of the size of the records.
+        hsize_t counts[1], offsets[1];
+        counts[0] = itemCount;
+        offsets[0] = itemOffset;
+        if (0 > H5Sselect_hyperslab(space_id, H5S_SELECT_SET, offsets, nullptr, counts, nullptr))
+            return closeSpace(space_id);
+
+        // Create a memory dataspace handle.
+        const hid_t memorySpace_id = H5Screate_simple(1, counts, nullptr);
+        if (0 > memorySpace_id)
+            return closeSpace(space_id);
+
+        // Write the records.
+        if (0 > H5Dwrite(datasetId, nativeTypeId, memorySpace_id, space_id, H5P_DEFAULT, itemBuffer))
+        {
+            H5Sclose(memorySpace_id);
+            return closeSpace(space_id);
+        }
+
+        // Terminate an access to the dataspace.
+        if (0 > H5Sclose(space_id))
+        {
+            H5Sclose(memorySpace_id);
+            return false;
+        }
+        return 0 <= H5Sclose(memorySpace_id);
+    }
+
     static bool closeSpace2(hid_t space1_id, hid_t space2_id)
     {
         H5Sclose(space1_id);
@@ -2778,6 +3877,190 @@ namespace mbc::h5
         return true;
     }
 
+    // The helpers of the columns address the items after the head, the rows trimmed before it are kept until the compaction.
+    static bool countItems(const DatasetColumns& columns, hsize_t& itemCount)
+    {
+        if (!countItems(columns.front().first, itemCount) || itemCount < columns.head_)
+            return false;
+        itemCount -= columns.head_;
+        return true;
+    }
+
+    static bool readCountAttribute(const hid_t datasetId, const char* name, hsize_t& count)
+    {
+        if (0 >= H5Aexists(datasetId, name))
+            return false;
+        const hid_t attributeId = H5Aopen(datasetId, name, H5P_DEFAULT);
+        if (0 > attributeId)
+            return false;
+        const bool status = 0 <= H5Aread(attributeId, H5T_NATIVE_HSIZE, &count);
+        H5Aclose(attributeId);
+        return status;
+    }
+
+    static bool writeCountAttribute(const hid_t datasetId, const char* name, const hsize_t count)
+    {
+        hid_t attributeId;
+        if (0 < H5Aexists(datasetId, name))
+            attributeId = H5Aopen(datasetId, name, H5P_DEFAULT);
+        else
+        {
+            const hid_t space_id = H5Screate(H5S_SCALAR);
+            if (0 > space_id)
+                return false;
+            attributeId = H5Acreate2(datasetId, name, H5T_STD_U64LE, space_id, H5P_DEFAULT, H5P_DEFAULT);
+            H5Sclose(space_id);
+        }
+        if (0 > attributeId)
+            return false;
+        const bool status = 0 <= H5Awrite(attributeId, H5T_NATIVE_HSIZE, &count);
+        H5Aclose(attributeId);
+        return status;
+    }
+
+    // The number of the items of a dataset with preallocated rows is kept in an attribute, the dataset without it holds the items only.
+    static bool readItemCount(const hid_t datasetId, hsize_t& itemCount)
+    {
+        return readCountAttribute(datasetId, itemCountAttributeName, itemCount);
+    }
+
+    static bool writeItemCount(const hid_t datasetId, const hsize_t itemCount)
+    {
+        return writeCountAttribute(datasetId, itemCountAttributeName, itemCount);
+    }
+
+    // The number of the rows trimmed from the head of a dataset is kept in an attribute, the dataset without it starts with its first item.
+    static hsize_t readHeadCount(const hid_t datasetId)
+    {
+        hsize_t headCount;
+        return readCountAttribute(datasetId, headCountAttributeName, headCount) ? headCount : 0;
+    }
+
+    static bool readItem(const DatasetColumns& columns, const hsize_t itemOffset, void* itemBuffer)
+    {
+        for (const auto& column : columns)
+            if (!readItem(column.first, column.second, columns.head_ + itemOffset, itemBuffer))
+                return false;
+        return true;
+    }
+
+    // Creates the type of the packed field of a column and returns the offset of the field in the items.
+    // A field transferred through the item-sized type is converted with the items as a background, which is several times slower
+    // than transferring the packed field as it is stored and copying it from or into the items.
+    static hid_t packedFieldType(const hid_t memoryType, size_t& fieldOffset)
+    {
+        char* name = H5Tget_member_name(memoryType, 0);
+        const hid_t memberType = H5Tget_member_type(memoryType, 0);
+        hid_t packedType = H5Tcreate(H5T_COMPOUND, 8);
+        if (nullptr == name || 0 > memberType || 0 > packedType || 0 > H5Tinsert(packedType, name, 0, memberType))
+        {
+            if (0 <= packedType)
+                H5Tclose(packedType);
+            packedType = -1;
+        }
+        fieldOffset = H5Tget_member_offset(memoryType, 0);
+        if (0 <= memberType)
+            H5Tclose(memberType);
+        if (nullptr != name)
+            H5free_memory(name);
+        return packedType;
+    }
+
+    static bool readItemRange(const DatasetColumns& columns, const hsize_t itemOffset, const hsize_t itemCount, void* itemBuffer)
+    {
+        if (1 == columns.size())
+            return readItemRange(columns.front().first, columns.front().second, columns.head_ + itemOffset, itemCount, itemBuffer);
+        std::vector<unsigned char> field(static_cast<size_t>(itemCount) * 8);
+        const size_t itemSize = H5Tget_size(columns.front().second);
+        const auto items = static_cast<unsigned char*>(itemBuffer);
+        for (const auto& column : columns)
+        {
+            size_t fieldOffset;
+            const hid_t packedType = packedFieldType(column.second, fieldOffset);
+            if (0 > packedType)
+                return false;
+            const bool status = readItemRange(column.first, packedType, columns.head_ + itemOffset, itemCount, field.data());
+            H5Tclose(packedType);
+            if (!status)
+                return false;
+            for (size_t i = 0; i < static_cast<size_t>(itemCount); ++i)
+                std::memcpy(items + i * itemSize + fieldOffset, field.data() + i * 8, 8);
+        }
+        return true;
+    }
+
+    static bool writeItem(const DatasetColumns& columns, const hsize_t itemOffset, const void* itemBuffer)
+    {
+        for (const auto& column : columns)
+            if (!writeItem(column.first, column.second, columns.head_ + itemOffset, itemBuffer))
+                return false;
+        return true;
+    }
+
+    // Writes the packed fields of the items column by column, the write appends the items if the offset is the item count.
+    static bool writeFields(const DatasetColumns& columns, const hsize_t itemOffset, const hsize_t itemCount, const void* itemBuffer, const bool append)
+    {
+        std::vector<unsigned char> field(static_cast<size_t>(itemCount) * 8);
+        const size_t itemSize = H5Tget_size(columns.front().second);
+        const auto items = static_cast<const unsigned char*>(itemBuffer);
+        for (const auto& column : columns)
+        {
+            size_t fieldOffset;
+            const hid_t packedType = packedFieldType(column.second, fieldOffset);
+            if (0 > packedType)
+                return false;
+            for (size_t i = 0; i < static_cast<size_t>(itemCount); ++i)
+                std::memcpy(field.data() + i * 8, items + i * itemSize + fieldOffset, 8);
+            const bool status = append ? appendItems(column.first, packedType, itemCount, field.data())
+                : writeItemRange(column.first, packedType, columns.head_ + itemOffset, itemCount, field.data());
+            H5Tclose(packedType);
+            if (!status)
+                return false;
+        }
+        return true;
+    }
+
+    static bool writeItemRange(const DatasetColumns& columns, const hsize_t itemOffset, const hsize_t itemCount, const void* itemBuffer)
+    {
+        if (1 == columns.size())
+            return writeItemRange(columns.front().first, columns.front().second, columns.head_ + itemOffset, itemCount, itemBuffer);
+        return writeFields(columns, itemOffset, itemCount, itemBuffer, false);
+    }
+
+    static bool appendItems(const DatasetColumns& columns, const hsize_t itemCount, const void* itemBuffer)
+    {
+        if (1 == columns.size())
+            return appendItems(columns.front().first, columns.front().second, itemCount, itemBuffer);
+        return writeFields(columns, 0, itemCount, itemBuffer, true);
+    }
+
+    static bool prependItems(const DatasetColumns& columns, const hsize_t itemCount, const void* itemBuffer, const size_t itemSize)
+    {
+        for (const auto& column : columns)
+            if (0 < columns.head_ ? !insertItems(column.first, column.second, columns.head_, itemCount, itemBuffer, itemSize)
+                : !prependItems(column.first, column.second, itemCount, itemBuffer, itemSize))
+                return false;
+        return true;
+    }
+
+    static bool deleteItems(const DatasetColumns& columns, const hsize_t offset, const hsize_t itemCount, const size_t itemSize)
+    {
+        for (const auto& column : columns)
+            if (!deleteItems(column.first, column.second, columns.head_ + offset, itemCount, itemSize))
+                return false;
+        return true;
+    }
+
+    static bool setExtent(const DatasetColumns& columns, const hsize_t itemCount)
+    {
+        hsize_t dims[1];
+        dims[0] = columns.head_ + itemCount;
+        for (const auto& column : columns)
+            if (0 > H5Dset_extent(column.first, dims))
+                return false;
+        return true;
+    }
+
     template <typename T> static hsize_t lowerNeighborIndex(const T* source, const hsize_t length, const long long targetTicks, bool& match)
     {
         match = false;
@@ -2803,24 +4086,22 @@ namespace mbc::h5
         return indexLow;
     }
 
-    template <typename T> static bool lowerNeighborIndex(const hid_t datasetId, const hid_t nativeTypeId, const long long targetTicks, hsize_t& index, bool& match)
+    template <typename T> static bool lowerNeighborIndex(const DatasetColumns& columns, const hsize_t itemCount, const long long targetTicks, hsize_t& index, bool& match)
     {
         match = false;
         index = 0;
+        const hid_t datasetId = columns.front().first;
+        const hid_t nativeTypeId = columns.front().second;
 
         // Get the dataspace handle.
         const hid_t space_id = H5Dget_space(datasetId);
         if (0 > space_id)
             return false;
-
-        // Get the original dimension.
-        hsize_t counts[1];
-        if (0 > H5Sget_simple_extent_dims(space_id, counts, nullptr))
-            return closeSpace(space_id);
-        hsize_t indexLow = 0, indexHigh = counts[0];
+        hsize_t indexLow = 0, indexHigh = itemCount;
         T t{};
 
         // Create a memory dataspace handle.
+        hsize_t counts[1];
         counts[0] = 1;
         const hid_t memorySpace_id = H5Screate_simple(1, counts, nullptr);
         if (0 > memorySpace_id)
@@ -2832,7 +4113,7 @@ namespace mbc::h5
             const hsize_t indexMiddle = indexLow + (indexHigh - indexLow) / 2;
 
             // Define a hyperslab in the dataset.
-            offsets[0] = indexMiddle;
+            offsets[0] = columns.head_ + indexMiddle;
             if (0 > H5Sselect_hyperslab(space_id, H5S_SELECT_SET, offsets, nullptr, counts, nullptr))
                 return closeSpace2(memorySpace_id, space_id);
 
@@ -2864,1659 +4145,5366 @@ done:
         return 0 <= H5Sclose(space_id);
     }
 
-    template <typename T> static bool mergeItems(const hid_t datasetId, const hid_t nativeTypeId, hsize_t inputStart, const hsize_t inputCount, const T* inputBuffer, const DuplicateTimeTicks duplicateTimeTicks, const bool verbose)
+    template <typename T> static bool readTicks(const DatasetColumns& columns, const hsize_t itemOffset, const hsize_t itemStride, const hsize_t itemCount, long long* ticksBuffer)
     {
-        hsize_t index;
-        const hsize_t inputStop = inputStart + inputCount;
-        bool match;
-        T dataValue{};
-        while (inputStart < inputStop)
-        {
-            T inputValue = *(inputBuffer + inputStart);
-            if (!lowerNeighborIndex<T>(datasetId, nativeTypeId, inputValue.ticks_, index, match))
-                return false;
-            if (match)
-            {
-                if (!readItem(datasetId, nativeTypeId, index, static_cast<void*>(&dataValue)))
-                    return false;
-                if (inputValue.isDifferent(dataValue))
-                {
-                    if (DuplicateTimeTicks::Update == duplicateTimeTicks)
-                    {
-                        if (verbose)
-                            traceDataDuplicateTicksUpdateInfo<T>(index, dataValue, inputStart, inputValue);
-                        if (!writeItem(datasetId, nativeTypeId, index, static_cast<void*>(&inputValue)))
-                            return traceDataDuplicateTicksUpdateError<T>(index, dataValue, inputStart, inputValue);
-                    }
-                    else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
-                        traceDataDuplicateTicksSkipError<T>(index, dataValue, inputStart, inputValue);
-                    else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
-                        return traceDataDuplicateTicksFailError<T>(index, dataValue, inputStart, inputValue);
-                }
-                ++inputStart;
-            }
-            else
-            {
-                ++index; // Upper neighbor.
-                if (!readItem(datasetId, nativeTypeId, index, static_cast<void*>(&dataValue)))
-                    return false;
-                hsize_t mergeCount = 1;
-                hsize_t mergeStart = inputStart;
-                for (++inputStart; inputStart < inputStop; ++inputStart)
-                {
-                    if ((inputBuffer + inputStart)->ticks_ < dataValue.ticks_)
-                        ++mergeCount;
-                    else
-                        break;
-                }
-                if (!insertItems(datasetId, nativeTypeId, index, mergeCount, static_cast<const void*>(inputBuffer + mergeStart), sizeof(T)))
-                    return false;
-            }
-        }
-        return true;
-    }
+        const hid_t datasetId = columns.front().first;
+        const hid_t nativeTypeId = columns.front().second;
 
-    static bool closeGroup(hid_t id)
-    {
-        H5Gclose(id);
-        return false;
-    }
-	
-    static bool isEmptyGroup(const hid_t fileId, const char* groupPath)
-    {
-        const hid_t group_id = H5Gopen2(fileId, groupPath, H5P_DEFAULT);
-        if (0 > group_id)
-            return traceGroupOpenError(groupPath);
-        H5G_info_t g_info;
-        const herr_t status = H5Gget_info(group_id, &g_info);
-        if (0 > status)
-        {
-            traceGroupInfoError(groupPath);
-            return closeGroup(group_id);
-        }
-        if (0 > H5Gclose(group_id))
-            return traceGroupCloseError(groupPath);
-        return g_info.nlinks == 0;
-    }
+        // Get the dataspace handle.
+        const hid_t space_id = H5Dget_space(datasetId);
+        if (0 > space_id)
+            return false;
 
-    // ----------------------------------------------------------------------
-    // ObjectInfo
-    // ----------------------------------------------------------------------
+        // Define a hyperslab in the dataset of every itemStride-th record.
+        hsize_t counts[1], offsets[1], strides[1];
+        counts[0] = itemCount;
+        offsets[0] = columns.head_ + itemOffset;
+        strides[0] = itemStride;
+        if (0 > H5Sselect_hyperslab(space_id, H5S_SELECT_SET, offsets, 1 < itemStride ? strides : nullptr, counts, nullptr))
+            return closeSpace(space_id);
 
-    ObjectInfo::ObjectInfo(const char* name, const GroupInfo* parent) :
-        name_(name),
-        path_(nullptr == parent ? name : parent->path()),
-        parent_(parent)
-    {
-        if (nullptr != parent)
-        {
-            path_.append("/");
-            path_.append(name);
-        }
-    }
+        // Create a memory dataspace handle.
+        const hid_t memorySpace_id = H5Screate_simple(1, counts, nullptr);
+        if (0 > memorySpace_id)
+            return closeSpace(space_id);
 
-    ObjectInfo::ObjectInfo() :
-        name_("/"),
-        path_(""),
-        parent_(nullptr)
-    {
+        // Read the items, a compound subset type with the time ticks field only would be way slower because of the type conversion.
+        std::vector<T> items(static_cast<size_t>(itemCount));
+        if (0 > H5Dread(datasetId, nativeTypeId, memorySpace_id, space_id, H5P_DEFAULT, static_cast<void*>(items.data())))
+            return closeSpace2(memorySpace_id, space_id);
+        for (const T& item : items)
+            *ticksBuffer++ = item.ticks_;
+
+        // Terminate an access to the dataspace.
+        if (0 > H5Sclose(memorySpace_id))
+            return closeSpace(space_id);
+        return 0 <= H5Sclose(space_id);
     }
 
     // ----------------------------------------------------------------------
-    // DataInfo
+    // TickIndex
     // ----------------------------------------------------------------------
 
-    DataInfo::DataInfo(const char* name, const GroupInfo* parent) :
-        ObjectInfo(name, parent)
-    {
-        dataKind_ = DataKind::TradeAperiodic;
-        ParsedDatasetName pdn;
-        isValidName_ = parseDatasetName(name, pdn);
-        dataType_ = pdn.dataType_;
-        ohlcvKind_ = pdn.ohlcvKind_;
-        scalarKind_ = pdn.scalarKind_;
-        tradeKind_ = pdn.tradeKind_;
-        quoteKind_ = pdn.quoteKind_;
-        timeFrame_ = pdn.timeFrame_;
-        if (isValidName_)
+    //! A sparse in-memory index of the (row, ticks) samples of a dataset, initially taken at the chunk boundaries.
+    //! A lookup is an in-memory search followed by the reads within at most one chunk: a few probes and a small slice.
+    //! The ticks of the last read slice are kept, so the consecutive lookups within it only verify its end rows.
+    //! The samples move along with their rows when the owning data inserts or deletes items, so the index is only
+    //! rebuilt when the dataset item count does not match the tracked one. Must be used under the library lock.
+    class TickIndex
+    {
+    public:
+        TickIndex() = default;
+        TickIndex(const TickIndex&) = delete;
+        TickIndex(const TickIndex&&) = delete;
+        void operator=(const TickIndex&) = delete;
+        void operator=(const TickIndex&&) = delete;
+
+        //! Drops the samples, the index will be rebuilt on the next lookup.
+        void reset()
         {
-            switch (dataType_)
-            {
-                case DataType::TradePriceOnly:
-                    dataKind_ = DataKind::TradePriceOnlyAperiodic;
-                    break;
-                case DataType::Quote:
-                    dataKind_ = DataKind::QuoteAperiodic;
-                    break;
-                case DataType::QuotePriceOnly:
-                    dataKind_ = DataKind::QuotePriceOnlyAperiodic;
-                    break;
-                case DataType::Ohlcv:
-                    dataKind_ = ohlcvKind2DataKind(ohlcvKind_, timeFrame_, false);
-                    break;
-                case DataType::OhlcvPriceOnly:
-                    dataKind_ = ohlcvPriceOnlyKind2DataKind(ohlcvKind_, timeFrame_, false);
-                    break;
-                case DataType::Scalar:
-                    dataKind_ = scalarKind2DataKind(scalarKind_, timeFrame_);
-                    break;
-                case DataType::OhlcvAdjusted:
-                    dataKind_ = ohlcvKind2DataKind(ohlcvKind_, timeFrame_, true);
-                    break;
-                case DataType::OhlcvAdjustedPriceOnly:
-                    dataKind_ = ohlcvPriceOnlyKind2DataKind(ohlcvKind_, timeFrame_, true);
-                    break;
-                case DataType::Trade:
-                default:
-                    break;
-            }
+            std::vector<Entry>().swap(entries_);
+            std::vector<long long>().swap(sliceTicks_);
+            built_ = false;
         }
-    }
 
-    DataInfo::DataInfo(const DataInfo& other) :
-        DataInfo(other.name(), other.parent_)
-    {
-    }
+        //! Finds an index of the item with the target ticks or of its lower neighbor.
+        template <typename T> bool lowerNeighborIndex(const DatasetColumns& columns, hsize_t itemCount, hsize_t maximumBytes, long long targetTicks, hsize_t& index, bool& match);
 
-    DataInfo::DataInfo(const DataInfo&& other) noexcept :
-        DataInfo(other.name(), other.parent_)
-    {
-    }
+        //! Takes the samples from the first ticks of the zones in the zone maps unless the index is built, so that no chunk is read.
+        void seed(const std::vector<DataZone>& zones, hsize_t chunkRows, hsize_t maximumBytes);
 
-    int DataInfo::compare(const void* first, const void* second) noexcept
-    {
-        // ReSharper disable CppCStyleCast
-        const auto p1 = *(const DataInfo**)first;
-        const auto p2 = *(const DataInfo**)second;
-        // ReSharper restore CppCStyleCast
+        //! Follows the items appended at the end of the dataset.
+        template <typename T> void appended(const T* input, hsize_t inputCount, hsize_t maximumBytes);
 
-        return strcmp(p1->path(), p2->path());
-    }
+        //! Follows the items inserted before the \p offset row.
+        void inserted(hsize_t offset, hsize_t itemCount);
 
-    // ----------------------------------------------------------------------
-    // GroupInfo
-    // ----------------------------------------------------------------------
+        //! Follows the items deleted starting from the \p offset row.
+        void deleted(hsize_t offset, hsize_t itemCount);
 
-    GroupInfo::GroupInfo() :
-        ObjectInfo()
-    {
-    }
+        //! Follows the items rewritten from the \p offset row to the end of the dataset, which holds \p itemCount items afterwards.
+        //! The samples of the rewritten rows are taken by the subsequent calls to rewritten().
+        void rewrite(hsize_t offset, hsize_t itemCount, hsize_t maximumBytes);
 
-    GroupInfo::GroupInfo(const char* name, const GroupInfo* parent) :
-        ObjectInfo(name, parent)
-    {
+        //! Takes the samples of the rewritten items starting at the \p offset row.
+        template <typename T> void rewritten(hsize_t offset, const T* input, hsize_t inputCount);
+
+    private:
+        struct Entry
+        {
+            hsize_t row_;
+            long long ticks_;
+        };
+
+        template <typename T> bool build(const DatasetColumns& columns, hsize_t itemCount, hsize_t maximumBytes);
+        void fit(hsize_t maximumBytes);
+
+        static constexpr hsize_t sliceRows{ 512 };
+
+        std::vector<Entry> entries_;
+        std::vector<long long> sliceTicks_;
+        hsize_t sliceOffset_{ 0 };
+        hsize_t itemCount_{ 0 };
+        hsize_t chunkRows_{ 0 };
+        hsize_t strideRows_{ 0 };
+        bool built_{ false };
+    };
+
+    template <typename T> bool TickIndex::build(const DatasetColumns& columns, const hsize_t itemCount, const hsize_t maximumBytes)
+    {
+        reset();
+        if (0 == chunkRows_)
+            chunkRows_ = datasetChunkRows(columns.front().first);
+        strideRows_ = chunkRows_;
+        hsize_t sampleCount = (itemCount + strideRows_ - 1) / strideRows_;
+        while (sampleCount * sizeof(Entry) > maximumBytes && 1 < sampleCount)
+        {
+            strideRows_ *= 2;
+            sampleCount = (itemCount + strideRows_ - 1) / strideRows_;
+        }
+        if (0 < sampleCount)
+        {
+            std::vector<long long> ticks(static_cast<size_t>(sampleCount));
+            if (!readTicks<T>(columns, 0, strideRows_, sampleCount, ticks.data()))
+                return false;
+            entries_.reserve(static_cast<size_t>(sampleCount));
+            for (hsize_t i = 0; i < sampleCount; ++i)
+                entries_.push_back({ i * strideRows_, ticks[static_cast<size_t>(i)] });
+        }
+        itemCount_ = itemCount;
+        built_ = true;
+        return true;
     }
 
-    void GroupInfo::enumerateDatasets(const DataInfoEnumerator& enumerate) const
-    {
-        const DataInfo** ptr{ datasets_.data() };
-        const size_t size = datasets_.size();
-        for (size_t i = 0; i != size; ++i)
-            enumerate(*ptr[i]);
+    void TickIndex::seed(const std::vector<DataZone>& zones, const hsize_t chunkRows, const hsize_t maximumBytes)
+    {
+        if (zones.empty() || sizeof(Entry) * 2 > maximumBytes)
+            return;
+        hsize_t itemCount{ 0 };
+        for (const auto& zone : zones)
+            itemCount += zone.count_;
+        if (built_ && itemCount_ == itemCount)
+            return;
+        reset();
+        chunkRows_ = chunkRows;
+        strideRows_ = chunkRows;
+        entries_.reserve(zones.size());
+        hsize_t row{ 0 };
+        for (const auto& zone : zones)
+        {
+            entries_.push_back({ row, zone.firstTicks_ });
+            row += zone.count_;
+        }
+        fit(maximumBytes);
+        itemCount_ = itemCount;
+        built_ = true;
     }
 
-    void GroupInfo::enumerateGroups(const GroupInfoEnumerator& enumerate) const
+    void TickIndex::fit(const hsize_t maximumBytes)
     {
-        const GroupInfo** ptr{ groups_.data() };
-        const size_t size = groups_.size();
-        for (size_t i = 0; i != size; ++i)
-            enumerate(ptr[i]);
+        // Thin out every other sample until the index fits into the budget.
+        while (entries_.size() * sizeof(Entry) > maximumBytes && 1 < entries_.size())
+        {
+            size_t j = 0;
+            for (size_t i = 0; i < entries_.size(); i += 2)
+                entries_[j++] = entries_[i];
+            entries_.resize(j);
+            strideRows_ *= 2;
+        }
     }
 
-    bool GroupInfo::iterateGroup(const hid_t groupOrFileId, const char* groupName, GroupInfo* parentGroupInfo)
+    template <typename T> bool TickIndex::lowerNeighborIndex(const DatasetColumns& columns, const hsize_t itemCount, const hsize_t maximumBytes, const long long targetTicks, hsize_t& index, bool& match)
     {
-        const hid_t id = H5Gopen2(groupOrFileId, groupName, H5P_DEFAULT);
-        if (0 > id)
-            return traceGroupOpenError(groupName);
-
-        H5G_info_t g_info;
-        herr_t status = H5Gget_info(id, &g_info);
-        if (0 > status)
+        if (sizeof(Entry) * 2 > maximumBytes)
         {
-            traceGroupInfoError(groupName);
-            return closeGroup(id);
+            if (built_)
+                reset();
+            return h5::lowerNeighborIndex<T>(columns, itemCount, targetTicks, index, match);
+        }
+        match = false;
+        index = 0;
+        if (0 == itemCount)
+            return true;
+        if (!built_ || itemCount_ != itemCount)
+        {
+            if (!build<T>(columns, itemCount, maximumBytes))
+            {
+                reset();
+                return h5::lowerNeighborIndex<T>(columns, itemCount, targetTicks, index, match);
+            }
         }
+        else
+            fit(maximumBytes);
+
+        // The bracket [low, high) contains the lower neighbor, the ticks of the low row are known unless it is the first row.
+        const auto upper = std::upper_bound(entries_.begin(), entries_.end(), targetTicks,
+            [](const long long ticks, const Entry& entry) { return ticks < entry.ticks_; });
+        hsize_t low = 0, high = itemCount;
+        long long lowTicks{ 0L };
+        bool lowKnown = false;
+        if (upper != entries_.begin())
+        {
+            low = (upper - 1)->row_;
+            lowTicks = (upper - 1)->ticks_;
+            lowKnown = true;
+        }
+        if (upper != entries_.end())
+            high = upper->row_;
 
-        const hsize_t numberOfLinks = g_info.nlinks;
-        const int maxObjectNameLength = 1024;
-        char name[maxObjectNameLength];
-        H5O_info_t o_info;
-        for (hsize_t index = 0; index < numberOfLinks; ++index)
+        // Narrow the bracket down to a slice by probing, all probes but the first one hit the chunk cache.
+        // This also handles the brackets widened by the inserted items.
+        long long ticks;
+        while (high - low > sliceRows)
         {
-            status = herr_t(H5Lget_name_by_idx(id, ".", H5_INDEX_NAME, H5_ITER_NATIVE, index, &name[0], maxObjectNameLength, H5P_DEFAULT));
-            if (0 > status)
+            const hsize_t middle = low + (high - low) / 2;
+            if (!readTicks<T>(columns, middle, 1, 1, &ticks))
+                return false;
+            if (targetTicks < ticks)
+                high = middle;
+            else
             {
-                traceGroupByIndexNameError(index, groupName);
-                return closeGroup(id);
+                low = middle;
+                lowTicks = ticks;
+                lowKnown = true;
+                if (targetTicks == ticks)
+                {
+                    index = middle;
+                    match = true;
+                    return true;
+                }
+            }
+        }
+        if (high == low)
+            return true; // The target precedes the first row.
+        bool stale;
+        if (sliceOffset_ == low && sliceTicks_.size() == high - low)
+        {
+            // The same slice as the last time, verify its end rows only.
+            long long ends[2];
+            const hsize_t last = high - low - 1;
+            if (!readTicks<T>(columns, low, 0 < last ? last : 1, 0 < last ? 2 : 1, ends))
+                return false;
+            stale = sliceTicks_.front() != ends[0] || (0 < last && sliceTicks_.back() != ends[1]);
+        }
+        else
+        {
+            sliceTicks_.resize(static_cast<size_t>(high - low));
+            if (!readTicks<T>(columns, low, 1, high - low, sliceTicks_.data()))
+            {
+                sliceTicks_.clear();
+                return false;
             }
+            sliceOffset_ = low;
+            stale = lowKnown && lowTicks != sliceTicks_.front();
+        }
+        if (stale)
+        {
+            // The dataset has been modified bypassing this index.
+            reset();
+            return h5::lowerNeighborIndex<T>(columns, itemCount, targetTicks, index, match);
+        }
+        const auto neighbor = std::upper_bound(sliceTicks_.begin(), sliceTicks_.end(), targetTicks);
+        if (neighbor == sliceTicks_.begin())
+            return true;
+        index = low + static_cast<hsize_t>(neighbor - sliceTicks_.begin() - 1);
+        match = *(neighbor - 1) == targetTicks;
+        return true;
+    }
 
-            status = H5Oget_info_by_idx(id, ".", H5_INDEX_NAME, H5_ITER_NATIVE, index, &o_info, H5P_DEFAULT);
-            if (0 > status)
+    template <typename T> void TickIndex::appended(const T* input, const hsize_t inputCount, const hsize_t maximumBytes)
+    {
+        if (!built_)
+            return;
+        hsize_t row = entries_.empty() ? 0 : entries_.back().row_ + strideRows_;
+        if (row < itemCount_)
+            row = itemCount_;
+        sliceTicks_.clear();
+        for (const hsize_t rowLimit = itemCount_ + inputCount; row < rowLimit; row += strideRows_)
+            entries_.push_back({ row, (input + (row - itemCount_))->ticks_ });
+        itemCount_ += inputCount;
+        fit(maximumBytes);
+    }
+
+    void TickIndex::inserted(const hsize_t offset, const hsize_t itemCount)
+    {
+        if (!built_)
+            return;
+        sliceTicks_.clear();
+        auto it = std::lower_bound(entries_.begin(), entries_.end(), offset,
+            [](const Entry& entry, const hsize_t row) { return entry.row_ < row; });
+        for (; it != entries_.end(); ++it)
+            it->row_ += itemCount;
+        itemCount_ += itemCount;
+    }
+
+    void TickIndex::deleted(const hsize_t offset, hsize_t itemCount)
+    {
+        if (!built_ || offset >= itemCount_)
+            return;
+        sliceTicks_.clear();
+        if (itemCount > itemCount_ - offset)
+            itemCount = itemCount_ - offset;
+        const hsize_t offsetEnd = offset + itemCount;
+        const auto first = std::lower_bound(entries_.begin(), entries_.end(), offset,
+            [](const Entry& entry, const hsize_t row) { return entry.row_ < row; });
+        auto last = std::lower_bound(first, entries_.end(), offsetEnd,
+            [](const Entry& entry, const hsize_t row) { return entry.row_ < row; });
+        for (auto it = last; it != entries_.end(); ++it)
+            it->row_ -= itemCount;
+        entries_.erase(first, last);
+        itemCount_ -= itemCount;
+    }
+
+    void TickIndex::rewrite(const hsize_t offset, const hsize_t itemCount, const hsize_t maximumBytes)
+    {
+        if (!built_)
+            return;
+        sliceTicks_.clear();
+        entries_.erase(std::lower_bound(entries_.begin(), entries_.end(), offset,
+            [](const Entry& entry, const hsize_t row) { return entry.row_ < row; }), entries_.end());
+
+        // The rows are sampled as the appended ones, their ticks are filled in as they are written.
+        hsize_t row = entries_.empty() ? 0 : entries_.back().row_ + strideRows_;
+        if (row < offset)
+            row = offset;
+        for (; row < itemCount; row += strideRows_)
+            entries_.push_back({ row, 0 });
+        itemCount_ = itemCount;
+        fit(maximumBytes);
+    }
+
+    template <typename T> void TickIndex::rewritten(const hsize_t offset, const T* input, const hsize_t inputCount)
+    {
+        if (!built_)
+            return;
+        const hsize_t offsetEnd = offset + inputCount;
+        for (auto it = std::lower_bound(entries_.begin(), entries_.end(), offset,
+            [](const Entry& entry, const hsize_t row) { return entry.row_ < row; }); it != entries_.end() && it->row_ < offsetEnd; ++it)
+            it->ticks_ = (input + (it->row_ - offset))->ticks_;
+    }
+
+    // Merges the sorted input into the sorted stored window starting at the window start, resolving the duplicate time ticks.
+    template <typename T> static bool mergeSorted(const T* inputBuffer, const T* input, const hsize_t inputCount, const T* window, const hsize_t windowStart, const hsize_t windowCount, const DuplicateTimeTicks duplicateTimeTicks, const bool verbose,
+        std::vector<T>& merged, hsize_t& insertedCount, hsize_t& updatedLast, bool& updated)
+    {
+        merged.reserve(static_cast<size_t>(windowCount + inputCount));
+        const T* data = window;
+        const T* const dataStop = data + windowCount;
+        const T* const inputStop = input + inputCount;
+        insertedCount = 0;
+        updatedLast = 0;
+        updated = false;
+        while (input < inputStop && data < dataStop)
+        {
+            if (input->ticks_ < data->ticks_)
             {
-                traceGroupByIndexObjectInfoError(index, groupName);
-                return closeGroup(id);
+                merged.push_back(*input++);
+                ++insertedCount;
+            }
+            else if (input->ticks_ > data->ticks_)
+                merged.push_back(*data++);
+            else
+            {
+                const hsize_t index = windowStart + static_cast<hsize_t>(merged.size());
+                const hsize_t inputIndex = static_cast<hsize_t>(input - inputBuffer);
+                if (input->isDifferent(*data))
+                {
+                    if (DuplicateTimeTicks::Update == duplicateTimeTicks)
+                    {
+                        if (verbose)
+                            traceDataDuplicateTicksUpdateInfo<T>(index, *data, inputIndex, *input);
+                        updatedLast = static_cast<hsize_t>(merged.size());
+                        updated = true;
+                        merged.push_back(*input);
+                    }
+                    else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
+                    {
+                        traceDataDuplicateTicksSkipError<T>(index, *data, inputIndex, *input);
+                        merged.push_back(*data);
+                    }
+                    else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
+                        return traceDataDuplicateTicksFailError<T>(index, *data, inputIndex, *input);
+                }
+                else
+                    merged.push_back(*data);
+                ++input;
+                ++data;
             }
+        }
+        insertedCount += static_cast<hsize_t>(inputStop - input);
+        merged.insert(merged.end(), input, inputStop);
+        merged.insert(merged.end(), data, dataStop);
+        return true;
+    }
 
-            switch (o_info.type)
+    // Walks the sorted input along the stored items from the window start page by page, resolving the duplicate time ticks
+    // before anything is written. Gets the number of the input items to insert and, if some stored items are updated,
+    // the row after the last updated one together with the number of the input items up to it.
+    template <typename T> static bool scanMerge(const DatasetColumns& columns, const T* inputBuffer, const T* input, const hsize_t inputCount, const hsize_t windowStart, const hsize_t dataCount, const hsize_t pageRows,
+        const DuplicateTimeTicks duplicateTimeTicks, const bool verbose, hsize_t& insertedCount, hsize_t& updatedEnd, hsize_t& updatedInputCount)
+    {
+        const T* const inputFirst = input;
+        const T* const inputStop = input + inputCount;
+        std::vector<T> page(static_cast<size_t>(std::min(pageRows, dataCount - windowStart)));
+        hsize_t mergedCount{ 0 };
+        insertedCount = 0;
+        updatedEnd = 0;
+        updatedInputCount = 0;
+        for (hsize_t pageStart = windowStart, pageCount; pageStart < dataCount && input < inputStop; pageStart += pageCount)
+        {
+            pageCount = std::min(pageRows, dataCount - pageStart);
+            if (!readItemRange(columns, pageStart, pageCount, static_cast<void*>(page.data())))
+                return false;
+            const T* data = page.data();
+            const T* const dataStop = data + pageCount;
+            while (input < inputStop && data < dataStop)
             {
-                case H5O_TYPE_GROUP:
+                if (input->ticks_ < data->ticks_)
                 {
-                    const auto ptr = new GroupInfo(name, parentGroupInfo);
-                    parentGroupInfo->groups_.append(ptr);
-                    if (!iterateGroup(id, name, ptr))
-                        return closeGroup(id);
-                    break;
+                    ++input;
+                    ++insertedCount;
                 }
-                case H5O_TYPE_DATASET:
+                else if (input->ticks_ > data->ticks_)
+                    ++data;
+                else
                 {
-                    const auto ptr = new DataInfo(name, parentGroupInfo);
-                    parentGroupInfo->datasets_.append(ptr);
-                    break;
+                    const hsize_t index = windowStart + mergedCount;
+                    const hsize_t inputIndex = static_cast<hsize_t>(input - inputBuffer);
+                    if (input->isDifferent(*data))
+                    {
+                        if (DuplicateTimeTicks::Update == duplicateTimeTicks)
+                        {
+                            if (verbose)
+                                traceDataDuplicateTicksUpdateInfo<T>(index, *data, inputIndex, *input);
+                            updatedEnd = index + 1;
+                            updatedInputCount = static_cast<hsize_t>(input - inputFirst) + 1;
+                        }
+                        else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
+                            traceDataDuplicateTicksSkipError<T>(index, *data, inputIndex, *input);
+                        else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
+                            return traceDataDuplicateTicksFailError<T>(index, *data, inputIndex, *input);
+                    }
+                    ++input;
+                    ++data;
                 }
-                case H5O_TYPE_NAMED_DATATYPE:
-                case H5O_TYPE_NTYPES:
-                case H5O_TYPE_UNKNOWN:
-                default: break;
+                ++mergedCount;
             }
         }
-        if (0 > H5Gclose(id))
-            return traceGroupCloseError(groupName);
+        insertedCount += static_cast<hsize_t>(inputStop - input);
         return true;
     }
 
-    void GroupInfo::moveDatasetsTo(DataInfoList* datasets)
+    // Merges the sorted input into the stored items from the window start to the data end, walking both from their ends
+    // in chunk-aligned pages. A merged item never lands before the stored items not read yet, so the rows are rewritten in place.
+    template <typename T> static bool mergeBackward(const DatasetColumns& columns, TickIndex* tickIndex, const T* input, const hsize_t inputCount, const hsize_t windowStart, const hsize_t dataEnd, const hsize_t mergedEnd,
+        const hsize_t pageRows, const hsize_t chunkRows, const DuplicateTimeTicks duplicateTimeTicks)
     {
-        size_t size = datasets_.size();
-        if (size > 0)
+        // The page ending at the row starts at a chunk boundary of the dataset, past the head, and holds at most the page rows.
+        const hsize_t head = columns.head_;
+        const auto pageStart = [pageRows, chunkRows, head](const hsize_t end)
         {
-            const DataInfo** ptr{ datasets_.data() };
-            for (size_t i = 0; i != size; ++i)
+            const hsize_t start = end + head > pageRows ? (end + head - pageRows + chunkRows - 1) / chunkRows * chunkRows : 0;
+            return start > head ? start - head : 0;
+        };
+        std::vector<T> page(static_cast<size_t>(std::min(pageRows, dataEnd - windowStart)));
+        std::vector<T> merged(static_cast<size_t>(std::min(pageRows, mergedEnd - windowStart)));
+        const T* inputStop = input + inputCount;
+        hsize_t dataStart = dataEnd, dataLeft = 0;
+        hsize_t row = mergedEnd, flushEnd = mergedEnd, flushStart = std::max(windowStart, pageStart(mergedEnd));
+        for (;;)
+        {
+            if (0 == dataLeft && dataStart > windowStart)
             {
-                datasets->append(ptr[i]);
-                ptr[i] = nullptr;
+                const hsize_t readStart = std::max(windowStart, pageStart(dataStart));
+                dataLeft = dataStart - readStart;
+                if (!readItemRange(columns, readStart, dataLeft, static_cast<void*>(page.data())))
+                    return false;
+                dataStart = readStart;
+            }
+            if (0 == dataLeft && input == inputStop)
+                break;
+            const T* item;
+            if (0 == dataLeft)
+                item = --inputStop;
+            else
+            {
+                const T& data = page[static_cast<size_t>(dataLeft - 1)];
+                if (input == inputStop || (inputStop - 1)->ticks_ < data.ticks_)
+                {
+                    item = &data;
+                    --dataLeft;
+                }
+                else if ((inputStop - 1)->ticks_ > data.ticks_)
+                    item = --inputStop;
+                else
+                {
+                    // The duplicates are resolved by the scan, an update takes the input item.
+                    item = DuplicateTimeTicks::Update == duplicateTimeTicks ? inputStop - 1 : &data;
+                    --inputStop;
+                    --dataLeft;
+                }
+            }
+            merged[static_cast<size_t>(--row - flushStart)] = *item;
+            if (row == flushStart)
+            {
+                if (!writeItemRange(columns, flushStart, flushEnd - flushStart, static_cast<const void*>(merged.data())))
+                    return false;
+                if (nullptr != tickIndex)
+                    tickIndex->rewritten(flushStart, merged.data(), flushEnd - flushStart);
+                flushEnd = flushStart;
+                flushStart = std::max(windowStart, pageStart(flushEnd));
             }
-            datasets_.size_ = 0;
         }
-
-        size = groups_.size();
-        if (size > 0)
+        if (row < flushEnd)
         {
-            GroupInfo** ptr{ const_cast<GroupInfo * *>(groups_.data()) };
-            for (size_t i = 0; i != size; ++i)
-                ptr[i]->moveDatasetsTo(datasets);
+            if (!writeItemRange(columns, row, flushEnd - row, static_cast<const void*>(merged.data() + (row - flushStart))))
+                return false;
+            if (nullptr != tickIndex)
+                tickIndex->rewritten(row, merged.data() + (row - flushStart), flushEnd - row);
         }
+        return true;
     }
 
-    void GroupInfo::enumerateDatasetsRecursive(const DataInfoEnumerator& enumerate) const
+    template <typename T> static bool mergeItems(TickIndex& tickIndex, const hsize_t maximumTickIndexBytes, const hsize_t maximumBufferBytes, const DatasetColumns& columns, const hsize_t inputStart, const hsize_t inputCount, const T* inputBuffer, const DuplicateTimeTicks duplicateTimeTicks, const bool verbose)
     {
-        size_t size = datasets_.size();
-        if (size > 0)
+        if (0 == inputCount)
+            return true;
+        const T* input = inputBuffer + inputStart;
+        hsize_t dataCount;
+        if (!countItems(columns, dataCount))
+            return false;
+
+        // The merge window starts at the first stored item not preceding the input and spans the rest of the dataset,
+        // since every stored item after an inserted one moves.
+        hsize_t windowStart;
+        bool match;
+        if (!tickIndex.lowerNeighborIndex<T>(columns, dataCount, maximumTickIndexBytes, input->ticks_, windowStart, match))
+            return false;
+        if (!match && windowStart < dataCount)
         {
-            const DataInfo** ptr{ datasets_.data() };
-            for (size_t i = 0; i != size; ++i)
-                enumerate(*ptr[i]);
+            T dataValue{};
+            if (!readItem(columns, windowStart, static_cast<void*>(&dataValue)))
+                return false;
+            if (dataValue.ticks_ < input->ticks_)
+                ++windowStart;
         }
 
-        size = groups_.size();
-        if (size > 0)
+        // The window is read and written in pages of whole chunks fitting into the read buffer, but at least one.
+        const hsize_t chunkRows = datasetChunkRows(columns.front().first);
+        hsize_t pageRows = chunkRows;
+        if (maximumBufferBytes > chunkRows * sizeof(T))
+            pageRows = chunkRows * (maximumBufferBytes / (chunkRows * sizeof(T)));
+
+        // Resolve the duplicates first, so that a failing merge writes nothing.
+        hsize_t insertedCount, updatedEnd, updatedInputCount;
+        if (!scanMerge(columns, inputBuffer, input, inputCount, windowStart, dataCount, pageRows, duplicateTimeTicks, verbose, insertedCount, updatedEnd, updatedInputCount))
+            return false;
+
+        if (0 == insertedCount)
         {
-            GroupInfo** ptr{ const_cast<GroupInfo * *>(groups_.data()) };
-            for (size_t i = 0; i != size; ++i)
-                ptr[i]->enumerateDatasetsRecursive(enumerate);
+            // Nothing has moved, rewrite the items up to the last updated one only.
+            if (0 < updatedEnd)
+                return mergeBackward(columns, nullptr, input, updatedInputCount, windowStart, updatedEnd, updatedEnd, pageRows, chunkRows, duplicateTimeTicks);
+            return true;
+        }
+
+        // Extend the dataset once and merge from its end backwards.
+        if (!setExtent(columns, dataCount + insertedCount))
+            return false;
+        tickIndex.rewrite(windowStart, dataCount + insertedCount, maximumTickIndexBytes);
+        if (!mergeBackward(columns, &tickIndex, input, inputCount, windowStart, dataCount, dataCount + insertedCount, pageRows, chunkRows, duplicateTimeTicks))
+        {
+            tickIndex.reset();
+            return false;
         }
+        return true;
     }
 
-    int GroupInfo::compare(const void* first, const void* second) noexcept
+    static bool closeGroup(hid_t id)
     {
-        // ReSharper disable CppCStyleCast
-        const auto p1 = *(const GroupInfo**)first;
-        const auto p2 = *(const GroupInfo**)second;
-        // ReSharper restore CppCStyleCast
-
-        return strcmp(p1->name(), p2->name());
+        H5Gclose(id);
+        return false;
     }
-
-    void GroupInfo::sort() const
+	
+    static bool isEmptyGroup(const hid_t fileId, const char* groupPath)
     {
-        size_t size{ datasets_.size() };
-        if (size > 1)
-            std::qsort(static_cast<void*>(datasets_.data()), size, sizeof(DataInfo*), DataInfo::compare);
-        size = groups_.size();
-        if (size > 0)
+        const hid_t group_id = H5Gopen2(fileId, groupPath, H5P_DEFAULT);
+        if (0 > group_id)
+            return traceGroupOpenError(groupPath);
+        H5G_info_t g_info;
+        const herr_t status = H5Gget_info(group_id, &g_info);
+        if (0 > status)
         {
-            const GroupInfo** ptr{ groups_.data() };
-            if (size > 1)
-                std::qsort(static_cast<void*>(ptr), size, sizeof(GroupInfo*), GroupInfo::compare);
-
-            for (size_t i = 0; i != size; ++i)
-                ptr[i]->sort();
+            traceGroupInfoError(groupPath);
+            return closeGroup(group_id);
         }
+        if (0 > H5Gclose(group_id))
+            return traceGroupCloseError(groupPath);
+        return g_info.nlinks == 0;
     }
 
-    static std::mutex theMutex;
-
     // ----------------------------------------------------------------------
-    // File
+    // Zone maps
     // ----------------------------------------------------------------------
 
-    std::shared_ptr<GroupInfo> File::contentTree(const bool sort) const
+    // The zone maps of a data are stored in a dataset next to it, named after the data with the zones suffix.
+    static bool isZonesName(const char* name)
     {
-        GroupInfo* root{ new GroupInfo() };
-        {
-            std::lock_guard<std::mutex> lock(theMutex);
-            if (!root->iterateGroup(fileId_, ".", root))
-                traceFileIterateError(filePath_);
-        }
-        if (sort)
-            root->sort();
-        return std::shared_ptr<GroupInfo>(root);
+        const size_t length = strlen(name), suffixLength = strlen(zonesNameSuffix);
+        return length > suffixLength && 0 == strcmp(name + length - suffixLength, zonesNameSuffix);
     }
 
-    std::shared_ptr<GroupInfo> File::contentTree(const char* filePath, const FileDriver fileDriver, const bool sort)
+    // Maps the segments of the data in the segmented layout under a moved group from their new paths,
+    // since a virtual dataset refers to its segments by their absolute paths.
+    static void segmentsReroot(const hid_t fileId, const std::string& groupPath)
     {
-        GroupInfo* root{ new GroupInfo() };
+        const hid_t groupId = H5Gopen2(fileId, groupPath.c_str(), H5P_DEFAULT);
+        if (0 > groupId)
+            return;
+        std::vector<std::string> names;
+        H5Lvisit(groupId, H5_INDEX_NAME, H5_ITER_NATIVE, [](hid_t, const char* name, const H5L_info_t*, void* data) -> herr_t
         {
-            std::lock_guard<std::mutex> lock(theMutex);
-            const hid_t fileId{ fileOpen(filePath, false, false, fileDriver, false) };
-            if (0 <= fileId)
+            if (!isSegmentName(name) && !isZonesName(name))
+                static_cast<std::vector<std::string>*>(data)->emplace_back(name);
+            return 0;
+        }, &names);
+        for (const auto& name : names)
+        {
+            H5O_info_t o_info;
+            if (0 > H5Oget_info_by_name(groupId, name.c_str(), &o_info, H5P_DEFAULT) || H5O_TYPE_DATASET != o_info.type)
+                continue;
+            const hid_t datasetId = H5Dopen2(groupId, name.c_str(), H5P_DEFAULT);
+            if (0 > datasetId)
+                continue;
+            const hid_t typeId = H5Dget_type(datasetId);
+            std::vector<DataSegment> segments;
+            const bool mapped = 0 <= typeId && segmentsRead(datasetId, segments);
+            H5Dclose(datasetId);
+            if (mapped)
             {
-                if (!root->iterateGroup(fileId, ".", root))
-                    traceFileIterateError(filePath);
-                if (0 > H5Fclose(fileId))
-                    traceFileCloseError(filePath);
+                const std::string datasetPath = groupPath + "/" + name;
+                const std::string parentPath = datasetPath.substr(0, datasetPath.find_last_of('/') + 1);
+                bool moved{ false };
+                for (auto& segment : segments)
+                {
+                    const std::string segmentPath = parentPath + segment.datasetPath_.substr(segment.datasetPath_.find_last_of('/') + 1);
+                    moved = moved || segmentPath != segment.datasetPath_;
+                    segment.datasetPath_ = segmentPath;
+                }
+                const hid_t lastId = H5Dopen2(fileId, segments.back().datasetPath_.c_str(), H5P_DEFAULT);
+                hsize_t rows{ 0 };
+                if (0 <= lastId && countItems(lastId, rows) && rows > segments.back().rowOffset_)
+                    segments.back().count_ = rows - segments.back().rowOffset_;
+                if (0 <= lastId)
+                    H5Dclose(lastId);
+                const hid_t remappedId = moved ? segmentsCreate(fileId, datasetPath.c_str(), typeId, segments) : -1;
+                if (0 <= remappedId)
+                    H5Dclose(remappedId);
             }
-            else
-                traceFileOpenReadOnlyError(filePath);
+            if (0 <= typeId)
+                H5Tclose(typeId);
         }
-        if (sort)
-            root->sort();
-        return std::shared_ptr<GroupInfo>(root);
+        H5Gclose(groupId);
     }
 
-    bool File::enumerateDatasets(const DataInfoEnumerator& enumerate, bool sort) const
+    // Deletes the segment datasets of the data in the segmented layout about to be deleted.
+    static void segmentsDelete(const hid_t fileId, const char* objectPath)
     {
-        GroupInfo root{};
+        // Save old error handler.
+        herr_t(*oldFunc)(hid_t, void*);
+        void* oldClientData;
+        H5Eget_auto2(H5E_DEFAULT, &oldFunc, &oldClientData);
+
+        // Turn off error handling.
+        H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr);
+
+        const hid_t datasetId = H5Dopen2(fileId, objectPath, H5P_DEFAULT);
+
+        // Restore previous error handler.
+        H5Eset_auto2(H5E_DEFAULT, oldFunc, oldClientData);
+
+        if (0 > datasetId)
+            return;
+        std::vector<DataSegment> segments;
+        const bool mapped = segmentsRead(datasetId, segments);
+        H5Dclose(datasetId);
+        if (!mapped)
+            return;
+        std::vector<std::string> paths;
+        for (const auto& segment : segments)
+            if (paths.end() == std::find(paths.begin(), paths.end(), segment.datasetPath_))
+                paths.push_back(segment.datasetPath_);
+        for (const auto& path : paths)
+            H5Ldelete(fileId, path.c_str(), H5P_DEFAULT);
+    }
+
+    static hid_t zonesOpen(const hid_t datasetId, const std::string& zonesPath, const hid_t dapl_id)
+    {
+        const hid_t fileId = H5Iget_file_id(datasetId);
+        if (0 > fileId)
+            return -1;
+
+        // Save old error handler.
+        herr_t(*oldFunc)(hid_t, void*);
+        void* oldClientData;
+        H5Eget_auto2(H5E_DEFAULT, &oldFunc, &oldClientData);
+
+        // Turn off error handling.
+        H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr);
+
+        const hid_t zonesId = H5Dopen2(fileId, zonesPath.c_str(), dapl_id);
+
+        // Restore previous error handler.
+        H5Eset_auto2(H5E_DEFAULT, oldFunc, oldClientData);
+
+        H5Fclose(fileId);
+        return zonesId;
+    }
+
+    // Adds the packed little-endian items of the ticks followed by the 64-bit doubles to the zone map of the chunk holding them.
+    static void zoneAdd(DataZone& zone, const unsigned char* items, const hsize_t itemCount, const size_t itemSize)
+    {
+        const size_t fields = std::min<size_t>(itemSize / 8 - 1, DataZone::maximumFields);
+        for (hsize_t i = 0; i < itemCount; ++i, items += itemSize)
         {
-            std::lock_guard<std::mutex> lock(theMutex);
-            if (!root.iterateGroup(fileId_, ".", &root))
+            long long ticks;
+            std::memcpy(&ticks, items, 8);
+            if (0 == zone.count_)
+                zone.firstTicks_ = ticks;
+            zone.lastTicks_ = ticks;
+            for (size_t k = 0; k < fields; ++k)
             {
-                traceFileIterateError(filePath_);
-                return false;
+                double value;
+                std::memcpy(&value, items + 8 + k * 8, 8);
+                if (0 == zone.count_ || value < zone.minimum_[k])
+                    zone.minimum_[k] = value;
+                if (0 == zone.count_ || value > zone.maximum_[k])
+                    zone.maximum_[k] = value;
+                zone.sum_[k] += value;
             }
+            ++zone.count_;
         }
-        if (sort)
+    }
+
+    // Merges the zone map of the items following the ones of a zone into it.
+    static void zoneMerge(DataZone& zone, const DataZone& next)
+    {
+        if (0 == zone.count_)
         {
-            DataInfoList* list{ new DataInfoList() };
-            root.moveDatasetsTo(list);
-            const size_t size{ list->size() };
-            const DataInfo** const data = list->data();
-            if (size > 1)
-                std::qsort(static_cast<void*>(data), size, sizeof(DataInfo*), DataInfo::compare);
-            for (size_t i = 0; i < size; ++i)
-                enumerate(*data[i]);
-            delete list;
+            zone = next;
+            return;
         }
-        else
+        if (0 == next.count_)
+            return;
+        zone.lastTicks_ = next.lastTicks_;
+        for (unsigned k = 0; k < DataZone::maximumFields; ++k)
         {
-            root.enumerateDatasetsRecursive(enumerate);
+            zone.minimum_[k] = std::min(zone.minimum_[k], next.minimum_[k]);
+            zone.maximum_[k] = std::max(zone.maximum_[k], next.maximum_[k]);
+            zone.sum_[k] += next.sum_[k];
         }
-        return true;
+        zone.count_ += next.count_;
     }
 
-    bool File::enumerateDatasets(const DataInfoEnumerator& enumerate, const char* instrumentPath, const bool sort) const
+    // Returns the index of the first item of every zone followed by the number of the items in all zones.
+    static std::vector<hsize_t> zoneStarts(const std::vector<DataZone>& zones)
     {
-        GroupInfo root{};
-        {
-            std::lock_guard<std::mutex> lock(theMutex);
-            if (!root.iterateGroup(fileId_, instrumentPath, &root))
-            {
-                traceFileIterateError(filePath_);
-                return false;
-            }
-        }
-        if (sort)
-            root.sort();
-        root.enumerateDatasets(enumerate);
-        return true;
+        std::vector<hsize_t> starts(zones.size() + 1, 0);
+        for (size_t z = 0; z < zones.size(); ++z)
+            starts[z + 1] = starts[z] + zones[z].count_;
+        return starts;
     }
 
-    bool File::enumerateDatasets(const DataInfoEnumerator& enumerate, const char* filePath, FileDriver fileDriver, bool sort)
+    // Returns the index of the zone holding an item, or the number of the zones if none does.
+    static size_t zoneOf(const std::vector<hsize_t>& starts, const hsize_t item)
     {
-        const std::shared_ptr<File> f = openReadOnly(filePath, fileDriver);
-        if (!f.operator bool())
-            return false;
-        return f->enumerateDatasets(enumerate, sort);
+        return static_cast<size_t>(std::upper_bound(starts.begin(), starts.end(), item) - starts.begin()) - 1;
     }
 
-    bool File::enumerateDatasets(const DataInfoEnumerator& enumerate, const char* filePath, FileDriver fileDriver, const char* instrumentPath, bool sort)
+    // Appends the zone maps of a range of the stored items, reading them a chunk at a time.
+    static bool zonesRead(const DatasetColumns& columns, const size_t itemSize, const hsize_t chunkRows, const hsize_t itemOffset, const hsize_t itemCount,
+        std::vector<DataZone>& zones)
     {
-        const std::shared_ptr<File> f = openReadOnly(filePath, fileDriver);
-        if (!f.operator bool())
-            return false;
-        return f->enumerateDatasets(enumerate, instrumentPath, sort);
+        std::vector<unsigned char> buffer(static_cast<size_t>(std::min(chunkRows, itemCount)) * itemSize);
+        const hsize_t itemEnd = itemOffset + itemCount;
+        for (hsize_t item = itemOffset; item < itemEnd; item += chunkRows)
+        {
+            const hsize_t count = std::min(chunkRows, itemEnd - item);
+            if (!readItemRange(columns, item, count, buffer.data()))
+                return false;
+            zones.emplace_back();
+            zoneAdd(zones.back(), buffer.data(), count, itemSize);
+        }
+        return true;
     }
 
-    static herr_t traceCallback(const unsigned number, const H5E_error2_t* errorDescription, void* clientData)
+    // ----------------------------------------------------------------------
+    // Aggregation
+    // ----------------------------------------------------------------------
+
+    // Creates a memory type holding a single 8-byte member of the native type, so that the library converts only this field.
+    static hid_t fieldType(const hid_t nativeTypeId, const int member)
     {
-        // ReSharper disable once CppCStyleCast
-        const auto log = (ErrorLogger)clientData;
-        if (nullptr != log)
+        char* name = H5Tget_member_name(nativeTypeId, static_cast<unsigned>(member));
+        const hid_t memberType = H5Tget_member_type(nativeTypeId, static_cast<unsigned>(member));
+        hid_t type = H5Tcreate(H5T_COMPOUND, 8);
+        if (nullptr == name || 0 > memberType || 8 != H5Tget_size(memberType) || 0 > type || 0 > H5Tinsert(type, name, 0, memberType))
         {
-            const int bufferSize{ 512 };
-            char buffer[bufferSize];
-            std::string text{ "h5: HDF5 error #" };
-            text.append(stringFromNumber(number, buffer, bufferSize));
-            text.append(": class: ");
-            if (0 > H5Eget_class_name(errorDescription->cls_id, buffer, bufferSize))
-                return herr_t(-1);
-
-            text.append(buffer);
-            text.append(", major: ");
-            if (0 > H5Eget_msg(errorDescription->maj_num, nullptr, buffer, bufferSize))
-                return herr_t(-1);
+            if (0 <= type)
+                H5Tclose(type);
+            type = -1;
+        }
+        if (nullptr != name)
+            H5free_memory(name);
+        if (0 <= memberType)
+            H5Tclose(memberType);
+        return type;
+    }
 
-            text.append(buffer);
-            text.append(", minor: ");
-            if (0 > H5Eget_msg(errorDescription->min_num, nullptr, buffer, bufferSize))
-                return herr_t(-1);
+    // The reduction kernels keep four independent partial results, so that the compiler can vectorize the loops
+    // and the additions of the consecutive values do not wait for each other.
+    static constexpr size_t aggregateLanes{ 4 };
 
-            text.append(buffer);
-            text.append(" (file:");
-            text.append(errorDescription->file_name);
-            text.append(", func:");
-            text.append(errorDescription->func_name);
-            text.append(", line:");
-            text.append(stringFromNumber(errorDescription->line, buffer, bufferSize));
-            text.append(")");
-            log(text.c_str(), true);
+    // Reduces a non-empty column to its minimum, maximum and sum, and combines them with the previous ones.
+    static void reduceColumn(const double* values, const size_t count, const bool combine, double& minimum, double& maximum, double& sum)
+    {
+        double minimums[aggregateLanes], maximums[aggregateLanes], sums[aggregateLanes]{};
+        for (size_t j = 0; j < aggregateLanes; ++j)
+            minimums[j] = maximums[j] = values[0];
+        size_t i = 0;
+        for (; i + aggregateLanes <= count; i += aggregateLanes)
+        {
+            for (size_t j = 0; j < aggregateLanes; ++j)
+            {
+                const double value = values[i + j];
+                minimums[j] = value < minimums[j] ? value : minimums[j];
+                maximums[j] = value > maximums[j] ? value : maximums[j];
+                sums[j] += value;
+            }
         }
-        return herr_t(0);
+        for (; i < count; ++i)
+        {
+            const double value = values[i];
+            minimums[0] = value < minimums[0] ? value : minimums[0];
+            maximums[0] = value > maximums[0] ? value : maximums[0];
+            sums[0] += value;
+        }
+        if (!combine)
+        {
+            minimum = minimums[0];
+            maximum = maximums[0];
+        }
+        for (size_t j = 0; j < aggregateLanes; ++j)
+        {
+            minimum = minimums[j] < minimum ? minimums[j] : minimum;
+            maximum = maximums[j] > maximum ? maximums[j] : maximum;
+        }
+        sum += (sums[0] + sums[1]) + (sums[2] + sums[3]);
     }
 
-    static herr_t autoTrace(const hid_t errorStackId, void* clientData)
+    // Adds the sum of the prices times the volumes and the sum of the volumes of the trades.
+    static void reduceVolumeWeighted(const double* prices, const double* volumes, const size_t count, double& weightedSum, double& volumeSum)
     {
-        return H5Ewalk2(errorStackId, H5E_WALK_UPWARD, traceCallback, clientData);
+        double weightedSums[aggregateLanes]{}, volumeSums[aggregateLanes]{};
+        size_t i = 0;
+        for (; i + aggregateLanes <= count; i += aggregateLanes)
+        {
+            for (size_t j = 0; j < aggregateLanes; ++j)
+            {
+                weightedSums[j] += prices[i + j] * volumes[i + j];
+                volumeSums[j] += volumes[i + j];
+            }
+        }
+        for (; i < count; ++i)
+        {
+            weightedSums[0] += prices[i] * volumes[i];
+            volumeSums[0] += volumes[i];
+        }
+        weightedSum += (weightedSums[0] + weightedSums[1]) + (weightedSums[2] + weightedSums[3]);
+        volumeSum += (volumeSums[0] + volumeSums[1]) + (volumeSums[2] + volumeSums[3]);
     }
 
-    void File::interceptErrorStack(const ErrorLogger errorLogger)
-    {
-        errorLoggerFunc.store(errorLogger);
-        // ReSharper disable CppCStyleCast
-        if (0 > H5Eset_auto(H5E_DEFAULT, autoTrace, (void*)errorLogger))
-            // ReSharper restore CppCStyleCast
-            if (nullptr != errorLogger)
-                errorLogger("h5: Error: H5Eset_auto() failed", true);
-    }
-
-    File::File(const char* filePath, const hid_t fileId, const bool readOnly) :
-        filePath_{ filePath },
-        fileId_{ fileId },
-        readOnly_{ readOnly }
+    // Adds the mid prices and the spreads of the quotes, each weighted by the ticks until the next quote.
+    // The last quote of the column is weighted by the caller when the next quote is known.
+    static void reduceTimeWeighted(const long long* ticks, const double* askPrices, const double* bidPrices, const size_t count,
+        double& midSum, double& spreadSum)
     {
+        double midSums[aggregateLanes]{}, spreadSums[aggregateLanes]{};
+        const size_t weighted = count - 1;
+        size_t i = 0;
+        for (; i + aggregateLanes <= weighted; i += aggregateLanes)
+        {
+            for (size_t j = 0; j < aggregateLanes; ++j)
+            {
+                const double weight = static_cast<double>(ticks[i + j + 1] - ticks[i + j]);
+                midSums[j] += (askPrices[i + j] + bidPrices[i + j]) * weight;
+                spreadSums[j] += (askPrices[i + j] - bidPrices[i + j]) * weight;
+            }
+        }
+        for (; i < weighted; ++i)
+        {
+            const double weight = static_cast<double>(ticks[i + 1] - ticks[i]);
+            midSums[0] += (askPrices[i] + bidPrices[i]) * weight;
+            spreadSums[0] += (askPrices[i] - bidPrices[i]) * weight;
+        }
+        midSum += 0.5 * ((midSums[0] + midSums[1]) + (midSums[2] + midSums[3]));
+        spreadSum += (spreadSums[0] + spreadSums[1]) + (spreadSums[2] + spreadSums[3]);
     }
 
-    File::~File() noexcept
-    {
-    	try
-    	{
-			close();
-		}
-    	catch(...)
-    	{
-    	}
-    }
+    // ----------------------------------------------------------------------
+    // Predicates
+    // ----------------------------------------------------------------------
 
-    void File::close()
+    // Returns the member index of a single field bit.
+    static int fieldMember(unsigned field)
     {
-        std::lock_guard<std::mutex> lock(theMutex);
-        if (0 <= fileId_)
+        int member = 0;
+        while (1U < field)
         {
-            if (!readOnly_)
-                if (0 > H5Fflush(fileId_, H5F_SCOPE_LOCAL))
-                    traceFileFlushError(filePath_);
-            if (0 > H5Fclose(fileId_))
-                traceFileCloseError(filePath_);
-            fileId_ = -1;
+            field >>= 1;
+            ++member;
         }
+        return member;
     }
 
-    void File::flush() const
+    // Checks that every term compares a single field of the item, or the difference of two, but not the ticks.
+    static bool validPredicate(const DataPredicate& predicate, const size_t members)
     {
-        std::lock_guard<std::mutex> lock(theMutex);
-        if (!readOnly_ && 0 <= fileId_)
-            if (0 > H5Fflush(fileId_, H5F_SCOPE_LOCAL))
-                traceFileFlushError(filePath_);
+        for (const PredicateTerm& term : predicate.terms_)
+        {
+            const unsigned field = term.field_, subtracted = term.subtractedField_;
+            if (0 == field || 0 != (field & (field - 1)) || 1 == field || 0 != (field >> members))
+                return false;
+            if (0 != subtracted && (0 != (subtracted & (subtracted - 1)) || 1 == subtracted || 0 != (subtracted >> members)))
+                return false;
+            if (PredicateComparison::Less > term.comparison_ || PredicateComparison::Between < term.comparison_)
+                return false;
+        }
+        return true;
     }
 
-    std::shared_ptr<File> File::openReadOnly(const char* filePath, const FileDriver fileDriver)
+    // Tells whether the zone of a chunk shows that no item in the chunk matches the predicate.
+    // The bounds of a difference of two fields follow from the bounds of the fields, since the rounding is monotonic.
+    static bool zoneExcludes(const DataPredicate& predicate, const DataZone& zone)
     {
-        std::shared_ptr<File> repository(nullptr);
-        const std::string path(filePath);
-        std::lock_guard<std::mutex> lock(theMutex);
-        hid_t fileId = fileOpen(path.c_str(), false, false, fileDriver, false);
-        if (0 > fileId)
-            traceFileOpenReadOnlyError(filePath);
-        else
-            repository = std::make_shared<File>(path.c_str(), fileId, true);
-        return repository;
+        for (const PredicateTerm& term : predicate.terms_)
+        {
+            const int k = fieldMember(term.field_) - 1;
+            double lower = zone.minimum_[k], upper = zone.maximum_[k];
+            if (0 != term.subtractedField_)
+            {
+                const int j = fieldMember(term.subtractedField_) - 1;
+                lower = zone.minimum_[k] - zone.maximum_[j];
+                upper = zone.maximum_[k] - zone.minimum_[j];
+            }
+            bool excludes{ false };
+            switch (term.comparison_)
+            {
+            case PredicateComparison::Less:
+                excludes = lower >= term.value_;
+                break;
+            case PredicateComparison::LessOrEqual:
+                excludes = lower > term.value_;
+                break;
+            case PredicateComparison::Greater:
+                excludes = upper <= term.value_;
+                break;
+            case PredicateComparison::GreaterOrEqual:
+                excludes = upper < term.value_;
+                break;
+            case PredicateComparison::Equal:
+                excludes = term.value_ < lower || term.value_ > upper;
+                break;
+            case PredicateComparison::Between:
+                excludes = upper < term.value_ || lower > term.upperValue_;
+                break;
+            case PredicateComparison::NotEqual:
+                break;
+            }
+            if (excludes)
+                return true;
+        }
+        return false;
     }
 
-    std::shared_ptr<File> File::openReadWrite(const char* filePath, const bool createNonexistent, const FileDriver fileDriver, const bool corkTheCache)
+    // Clears the mask of the values not satisfying the comparison of a term.
+    // The comparison is chosen outside the loops, so that every loop is a branchless one the compiler vectorizes.
+    static void matchTerm(const double* values, const size_t count, const PredicateTerm& term, unsigned char* mask)
     {
-        std::shared_ptr<File> repository(nullptr);
-        const std::string path(filePath);
-        std::lock_guard<std::mutex> lock(theMutex);
-        hid_t fileId = fileOpen(path.c_str(), true, createNonexistent, fileDriver, corkTheCache);
-        if (0 > fileId)
-            traceFileOpenReadWriteError(filePath, createNonexistent);
-        else
-            repository = std::make_shared<File>(path.c_str(), fileId, false);
-        return repository;
+        const double value = term.value_, upperValue = term.upperValue_;
+        switch (term.comparison_)
+        {
+        case PredicateComparison::Less:
+            for (size_t r = 0; r < count; ++r)
+                mask[r] &= static_cast<unsigned char>(values[r] < value);
+            break;
+        case PredicateComparison::LessOrEqual:
+            for (size_t r = 0; r < count; ++r)
+                mask[r] &= static_cast<unsigned char>(values[r] <= value);
+            break;
+        case PredicateComparison::Greater:
+            for (size_t r = 0; r < count; ++r)
+                mask[r] &= static_cast<unsigned char>(values[r] > value);
+            break;
+        case PredicateComparison::GreaterOrEqual:
+            for (size_t r = 0; r < count; ++r)
+                mask[r] &= static_cast<unsigned char>(values[r] >= value);
+            break;
+        case PredicateComparison::Equal:
+            for (size_t r = 0; r < count; ++r)
+                mask[r] &= static_cast<unsigned char>(values[r] == value);
+            break;
+        case PredicateComparison::NotEqual:
+            for (size_t r = 0; r < count; ++r)
+                mask[r] &= static_cast<unsigned char>(values[r] != value);
+            break;
+        case PredicateComparison::Between:
+            for (size_t r = 0; r < count; ++r)
+                mask[r] &= static_cast<unsigned char>(values[r] >= value) & static_cast<unsigned char>(values[r] <= upperValue);
+            break;
+        }
     }
 
-    bool File::deleteObject(const char* objectPath, const bool deleteEmptyParentPath) const
+    // Evaluates a predicate on the items a term at a time and moves the matching items to the front, keeping their order.
+    // The items are evaluated in blocks, so that the values and the mask of a block stay in the cache.
+    // Returns the number of the matching items.
+    template <typename T> static size_t filterItems(T* items, const size_t count, const DataPredicate& predicate)
     {
-        std::lock_guard<std::mutex> lock(theMutex);
-        herr_t err = H5Ldelete(fileId_, objectPath, H5P_DEFAULT);
-        if (err < 0)
-            return traceFailedToDeleteObjectError("an object", objectPath);
-        if (deleteEmptyParentPath)
+        if (predicate.terms_.empty())
+            return count;
+        constexpr size_t blockRows{ 2048 };
+        double values[blockRows];
+        unsigned char mask[blockRows];
+        size_t matched = 0;
+        for (size_t b = 0; b < count; b += blockRows)
         {
-            std::string path{ objectPath };
-            while (true)
+            const size_t rows = std::min(blockRows, count - b);
+            const auto bytes = reinterpret_cast<const unsigned char*>(items + b);
+            std::memset(mask, 1, rows);
+            for (const PredicateTerm& term : predicate.terms_)
             {
-                const std::string::size_type index = path.find_last_of('/');
-                if (std::string::npos != index && index > 0)
+                const unsigned char* field = bytes + static_cast<size_t>(fieldMember(term.field_)) * 8;
+                for (size_t r = 0; r < rows; ++r, field += sizeof(T))
+                    std::memcpy(values + r, field, 8);
+                if (0 != term.subtractedField_)
                 {
-                    path = path.substr(0, index);
-                    const char* groupPath = path.c_str();
-                    if (isEmptyGroup(fileId_, groupPath))
+                    const unsigned char* subtracted = bytes + static_cast<size_t>(fieldMember(term.subtractedField_)) * 8;
+                    for (size_t r = 0; r < rows; ++r, subtracted += sizeof(T))
                     {
-                        err = H5Ldelete(fileId_, groupPath, H5P_DEFAULT);
-                        if (err < 0)
-                        {
-                            traceFailedToDeleteObjectError("an empty group", groupPath);
-                            break;
-                        }
-                        continue;
+                        double value;
+                        std::memcpy(&value, subtracted, 8);
+                        values[r] -= value;
                     }
                 }
-                break;
+                matchTerm(values, rows, term, mask);
+            }
+            for (size_t r = 0; r < rows; ++r)
+            {
+                if (0 != mask[r])
+                {
+                    if (matched != b + r)
+                        items[matched] = items[b + r];
+                    ++matched;
+                }
             }
         }
-        return true;
+        return matched;
     }
 
-    bool File::moveInstrument(const char* instrumentPathOld, const char* instrumentPathNew) const
-    {
-        std::lock_guard<std::mutex> lock(theMutex);
-        // Create group creation property list and set it to allow creation of intermediate groups.
-        const hid_t lcpl_id = H5Pcreate(H5P_LINK_CREATE);
-        H5Pset_create_intermediate_group(lcpl_id, 1);
-        const herr_t status = H5Lmove(fileId_, instrumentPathOld, fileId_, instrumentPathNew, lcpl_id, H5P_DEFAULT);
-        H5Pclose(lcpl_id);
-        if (0 > status)
-            return traceFailedToMoveInstrumentError(instrumentPathOld, instrumentPathNew);
-        return true;
-    }
+    // ----------------------------------------------------------------------
+    // Downsampling
+    // ----------------------------------------------------------------------
 
-    bool File::renameInstrument(const char* instrumentPath, const char* instrumentNewName) const
-    {
-        std::string path{ instrumentPath };
-        const auto index = path.find_last_of('/');
-        if (std::string::npos == index || path.length() <= index)
-            return traceFailedToExtractGroupNameError(instrumentPath);
-        const std::string instrumentOldName = path.substr(index + 1);
-        if (instrumentOldName.length() < 1)
-            return traceFailedToExtractGroupNameError(instrumentPath);
-        if (0 == index)
-            path = "/";
-        else
+    // The value a chart shows for an item.
+    static double chartedValue(const Quote& item) { return 0.5 * (item.askPrice_ + item.bidPrice_); }
+    static double chartedValue(const QuotePriceOnly& item) { return 0.5 * (item.askPrice_ + item.bidPrice_); }
+    static double chartedValue(const Trade& item) { return item.price_; }
+    static double chartedValue(const TradePriceOnly& item) { return item.price_; }
+    static double chartedValue(const Ohlcv& item) { return item.close_; }
+    static double chartedValue(const OhlcvPriceOnly& item) { return item.close_; }
+    static double chartedValue(const Scalar& item) { return item.value_; }
+
+    // The lowest and the highest values an envelope shows for an item.
+    template <typename T> static double lowestValue(const T& item) { return chartedValue(item); }
+    template <typename T> static double highestValue(const T& item) { return chartedValue(item); }
+    static double lowestValue(const Ohlcv& item) { return item.low_; }
+    static double lowestValue(const OhlcvPriceOnly& item) { return item.low_; }
+    static double highestValue(const Ohlcv& item) { return item.high_; }
+    static double highestValue(const OhlcvPriceOnly& item) { return item.high_; }
+
+    //! Chooses the items of a range to chart while the range is passed through it page by page, in a single pass.
+    //! The chosen items are passed to the callback when a page has been processed, and after the last item at the latest.
+    template <typename T> class Downsampler
+    {
+    public:
+        Downsampler(const Collect<T>& collect, const hsize_t itemCount, const hsize_t targetPoints, const DownsamplingMethod method) :
+            collect_(collect), itemCount_(itemCount), targetPoints_(targetPoints), method_(method)
         {
-            path = path.substr(0, index);
-            const auto length = path.length();
-            if (1 < length && path[length - 1] == '/')
-                path = path.substr(0, length - 1);
+            if (DownsamplingMethod::EveryNth == method_)
+                stride_ = (itemCount_ + targetPoints_ - 1) / targetPoints_;
+            else if (DownsamplingMethod::MinMaxEnvelope == method_)
+                bucketEnd_ = bucketEnd(0);
+            else
+                bucketEnd_ = 1;
+        }
+        Downsampler(const Downsampler&) = delete;
+        Downsampler(const Downsampler&&) = delete;
+        void operator=(const Downsampler&) = delete;
+        void operator=(const Downsampler&&) = delete;
+
+        //! Processes the next page of the items.
+        void add(const T* items, hsize_t itemCount);
+
+    private:
+        //! The end of a bucket relative to the range: the envelope divides all items into the buckets, the largest triangles
+        //! keep the first and the last items in the buckets of their own and divide the items between them.
+        hsize_t bucketEnd(const hsize_t bucket) const
+        {
+            if (DownsamplingMethod::MinMaxEnvelope == method_)
+            {
+                const hsize_t buckets = targetPoints_ / 2;
+                return bucket + 1 >= buckets ? itemCount_
+                    : static_cast<hsize_t>(static_cast<double>(bucket + 1) * static_cast<double>(itemCount_) / static_cast<double>(buckets));
+            }
+            const hsize_t buckets = targetPoints_ - 2;
+            if (0 == bucket)
+                return 1;
+            if (bucket >= buckets)
+                return bucket == buckets ? itemCount_ - 1 : itemCount_;
+            return 1 + static_cast<hsize_t>(static_cast<double>(bucket) * static_cast<double>(itemCount_ - 2) / static_cast<double>(buckets));
         }
 
-        std::lock_guard<std::mutex> lock(theMutex);
-        const hid_t idPath = groupOpen(path.c_str(), fileId_, false, false);
-        if (0 > idPath)
-            return traceGroupOpenError(path.c_str());
-        const herr_t status = H5Lmove(idPath, instrumentOldName.c_str(), idPath, instrumentNewName, H5P_DEFAULT, H5P_DEFAULT);
-        H5Gclose(idPath);
-        if (0 > status)
-            return traceFailedToMoveInstrumentGroupError(path.c_str(), instrumentOldName.c_str(), instrumentNewName);
-        return true;
-    }
-
-    std::shared_ptr<Instrument> File::openInstrument(const char* instrumentPath, const bool createNonexistent)
-    {
-        std::shared_ptr<Instrument> instrument(nullptr);
-        std::lock_guard<std::mutex> lock(theMutex);
-        hid_t groupId = groupOpen(instrumentPath, fileId_, !readOnly_, createNonexistent);
-        if (0 > groupId)
-            traceFileOpenInstrumentError(instrumentPath, filePath_);
-        else
-            instrument = std::make_shared<Instrument>(instrumentPath, groupId, readOnly_, filePath_);
-        return instrument;
+        //! Completes the current bucket once all its items have been seen.
+        void completeBucket();
+
+        //! The position of an item on the chart, the ticks relative to the first item.
+        double position(const T& item) const { return static_cast<double>(item.ticks_ - firstTicks_); }
+
+        const Collect<T>& collect_;
+        const hsize_t itemCount_;
+        const hsize_t targetPoints_;
+        const DownsamplingMethod method_;
+        std::vector<T> chosen_;
+        hsize_t index_{ 0 };
+        hsize_t stride_{ 0 };
+        hsize_t bucket_{ 0 };
+        hsize_t bucketEnd_{ 0 };
+        long long firstTicks_{ 0 };
+
+        // The envelope of the current bucket.
+        T lowest_{}, highest_{};
+        hsize_t lowestIndex_{ 0 }, highestIndex_{ 0 };
+
+        // The largest triangles choose an item of the previous bucket once the current bucket is complete.
+        std::vector<T> previous_, current_;
+        double chosenPosition_{ 0 }, chosenValue_{ 0 };
+    };
+
+    template <typename T> void Downsampler<T>::add(const T* items, const hsize_t itemCount)
+    {
+        if (0 == index_ && 0 < itemCount)
+            firstTicks_ = items[0].ticks_;
+        for (hsize_t i = 0; i < itemCount; ++i, ++index_)
+        {
+            const T& item = items[i];
+            if (DownsamplingMethod::EveryNth == method_)
+            {
+                if (0 == index_ % stride_)
+                    chosen_.push_back(item);
+                continue;
+            }
+            if (DownsamplingMethod::MinMaxEnvelope == method_)
+            {
+                if (index_ == lowestIndex_ || lowestValue(item) < lowestValue(lowest_))
+                {
+                    lowest_ = item;
+                    lowestIndex_ = index_;
+                }
+                if (index_ == highestIndex_ || highestValue(item) > highestValue(highest_))
+                {
+                    highest_ = item;
+                    highestIndex_ = index_;
+                }
+            }
+            else
+                current_.push_back(item);
+            if (index_ + 1 == bucketEnd_)
+                completeBucket();
+        }
+        if (!chosen_.empty())
+        {
+            collect_(chosen_.data(), chosen_.size());
+            chosen_.clear();
+        }
     }
 
-    // ----------------------------------------------------------------------
-    // Instrument
-    // ----------------------------------------------------------------------
-
-    Instrument::Instrument(const char* instrumentPath, const hid_t groupId, const bool readOnly, std::string filePath) :
-        filePath_{std::move(filePath)},
-        instrumentPath_{ instrumentPath },
-        groupId_{ groupId },
-        readOnly_{ readOnly }
+    template <typename T> void Downsampler<T>::completeBucket()
     {
-    }
+        if (DownsamplingMethod::MinMaxEnvelope == method_)
+        {
+            if (lowestIndex_ != highestIndex_)
+            {
+                chosen_.push_back(lowestIndex_ < highestIndex_ ? lowest_ : highest_);
+                chosen_.push_back(lowestIndex_ < highestIndex_ ? highest_ : lowest_);
+            }
+            else
+                chosen_.push_back(lowest_);
 
-    Instrument::~Instrument()
-    {
-		try
-		{
-			close();
-		}
-		catch (...)
-		{
-		}
-	}
+            // The envelope of the next bucket starts with its first item.
+            bucketEnd_ = bucketEnd(++bucket_);
+            lowestIndex_ = highestIndex_ = index_ + 1;
+            return;
+        }
 
-    void Instrument::close()
-    {
-        std::lock_guard<std::mutex> lock(theMutex);
-        if (0 <= groupId_)
+        // The item of the previous bucket forming the largest triangle with the chosen item and the average of the current bucket.
+        if (!previous_.empty())
         {
-            if (!readOnly_)
-                if (0 > H5Gflush(groupId_))
-                    traceInstrumentFlushError(instrumentPath_, filePath_);
-            if (0 > H5Gclose(groupId_))
-                traceInstrumentCloseError(instrumentPath_, filePath_);
-            groupId_ = -1;
+            double averagePosition{ 0 }, averageValue{ 0 };
+            for (const T& item : current_)
+            {
+                averagePosition += position(item);
+                averageValue += chartedValue(item);
+            }
+            averagePosition /= static_cast<double>(current_.size());
+            averageValue /= static_cast<double>(current_.size());
+            size_t largest = 0;
+            double largestArea{ -1 };
+            for (size_t j = 0; j < previous_.size(); ++j)
+            {
+                const double area = std::fabs((chosenPosition_ - averagePosition) * (chartedValue(previous_[j]) - chosenValue_)
+                    - (chosenPosition_ - position(previous_[j])) * (averageValue - chosenValue_));
+                if (area > largestArea)
+                {
+                    largestArea = area;
+                    largest = j;
+                }
+            }
+            chosen_.push_back(previous_[largest]);
+            chosenPosition_ = position(previous_[largest]);
+            chosenValue_ = chartedValue(previous_[largest]);
         }
-    }
 
-    void Instrument::flush() const
-    {
-        std::lock_guard<std::mutex> lock(theMutex);
-        if (!readOnly_ && 0 <= groupId_)
-            if (0 > H5Gflush(groupId_))
-                traceInstrumentFlushError(instrumentPath_, filePath_);
+        // The first and the last items are always chosen.
+        if (0 == bucket_ || index_ + 1 == itemCount_)
+        {
+            chosen_.push_back(current_.front());
+            chosenPosition_ = position(current_.front());
+            chosenValue_ = chartedValue(current_.front());
+            current_.clear();
+        }
+        previous_.swap(current_);
+        current_.clear();
+        bucketEnd_ = bucketEnd(++bucket_);
     }
 
-    int Instrument::compareDataset(const void* first, const void* second) noexcept
-    {
-		// ReSharper disable CppCStyleCast
-		const auto p1 = (const DataInfo*)first;
-		const auto p2 = (const DataInfo*)second;
-		// ReSharper restore CppCStyleCast
-
-		return strcmp(p1->name(), p2->name());
-    }
+    // ----------------------------------------------------------------------
+    // ObjectInfo
+    // ----------------------------------------------------------------------
 
-    bool Instrument::enumerateDatasets(const DataInfoEnumerator& enumerate, const bool sort) const
+    ObjectInfo::ObjectInfo(const char* name, const GroupInfo* parent) :
+        name_(name),
+        path_(nullptr == parent ? name : parent->path()),
+        parent_(parent)
     {
-        bool status;
-		GroupInfo root{};
-		{
-			std::lock_guard<std::mutex> lock(theMutex);
-			status = root.iterateGroup(groupId_, instrumentPath_.c_str(), &root);
-		}
-    	if (status)
+        if (nullptr != parent)
         {
-	        if (sort)
-		        root.sort();
-	        root.enumerateDatasets(enumerate);
+            path_.append("/");
+            path_.append(name);
         }
-    	else
-			traceInstrumentDatasetEnumerationError(instrumentPath_, filePath_);
-
-    	return status;
     }
 
-    static void closeTypes(DatasetTraits& datasetTraits)
+    ObjectInfo::ObjectInfo() :
+        name_("/"),
+        path_(""),
+        parent_(nullptr)
     {
-        H5Tclose(datasetTraits.standardType_);
-        H5Tclose(datasetTraits.nativeType_);
     }
 
-    std::shared_ptr<QuoteData> Instrument::openQuoteData(const bool createNonexistent) const
-    {
-        std::shared_ptr<QuoteData> ptr;
-        DatasetTraits datasetTraits;
-        hid_t datasetId;
-        {
-            std::lock_guard<std::mutex> lock(theMutex);
-            if (!dataKind2DatasetTraits(DataKind::QuoteAperiodic, datasetTraits))
-                return ptr;
-            datasetId = datasetOpen(datasetTraits.name_, groupId_, datasetTraits.standardType_, !readOnly_, createNonexistent);
-            if (0 > datasetId)
-            {
-                closeTypes(datasetTraits);
-                return ptr;
-            }
-        }
-        ptr.reset(new QuoteData(this, datasetTraits.name_, datasetId, datasetTraits.nativeType_, datasetTraits.standardType_, readOnly_));
-        return ptr;
-    }
+    // ----------------------------------------------------------------------
+    // DataInfo
+    // ----------------------------------------------------------------------
 
-    std::shared_ptr<QuotePriceOnlyData> Instrument::openQuotePriceOnlyData(const bool createNonexistent) const
+    DataInfo::DataInfo(const char* name, const GroupInfo* parent) :
+        ObjectInfo(name, parent)
     {
-        std::shared_ptr<QuotePriceOnlyData> ptr;
-        DatasetTraits datasetTraits;
-        hid_t datasetId;
+        dataKind_ = DataKind::TradeAperiodic;
+        ParsedDatasetName pdn;
+        isValidName_ = parseDatasetName(name, pdn);
+        dataType_ = pdn.dataType_;
+        ohlcvKind_ = pdn.ohlcvKind_;
+        scalarKind_ = pdn.scalarKind_;
+        tradeKind_ = pdn.tradeKind_;
+        quoteKind_ = pdn.quoteKind_;
+        timeFrame_ = pdn.timeFrame_;
+        if (isValidName_)
         {
-            std::lock_guard<std::mutex> lock(theMutex);
-            if (!dataKind2DatasetTraits(DataKind::QuotePriceOnlyAperiodic, datasetTraits))
-                return ptr;
-            datasetId = datasetOpen(datasetTraits.name_, groupId_, datasetTraits.standardType_, !readOnly_, createNonexistent);
-            if (0 > datasetId)
+            switch (dataType_)
             {
-                closeTypes(datasetTraits);
-                return ptr;
+                case DataType::TradePriceOnly:
+                    dataKind_ = DataKind::TradePriceOnlyAperiodic;
+                    break;
+                case DataType::Quote:
+                    dataKind_ = DataKind::QuoteAperiodic;
+                    break;
+                case DataType::QuotePriceOnly:
+                    dataKind_ = DataKind::QuotePriceOnlyAperiodic;
+                    break;
+                case DataType::Ohlcv:
+                    dataKind_ = ohlcvKind2DataKind(ohlcvKind_, timeFrame_, false);
+                    break;
+                case DataType::OhlcvPriceOnly:
+                    dataKind_ = ohlcvPriceOnlyKind2DataKind(ohlcvKind_, timeFrame_, false);
+                    break;
+                case DataType::Scalar:
+                    dataKind_ = scalarKind2DataKind(scalarKind_, timeFrame_);
+                    break;
+                case DataType::OhlcvAdjusted:
+                    dataKind_ = ohlcvKind2DataKind(ohlcvKind_, timeFrame_, true);
+                    break;
+                case DataType::OhlcvAdjustedPriceOnly:
+                    dataKind_ = ohlcvPriceOnlyKind2DataKind(ohlcvKind_, timeFrame_, true);
+                    break;
+                case DataType::Trade:
+                default:
+                    break;
             }
         }
-        ptr.reset(new QuotePriceOnlyData(this, datasetTraits.name_, datasetId, datasetTraits.nativeType_, datasetTraits.standardType_, readOnly_));
-        return ptr;
     }
 
-    std::shared_ptr<TradeData> Instrument::openTradeData(const bool createNonexistent) const
+    DataInfo::DataInfo(const DataInfo& other) :
+        DataInfo(other.name(), other.parent_)
     {
-        std::shared_ptr<TradeData> ptr;
-        DatasetTraits datasetTraits;
-        hid_t datasetId;
-        {
-            std::lock_guard<std::mutex> lock(theMutex);
-            if (!dataKind2DatasetTraits(DataKind::TradeAperiodic, datasetTraits))
-                return ptr;
-            datasetId = datasetOpen(datasetTraits.name_, groupId_, datasetTraits.standardType_, !readOnly_, createNonexistent);
-            if (0 > datasetId)
-            {
-                closeTypes(datasetTraits);
-                return ptr;
-            }
-        }
-        ptr.reset(new TradeData(this, datasetTraits.name_, datasetId, datasetTraits.nativeType_, datasetTraits.standardType_, readOnly_));
-        return ptr;
     }
 
-    std::shared_ptr<TradePriceOnlyData> Instrument::openTradePriceOnlyData(const bool createNonexistent) const
+    DataInfo::DataInfo(const DataInfo&& other) noexcept :
+        DataInfo(other.name(), other.parent_)
     {
-        std::shared_ptr<TradePriceOnlyData> ptr;
-        DatasetTraits datasetTraits;
-        hid_t datasetId;
-        {
-            std::lock_guard<std::mutex> lock(theMutex);
-            if (!dataKind2DatasetTraits(DataKind::TradePriceOnlyAperiodic, datasetTraits))
-                return ptr;
-            datasetId = datasetOpen(datasetTraits.name_, groupId_, datasetTraits.standardType_, !readOnly_, createNonexistent);
-            if (0 > datasetId)
-            {
-                closeTypes(datasetTraits);
-                return ptr;
-            }
-        }
-        ptr.reset(new TradePriceOnlyData(this, datasetTraits.name_, datasetId, datasetTraits.nativeType_, datasetTraits.standardType_, readOnly_));
-        return ptr;
     }
 
-    inline std::shared_ptr<OhlcvData> Instrument::openOhlcvData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool adjusted, const bool createNonexistent) const
+    int DataInfo::compare(const void* first, const void* second) noexcept
     {
-        std::shared_ptr<OhlcvData> ptr;
-        DatasetTraits datasetTraits;
-        hid_t datasetId;
-        {
-            std::lock_guard<std::mutex> lock(theMutex);
-            const DataKind dataKind = ohlcvKind2DataKind(kind, timeFrame, adjusted);
-            if (!dataKind2DatasetTraits(dataKind, datasetTraits))
-                return ptr;
-            datasetId = datasetOpen(datasetTraits.name_, groupId_, datasetTraits.standardType_, !readOnly_, createNonexistent);
-            if (0 > datasetId)
-            {
-                closeTypes(datasetTraits);
-                return ptr;
-            }
-        }
-        ptr.reset(new OhlcvData(this, datasetTraits.name_, datasetId, datasetTraits.nativeType_, datasetTraits.standardType_, readOnly_));
-        return ptr;
-    }
+        // ReSharper disable CppCStyleCast
+        const auto p1 = *(const DataInfo**)first;
+        const auto p2 = *(const DataInfo**)second;
+        // ReSharper restore CppCStyleCast
 
-    std::shared_ptr<OhlcvData> Instrument::openOhlcvData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool createNonexistent) const
-    {
-        return openOhlcvData(kind, timeFrame, false, createNonexistent);
+        return strcmp(p1->path(), p2->path());
     }
 
-    std::shared_ptr<OhlcvData> Instrument::openOhlcvAdjustedData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool createNonexistent) const
+    // ----------------------------------------------------------------------
+    // GroupInfo
+    // ----------------------------------------------------------------------
+
+    GroupInfo::GroupInfo() :
+        ObjectInfo()
     {
-        return openOhlcvData(kind, timeFrame, true, createNonexistent);
     }
 
-    inline std::shared_ptr<OhlcvPriceOnlyData> Instrument::openOhlcvPriceOnlyData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool adjusted, const bool createNonexistent) const
+    GroupInfo::GroupInfo(const char* name, const GroupInfo* parent) :
+        ObjectInfo(name, parent)
     {
-        std::shared_ptr<OhlcvPriceOnlyData> ptr;
-        DatasetTraits datasetTraits;
-        hid_t datasetId;
-        {
-            std::lock_guard<std::mutex> lock(theMutex);
-            const DataKind dataKind = ohlcvPriceOnlyKind2DataKind(kind, timeFrame, adjusted);
-            if (!dataKind2DatasetTraits(dataKind, datasetTraits))
-                return ptr;
-            datasetId = datasetOpen(datasetTraits.name_, groupId_, datasetTraits.standardType_, !readOnly_, createNonexistent);
-            if (0 > datasetId)
-            {
-                closeTypes(datasetTraits);
-                return ptr;
-            }
-        }
-        ptr.reset(new OhlcvPriceOnlyData(this, datasetTraits.name_, datasetId, datasetTraits.nativeType_, datasetTraits.standardType_, readOnly_));
-        return ptr;
     }
 
-    std::shared_ptr<OhlcvPriceOnlyData> Instrument::openOhlcvPriceOnlyData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool createNonexistent) const
+    void GroupInfo::enumerateDatasets(const DataInfoEnumerator& enumerate) const
     {
-        return openOhlcvPriceOnlyData(kind, timeFrame, false, createNonexistent);
+        const DataInfo** ptr{ datasets_.data() };
+        const size_t size = datasets_.size();
+        for (size_t i = 0; i != size; ++i)
+            enumerate(*ptr[i]);
     }
 
-    std::shared_ptr<OhlcvPriceOnlyData> Instrument::openOhlcvAdjustedPriceOnlyData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool createNonexistent) const
+    void GroupInfo::enumerateGroups(const GroupInfoEnumerator& enumerate) const
     {
-        return openOhlcvPriceOnlyData(kind, timeFrame, true, createNonexistent);
+        const GroupInfo** ptr{ groups_.data() };
+        const size_t size = groups_.size();
+        for (size_t i = 0; i != size; ++i)
+            enumerate(ptr[i]);
     }
 
-    std::shared_ptr<ScalarData> Instrument::openScalarData(const DataTimeFrame timeFrame, const bool createNonexistent) const
+    bool GroupInfo::iterateGroup(const hid_t groupOrFileId, const char* groupName, GroupInfo* parentGroupInfo)
     {
-        std::shared_ptr<ScalarData> ptr;
-        DatasetTraits datasetTraits;
-        hid_t datasetId;
+        const hid_t id = H5Gopen2(groupOrFileId, groupName, H5P_DEFAULT);
+        if (0 > id)
+            return traceGroupOpenError(groupName);
+
+        H5G_info_t g_info;
+        herr_t status = H5Gget_info(id, &g_info);
+        if (0 > status)
         {
-            std::lock_guard<std::mutex> lock(theMutex);
-            const DataKind dataKind = scalarKind2DataKind(ScalarKind::Default, timeFrame);
-            if (!dataKind2DatasetTraits(dataKind, datasetTraits))
-                return ptr;
-            datasetId = datasetOpen(datasetTraits.name_, groupId_, datasetTraits.standardType_, !readOnly_, createNonexistent);
-            if (0 > datasetId)
+            traceGroupInfoError(groupName);
+            return closeGroup(id);
+        }
+
+        const hsize_t numberOfLinks = g_info.nlinks;
+        const int maxObjectNameLength = 1024;
+        char name[maxObjectNameLength];
+        H5O_info_t o_info;
+        for (hsize_t index = 0; index < numberOfLinks; ++index)
+        {
+            status = herr_t(H5Lget_name_by_idx(id, ".", H5_INDEX_NAME, H5_ITER_NATIVE, index, &name[0], maxObjectNameLength, H5P_DEFAULT));
+            if (0 > status)
             {
-                closeTypes(datasetTraits);
-                return ptr;
+                traceGroupByIndexNameError(index, groupName);
+                return closeGroup(id);
             }
-        }
-        ptr.reset(new ScalarData(this, datasetTraits.name_, datasetId, datasetTraits.nativeType_, datasetTraits.standardType_, readOnly_));
-        return ptr;
-    }
 
-    // ----------------------------------------------------------------------
-    // Data
-    // ----------------------------------------------------------------------
+            status = H5Oget_info_by_idx(id, ".", H5_INDEX_NAME, H5_ITER_NATIVE, index, &o_info, H5P_DEFAULT);
+            if (0 > status)
+            {
+                traceGroupByIndexObjectInfoError(index, groupName);
+                return closeGroup(id);
+            }
 
-    Data::Data(const Instrument* instrument, const char* name, const hid_t datasetId, const hid_t nativeTypeId, const hid_t standardTypeId, const bool readOnly) :
-        maximumReadBufferBytes_{ defaultMaximumReadBufferBytes_ },
-        filePath_(instrument->filePath_),
-        datasetPath_(instrument->instrumentPath_),
-        datasetId_{ datasetId },
-        nativeTypeId_{ nativeTypeId },
-        standardTypeId_{ standardTypeId },
-        readOnly_{ readOnly }
-    {
-        datasetPath_.append("/");
-        datasetPath_.append(name);
+            switch (o_info.type)
+            {
+                case H5O_TYPE_GROUP:
+                {
+                    // A group named after a data and holding the ticks dataset is a data in the columnar layout.
+                    ParsedDatasetName pdn;
+                    if (parseDatasetName(name, pdn) && 0 < H5Lexists(id, (std::string(name) + "/ticks").c_str(), H5P_DEFAULT))
+                    {
+                        const auto ptr = new DataInfo(name, parentGroupInfo);
+                        parentGroupInfo->datasets_.append(ptr);
+                        break;
+                    }
+                    const auto ptr = new GroupInfo(name, parentGroupInfo);
+                    parentGroupInfo->groups_.append(ptr);
+                    if (!iterateGroup(id, name, ptr))
+                        return closeGroup(id);
+                    break;
+                }
+                case H5O_TYPE_DATASET:
+                {
+                    if (isZonesName(name) || isSegmentName(name))
+                        break;
+                    const auto ptr = new DataInfo(name, parentGroupInfo);
+                    parentGroupInfo->datasets_.append(ptr);
+                    break;
+                }
+                case H5O_TYPE_NAMED_DATATYPE:
+                case H5O_TYPE_NTYPES:
+                case H5O_TYPE_UNKNOWN:
+                default: break;
+            }
+        }
+        if (0 > H5Gclose(id))
+            return traceGroupCloseError(groupName);
+        return true;
     }
 
-    Data::~Data()
+    void GroupInfo::moveDatasetsTo(DataInfoList* datasets)
     {
-		try
-		{
-			close();
-		}
-		catch (...)
-		{
-		}
-	}
-
-    hsize_t Data::defaultMaximumReadBufferBytes_{ 1024L * 1024L };
-
-    void Data::close()
-    {
-        std::lock_guard<std::mutex> lock(theMutex);
-        if (0 <= datasetId_)
+        size_t size = datasets_.size();
+        if (size > 0)
         {
-            if (!readOnly_)
-                if (0 > H5Dflush(datasetId_))
-                    traceDataFlushError(datasetPath_, filePath_);
-            if (0 > H5Dclose(datasetId_))
-                traceDataCloseError(datasetPath_, filePath_);
-            datasetId_ = -1;
+            const DataInfo** ptr{ datasets_.data() };
+            for (size_t i = 0; i != size; ++i)
+            {
+                datasets->append(ptr[i]);
+                ptr[i] = nullptr;
+            }
+            datasets_.size_ = 0;
         }
-        if (0 <= nativeTypeId_)
+
+        size = groups_.size();
+        if (size > 0)
         {
-            if (0 > H5Tclose(nativeTypeId_))
-                traceDataCloseNativeTypeError(datasetPath_, filePath_);
-            nativeTypeId_ = -1;
+            GroupInfo** ptr{ const_cast<GroupInfo * *>(groups_.data()) };
+            for (size_t i = 0; i != size; ++i)
+                ptr[i]->moveDatasetsTo(datasets);
         }
-        if (0 <= standardTypeId_)
+    }
+
+    void GroupInfo::enumerateDatasetsRecursive(const DataInfoEnumerator& enumerate) const
+    {
+        size_t size = datasets_.size();
+        if (size > 0)
         {
-            if (0 > H5Tclose(standardTypeId_))
-                traceDataCloseStandardTypeError(datasetPath_, filePath_);
-            standardTypeId_ = -1;
+            const DataInfo** ptr{ datasets_.data() };
+            for (size_t i = 0; i != size; ++i)
+                enumerate(*ptr[i]);
+        }
+
+        size = groups_.size();
+        if (size > 0)
+        {
+            GroupInfo** ptr{ const_cast<GroupInfo * *>(groups_.data()) };
+            for (size_t i = 0; i != size; ++i)
+                ptr[i]->enumerateDatasetsRecursive(enumerate);
         }
     }
 
-    void Data::flush() const
+    int GroupInfo::compare(const void* first, const void* second) noexcept
     {
-        std::lock_guard<std::mutex> lock(theMutex);
-        if (!readOnly_ && 0 <= datasetId_)
-            if (0 > H5Dflush(datasetId_))
-                traceDataFlushError(datasetPath_, filePath_);
+        // ReSharper disable CppCStyleCast
+        const auto p1 = *(const GroupInfo**)first;
+        const auto p2 = *(const GroupInfo**)second;
+        // ReSharper restore CppCStyleCast
+
+        return strcmp(p1->name(), p2->name());
     }
 
-    long long Data::firstTicks() const
+    void GroupInfo::sort() const
     {
-        long long ticks{0L};
-        hsize_t dataCount;
-        std::lock_guard<std::mutex> lock(theMutex);
-        if (!countItems(datasetId_, dataCount))
-            traceDataGetItemCountError(datasetPath_, filePath_);
-        else if (0 < dataCount)
+        size_t size{ datasets_.size() };
+        if (size > 1)
+            std::qsort(static_cast<void*>(datasets_.data()), size, sizeof(DataInfo*), DataInfo::compare);
+        size = groups_.size();
+        if (size > 0)
         {
-            unsigned char buffer[256];
-            if (!readItem(datasetId_, nativeTypeId_, 0, static_cast<void*>(buffer)))
-                traceDataReadFirstItemError(datasetPath_, filePath_);
-            else
-                ticks = reinterpret_cast<Scalar*>(buffer)->ticks_;
+            const GroupInfo** ptr{ groups_.data() };
+            if (size > 1)
+                std::qsort(static_cast<void*>(ptr), size, sizeof(GroupInfo*), GroupInfo::compare);
+
+            for (size_t i = 0; i != size; ++i)
+                ptr[i]->sort();
         }
-        return ticks;
     }
 
-    long long Data::lastTicks() const
+    // ----------------------------------------------------------------------
+    // Locking
+    // ----------------------------------------------------------------------
+
+    // The HDF5 library is not re-entrant unless built thread-safe, so all calls into it are serialized on this mutex.
+    // It is always acquired last, after the File -> Instrument -> Data object locks, and is never held while a user callback runs.
+    static std::mutex theLibraryMutex;
+
+    typedef std::shared_lock<std::shared_mutex> ReadLock;
+    typedef std::unique_lock<std::shared_mutex> WriteLock;
+    typedef std::lock_guard<std::mutex> LibraryLock;
+
+    // ----------------------------------------------------------------------
+    // Parallel chunk access
+    // ----------------------------------------------------------------------
+
+    // The library runs the filter pipeline serially under the library lock. Multi-chunk reads instead
+    // fetch the stored chunks with H5Dread_chunk under the lock and decode them on several threads outside of it,
+    // and appends of whole chunks encode them on several threads and store them with H5Dwrite_chunk.
+
+    enum class ChunkFilterKind { Shuffle, Deflate, TimeSeries };
+
+    struct ChunkFilter
     {
-        long long ticks{0L};
-        hsize_t dataCount;
-        std::lock_guard<std::mutex> lock(theMutex);
-        if (!countItems(datasetId_, dataCount))
-            traceDataGetItemCountError(datasetPath_, filePath_);
-        else if (0 < dataCount)
+        ChunkFilterKind kind_;
+        size_t parameter_;
+    };
+
+    // Gets the filter pipeline of a dataset if its chunks can be decoded here byte-identically to H5Dread:
+    // the stored type must be the native type and every filter must be shuffle, deflate or the time series codec.
+    static bool chunkPipeline(const hid_t datasetId, const hid_t nativeTypeId, std::vector<ChunkFilter>& pipeline)
+    {
+        pipeline.clear();
+        const hid_t type_id = H5Dget_type(datasetId);
+        if (0 > type_id)
+            return false;
+        const bool nativeStorage = 0 < H5Tequal(type_id, nativeTypeId);
+        H5Tclose(type_id);
+        if (!nativeStorage)
+            return false;
+        const hid_t dcpl_id = H5Dget_create_plist(datasetId);
+        if (0 > dcpl_id)
+            return false;
+        const int filters = H5D_CHUNKED == H5Pget_layout(dcpl_id) ? H5Pget_nfilters(dcpl_id) : -1;
+        bool supported = 0 <= filters;
+        for (int i = 0; supported && i < filters; ++i)
         {
-            unsigned char buffer[256];
-            if (!readItem(datasetId_, nativeTypeId_, dataCount - 1, static_cast<void*>(buffer)))
-                traceDataReadLastItemError(datasetPath_, filePath_);
+            unsigned int flags, config;
+            unsigned int cd_values[3]{ 0, 0, 0 };
+            size_t cd_nelmts = 3;
+            const H5Z_filter_t filter = H5Pget_filter2(dcpl_id, static_cast<unsigned>(i), &flags, &cd_nelmts, cd_values, 0, nullptr, &config);
+            if (H5Z_FILTER_SHUFFLE == filter)
+                pipeline.push_back({ ChunkFilterKind::Shuffle, 0 < cd_nelmts ? cd_values[0] : H5Tget_size(nativeTypeId) });
+            else if (H5Z_FILTER_DEFLATE == filter)
+                pipeline.push_back({ ChunkFilterKind::Deflate, 0 < cd_nelmts ? cd_values[0] : 6U });
+            else if (timeSeriesFilterId == filter && 0 < cd_nelmts && 0 < cd_values[0] && (2 > cd_nelmts || 0 != cd_values[1])
+                && (3 > cd_nelmts || timeSeriesFilterVersion >= cd_values[2]))
+                pipeline.push_back({ ChunkFilterKind::TimeSeries, cd_values[0] });
             else
-                ticks = *reinterpret_cast<long long*>(buffer);
+                supported = false;
         }
-        return ticks;
+        H5Pclose(dcpl_id);
+        return supported;
     }
 
-    hsize_t Data::count() const
+    // The threads shared by all parallel chunk accesses, started on the first use and kept until the process exits.
+    class WorkerPool final
     {
-        hsize_t dataCount{0UL};
-        std::lock_guard<std::mutex> lock(theMutex);
-        if (!countItems(datasetId_, dataCount))
-            traceDataGetItemCountError(datasetPath_, filePath_);
-        return dataCount;
-    }
+    public:
+        WorkerPool() = default;
+        WorkerPool(const WorkerPool&) = delete;
+        void operator=(const WorkerPool&) = delete;
 
-    template <typename T> bool Data::spreadList(std::vector<T>& input, const bool verbose)
-    {
-        return spreadList(const_cast<T*>(input.data()), static_cast<size_t>(input.size()), verbose);
-    }
+        ~WorkerPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stop_ = true;
+            }
+            wake_.notify_all();
+            for (std::thread& t : threads_)
+                t.join();
+        }
 
-    template <typename T> bool Data::spreadList(T* input, const size_t inputCount, const bool verbose)
-    {
-        size_t iStart = 0, iCount = 0, j;
-        long long lStart = input[0].ticks_;
-        bool spread = false;
-        T t{};
-        for (size_t i = 1; i < inputCount; ++i)
+        static WorkerPool& instance()
         {
-            const long long l = input[i].ticks_;
-            if (lStart == l)
-                ++iCount;
-            else
+            static WorkerPool pool;
+            return pool;
+        }
+
+        // Runs a worker on the given number of threads, including the calling one, and waits for all of them.
+        // The worker takes its work from a shared counter, so the calling thread finishes the work the busy pool threads did not start,
+        // and the tasks started after that return at once.
+        void run(const unsigned threads, const std::function<void()>& worker)
+        {
+            struct Run
             {
-                if (0 < iCount)
+                std::mutex mutex_;
+                std::condition_variable done_;
+                unsigned running_{ 0 };
+                bool finished_{ false };
+            };
+            const auto run = std::make_shared<Run>();
+            if (1 < threads)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                try
                 {
-                    if (verbose)
-                    {
-                        traceSpreadingDuplicateInputTimeTick<T>(iStart, input[iStart]);
-                        for (j = iStart + 1; j < i; ++j)
-                        {
-                            traceSpreadingDuplicateInputTimeTick<T>(j, input[j], lStart + 1);
-                            t = input[j];
-                            t.ticks_ = ++lStart;
-                            input[j] = t;
-                        }
-                    }
-                    else
+                    while (threads_.size() + 1 < threads && threads_.size() < maximumThreads)
+                        threads_.emplace_back(&WorkerPool::work, this);
+                }
+                catch (...)
+                {
+                    // The threads already started share the work.
+                }
+                for (unsigned i = 1; i < threads; ++i)
+                    tasks_.emplace_back([run, &worker]()
                     {
-                        for (j = iStart + 1; j < i; ++j)
                         {
-                            t = input[j];
-                            t.ticks_ = ++lStart;
-                            input[j] = t;
+                            std::lock_guard<std::mutex> runLock(run->mutex_);
+                            if (run->finished_)
+                                return;
+                            ++run->running_;
                         }
-                    }
-                    iCount = 0;
-                    spread = true;
-                }
-                iStart = i;
-                lStart = input[i].ticks_;
+                        worker();
+                        std::lock_guard<std::mutex> runLock(run->mutex_);
+                        --run->running_;
+                        run->done_.notify_all();
+                    });
             }
+            wake_.notify_all();
+            worker();
+            std::unique_lock<std::mutex> runLock(run->mutex_);
+            run->finished_ = true;
+            run->done_.wait(runLock, [&run] { return 0 == run->running_; });
         }
-        if (0 < iCount)
+
+    private:
+        static constexpr size_t maximumThreads{ 256 };
+
+        void work()
         {
-            iCount += iStart;
-            if (verbose)
-            {
-                traceSpreadingDuplicateInputTimeTick<T>(iStart, input[iStart]);
-                for (j = iStart + 1; j <= iCount; ++j)
-                {
-                    traceSpreadingDuplicateInputTimeTick<T>(j, input[j], lStart + 1);
-                    t = input[j];
-                    t.ticks_ = ++lStart;
-                    input[j] = t;
-                }
-            }
-            else
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (;;)
             {
-                for (j = iStart + 1; j <= iCount; ++j)
-                {
-                    t = input[j];
-                    t.ticks_ = ++lStart;
-                    input[j] = t;
-                }
+                wake_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+                if (stop_)
+                    return;
+                const std::function<void()> task = std::move(tasks_.front());
+                tasks_.pop_front();
+                lock.unlock();
+                task();
+                lock.lock();
             }
-            spread = true;
         }
-        return spread;
+
+        std::mutex mutex_;
+        std::condition_variable wake_;
+        std::deque<std::function<void()>> tasks_;
+        std::vector<std::thread> threads_;
+        bool stop_{ false };
+    };
+
+    // Runs a worker on the given number of threads, including the calling one, and waits for all of them.
+    static void runOnThreads(const unsigned threads, const std::function<void()>& worker)
+    {
+        WorkerPool::instance().run(threads, worker);
     }
 
-    template <typename T> bool Data::deleteIndexRange(const hsize_t indexFrom, const hsize_t indexTo) const
+    // The shuffle filter: the stored chunk holds the first bytes of all elements, then the second bytes, and so on.
+    static void shuffle(const unsigned char* in, const size_t bytes, const size_t elementSize, unsigned char* out)
     {
-        if (readOnly_)
-            return false;
-        if (indexTo < indexFrom)
-            return true;
-        const hsize_t count = indexTo - indexFrom + 1;
-        if (count > 0)
+        const size_t elements = bytes / elementSize;
+        for (size_t j = 0; j < elementSize; ++j)
         {
-            std::lock_guard<std::mutex> lock(theMutex);
-            return deleteItems(datasetId_, nativeTypeId_, indexFrom, count, sizeof(T));
+            unsigned char* plane = out + j * elements;
+            for (size_t i = 0; i < elements; ++i)
+                plane[i] = in[i * elementSize + j];
         }
-        return true;
+        const size_t whole = elements * elementSize;
+        std::memcpy(out + whole, in + whole, bytes - whole);
     }
 
-    template <typename T> bool Data::deleteTickRange(const long long ticksFrom, const long long ticksTo) const
+    // Reverses the shuffle filter.
+    static void unshuffle(const unsigned char* in, const size_t bytes, const size_t elementSize, unsigned char* out)
     {
-        if (readOnly_)
-            return false;
-        if (ticksTo < ticksFrom)
-            return true;
-        hsize_t indexFrom, indexTo;
-        bool matchFrom, matchTo;
+        const size_t elements = bytes / elementSize;
+        for (size_t j = 0; j < elementSize; ++j)
         {
-            std::lock_guard<std::mutex> lock(theMutex);
-            if (!ticksToIndexNoLock<T>(ticksFrom, indexFrom, matchFrom) ||
-                !ticksToIndexNoLock<T>(ticksTo, indexTo, matchTo))
-                return false;
+            const unsigned char* plane = in + j * elements;
+            for (size_t i = 0; i < elements; ++i)
+                out[i * elementSize + j] = plane[i];
         }
-        if (!matchFrom)
-            ++indexFrom;
-        const hsize_t count = indexTo - indexFrom + 1;
-        if (count > 0)
+        const size_t whole = elements * elementSize;
+        std::memcpy(out + whole, in + whole, bytes - whole);
+    }
+
+    // Decodes a stored chunk in place, skipping the filters the filter mask marks as not applied.
+    static bool decodeChunk(const std::vector<ChunkFilter>& pipeline, const uint32_t filterMask, const size_t chunkBytes, std::vector<unsigned char>& chunk, std::vector<unsigned char>& scratch)
+    {
+        for (size_t i = pipeline.size(); 0 < i--;)
         {
-            std::lock_guard<std::mutex> lock(theMutex);
-            return deleteItems(datasetId_, nativeTypeId_, indexFrom, count, sizeof(T));
+            if (0 != (filterMask & (1U << i)))
+                continue;
+            scratch.resize(chunkBytes);
+            const ChunkFilter& filter = pipeline[i];
+            if (ChunkFilterKind::Shuffle == filter.kind_)
+            {
+                if (chunk.size() != chunkBytes || 0 == filter.parameter_)
+                    return false;
+                unshuffle(chunk.data(), chunkBytes, filter.parameter_, scratch.data());
+            }
+            else if (ChunkFilterKind::Deflate == filter.kind_)
+            {
+                uLongf bytes = static_cast<uLongf>(chunkBytes);
+                if (Z_OK != uncompress(scratch.data(), &bytes, chunk.data(), static_cast<uLong>(chunk.size())) || chunkBytes != bytes)
+                    return false;
+            }
+            else if (timeSeriesDecodedBytes(chunk.data(), chunk.size(), filter.parameter_) != chunkBytes
+                || !timeSeriesDecodeChunk(chunk.data(), chunk.size(), filter.parameter_, scratch.data()))
+                return false;
+            chunk.swap(scratch);
         }
-        return true;
+        return chunk.size() == chunkBytes;
     }
 
-    template <typename T> bool Data::addData(const T* input, const hsize_t inputCount, DuplicateTimeTicks duplicateTimeTicks, bool verbose) const
+    // Encodes a chunk, marking in the filter mask the optional filters skipped because they did not shrink it, as the library does.
+    static bool encodeChunk(const std::vector<ChunkFilter>& pipeline, const unsigned char* in, const size_t chunkBytes, std::vector<unsigned char>& chunk, std::vector<unsigned char>& scratch, uint32_t& filterMask)
     {
-        if (readOnly_)
-            return false;
-        T inputFirst = input[0], inputLast = input[inputCount - 1];
-        const long long inputFirstTicks = inputFirst.ticks_;
-        const long long inputLastTicks = inputLast.ticks_;
+        filterMask = 0;
+        chunk.assign(in, in + chunkBytes);
+        for (size_t i = 0; i < pipeline.size(); ++i)
         {
-            long long l1 = inputFirstTicks;
-            for (hsize_t i = 1; i < inputCount; ++i)
+            const ChunkFilter& filter = pipeline[i];
+            if (ChunkFilterKind::Shuffle == filter.kind_)
             {
-                const long long l2 = input[i].ticks_;
-                if (l1 >= l2)
-                {
-                    traceNonIncreasingInputTicksError<T>(input[i - 1], input[i]);
+                if (0 == filter.parameter_)
+                    return false;
+                scratch.resize(chunk.size());
+                shuffle(chunk.data(), chunk.size(), filter.parameter_, scratch.data());
+            }
+            else if (ChunkFilterKind::Deflate == filter.kind_)
+            {
+                uLongf bytes = compressBound(static_cast<uLong>(chunk.size()));
+                scratch.resize(bytes);
+                if (Z_OK != compress2(scratch.data(), &bytes, chunk.data(), static_cast<uLong>(chunk.size()), static_cast<int>(filter.parameter_)))
                     return false;
+                if (bytes >= chunk.size())
+                {
+                    filterMask |= 1U << i;
+                    continue;
                 }
-                l1 = l2;
+                scratch.resize(bytes);
+            }
+            else
+            {
+                const size_t boundBytes = timeSeriesEncodedBytesBound(chunk.size(), filter.parameter_);
+                if (0 == boundBytes)
+                    return false;
+                scratch.resize(boundBytes);
+                scratch.resize(timeSeriesEncodeChunk(chunk.data(), chunk.size(), filter.parameter_, true, scratch.data()));
             }
+            chunk.swap(scratch);
         }
-        std::lock_guard<std::mutex> lock(theMutex);
-        hsize_t dataCount;
-        if (!countItems(datasetId_, dataCount))
+        return true;
+    }
+
+    // Reads a range of items spanning several chunks on the given number of threads, including the calling one.
+    // The caller must hold the data lock but not the library lock.
+    static bool readChunksParallel(const hid_t datasetId, const std::vector<ChunkFilter>& pipeline, const size_t itemSize, const hsize_t chunkRows,
+        const hsize_t itemOffset, const hsize_t itemCount, void* itemBuffer, const unsigned threads)
+    {
+        const hsize_t itemEnd = itemOffset + itemCount;
+        const hsize_t lastChunk = (itemEnd - 1) / chunkRows;
+        const size_t chunkBytes = static_cast<size_t>(chunkRows) * itemSize;
+        const auto out = static_cast<unsigned char*>(itemBuffer);
+        std::atomic<hsize_t> nextChunk{ itemOffset / chunkRows };
+        std::atomic<bool> failed{ false };
+        const auto worker = [&]() noexcept
         {
-            traceDataGetItemCountError(datasetPath_, filePath_);
+            try
+            {
+                std::vector<unsigned char> chunk, scratch;
+                for (hsize_t c = nextChunk++; c <= lastChunk && !failed.load(std::memory_order_relaxed); c = nextChunk++)
+                {
+                    hsize_t offsets[1]{ c * chunkRows };
+                    uint32_t filterMask{ 0 };
+                    bool status;
+                    {
+                        LibraryLock libraryLock(theLibraryMutex);
+                        hsize_t storedBytes{ 0 };
+                        status = 0 <= H5Dget_chunk_storage_size(datasetId, offsets, &storedBytes) && 0 < storedBytes;
+                        if (status)
+                        {
+                            chunk.resize(static_cast<size_t>(storedBytes));
+                            status = 0 <= H5Dread_chunk(datasetId, H5P_DEFAULT, offsets, &filterMask, chunk.data());
+                        }
+                    }
+                    if (!status || !decodeChunk(pipeline, filterMask, chunkBytes, chunk, scratch))
+                    {
+                        failed.store(true);
+                        return;
+                    }
+                    const hsize_t from = std::max(itemOffset, offsets[0]);
+                    const hsize_t to = std::min(itemEnd, offsets[0] + chunkRows);
+                    std::memcpy(out + (from - itemOffset) * itemSize, chunk.data() + (from - offsets[0]) * itemSize, static_cast<size_t>(to - from) * itemSize);
+                }
+            }
+            catch (...)
+            {
+                failed.store(true);
+            }
+        };
+        runOnThreads(threads, worker);
+        return !failed.load();
+    }
+
+    // Appends whole chunks of items, encoding them on the given number of threads, including the calling one.
+    // The caller must hold the data lock and the library lock, which is released while the chunks are encoded.
+    // The caller drops the rows of a failed append.
+    static bool writeChunksParallel(const hid_t datasetId, const std::vector<ChunkFilter>& pipeline, const size_t itemSize, const hsize_t chunkRows,
+        const hsize_t firstRow, const hsize_t chunkCount, const void* itemBuffer, const unsigned threads, std::unique_lock<std::mutex>& libraryLock)
+    {
+        // The preallocated rows past the written chunks are kept.
+        hsize_t dims[1]{ firstRow + chunkCount * chunkRows }, extent;
+        if (!countItems(datasetId, extent) || (extent < dims[0] && 0 > H5Dset_extent(datasetId, dims)))
             return false;
-        }
-        if (0 == dataCount) // Empty dataset
-        {
-            if (!appendItems(datasetId_, nativeTypeId_, inputCount, static_cast<void*>(const_cast<T*>(input))))
-                return traceDataAppendFailError(inputCount, datasetPath_, filePath_);
-            return true;
-        }
-        T dataFirst{}, dataLast{};
-        if (!readItem(datasetId_, nativeTypeId_, 0, static_cast<void*>(&dataFirst)))
+        const size_t chunkBytes = static_cast<size_t>(chunkRows) * itemSize;
+        const auto in = static_cast<const unsigned char*>(itemBuffer);
+
+        // The chunks are encoded in batches, so that only a few encoded chunks per thread are held in memory.
+        const hsize_t batchChunks = 4UL * threads;
+        std::vector<std::vector<unsigned char>> encoded(static_cast<size_t>(batchChunks));
+        std::vector<uint32_t> filterMasks(static_cast<size_t>(batchChunks));
+        bool status{ true };
+        for (hsize_t first = 0; status && first < chunkCount; first += batchChunks)
         {
-            traceDataReadFirstItemError(datasetPath_, filePath_);
-            return false;
-        }
-        if (!readItem(datasetId_, nativeTypeId_, dataCount - 1, static_cast<void*>(&dataLast)))
-        {
-            traceDataReadLastItemError(datasetPath_, filePath_);
-            return false;
-        }
-        const long long dataFirstTicks = dataFirst.ticks_;
-        const long long dataLastTicks = dataLast.ticks_;
-        if (inputFirstTicks > dataLastTicks) //      dddddddd
-        {                                    //               iiii
-            if (!appendItems(datasetId_, nativeTypeId_, inputCount, static_cast<void*>(const_cast<T*>(input))))
-                return traceDataAppendFailError(inputCount, datasetPath_, filePath_);
-            return true;
-        }
-        if (inputFirstTicks == dataLastTicks) //      ddddddd[d]
-        {                                     //             [i]iii
-            if (inputFirst.isDifferent(dataLast))
+            const hsize_t last = std::min(chunkCount, first + batchChunks);
+            std::atomic<hsize_t> nextChunk{ first };
+            std::atomic<bool> failed{ false };
+            libraryLock.unlock();
+            try
             {
-                const hsize_t count1 = dataCount - 1;
-                if (DuplicateTimeTicks::Update == duplicateTimeTicks)
+                runOnThreads(threads, [&]() noexcept
                 {
-                    if (verbose)
-                        traceDataDuplicateTicksUpdateInfo<T>(count1, dataLast, 0, inputFirst);
-                    if (!writeItem(datasetId_, nativeTypeId_, count1, static_cast<void*>(&inputFirst)))
-                        return traceDataDuplicateTicksUpdateError<T>(count1, dataLast, 0, inputFirst);
-                }
-                else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
-                    traceDataDuplicateTicksSkipError<T>(count1, dataLast, 0, inputFirst);
-                else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
-                    return traceDataDuplicateTicksFailError<T>(count1, dataLast, 0, inputFirst);
+                    try
+                    {
+                        std::vector<unsigned char> scratch;
+                        for (hsize_t c = nextChunk++; c < last && !failed.load(std::memory_order_relaxed); c = nextChunk++)
+                        {
+                            const auto slot = static_cast<size_t>(c - first);
+                            if (!encodeChunk(pipeline, in + c * chunkBytes, chunkBytes, encoded[slot], scratch, filterMasks[slot]))
+                                failed.store(true);
+                        }
+                    }
+                    catch (...)
+                    {
+                        failed.store(true);
+                    }
+                });
             }
-            if (1 < inputCount)
+            catch (...)
             {
-                if (!appendItems(datasetId_, nativeTypeId_, inputCount - 1, static_cast<void*>(const_cast<T*>(input + 1))))
-                    traceDataAppendOffsetFailError(inputCount - 1, 1, datasetPath_, filePath_);
+                failed.store(true);
+            }
+            libraryLock.lock();
+            status = !failed.load();
+            for (hsize_t c = first; status && c < last; ++c)
+            {
+                const auto slot = static_cast<size_t>(c - first);
+                const hsize_t offsets[1]{ firstRow + c * chunkRows };
+                status = 0 <= H5Dwrite_chunk(datasetId, H5P_DEFAULT, filterMasks[slot], offsets, encoded[slot].size(), encoded[slot].data());
             }
-            return true;
         }
-        if (inputLastTicks < dataFirstTicks) //      dddddddd
-        {                                    // iiii
-            if (!prependItems(datasetId_, nativeTypeId_, inputCount, static_cast<void*>(const_cast<T*>(input)), sizeof(T)))
-                return traceDataPrependFailError(inputCount, datasetPath_, filePath_);
-            return true;
+        return status;
+    }
+
+    // ----------------------------------------------------------------------
+    // File
+    // ----------------------------------------------------------------------
+
+    std::shared_ptr<GroupInfo> File::contentTree(const bool sort) const
+    {
+        GroupInfo* root{ new GroupInfo() };
+        {
+            ReadLock lock(mutex_);
+            LibraryLock libraryLock(theLibraryMutex);
+            if (!root->iterateGroup(fileId_, ".", root))
+                traceFileIterateError(filePath_);
         }
-        if (inputLastTicks == dataFirstTicks) //      [d]ddddddd
-        {                                     //   iii[i]
-            const hsize_t count1 = inputCount - 1;
-            if (inputFirst.isDifferent(dataFirst))
+        if (sort)
+            root->sort();
+        return std::shared_ptr<GroupInfo>(root);
+    }
+
+    std::shared_ptr<GroupInfo> File::contentTree(const char* filePath, const FileDriver fileDriver, const bool sort)
+    {
+        GroupInfo* root{ new GroupInfo() };
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            const hid_t fileId{ fileOpen(filePath, false, false, fileDriver, false, false) };
+            if (0 <= fileId)
             {
-                if (DuplicateTimeTicks::Update == duplicateTimeTicks)
-                {
-                    if (verbose)
-                        traceDataDuplicateTicksUpdateInfo<T>(0, dataFirst, count1, inputLast);
-                    if (!writeItem(datasetId_, nativeTypeId_, 0, static_cast<void*>(&inputLast)))
-                        return traceDataDuplicateTicksUpdateError<T>(0, dataFirst, count1, inputLast);
-                }
-                else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
-                    traceDataDuplicateTicksSkipError<T>(0, dataFirst, count1, inputLast);
-                else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
-                    return traceDataDuplicateTicksFailError<T>(0, dataFirst, count1, inputLast);
+                if (!root->iterateGroup(fileId, ".", root))
+                    traceFileIterateError(filePath);
+                if (0 > H5Fclose(fileId))
+                    traceFileCloseError(filePath);
             }
-            if (0 < count1)
+            else
+                traceFileOpenReadOnlyError(filePath);
+        }
+        if (sort)
+            root->sort();
+        return std::shared_ptr<GroupInfo>(root);
+    }
+
+    bool File::enumerateDatasets(const DataInfoEnumerator& enumerate, bool sort) const
+    {
+        GroupInfo root{};
+        {
+            ReadLock lock(mutex_);
+            LibraryLock libraryLock(theLibraryMutex);
+            if (!root.iterateGroup(fileId_, ".", &root))
             {
-                if (!prependItems(datasetId_, nativeTypeId_, count1, static_cast<void*>(const_cast<T*>(input)), sizeof(T)))
-                    return traceDataPrependFailError(count1, datasetPath_, filePath_);
+                traceFileIterateError(filePath_);
+                return false;
             }
-            return true;
         }
-        if (inputLastTicks > dataLastTicks)
+        if (sort)
         {
-            hsize_t index; bool match;
-            if (inputFirstTicks > dataFirstTicks) // dddddddddddd[d]
-            {                                     //          iii[i]iiiiiii
-                index = lowerNeighborIndex<T>(input, inputCount, dataLastTicks, match);
-                if (match)
-                {
-                    T t = *(input + index);
-                    if (t.isDifferent(dataLast))
-                    {
-                        const hsize_t count1 = dataCount - 1;
-                        if (DuplicateTimeTicks::Update == duplicateTimeTicks)
-                        {
-                            if (verbose)
-                                traceDataDuplicateTicksUpdateInfo<T>(count1, dataLast, index, t);
-                            if (!writeItem(datasetId_, nativeTypeId_, count1, static_cast<void*>(&t)))
-                                return traceDataDuplicateTicksUpdateError<T>(count1, dataLast, index, t);
-                        }
-                        else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
-                            traceDataDuplicateTicksSkipError<T>(count1, dataLast, index, t);
-                        else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
-                            return traceDataDuplicateTicksFailError<T>(count1, dataLast, index, t);
-                    }
-                    if (0 < index)
-                    {
-                        if (!mergeItems(datasetId_, nativeTypeId_, 0, index, input, duplicateTimeTicks, verbose))
-                            return traceDataMergeFailError(index, datasetPath_, filePath_);
-                    }
-                }
-                else if (0 <= index)
-                {
-                    if (!mergeItems(datasetId_, nativeTypeId_, 0, index + 1, input, duplicateTimeTicks, verbose))
-                        return traceDataMergeFailError(index, datasetPath_, filePath_);
-                }
-                if (++index < inputCount)
-                {
-                    if (!appendItems(datasetId_, nativeTypeId_, inputCount - index, static_cast<void*>(const_cast<T*>(input + index))))
-                        return traceDataAppendOffsetFailError(inputCount - index, index, datasetPath_, filePath_);
-                }
-            }
-            else //     [d]ddddddd[d]
-            {    // iiii[i]iiiiiii[i]iiiiiii
-                index = lowerNeighborIndex<T>(input, inputCount, dataFirstTicks, match);
-                if (match)
-                {
-                    T t = *(input + index);
-                    if (t.isDifferent(dataFirst))
-                    {
-                        if (DuplicateTimeTicks::Update == duplicateTimeTicks)
-                        {
-                            if (verbose)
-                                traceDataDuplicateTicksUpdateInfo<T>(0, dataFirst, index, t);
-                            if (!writeItem(datasetId_, nativeTypeId_, 0, static_cast<void*>(&t)))
-                                return traceDataDuplicateTicksUpdateError<T>(0, dataFirst, index, t);
-                        }
-                        else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
-                            traceDataDuplicateTicksSkipError<T>(0, dataFirst, index, t);
-                        else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
-                            return traceDataDuplicateTicksFailError<T>(0, dataFirst, index, t);
-                    }
-                    if (0 < index)
-                    {
-                        if (!prependItems(datasetId_, nativeTypeId_, index, static_cast<void*>(const_cast<T*>(input)), sizeof(T)))
-                            return traceDataPrependFailError(index, datasetPath_, filePath_);
-                    }
-                }
-                else
-                {
-                    if (!prependItems(datasetId_, nativeTypeId_, index + 1, static_cast<void*>(const_cast<T*>(input)), sizeof(T)))
-                        return traceDataPrependFailError(index, datasetPath_, filePath_);
-                }
-                ++index; // The upper neighbor.
-                hsize_t index2 = lowerNeighborIndex<T>(input, inputCount, dataLastTicks, match);
-                if (match)
-                {
-                    T t = *(input + index2);
-                    if (t.isDifferent(dataLast))
-                    {
-                        const hsize_t count1 = dataCount - 1;
-                        if (DuplicateTimeTicks::Update == duplicateTimeTicks)
-                        {
-                            if (verbose)
-                                traceDataDuplicateTicksUpdateInfo<T>(count1, dataLast, index, t);
-                            if (!writeItem(datasetId_, nativeTypeId_, count1, static_cast<void*>(&t)))
-                                return traceDataDuplicateTicksUpdateError<T>(count1, dataLast, index, t);
-                        }
-                        else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
-                            traceDataDuplicateTicksSkipError<T>(count1, dataLast, index, t);
-                        else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
-                            return traceDataDuplicateTicksFailError<T>(count1, dataLast, index, t);
-                    }
-                }
-                if (index <= index2)
-                {
-                    if (!mergeItems(datasetId_, nativeTypeId_, index, index2 - index + 1, input, duplicateTimeTicks, verbose))
-                        return traceDataMergeOffsetFailError(index2 - index + 1, index, datasetPath_, filePath_);
-                }
-                ++index2; // The upper neighbor.
-                if (index2 < inputCount)
-                {
-                    if (!appendItems(datasetId_, nativeTypeId_, inputCount - index2, static_cast<void*>(const_cast<T*>(input + index2))))
-                        return traceDataAppendOffsetFailError(inputCount - index2, index2, datasetPath_, filePath_);
-                }
-            }
+            DataInfoList* list{ new DataInfoList() };
+            root.moveDatasetsTo(list);
+            const size_t size{ list->size() };
+            const DataInfo** const data = list->data();
+            if (size > 1)
+                std::qsort(static_cast<void*>(data), size, sizeof(DataInfo*), DataInfo::compare);
+            for (size_t i = 0; i < size; ++i)
+                enumerate(*data[i]);
+            delete list;
         }
         else
         {
-            if (inputFirstTicks > dataFirstTicks) // ddd[d]ddd[d]ddddd
-            {                                     //    [i]iii[i]
-                if (!mergeItems<T>(datasetId_, nativeTypeId_, 0, inputCount, input, duplicateTimeTicks, verbose))
-                    return traceDataMergeFailError(inputCount, datasetPath_, filePath_);
+            root.enumerateDatasetsRecursive(enumerate);
+        }
+        return true;
+    }
+
+    bool File::enumerateDatasets(const DataInfoEnumerator& enumerate, const char* instrumentPath, const bool sort) const
+    {
+        GroupInfo root{};
+        {
+            ReadLock lock(mutex_);
+            LibraryLock libraryLock(theLibraryMutex);
+            if (!root.iterateGroup(fileId_, instrumentPath, &root))
+            {
+                traceFileIterateError(filePath_);
+                return false;
             }
-            else //      [d]dddddddd
-            {    // iiiii[i]ii
-                bool match;
-                hsize_t index = lowerNeighborIndex<T>(input, inputCount, dataFirstTicks, match);
-                if (match)
-                {
-                    T t = *(input + index);
-                    if (t.isDifferent(dataFirst))
-                    {
-                        if (DuplicateTimeTicks::Update == duplicateTimeTicks)
-                        {
-                            if (verbose)
-                                traceDataDuplicateTicksUpdateInfo<T>(0, dataFirst, index, t);
-                            if (!writeItem(datasetId_, nativeTypeId_, 0, static_cast<void*>(&t)))
-                                return traceDataDuplicateTicksUpdateError<T>(0, dataFirst, index, t);
-                        }
-                        else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
-                            traceDataDuplicateTicksSkipError<T>(0, dataFirst, index, t);
-                        else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
-                            return traceDataDuplicateTicksFailError<T>(0, dataFirst, index, t);
-                    }
-                    if (0 < index)
-                    {
-                        if (!prependItems(datasetId_, nativeTypeId_, index, static_cast<void*>(const_cast<T*>(input)), sizeof(T)))
-                            return traceDataPrependFailError(index, datasetPath_, filePath_);
-                    }
-                }
-                else if (0 <= index)
+        }
+        if (sort)
+            root.sort();
+        root.enumerateDatasets(enumerate);
+        return true;
+    }
+
+    bool File::enumerateDatasets(const DataInfoEnumerator& enumerate, const char* filePath, FileDriver fileDriver, bool sort)
+    {
+        const std::shared_ptr<File> f = openReadOnly(filePath, fileDriver);
+        if (!f.operator bool())
+            return false;
+        return f->enumerateDatasets(enumerate, sort);
+    }
+
+    bool File::enumerateDatasets(const DataInfoEnumerator& enumerate, const char* filePath, FileDriver fileDriver, const char* instrumentPath, bool sort)
+    {
+        const std::shared_ptr<File> f = openReadOnly(filePath, fileDriver);
+        if (!f.operator bool())
+            return false;
+        return f->enumerateDatasets(enumerate, instrumentPath, sort);
+    }
+
+    static herr_t traceCallback(const unsigned number, const H5E_error2_t* errorDescription, void* clientData)
+    {
+        // ReSharper disable once CppCStyleCast
+        const auto log = (ErrorLogger)clientData;
+        if (nullptr != log)
+        {
+            const int bufferSize{ 512 };
+            char buffer[bufferSize];
+            std::string text{ "h5: HDF5 error #" };
+            text.append(stringFromNumber(number, buffer, bufferSize));
+            text.append(": class: ");
+            if (0 > H5Eget_class_name(errorDescription->cls_id, buffer, bufferSize))
+                return herr_t(-1);
+
+            text.append(buffer);
+            text.append(", major: ");
+            if (0 > H5Eget_msg(errorDescription->maj_num, nullptr, buffer, bufferSize))
+                return herr_t(-1);
+
+            text.append(buffer);
+            text.append(", minor: ");
+            if (0 > H5Eget_msg(errorDescription->min_num, nullptr, buffer, bufferSize))
+                return herr_t(-1);
+
+            text.append(buffer);
+            text.append(" (file:");
+            text.append(errorDescription->file_name);
+            text.append(", func:");
+            text.append(errorDescription->func_name);
+            text.append(", line:");
+            text.append(stringFromNumber(errorDescription->line, buffer, bufferSize));
+            text.append(")");
+            log(text.c_str(), true);
+        }
+        return herr_t(0);
+    }
+
+    static herr_t autoTrace(const hid_t errorStackId, void* clientData)
+    {
+        return H5Ewalk2(errorStackId, H5E_WALK_UPWARD, traceCallback, clientData);
+    }
+
+    void File::interceptErrorStack(const ErrorLogger errorLogger)
+    {
+        errorLoggerFunc.store(errorLogger);
+        // ReSharper disable CppCStyleCast
+        if (0 > H5Eset_auto(H5E_DEFAULT, autoTrace, (void*)errorLogger))
+            // ReSharper restore CppCStyleCast
+            if (nullptr != errorLogger)
+                errorLogger("h5: Error: H5Eset_auto() failed", true);
+    }
+
+    File::File(const char* filePath, const hid_t fileId, const bool readOnly, const bool swmr) :
+        filePath_{ filePath },
+        fileId_{ fileId },
+        readOnly_{ readOnly },
+        swmr_{ swmr }
+    {
+    }
+
+    File::~File() noexcept
+    {
+    	try
+    	{
+			close();
+		}
+    	catch(...)
+    	{
+    	}
+    }
+
+    void File::close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(corkMutex_);
+            stopCorking_ = true;
+        }
+        wakeCorking_.notify_all();
+        if (corkThread_.joinable())
+            corkThread_.join();
+        WriteLock lock(mutex_);
+        LibraryLock libraryLock(theLibraryMutex);
+        if (0 <= fileId_)
+        {
+            if (!readOnly_)
+                if (0 > H5Fflush(fileId_, H5F_SCOPE_LOCAL))
+                    traceFileFlushError(filePath_);
+            if (0 > H5Fclose(fileId_))
+                traceFileCloseError(filePath_);
+            fileId_ = -1;
+        }
+    }
+
+    void File::flush() const
+    {
+        ReadLock lock(mutex_);
+        LibraryLock libraryLock(theLibraryMutex);
+        if (!readOnly_ && 0 <= fileId_)
+            if (0 > H5Fflush(fileId_, H5F_SCOPE_LOCAL))
+                traceFileFlushError(filePath_);
+    }
+
+    size_t File::metadataCacheBytes() const
+    {
+        ReadLock lock(mutex_);
+        LibraryLock libraryLock(theLibraryMutex);
+        size_t maximumBytes, minimumCleanBytes, bytes{ 0 };
+        int entries;
+        if (0 <= fileId_ && 0 > H5Fget_mdc_size(fileId_, &maximumBytes, &minimumCleanBytes, &bytes, &entries))
+            bytes = 0;
+        return bytes;
+    }
+
+    void File::flushCorked(const CorkOptions corkOptions)
+    {
+        // The library is taken without waiting when no writer holds it. Only a flush which is due or a check of the size
+        // put off for several polls waits for the writer, which gets the library back right after.
+        // The flush writes the dirty entries, the evictions after it write nothing until the cache is corked again.
+        const std::chrono::milliseconds poll{ 10 };
+        const unsigned maximumBusyPolls{ 10 };
+        const std::chrono::milliseconds interval{ corkOptions.flushMilliseconds_ };
+        auto flushed = std::chrono::steady_clock::now();
+        bool evicting{ false };
+        unsigned busyPolls{ 0 };
+        std::unique_lock<std::mutex> lock(corkMutex_);
+        while (!wakeCorking_.wait_for(lock, poll, [this] { return stopCorking_; }))
+        {
+            lock.unlock();
+            {
+                std::unique_lock<std::mutex> libraryLock(theLibraryMutex, std::try_to_lock);
+                if (!libraryLock.owns_lock() && (++busyPolls >= maximumBusyPolls || (0 < interval.count() && std::chrono::steady_clock::now() - flushed >= interval)))
+                    libraryLock.lock();
+                size_t maximumBytes, minimumCleanBytes, bytes;
+                int entries;
+                if (libraryLock.owns_lock() && 0 <= H5Fget_mdc_size(fileId_, &maximumBytes, &minimumCleanBytes, &bytes, &entries))
+                {
+                    busyPolls = 0;
+                    const auto now = std::chrono::steady_clock::now();
+                    const bool full = 0 < corkOptions.maximumBytes_ && bytes >= corkOptions.maximumBytes_;
+                    if (evicting && bytes <= corkOptions.maximumBytes_ / 2)
+                        evicting = !fileCork(fileId_, true, 0);
+                    if ((full && !evicting) || (0 < interval.count() && now - flushed >= interval))
+                    {
+                        if (0 > H5Fflush(fileId_, H5F_SCOPE_LOCAL))
+                            traceFileFlushError(filePath_);
+                        else
+                            corkFlushes_.fetch_add(1, std::memory_order_relaxed);
+                        flushed = now;
+                        if (full && !evicting)
+                            evicting = fileCork(fileId_, false, corkOptions.maximumBytes_ / 2);
+                    }
+                }
+            }
+            lock.lock();
+        }
+    }
+
+    std::shared_ptr<File> File::openReadOnly(const char* filePath, const FileDriver fileDriver, const bool swmr)
+    {
+        std::shared_ptr<File> repository(nullptr);
+        const std::string path(filePath);
+        LibraryLock libraryLock(theLibraryMutex);
+        hid_t fileId = fileOpen(path.c_str(), false, false, fileDriver, false, swmr);
+        if (0 > fileId)
+            traceFileOpenReadOnlyError(filePath);
+        else
+            repository = std::make_shared<File>(path.c_str(), fileId, true, swmr);
+        return repository;
+    }
+
+    std::shared_ptr<File> File::openReadWrite(const char* filePath, const bool createNonexistent, const FileDriver fileDriver, const bool corkTheCache, const bool swmr)
+    {
+        std::shared_ptr<File> repository(nullptr);
+        const std::string path(filePath);
+        LibraryLock libraryLock(theLibraryMutex);
+        hid_t fileId = fileOpen(path.c_str(), true, createNonexistent, fileDriver, corkTheCache, swmr);
+        if (0 > fileId)
+            traceFileOpenReadWriteError(filePath, createNonexistent);
+        else
+            repository = std::make_shared<File>(path.c_str(), fileId, false, swmr);
+        return repository;
+    }
+
+    std::shared_ptr<File> File::openReadWrite(const char* filePath, const bool createNonexistent, const FileDriver fileDriver, const CorkOptions& corkOptions, const bool swmr)
+    {
+        std::shared_ptr<File> repository = openReadWrite(filePath, createNonexistent, fileDriver, true, swmr);
+        if (repository && (0 < corkOptions.maximumBytes_ || 0 < corkOptions.flushMilliseconds_))
+            repository->corkThread_ = std::thread(&File::flushCorked, repository.get(), corkOptions);
+        return repository;
+    }
+
+    bool File::deleteObject(const char* objectPath, const bool deleteEmptyParentPath) const
+    {
+        WriteLock lock(mutex_);
+        LibraryLock libraryLock(theLibraryMutex);
+        segmentsDelete(fileId_, objectPath);
+        herr_t err = H5Ldelete(fileId_, objectPath, H5P_DEFAULT);
+        if (err < 0)
+            return traceFailedToDeleteObjectError("an object", objectPath);
+        if (deleteEmptyParentPath)
+        {
+            std::string path{ objectPath };
+            while (true)
+            {
+                const std::string::size_type index = path.find_last_of('/');
+                if (std::string::npos != index && index > 0)
+                {
+                    path = path.substr(0, index);
+                    const char* groupPath = path.c_str();
+                    if (isEmptyGroup(fileId_, groupPath))
+                    {
+                        err = H5Ldelete(fileId_, groupPath, H5P_DEFAULT);
+                        if (err < 0)
+                        {
+                            traceFailedToDeleteObjectError("an empty group", groupPath);
+                            break;
+                        }
+                        continue;
+                    }
+                }
+                break;
+            }
+        }
+        return true;
+    }
+
+    bool File::moveInstrument(const char* instrumentPathOld, const char* instrumentPathNew) const
+    {
+        WriteLock lock(mutex_);
+        LibraryLock libraryLock(theLibraryMutex);
+        // Create group creation property list and set it to allow creation of intermediate groups.
+        const hid_t lcpl_id = H5Pcreate(H5P_LINK_CREATE);
+        H5Pset_create_intermediate_group(lcpl_id, 1);
+        const herr_t status = H5Lmove(fileId_, instrumentPathOld, fileId_, instrumentPathNew, lcpl_id, H5P_DEFAULT);
+        H5Pclose(lcpl_id);
+        if (0 > status)
+            return traceFailedToMoveInstrumentError(instrumentPathOld, instrumentPathNew);
+        segmentsReroot(fileId_, instrumentPathNew);
+        return true;
+    }
+
+    bool File::renameInstrument(const char* instrumentPath, const char* instrumentNewName) const
+    {
+        std::string path{ instrumentPath };
+        const auto index = path.find_last_of('/');
+        if (std::string::npos == index || path.length() <= index)
+            return traceFailedToExtractGroupNameError(instrumentPath);
+        const std::string instrumentOldName = path.substr(index + 1);
+        if (instrumentOldName.length() < 1)
+            return traceFailedToExtractGroupNameError(instrumentPath);
+        if (0 == index)
+            path = "/";
+        else
+        {
+            path = path.substr(0, index);
+            const auto length = path.length();
+            if (1 < length && path[length - 1] == '/')
+                path = path.substr(0, length - 1);
+        }
+
+        WriteLock lock(mutex_);
+        LibraryLock libraryLock(theLibraryMutex);
+        const hid_t idPath = groupOpen(path.c_str(), fileId_, false, false);
+        if (0 > idPath)
+            return traceGroupOpenError(path.c_str());
+        const herr_t status = H5Lmove(idPath, instrumentOldName.c_str(), idPath, instrumentNewName, H5P_DEFAULT, H5P_DEFAULT);
+        H5Gclose(idPath);
+        if (0 > status)
+            return traceFailedToMoveInstrumentGroupError(path.c_str(), instrumentOldName.c_str(), instrumentNewName);
+        segmentsReroot(fileId_, ("/" == path ? path : path + "/") + instrumentNewName);
+        return true;
+    }
+
+    std::shared_ptr<Instrument> File::openInstrument(const char* instrumentPath, const bool createNonexistent)
+    {
+        std::shared_ptr<Instrument> instrument(nullptr);
+        ReadLock lock(mutex_);
+        hid_t groupId;
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            groupId = groupOpen(instrumentPath, fileId_, !readOnly_, createNonexistent);
+        }
+        if (0 > groupId)
+            traceFileOpenInstrumentError(instrumentPath, filePath_);
+        else
+            instrument = std::make_shared<Instrument>(instrumentPath, groupId, readOnly_, filePath_, datasetCreationOptions_, swmr_);
+        return instrument;
+    }
+
+    DatasetCreationOptions File::datasetCreationOptions() const
+    {
+        ReadLock lock(mutex_);
+        return datasetCreationOptions_;
+    }
+
+    void File::setDatasetCreationOptions(const DatasetCreationOptions& options)
+    {
+        WriteLock lock(mutex_);
+        datasetCreationOptions_ = options;
+    }
+
+    size_t File::chunkCacheBudget()
+    {
+        return theChunkCacheBudget.load(std::memory_order_relaxed);
+    }
+
+    void File::setChunkCacheBudget(const size_t bytes)
+    {
+        theChunkCacheBudget.store(bytes, std::memory_order_relaxed);
+    }
+
+    size_t File::chunkCacheBytes()
+    {
+        return theChunkCacheBytes.load(std::memory_order_relaxed);
+    }
+
+    // ----------------------------------------------------------------------
+    // Instrument
+    // ----------------------------------------------------------------------
+
+    Instrument::Instrument(const char* instrumentPath, const hid_t groupId, const bool readOnly, std::string filePath, const DatasetCreationOptions& datasetCreationOptions, const bool swmr) :
+        filePath_{std::move(filePath)},
+        instrumentPath_{ instrumentPath },
+        datasetCreationOptions_{ datasetCreationOptions },
+        groupId_{ groupId },
+        readOnly_{ readOnly },
+        swmr_{ swmr }
+    {
+    }
+
+    Instrument::~Instrument()
+    {
+		try
+		{
+			close();
+		}
+		catch (...)
+		{
+		}
+	}
+
+    void Instrument::close()
+    {
+        WriteLock lock(mutex_);
+        LibraryLock libraryLock(theLibraryMutex);
+        if (0 <= groupId_)
+        {
+            if (!readOnly_)
+                if (0 > H5Gflush(groupId_))
+                    traceInstrumentFlushError(instrumentPath_, filePath_);
+            if (0 > H5Gclose(groupId_))
+                traceInstrumentCloseError(instrumentPath_, filePath_);
+            groupId_ = -1;
+        }
+    }
+
+    void Instrument::flush() const
+    {
+        ReadLock lock(mutex_);
+        LibraryLock libraryLock(theLibraryMutex);
+        if (!readOnly_ && 0 <= groupId_)
+            if (0 > H5Gflush(groupId_))
+                traceInstrumentFlushError(instrumentPath_, filePath_);
+    }
+
+    int Instrument::compareDataset(const void* first, const void* second) noexcept
+    {
+		// ReSharper disable CppCStyleCast
+		const auto p1 = (const DataInfo*)first;
+		const auto p2 = (const DataInfo*)second;
+		// ReSharper restore CppCStyleCast
+
+		return strcmp(p1->name(), p2->name());
+    }
+
+    bool Instrument::enumerateDatasets(const DataInfoEnumerator& enumerate, const bool sort) const
+    {
+        bool status;
+		GroupInfo root{};
+		{
+			ReadLock lock(mutex_);
+			LibraryLock libraryLock(theLibraryMutex);
+			status = root.iterateGroup(groupId_, instrumentPath_.c_str(), &root);
+		}
+    	if (status)
+        {
+	        if (sort)
+		        root.sort();
+	        root.enumerateDatasets(enumerate);
+        }
+    	else
+			traceInstrumentDatasetEnumerationError(instrumentPath_, filePath_);
+
+    	return status;
+    }
+
+    static void closeTypes(DatasetTraits& datasetTraits)
+    {
+        H5Tclose(datasetTraits.standardType_);
+        H5Tclose(datasetTraits.nativeType_);
+    }
+
+    std::shared_ptr<QuoteData> Instrument::openQuoteData(const bool createNonexistent) const
+    {
+        return openQuoteData(createNonexistent, datasetCreationOptions_);
+    }
+
+    std::shared_ptr<QuoteData> Instrument::openQuoteData(const bool createNonexistent, const DatasetCreationOptions& options) const
+    {
+        std::shared_ptr<QuoteData> ptr;
+        DatasetTraits datasetTraits;
+        DatasetColumns columns;
+        size_t chunkCacheBytes;
+        hid_t datasetId;
+        ReadLock lock(mutex_);
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            if (!dataKind2DatasetTraits(DataKind::QuoteAperiodic, datasetTraits))
+                return ptr;
+            datasetId = dataOpen(datasetTraits, groupId_, !readOnly_, createNonexistent, options, columns, chunkCacheBytes);
+            if (0 > datasetId)
+            {
+                closeTypes(datasetTraits);
+                return ptr;
+            }
+        }
+        ptr.reset(new QuoteData(this, datasetTraits.name_, datasetId, datasetTraits.nativeType_, datasetTraits.standardType_, readOnly_));
+        ptr->columns_.swap(columns);
+        ptr->chunkCacheBytes_ = chunkCacheBytes;
+        ptr->options_ = options;
+        return ptr;
+    }
+
+    std::shared_ptr<QuotePriceOnlyData> Instrument::openQuotePriceOnlyData(const bool createNonexistent) const
+    {
+        return openQuotePriceOnlyData(createNonexistent, datasetCreationOptions_);
+    }
+
+    std::shared_ptr<QuotePriceOnlyData> Instrument::openQuotePriceOnlyData(const bool createNonexistent, const DatasetCreationOptions& options) const
+    {
+        std::shared_ptr<QuotePriceOnlyData> ptr;
+        DatasetTraits datasetTraits;
+        DatasetColumns columns;
+        size_t chunkCacheBytes;
+        hid_t datasetId;
+        ReadLock lock(mutex_);
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            if (!dataKind2DatasetTraits(DataKind::QuotePriceOnlyAperiodic, datasetTraits))
+                return ptr;
+            datasetId = dataOpen(datasetTraits, groupId_, !readOnly_, createNonexistent, options, columns, chunkCacheBytes);
+            if (0 > datasetId)
+            {
+                closeTypes(datasetTraits);
+                return ptr;
+            }
+        }
+        ptr.reset(new QuotePriceOnlyData(this, datasetTraits.name_, datasetId, datasetTraits.nativeType_, datasetTraits.standardType_, readOnly_));
+        ptr->columns_.swap(columns);
+        ptr->chunkCacheBytes_ = chunkCacheBytes;
+        ptr->options_ = options;
+        return ptr;
+    }
+
+    std::shared_ptr<TradeData> Instrument::openTradeData(const bool createNonexistent) const
+    {
+        return openTradeData(createNonexistent, datasetCreationOptions_);
+    }
+
+    std::shared_ptr<TradeData> Instrument::openTradeData(const bool createNonexistent, const DatasetCreationOptions& options) const
+    {
+        std::shared_ptr<TradeData> ptr;
+        DatasetTraits datasetTraits;
+        DatasetColumns columns;
+        size_t chunkCacheBytes;
+        hid_t datasetId;
+        ReadLock lock(mutex_);
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            if (!dataKind2DatasetTraits(DataKind::TradeAperiodic, datasetTraits))
+                return ptr;
+            datasetId = dataOpen(datasetTraits, groupId_, !readOnly_, createNonexistent, options, columns, chunkCacheBytes);
+            if (0 > datasetId)
+            {
+                closeTypes(datasetTraits);
+                return ptr;
+            }
+        }
+        ptr.reset(new TradeData(this, datasetTraits.name_, datasetId, datasetTraits.nativeType_, datasetTraits.standardType_, readOnly_));
+        ptr->columns_.swap(columns);
+        ptr->chunkCacheBytes_ = chunkCacheBytes;
+        ptr->options_ = options;
+        return ptr;
+    }
+
+    std::shared_ptr<TradePriceOnlyData> Instrument::openTradePriceOnlyData(const bool createNonexistent) const
+    {
+        return openTradePriceOnlyData(createNonexistent, datasetCreationOptions_);
+    }
+
+    std::shared_ptr<TradePriceOnlyData> Instrument::openTradePriceOnlyData(const bool createNonexistent, const DatasetCreationOptions& options) const
+    {
+        std::shared_ptr<TradePriceOnlyData> ptr;
+        DatasetTraits datasetTraits;
+        DatasetColumns columns;
+        size_t chunkCacheBytes;
+        hid_t datasetId;
+        ReadLock lock(mutex_);
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            if (!dataKind2DatasetTraits(DataKind::TradePriceOnlyAperiodic, datasetTraits))
+                return ptr;
+            datasetId = dataOpen(datasetTraits, groupId_, !readOnly_, createNonexistent, options, columns, chunkCacheBytes);
+            if (0 > datasetId)
+            {
+                closeTypes(datasetTraits);
+                return ptr;
+            }
+        }
+        ptr.reset(new TradePriceOnlyData(this, datasetTraits.name_, datasetId, datasetTraits.nativeType_, datasetTraits.standardType_, readOnly_));
+        ptr->columns_.swap(columns);
+        ptr->chunkCacheBytes_ = chunkCacheBytes;
+        ptr->options_ = options;
+        return ptr;
+    }
+
+    inline std::shared_ptr<OhlcvData> Instrument::openOhlcvData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool adjusted, const bool createNonexistent, const DatasetCreationOptions& options) const
+    {
+        std::shared_ptr<OhlcvData> ptr;
+        DatasetTraits datasetTraits;
+        DatasetColumns columns;
+        size_t chunkCacheBytes;
+        hid_t datasetId;
+        ReadLock lock(mutex_);
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            const DataKind dataKind = ohlcvKind2DataKind(kind, timeFrame, adjusted);
+            if (!dataKind2DatasetTraits(dataKind, datasetTraits))
+                return ptr;
+            datasetId = dataOpen(datasetTraits, groupId_, !readOnly_, createNonexistent, options, columns, chunkCacheBytes);
+            if (0 > datasetId)
+            {
+                closeTypes(datasetTraits);
+                return ptr;
+            }
+        }
+        ptr.reset(new OhlcvData(this, datasetTraits.name_, datasetId, datasetTraits.nativeType_, datasetTraits.standardType_, readOnly_));
+        ptr->columns_.swap(columns);
+        ptr->chunkCacheBytes_ = chunkCacheBytes;
+        ptr->options_ = options;
+        return ptr;
+    }
+
+    std::shared_ptr<OhlcvData> Instrument::openOhlcvData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool createNonexistent) const
+    {
+        return openOhlcvData(kind, timeFrame, false, createNonexistent, datasetCreationOptions_);
+    }
+
+    std::shared_ptr<OhlcvData> Instrument::openOhlcvData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool createNonexistent, const DatasetCreationOptions& options) const
+    {
+        return openOhlcvData(kind, timeFrame, false, createNonexistent, options);
+    }
+
+    std::shared_ptr<OhlcvData> Instrument::openOhlcvAdjustedData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool createNonexistent) const
+    {
+        return openOhlcvData(kind, timeFrame, true, createNonexistent, datasetCreationOptions_);
+    }
+
+    std::shared_ptr<OhlcvData> Instrument::openOhlcvAdjustedData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool createNonexistent, const DatasetCreationOptions& options) const
+    {
+        return openOhlcvData(kind, timeFrame, true, createNonexistent, options);
+    }
+
+    inline std::shared_ptr<OhlcvPriceOnlyData> Instrument::openOhlcvPriceOnlyData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool adjusted, const bool createNonexistent, const DatasetCreationOptions& options) const
+    {
+        std::shared_ptr<OhlcvPriceOnlyData> ptr;
+        DatasetTraits datasetTraits;
+        DatasetColumns columns;
+        size_t chunkCacheBytes;
+        hid_t datasetId;
+        ReadLock lock(mutex_);
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            const DataKind dataKind = ohlcvPriceOnlyKind2DataKind(kind, timeFrame, adjusted);
+            if (!dataKind2DatasetTraits(dataKind, datasetTraits))
+                return ptr;
+            datasetId = dataOpen(datasetTraits, groupId_, !readOnly_, createNonexistent, options, columns, chunkCacheBytes);
+            if (0 > datasetId)
+            {
+                closeTypes(datasetTraits);
+                return ptr;
+            }
+        }
+        ptr.reset(new OhlcvPriceOnlyData(this, datasetTraits.name_, datasetId, datasetTraits.nativeType_, datasetTraits.standardType_, readOnly_));
+        ptr->columns_.swap(columns);
+        ptr->chunkCacheBytes_ = chunkCacheBytes;
+        ptr->options_ = options;
+        return ptr;
+    }
+
+    std::shared_ptr<OhlcvPriceOnlyData> Instrument::openOhlcvPriceOnlyData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool createNonexistent) const
+    {
+        return openOhlcvPriceOnlyData(kind, timeFrame, false, createNonexistent, datasetCreationOptions_);
+    }
+
+    std::shared_ptr<OhlcvPriceOnlyData> Instrument::openOhlcvPriceOnlyData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool createNonexistent, const DatasetCreationOptions& options) const
+    {
+        return openOhlcvPriceOnlyData(kind, timeFrame, false, createNonexistent, options);
+    }
+
+    std::shared_ptr<OhlcvPriceOnlyData> Instrument::openOhlcvAdjustedPriceOnlyData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool createNonexistent) const
+    {
+        return openOhlcvPriceOnlyData(kind, timeFrame, true, createNonexistent, datasetCreationOptions_);
+    }
+
+    std::shared_ptr<OhlcvPriceOnlyData> Instrument::openOhlcvAdjustedPriceOnlyData(const OhlcvKind kind, const DataTimeFrame timeFrame, const bool createNonexistent, const DatasetCreationOptions& options) const
+    {
+        return openOhlcvPriceOnlyData(kind, timeFrame, true, createNonexistent, options);
+    }
+
+    std::shared_ptr<ScalarData> Instrument::openScalarData(const DataTimeFrame timeFrame, const bool createNonexistent) const
+    {
+        return openScalarData(timeFrame, createNonexistent, datasetCreationOptions_);
+    }
+
+    std::shared_ptr<ScalarData> Instrument::openScalarData(const DataTimeFrame timeFrame, const bool createNonexistent, const DatasetCreationOptions& options) const
+    {
+        std::shared_ptr<ScalarData> ptr;
+        DatasetTraits datasetTraits;
+        DatasetColumns columns;
+        size_t chunkCacheBytes;
+        hid_t datasetId;
+        ReadLock lock(mutex_);
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            const DataKind dataKind = scalarKind2DataKind(ScalarKind::Default, timeFrame);
+            if (!dataKind2DatasetTraits(dataKind, datasetTraits))
+                return ptr;
+            datasetId = dataOpen(datasetTraits, groupId_, !readOnly_, createNonexistent, options, columns, chunkCacheBytes);
+            if (0 > datasetId)
+            {
+                closeTypes(datasetTraits);
+                return ptr;
+            }
+        }
+        ptr.reset(new ScalarData(this, datasetTraits.name_, datasetId, datasetTraits.nativeType_, datasetTraits.standardType_, readOnly_));
+        ptr->columns_.swap(columns);
+        ptr->chunkCacheBytes_ = chunkCacheBytes;
+        ptr->options_ = options;
+        return ptr;
+    }
+
+    // ----------------------------------------------------------------------
+    // Data
+    // ----------------------------------------------------------------------
+
+    Data::Data(const Instrument* instrument, const char* name, const hid_t datasetId, const hid_t nativeTypeId, const hid_t standardTypeId, const bool readOnly) :
+        maximumReadBufferBytes_{ defaultMaximumReadBufferBytes_ },
+        maximumTickIndexBytes_{ defaultMaximumTickIndexBytes_ },
+        decompressionThreads_{ defaultDecompressionThreads_ },
+        compressionThreads_{ defaultCompressionThreads_ },
+        preallocate_{ defaultPreallocate_ },
+        chunkCacheBytes_{ 0 },
+        tickIndex_{ std::make_unique<TickIndex>() },
+        summaryCached_{ false },
+        summaryCount_{ 0UL },
+        summaryFirstTicks_{ 0L },
+        summaryLastTicks_{ 0L },
+        chunkRows_{ 0UL },
+        readCount_{ 0UL },
+        readItemCount_{ 0UL },
+        readChunkCount_{ 0UL },
+        filePath_(instrument->filePath_),
+        datasetPath_(instrument->instrumentPath_),
+        groupId_{ -1 },
+        datasetId_{ datasetId },
+        nativeTypeId_{ nativeTypeId },
+        standardTypeId_{ standardTypeId },
+        columns_{ { datasetId, nativeTypeId } },
+        zonesId_{ -1 },
+        zonesStored_{ 0 },
+        zonesLoaded_{ false },
+        zonesValid_{ false },
+        segmentsLoaded_{ false },
+        itemCount_{ 0UL },
+        itemCountTracked_{ false },
+        itemCountChanged_{ false },
+        readOnly_{ readOnly },
+        swmr_{ instrument->swmr_ }
+    {
+        datasetPath_.append("/");
+        datasetPath_.append(name);
+
+        // The group of the instrument is held open, so that the data follows it when the instrument is moved or renamed.
+        LibraryLock libraryLock(theLibraryMutex);
+        groupId_ = H5Oopen(instrument->groupId_, ".", H5P_DEFAULT);
+        columns_.head_ = readHeadCount(datasetId);
+    }
+
+    Data::~Data()
+    {
+		try
+		{
+			close();
+		}
+		catch (...)
+		{
+		}
+	}
+
+    hsize_t Data::defaultMaximumReadBufferBytes_{ 1024L * 1024L };
+    hsize_t Data::defaultMaximumTickIndexBytes_{ 1024L * 1024L };
+    unsigned Data::defaultDecompressionThreads_{ 1U };
+    unsigned Data::defaultCompressionThreads_{ 0U };
+    bool Data::defaultPreallocate_{ false };
+
+    void Data::close()
+    {
+        WriteLock lock(mutex_);
+        LibraryLock libraryLock(theLibraryMutex);
+        tickIndex_->reset();
+        summaryCached_.store(false, std::memory_order_relaxed);
+        if (0 <= datasetId_)
+        {
+            if (!readOnly_ && !shrinkNoLock())
+                storeItemCountNoLock();
+            for (const auto& column : columns_)
+            {
+                if (!readOnly_)
+                    if (0 > H5Dflush(column.first))
+                        traceDataFlushError(datasetPath_, filePath_);
+                if (0 > H5Dclose(column.first))
+                    traceDataCloseError(datasetPath_, filePath_);
+                if (column.second != nativeTypeId_ && 0 > H5Tclose(column.second))
+                    traceDataCloseNativeTypeError(datasetPath_, filePath_);
+            }
+            columns_ = { { -1, -1 } };
+            datasetId_ = -1;
+        }
+        chunkCacheRelease(chunkCacheBytes_);
+        chunkCacheBytes_ = 0;
+        itemCountTracked_ = false;
+        itemCountChanged_ = false;
+        if (0 <= zonesId_)
+        {
+            storeZonesNoLock();
+            if (0 > H5Dclose(zonesId_))
+                traceDataCloseError(datasetPath_, filePath_);
+            zonesId_ = -1;
+        }
+        zones_.clear();
+        zonesStored_ = 0;
+        zonesLoaded_ = false;
+        zonesValid_ = false;
+        for (const hid_t segmentId : segmentIds_)
+            if (0 > H5Dclose(segmentId))
+                traceDataCloseError(datasetPath_, filePath_);
+        segmentIds_.clear();
+        segments_.clear();
+        segmentsLoaded_ = false;
+        if (0 <= groupId_)
+        {
+            if (0 > H5Oclose(groupId_))
+                traceDataCloseError(datasetPath_, filePath_);
+            groupId_ = -1;
+        }
+        if (0 <= nativeTypeId_)
+        {
+            if (0 > H5Tclose(nativeTypeId_))
+                traceDataCloseNativeTypeError(datasetPath_, filePath_);
+            nativeTypeId_ = -1;
+        }
+        if (0 <= standardTypeId_)
+        {
+            if (0 > H5Tclose(standardTypeId_))
+                traceDataCloseStandardTypeError(datasetPath_, filePath_);
+            standardTypeId_ = -1;
+        }
+    }
+
+    void Data::flush() const
+    {
+        ReadLock lock(mutex_);
+        LibraryLock libraryLock(theLibraryMutex);
+        if (!readOnly_ && 0 <= datasetId_)
+        {
+            storeItemCountNoLock();
+            for (const auto& column : columns_)
+                if (0 > H5Dflush(column.first))
+                    traceDataFlushError(datasetPath_, filePath_);
+            for (const hid_t segmentId : segmentIds_)
+                if (0 > H5Dflush(segmentId))
+                    traceDataFlushError(datasetPath_, filePath_);
+            storeZonesNoLock();
+            if (0 <= zonesId_ && 0 > H5Dflush(zonesId_))
+                traceDataFlushError(datasetPath_, filePath_);
+        }
+    }
+
+    long long Data::firstTicks() const
+    {
+        return summary().firstTicks_;
+    }
+
+    long long Data::lastTicks() const
+    {
+        return summary().lastTicks_;
+    }
+
+    hsize_t Data::count() const
+    {
+        return summary().count_;
+    }
+
+    DataSummary Data::summary() const
+    {
+        DataSummary summary{ 0UL, 0L, 0L };
+        ReadLock lock(mutex_);
+        if (!summaryNoLock(summary))
+            summary.count_ = 0UL;
+        return summary;
+    }
+
+    DataReadStatistics Data::readStatistics() const
+    {
+        return { readCount_.load(std::memory_order_relaxed), readItemCount_.load(std::memory_order_relaxed), readChunkCount_.load(std::memory_order_relaxed) };
+    }
+
+    bool Data::refresh() const
+    {
+        WriteLock lock(mutex_);
+        return refreshNoLock();
+    }
+
+    bool Data::refreshNoLock() const
+    {
+        // The writer sees its own writes. The tick index follows the new item count on the next lookup.
+        summaryCached_.store(false, std::memory_order_relaxed);
+        if (readOnly_)
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            for (const auto& column : columns_)
+            {
+                if (0 > H5Drefresh(column.first))
+                {
+                    traceDataRefreshError(datasetPath_, filePath_);
+                    return false;
+                }
+            }
+            zonesLoaded_ = false;
+            if (0 <= zonesId_ && 0 > H5Drefresh(zonesId_))
+            {
+                traceDataRefreshError(datasetPath_, filePath_);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename T> bool Data::followData(const Collect<T>& collect, hsize_t& index) const
+    {
+        {
+            WriteLock lock(mutex_);
+            if (!refreshNoLock())
+                return false;
+        }
+
+        // The items are only appended by the writer, so the ones after the index are the new ones.
+        // Only the count is read, the summary would also read the first and the last items.
+        ReadLock lock(mutex_);
+        hsize_t dataCount;
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            if (!countRowsNoLock(dataCount))
+            {
+                traceDataGetItemCountError(datasetPath_, filePath_);
+                return false;
+            }
+        }
+        if (index >= dataCount)
+            return true;
+        if (!collectItemsNoLock<T>(collect, index, dataCount - index))
+            return false;
+        index = dataCount;
+        return true;
+    }
+
+    void Data::resetReadStatistics() const
+    {
+        readCount_.store(0UL, std::memory_order_relaxed);
+        readItemCount_.store(0UL, std::memory_order_relaxed);
+        readChunkCount_.store(0UL, std::memory_order_relaxed);
+    }
+
+    hsize_t Data::chunkRowsNoLock() const
+    {
+        hsize_t chunkRows = chunkRows_.load(std::memory_order_relaxed);
+        if (0 == chunkRows)
+        {
+            chunkRows = datasetChunkRows(segmentedNoLock() ? segmentIds_.back() : datasetId_);
+            chunkRows_.store(chunkRows, std::memory_order_relaxed);
+        }
+        return chunkRows;
+    }
+
+    bool Data::fetchZones(std::vector<DataZone>& zones) const
+    {
+        ReadLock lock(mutex_);
+        LibraryLock libraryLock(theLibraryMutex);
+        if (!loadZonesNoLock(true))
+        {
+            zones.clear();
+            return false;
+        }
+        zones = zones_;
+        return true;
+    }
+
+    bool Data::buildZones() const
+    {
+        WriteLock lock(mutex_);
+        LibraryLock libraryLock(theLibraryMutex);
+
+        // The datasets cannot be created in the SWMR mode.
+        bool status = !readOnly_ && !swmr_;
+        if (status && !loadZonesNoLock(false) && 0 > zonesId_)
+            status = openZonesNoLock(true);
+        status = status && loadZonesNoLock(true);
+        if (status)
+            storeZonesNoLock();
+        else
+            traceDataZonesError(datasetPath_, filePath_);
+        return status && zonesValid_;
+    }
+
+    bool Data::openZonesNoLock(const bool create) const
+    {
+        size_t chunkCacheBytes;
+        const hid_t dapl_id = zonesAccess(options_, chunkCacheBytes);
+        const hid_t access = 0 <= dapl_id ? dapl_id : H5P_DEFAULT;
+        std::string path;
+        if (!pathNoLock(path))
+            zonesId_ = -1;
+        else if (create)
+        {
+            const hid_t fileId = H5Iget_file_id(datasetId_);
+            zonesId_ = 0 <= fileId ? zonesCreate(fileId, path + zonesNameSuffix, access) : -1;
+            if (0 <= fileId)
+                H5Fclose(fileId);
+        }
+        else
+            zonesId_ = zonesOpen(datasetId_, path + zonesNameSuffix, access);
+        if (0 <= dapl_id)
+            H5Pclose(dapl_id);
+        if (0 > zonesId_)
+        {
+            chunkCacheRelease(chunkCacheBytes);
+            return false;
+        }
+        chunkCacheBytes_ += chunkCacheBytes;
+        return true;
+    }
+
+    bool Data::loadZonesNoLock(const bool build) const
+    {
+        if (zonesLoaded_ && zonesValid_)
+        {
+            // The zone maps of the items written by another handle of the data since are loaded again.
+            hsize_t dataCount, zonesCount{ 0 };
+            for (const auto& zone : zones_)
+                zonesCount += zone.count_;
+            if (!countRowsNoLock(dataCount) || dataCount != zonesCount)
+                zonesLoaded_ = false;
+        }
+        if (!zonesLoaded_)
+        {
+            zonesLoaded_ = true;
+            zonesValid_ = false;
+            zones_.clear();
+            zonesStored_ = 0;
+            if (0 > zonesId_)
+                (void)openZonesNoLock(false);
+            hsize_t dataCount, zoneCount;
+            if (0 > zonesId_ || !countRowsNoLock(dataCount) || !countItems(zonesId_, zoneCount))
+                return false;
+
+            // The zone maps are outdated if the data has been written by a writer not maintaining them,
+            // which shows in the item counts unless the writer has only updated the existing items.
+            const hsize_t chunkRows = chunkRowsNoLock();
+            bool current = zoneCount <= dataCount && (0 == zoneCount) == (0 == dataCount);
+            if (current && 0 < zoneCount)
+            {
+                const hid_t type = zoneType(false);
+                zones_.resize(static_cast<size_t>(zoneCount));
+                current = 0 <= type && readItemRange(zonesId_, type, 0, zoneCount, zones_.data());
+                if (0 <= type)
+                    H5Tclose(type);
+                hsize_t count{ 0 };
+                for (size_t z = 0; current && z < zones_.size(); ++z)
+                {
+                    current = 0 < zones_[z].count_ && chunkRows >= zones_[z].count_;
+                    count += zones_[z].count_;
+                }
+                current = current && count == dataCount;
+            }
+            if (current)
+            {
+                zonesValid_ = true;
+                zonesStored_ = zones_.size();
+                return true;
+            }
+
+            // The outdated zone maps are dropped, so that the later writes do not make them look current.
+            zones_.clear();
+            hsize_t dims[1]{ 0 };
+            if (!readOnly_)
+                H5Dset_extent(zonesId_, dims);
+        }
+        if (zonesValid_ || !build || readOnly_ || 0 > zonesId_)
+            return zonesValid_;
+
+        // The zone maps after the valid ones are rebuilt from the stored items chunk by chunk and stored on a flush.
+        const size_t validCount = zones_.size();
+        const hsize_t itemOffset = zoneStarts(zones_).back();
+        hsize_t dataCount{ 0 };
+        const bool status = countRowsNoLock(dataCount) && itemOffset <= dataCount
+            && zonesRead(columns_, H5Tget_size(nativeTypeId_), chunkRowsNoLock(), itemOffset, dataCount - itemOffset, zones_);
+        if (!status)
+        {
+            traceDataZonesError(datasetPath_, filePath_);
+            zones_.resize(validCount);
+        }
+        zonesValid_ = status;
+        return zonesValid_;
+    }
+
+    void Data::storeZonesNoLock() const
+    {
+        if (!zonesLoaded_ || readOnly_ || 0 > zonesId_ || zonesStored_ == zones_.size())
+            return;
+        const hid_t type = zoneType(false);
+        hsize_t dims[1];
+        dims[0] = zones_.size();
+        const bool status = 0 <= type && 0 <= H5Dset_extent(zonesId_, dims)
+            && writeItemRange(zonesId_, type, zonesStored_, dims[0] - zonesStored_, zones_.data() + zonesStored_);
+        if (0 <= type)
+            H5Tclose(type);
+        if (status)
+        {
+            zonesStored_ = zones_.size();
+            return;
+        }
+
+        // The emptied zone maps are outdated for the stored items, they are rebuilt on the next read.
+        traceDataZonesError(datasetPath_, filePath_);
+        dims[0] = 0;
+        H5Dset_extent(zonesId_, dims);
+        zones_.clear();
+        zonesStored_ = 0;
+        zonesValid_ = false;
+    }
+
+    void Data::seedTickIndexNoLock() const
+    {
+        // The zone maps hold the first ticks of every chunk, which are the samples the tick index starts with.
+        if (loadZonesNoLock(false))
+            tickIndex_->seed(zones_, chunkRowsNoLock(), maximumTickIndexBytes_);
+    }
+
+    void Data::appendZonesNoLock(const void* appendedItems, const hsize_t appendedCount) const
+    {
+        // The appended items fill the last zone up to a chunk and the new ones, the zone maps to be rebuilt stay as they are.
+        if (!zonesLoaded_ || !zonesValid_ || 0 > zonesId_ || 0 == appendedCount)
+            return;
+        const hsize_t chunkRows = chunkRowsNoLock();
+        const size_t itemSize = H5Tget_size(nativeTypeId_);
+        const auto items = static_cast<const unsigned char*>(appendedItems);
+        if (!zones_.empty() && chunkRows > zones_.back().count_)
+            zonesStored_ = std::min(zonesStored_, zones_.size() - 1);
+        for (hsize_t i = 0; i < appendedCount;)
+        {
+            if (zones_.empty() || chunkRows <= zones_.back().count_)
+                zones_.emplace_back();
+            const hsize_t count = std::min(appendedCount - i, chunkRows - zones_.back().count_);
+            zoneAdd(zones_.back(), items + i * itemSize, count, itemSize);
+            i += count;
+        }
+    }
+
+    void Data::spliceZonesNoLock(const hsize_t itemOffset, const hsize_t replacedCount, const hsize_t writtenCount) const
+    {
+        if (!zonesLoaded_ || 0 > zonesId_)
+            return;
+        if (!zonesValid_)
+        {
+            dropZonesNoLock(itemOffset);
+            return;
+        }
+
+        // The zones holding the replaced items or split by the inserted ones are replaced by the zones of their items after the write,
+        // which are the written items and the rest of the replaced zones. The zones after them move along without reading their items.
+        const std::vector<hsize_t> starts = zoneStarts(zones_);
+        const hsize_t replacedEnd = itemOffset + replacedCount;
+        const size_t first = std::min(zoneOf(starts, itemOffset), zones_.size());
+        const size_t last = first < zones_.size() && (starts[first] < itemOffset || 0 < replacedCount)
+            ? std::max(first + 1, static_cast<size_t>(std::lower_bound(starts.begin(), starts.end() - 1, replacedEnd) - starts.begin())) : first;
+        const hsize_t readOffset = first < last ? starts[first] : itemOffset;
+        const hsize_t readCount = (first < last ? starts[last] : itemOffset) - readOffset - replacedCount + writtenCount;
+        std::vector<DataZone> zones;
+        if (!zonesRead(columns_, H5Tget_size(nativeTypeId_), chunkRowsNoLock(), readOffset, readCount, zones))
+        {
+            traceDataZonesError(datasetPath_, filePath_);
+            dropZonesNoLock(itemOffset);
+            return;
+        }
+        zones_.erase(zones_.begin() + static_cast<std::ptrdiff_t>(first), zones_.begin() + static_cast<std::ptrdiff_t>(last));
+        zones_.insert(zones_.begin() + static_cast<std::ptrdiff_t>(first), zones.begin(), zones.end());
+
+        // The short zones around the written items are merged with their neighbors where they fit in a chunk.
+        const hsize_t chunkRows = chunkRowsNoLock();
+        size_t changed = first;
+        const size_t seams[2]{ first + zones.size(), first };
+        for (const size_t seam : seams)
+        {
+            if (0 < seam && seam < zones_.size() && chunkRows >= zones_[seam - 1].count_ + zones_[seam].count_)
+            {
+                zoneMerge(zones_[seam - 1], zones_[seam]);
+                zones_.erase(zones_.begin() + static_cast<std::ptrdiff_t>(seam));
+                changed = std::min(changed, seam - 1);
+            }
+        }
+
+        // The stored zone maps from the first changed one on are dropped, so that they do not look current if the data is closed before they are stored.
+        zonesStored_ = std::min(zonesStored_, changed);
+        hsize_t dims[1];
+        dims[0] = zonesStored_;
+        if (0 > H5Dset_extent(zonesId_, dims))
+            traceDataZonesError(datasetPath_, filePath_);
+    }
+
+    void Data::dropZonesNoLock(const hsize_t itemOffset) const
+    {
+        if (!zonesLoaded_ || 0 > zonesId_)
+            return;
+        zones_.resize(std::min(zones_.size(), zoneOf(zoneStarts(zones_), itemOffset)));
+        zonesValid_ = false;
+        zonesStored_ = std::min(zonesStored_, zones_.size());
+        hsize_t dims[1];
+        dims[0] = zonesStored_;
+        if (0 > H5Dset_extent(zonesId_, dims))
+            traceDataZonesError(datasetPath_, filePath_);
+    }
+
+    bool Data::readItemsNoLock(const hsize_t itemOffset, const hsize_t itemCount, void* itemBuffer, std::unique_lock<std::mutex>& libraryLock) const
+    {
+        if (!segmentedNoLock())
+            return readRowsNoLock(datasetId_, itemOffset, itemCount, itemBuffer, libraryLock);
+
+        // Every segment is read from its own dataset, so that its chunks are decompressed in parallel as those of a single dataset.
+        const size_t itemSize = H5Tget_size(nativeTypeId_);
+        auto items = static_cast<unsigned char*>(itemBuffer);
+        const hsize_t itemEnd = itemOffset + itemCount;
+        auto segment = std::upper_bound(segments_.begin(), segments_.end(), itemOffset,
+            [](const hsize_t item, const DataSegment& s) { return item < s.offset_; });
+        if (segments_.begin() != segment)
+            --segment;
+        for (hsize_t item = itemOffset; item < itemEnd; ++segment)
+        {
+            if (segments_.end() == segment)
+                return false;
+            const hsize_t count = std::min(itemEnd, segment->offset_ + segment->count_) - item;
+            const hid_t segmentId = segmentIds_[static_cast<size_t>(segment - segments_.begin())];
+            if (0 < count && !readRowsNoLock(segmentId, segment->rowOffset_ + item - segment->offset_, count, items, libraryLock))
+                return false;
+            items += count * itemSize;
+            item += count;
+        }
+        return true;
+    }
+
+    bool Data::readRowsNoLock(const hid_t datasetId, const hsize_t rowOffset, const hsize_t rowCount, void* itemBuffer, std::unique_lock<std::mutex>& libraryLock) const
+    {
+        // The rows of the data are taken past the head of its dataset, the chunks are read directly from the dataset.
+        const hsize_t chunkRows = chunkRowsNoLock();
+        const hsize_t head = datasetId == datasetId_ ? columns_.head_ : 0;
+        const hsize_t chunks = 0 < rowCount ? (head + rowOffset + rowCount - 1) / chunkRows - (head + rowOffset) / chunkRows + 1 : 0;
+        unsigned threads = decompressionThreads_;
+        if (0 == threads)
+            threads = std::max(std::thread::hardware_concurrency(), 1U);
+        if (threads > chunks)
+            threads = static_cast<unsigned>(chunks);
+        std::vector<ChunkFilter> pipeline;
+        const size_t itemSize = H5Tget_size(nativeTypeId_);
+        // The columnar layout takes the library path, the direct chunk access covers a single compound dataset.
+        // The direct chunk access bypasses the chunk cache, so the reads the cache holds take the library path as well.
+        if (1 < threads && 1 == columns_.size() && static_cast<size_t>(rowCount) * itemSize > chunkCacheBytes_ && chunkPipeline(datasetId, nativeTypeId_, pipeline))
+        {
+            libraryLock.unlock();
+            const bool status = readChunksParallel(datasetId, pipeline, itemSize, chunkRows, head + rowOffset, rowCount, itemBuffer, threads);
+            libraryLock.lock();
+            if (status)
+                return true;
+        }
+        if (datasetId != datasetId_)
+            return readItemRange(datasetId, nativeTypeId_, rowOffset, rowCount, itemBuffer);
+        return readItemRange(columns_, rowOffset, rowCount, itemBuffer);
+    }
+
+    bool Data::appendItemsNoLock(const hsize_t itemCount, const void* itemBuffer, std::unique_lock<std::mutex>& libraryLock) const
+    {
+        if (!segmentedNoLock())
+            return appendRowsNoLock(datasetId_, itemCount, itemBuffer, libraryLock);
+
+        // The items go to the dataset of the last segment, which the virtual dataset maps up to its end.
+        DataSegment& segment = segments_.back();
+        const bool status = appendRowsNoLock(segmentIds_.back(), itemCount, itemBuffer, libraryLock);
+        hsize_t rowCount;
+        if (countItems(segmentIds_.back(), rowCount) && rowCount >= segment.rowOffset_)
+            segment.count_ = rowCount - segment.rowOffset_;
+        return status;
+    }
+
+    bool Data::appendRowsNoLock(const hid_t datasetId, const hsize_t itemCount, const void* itemBuffer, std::unique_lock<std::mutex>& libraryLock) const
+    {
+        // The items of the data with preallocated rows are written over the rows after the last item.
+        // The rows of the data are counted past the head of its dataset, while the chunks are written directly to the dataset.
+        hsize_t dataCount, rowCount;
+        const hsize_t head = datasetId == datasetId_ ? columns_.head_ : 0;
+        if (datasetId == datasetId_ ? !countItems(columns_, rowCount) : !countItems(datasetId, rowCount))
+            return false;
+        dataCount = rowCount;
+        const hsize_t storedRows = rowCount;
+        bool preallocated{ false };
+        if (datasetId == datasetId_)
+        {
+            if (!countRowsNoLock(dataCount))
+                return false;
+            preallocated = itemCountTracked_ || (preallocate_ && !swmr_);
+        }
+        const hsize_t chunkRows = chunkRowsNoLock();
+        const bool grown = preallocated && dataCount + itemCount > rowCount;
+        if (grown)
+        {
+            // The dataset grows in whole chunks by half of its items, up to a limit, so that a run of small appends resizes it rarely.
+            const hsize_t headroom = std::min(dataCount / 2, maximumPreallocatedChunks * chunkRows);
+            rowCount = (dataCount + itemCount + headroom + chunkRows - 1) / chunkRows * chunkRows;
+            if (!setExtent(columns_, rowCount))
+                return false;
+        }
+        const auto append = [this, datasetId, preallocated](const hsize_t row, const hsize_t count, const void* items)
+        {
+            if (preallocated)
+                return writeItemRange(columns_, row, count, items);
+            if (datasetId != datasetId_)
+                return appendItems(datasetId, nativeTypeId_, count, items);
+            return appendItems(columns_, count, items);
+        };
+        const auto written = [this, preallocated, grown, dataCount, itemCount](const bool status)
+        {
+            if (status && preallocated)
+            {
+                // The attribute is written with the rows it covers when the dataset grows, so that the preallocated rows are never taken for items.
+                // The appends within the preallocated rows keep the item count in memory until a flush.
+                itemCount_ = dataCount + itemCount;
+                if (grown || !itemCountTracked_)
+                {
+                    itemCountChanged_ = false;
+                    itemCountTracked_ = writeItemCount(columns_.front().first, itemCount_);
+                    if (!itemCountTracked_)
+                    {
+                        traceDataItemCountError(datasetPath_, filePath_);
+                        return false;
+                    }
+                }
+                else
+                    itemCountChanged_ = true;
+            }
+            return status;
+        };
+        unsigned threads = compressionThreads_;
+        if (0 == threads)
+            threads = std::max(std::thread::hardware_concurrency(), 1U);
+        std::vector<ChunkFilter> pipeline;
+        bool status{ false }, parallel{ false };
+        if (1 < threads && 1 == columns_.size() && 2 * chunkRows <= itemCount)
+        {
+            // The items up to the first chunk boundary and after the last one take the library path.
+            const hsize_t headCount = (chunkRows - (head + dataCount) % chunkRows) % chunkRows;
+            const hsize_t chunks = (itemCount - headCount) / chunkRows;
+            parallel = 1 < chunks && chunkPipeline(datasetId, nativeTypeId_, pipeline);
+            if (parallel)
+            {
+                const size_t itemSize = H5Tget_size(nativeTypeId_);
+                const auto items = static_cast<const unsigned char*>(itemBuffer);
+                const hsize_t tailCount = itemCount - headCount - chunks * chunkRows;
+                if (threads > chunks)
+                    threads = static_cast<unsigned>(chunks);
+                status = (0 == headCount || append(dataCount, headCount, itemBuffer))
+                    && writeChunksParallel(datasetId, pipeline, itemSize, chunkRows, head + dataCount + headCount, chunks, items + headCount * itemSize, threads, libraryLock)
+                    && (0 == tailCount || append(dataCount + itemCount - tailCount, tailCount, items + (itemCount - tailCount) * itemSize));
+            }
+        }
+        if (!parallel)
+            status = append(dataCount, itemCount, itemBuffer);
+        if (!status)
+        {
+            // The rows a failed append has written are dropped, so that the data holds the items it held before.
+            hsize_t dims[1]{ storedRows };
+            if (datasetId == datasetId_)
+                (void)setExtent(columns_, storedRows);
+            else
+                H5Dset_extent(datasetId, dims);
+        }
+        return written(status);
+    }
+
+    bool Data::countRowsNoLock(hsize_t& itemCount) const
+    {
+        // Another handle of the data may have trimmed its head since, which moves the items indexed by this one.
+        const hsize_t head = 0 <= columns_.front().first ? readHeadCount(columns_.front().first) : 0;
+        if (head != columns_.head_)
+        {
+            columns_.head_ = head;
+            tickIndex_->reset();
+            zonesLoaded_ = false;
+            summaryCached_.store(false, std::memory_order_relaxed);
+        }
+
+        // Another handle of the data may have preallocated rows or stored its appends since, unless this one keeps appends not yet stored.
+        if (!itemCountChanged_)
+            itemCountTracked_ = 0 <= columns_.front().first && readItemCount(columns_.front().first, itemCount_);
+        if (itemCountTracked_)
+        {
+            itemCount = itemCount_;
+            return true;
+        }
+        return countItems(columns_, itemCount);
+    }
+
+    bool Data::shrinkNoLock() const
+    {
+        hsize_t dataCount;
+        if (!countRowsNoLock(dataCount))
+            return false;
+        if (!itemCountTracked_)
+            return true;
+
+        // The dataset holds the items only and loses the attribute, as the one written without preallocation.
+        if (!setExtent(columns_, dataCount) || 0 > H5Adelete(columns_.front().first, itemCountAttributeName))
+            return traceDataShrinkError(datasetPath_, filePath_);
+        itemCountTracked_ = false;
+        itemCountChanged_ = false;
+        return true;
+    }
+
+    void Data::storeItemCountNoLock() const
+    {
+        if (!itemCountChanged_)
+            return;
+        itemCountChanged_ = false;
+        if (itemCountTracked_ && !writeItemCount(columns_.front().first, itemCount_))
+            traceDataItemCountError(datasetPath_, filePath_);
+    }
+
+    bool Data::shrinkToFit() const
+    {
+        if (readOnly_)
+            return false;
+        WriteLock lock(mutex_);
+        LibraryLock libraryLock(theLibraryMutex);
+        return 0 <= datasetId_ && shrinkNoLock();
+    }
+
+    bool Data::segmentedNoLock() const
+    {
+        if (segmentsLoaded_)
+            return !segments_.empty();
+        segmentsLoaded_ = true;
+        const hid_t dcpl_id = H5Dget_create_plist(datasetId_);
+        const bool mapped = 0 <= dcpl_id && H5D_VIRTUAL == H5Pget_layout(dcpl_id);
+        if (0 <= dcpl_id)
+            H5Pclose(dcpl_id);
+        if (!mapped)
+            return false;
+
+        // The datasets of the segments stay open, the count of the last segment follows its dataset.
+        const hid_t fileId = H5Iget_file_id(datasetId_);
+        bool status = 0 <= fileId && segmentsRead(datasetId_, segments_);
+
+        // The segments lie next to the virtual dataset, which may have been moved with its instrument since it was opened.
+        std::string path;
+        if (status && pathNoLock(path))
+            segmentsRebase(path, segments_);
+        for (size_t i = 0; status && i < segments_.size(); ++i)
+        {
+            size_t chunkCacheBytes;
+            const hid_t segmentId = datasetOpen(segments_[i].datasetPath_.c_str(), fileId, standardTypeId_, !readOnly_, false, options_, chunkCacheBytes);
+            status = 0 <= segmentId;
+            if (status)
+            {
+                segmentIds_.push_back(segmentId);
+                chunkCacheBytes_ += chunkCacheBytes;
+            }
+        }
+        hsize_t rowCount;
+        status = status && countItems(segmentIds_.back(), rowCount) && rowCount >= segments_.back().rowOffset_;
+        if (status)
+            segments_.back().count_ = rowCount - segments_.back().rowOffset_;
+        if (0 <= fileId)
+            H5Fclose(fileId);
+        if (!status)
+        {
+            traceDataLoadSegmentsError(datasetPath_, filePath_);
+            for (const hid_t segmentId : segmentIds_)
+                segmentClose(segmentId, chunkCacheBytes_);
+            segmentIds_.clear();
+            segments_.clear();
+        }
+        return status;
+    }
+
+    bool Data::deleteRowsNoLock(const hsize_t itemOffset, const hsize_t itemCount, const size_t itemSize) const
+    {
+        // Trimming the head of a data opened with the segmented option maps the dataset of the items as a segment starting after the trimmed rows
+        // instead of moving the rest of them. Other data in the compound layout keeps its dataset and moves its head past the trimmed rows instead.
+        // The trimmed rows are reclaimed by the compaction only. The SWMR readers do not follow the head, so the SWMR writers move the rows.
+        hsize_t dataCount;
+        if (!shrinkNoLock() || !countRowsNoLock(dataCount))
+            return false;
+        if (itemOffset >= dataCount)
+            return true;
+        if (itemCount > dataCount - itemOffset)
+            return false; // A range past the last row is not deleted.
+        const bool zones = loadZonesNoLock(false) || 0 <= zonesId_;
+        if (0 == itemOffset && options_.segmented_ && !segmentedNoLock() && 1 == columns_.size() && !swmr_)
+            (void)mapSegmentsNoLock();
+        bool status;
+        if (segmentedNoLock())
+            status = spliceSegmentsNoLock(itemOffset, itemCount, -1, std::string(), 0);
+        else if (0 == itemOffset && 1 == columns_.size() && !swmr_)
+            status = trimHeadNoLock(itemCount);
+        else
+            status = deleteItems(columns_, itemOffset, itemCount, itemSize);
+        if (zones)
+        {
+            // Only the zones cut by the deleted range are read again.
+            if (status)
+                spliceZonesNoLock(itemOffset, itemCount, 0);
+            else
+                dropZonesNoLock(itemOffset);
+        }
+        return status;
+    }
+
+    bool Data::trimHeadNoLock(const hsize_t itemCount) const
+    {
+        hsize_t dataCount;
+        const hid_t datasetId = columns_.front().first;
+        if (!countItems(columns_, dataCount))
+            return false;
+        if (itemCount < dataCount)
+        {
+            if (!writeCountAttribute(datasetId, headCountAttributeName, columns_.head_ + itemCount))
+                return false;
+            columns_.head_ += itemCount;
+            return true;
+        }
+
+        // No item is left to be moved, so the dataset is emptied instead.
+        hsize_t dims[1]{ 0 };
+        if (0 > H5Dset_extent(datasetId, dims) || (0 < columns_.head_ && 0 > H5Adelete(datasetId, headCountAttributeName)))
+            return false;
+        columns_.head_ = 0;
+        return true;
+    }
+
+    bool Data::pathNoLock(std::string& path) const
+    {
+        // The data lies in the group of its instrument, which the data holds open.
+        if (!groupPath(groupId_, path))
+            return false;
+        if (path.back() != '/')
+            path.append("/");
+        path.append(datasetPath_, datasetPath_.find_last_of('/') + 1, std::string::npos);
+        return true;
+    }
+
+    bool Data::mapSegmentsNoLock() const
+    {
+        // The dataset is renamed to the first segment, the open handle follows it. The segment maps the rows past the head of the dataset,
+        // which the mapping keeps instead of the attribute.
+        std::string path;
+        if (!pathNoLock(path))
+            return traceDataSpliceSegmentsError(datasetPath_, filePath_);
+        const std::string segmentPath = path + segmentNameInfix + "0";
+        const hid_t fileId = H5Iget_file_id(datasetId_);
+        hsize_t dataCount;
+        bool status = 0 <= fileId && countItems(columns_, dataCount)
+            && 0 == H5Lexists(fileId, segmentPath.c_str(), H5P_DEFAULT)
+            && 0 <= H5Lmove(fileId, path.c_str(), fileId, segmentPath.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+        if (status)
+        {
+            const std::vector<DataSegment> segments{ { segmentPath, 0, columns_.head_, dataCount } };
+            const hid_t datasetId = segmentsCreate(fileId, path.c_str(), standardTypeId_, segments);
+            status = 0 <= datasetId;
+            if (status)
+            {
+                if (0 < columns_.head_)
+                    H5Adelete(datasetId_, headCountAttributeName);
+                segments_ = segments;
+                segmentIds_.assign(1, datasetId_);
+                datasetId_ = datasetId;
+                columns_.front().first = datasetId;
+                columns_.head_ = 0;
+                segmentsLoaded_ = true;
+            }
+            else
+                H5Lmove(fileId, segmentPath.c_str(), fileId, path.c_str(), H5P_DEFAULT, H5P_DEFAULT);
+        }
+        if (0 <= fileId)
+            H5Fclose(fileId);
+        if (!status)
+            traceDataSpliceSegmentsError(datasetPath_, filePath_);
+        return status;
+    }
+
+    bool Data::fetchSegments(std::vector<DataSegment>& segments) const
+    {
+        ReadLock lock(mutex_);
+        LibraryLock libraryLock(theLibraryMutex);
+        segments.clear();
+        if (segmentedNoLock())
+        {
+            std::string path;
+            if (!pathNoLock(path))
+                return false;
+            segments = segments_;
+            segmentsRebase(path, segments);
+            return true;
+        }
+        hsize_t dataCount;
+        std::string path;
+        if (0 > datasetId_ || !countRowsNoLock(dataCount) || !pathNoLock(path))
+            return false;
+        segments.push_back({ path, 0, columns_.head_, dataCount });
+        return true;
+    }
+
+    bool Data::compact(const hsize_t segmentRows) const
+    {
+        if (readOnly_)
+            return false;
+        WriteLock lock(mutex_);
+        std::unique_lock<std::mutex> libraryLock(theLibraryMutex);
+        const size_t itemSize = H5Tget_size(nativeTypeId_);
+        const hsize_t pageRows = 16 * chunkRowsNoLock();
+        std::vector<unsigned char> page;
+        if (!segmentedNoLock())
+        {
+            // The items are moved over the rows trimmed from the head a few chunks at a time, every page is read before it is overwritten.
+            hsize_t dataCount;
+            if (0 > datasetId_ || !shrinkNoLock() || !countRowsNoLock(dataCount))
+                return false;
+            if (0 == columns_.head_)
+                return true;
+            DatasetColumns columns{ columns_ };
+            columns.head_ = 0;
+            bool status{ true };
+            for (hsize_t item = 0; status && item < dataCount; item += pageRows)
+            {
+                const hsize_t pageCount = std::min(pageRows, dataCount - item);
+                page.resize(static_cast<size_t>(pageCount) * itemSize);
+                status = readItemRange(columns_, item, pageCount, page.data()) && writeItemRange(columns, item, pageCount, page.data());
+            }
+            if (status && setExtent(columns, dataCount) && 0 <= H5Adelete(datasetId_, headCountAttributeName))
+            {
+                columns_.head_ = 0;
+                return true;
+            }
+            return traceDataCompactError(datasetPath_, filePath_);
+        }
+        // A segment mapping its dataset alone from a row after the first one holds the trimmed rows, which are reclaimed by copying it.
+        const auto trimmed = [this](const size_t i)
+        {
+            const std::string& path = segments_[i].datasetPath_;
+            return 0 < segments_[i].rowOffset_ && 1 == std::count_if(segments_.begin(), segments_.end(), [&path](const DataSegment& s) { return path == s.datasetPath_; });
+        };
+        for (size_t first = 0; first < segments_.size(); ++first)
+        {
+            size_t last = first;
+            while (last < segments_.size() && segments_[last].count_ < segmentRows)
+                ++last;
+            if (2 > last - first)
+            {
+                if (!trimmed(first))
+                {
+                    first = std::max(first, last);
+                    continue;
+                }
+                last = first + 1;
+            }
+
+            // The items of the run are copied to a new segment a few chunks at a time, so that a long run is not held in memory.
+            const hsize_t offset = segments_[first].offset_;
+            const hsize_t count = segments_[last - 1].offset_ + segments_[last - 1].count_ - offset;
+            std::string segmentPath;
+            const hid_t segmentId = createSegmentNoLock(segmentPath);
+            bool status = 0 <= segmentId;
+            for (hsize_t item = 0; status && item < count; item += pageRows)
+            {
+                const hsize_t pageCount = std::min(pageRows, count - item);
+                page.resize(static_cast<size_t>(pageCount) * itemSize);
+                status = readItemsNoLock(offset + item, pageCount, page.data(), libraryLock) && appendRowsNoLock(segmentId, pageCount, page.data(), libraryLock);
+            }
+            if (!status)
+            {
+                if (0 <= segmentId)
+                    segmentDrop(segmentId, segmentPath, chunkCacheBytes_);
+                return traceDataSpliceSegmentsError(datasetPath_, filePath_);
+            }
+            if (!spliceSegmentsNoLock(offset, count, segmentId, segmentPath, count))
+                return false;
+        }
+        return true;
+    }
+
+    bool Data::spliceSegmentsNoLock(const hsize_t itemOffset, const hsize_t replacedCount, const hid_t segmentId, const std::string& segmentPath, const hsize_t segmentCount) const
+    {
+        // The segments overlapping the replaced rows are cut to the rows outside of them, the others are mapped as they are.
+        // A cut segment keeps its dataset, so that no stored row is rewritten.
+        std::string path;
+        if (pathNoLock(path))
+            segmentsRebase(path, segments_);
+        else
+        {
+            if (0 <= segmentId)
+                segmentDrop(segmentId, segmentPath, chunkCacheBytes_);
+            return traceDataSpliceSegmentsError(datasetPath_, filePath_);
+        }
+        std::vector<DataSegment> segments;
+        std::vector<hid_t> segmentIds;
+        hsize_t offset{ 0 };
+        const auto map = [&segments, &segmentIds, &offset](const std::string& path, const hid_t id, const hsize_t rowOffset, const hsize_t count)
+        {
+            if (0 < count)
+            {
+                segments.push_back({ path, offset, rowOffset, count });
+                segmentIds.push_back(id);
+                H5Iinc_ref(id);
+                offset += count;
+            }
+        };
+        const hsize_t replacedEnd = itemOffset + replacedCount;
+        for (size_t i = 0; i < segments_.size() && segments_[i].offset_ < itemOffset; ++i)
+            map(segments_[i].datasetPath_, segmentIds_[i], segments_[i].rowOffset_, std::min(segments_[i].count_, itemOffset - segments_[i].offset_));
+        if (0 <= segmentId)
+            map(segmentPath, segmentId, 0, segmentCount);
+        for (size_t i = 0; i < segments_.size(); ++i)
+        {
+            const hsize_t segmentEnd = segments_[i].offset_ + segments_[i].count_;
+            if (segmentEnd > replacedEnd)
+            {
+                const hsize_t skipped = replacedEnd > segments_[i].offset_ ? replacedEnd - segments_[i].offset_ : 0;
+                map(segments_[i].datasetPath_, segmentIds_[i], segments_[i].rowOffset_ + skipped, segments_[i].count_ - skipped);
+            }
+        }
+        if (segments.empty())
+        {
+            // All rows are deleted, the first segment stays as an empty one.
+            segments.push_back({ segments_.front().datasetPath_, 0, 0, 0 });
+            segmentIds.push_back(segmentIds_.front());
+            H5Iinc_ref(segmentIds_.front());
+        }
+
+        // The last segment is mapped up to the end of its dataset, so the rows after a cut at its end are dropped.
+        hsize_t dims[1];
+        dims[0] = segments.back().rowOffset_ + segments.back().count_;
+        const bool status = remapSegmentsNoLock(segments, segmentIds) && 0 <= H5Dset_extent(segmentIds_.back(), dims);
+        if (0 <= segmentId)
+        {
+            if (status)
+                segmentClose(segmentId, chunkCacheBytes_);
+            else
+                segmentDrop(segmentId, segmentPath, chunkCacheBytes_);
+        }
+        if (!status)
+            return traceDataSpliceSegmentsError(datasetPath_, filePath_);
+        return true;
+    }
+
+    bool Data::remapSegmentsNoLock(std::vector<DataSegment>& segments, std::vector<hid_t>& segmentIds) const
+    {
+        std::string path;
+        const hid_t fileId = pathNoLock(path) ? H5Iget_file_id(datasetId_) : -1;
+        const hid_t datasetId = 0 <= fileId ? segmentsCreate(fileId, path.c_str(), standardTypeId_, segments) : -1;
+        if (0 > datasetId)
+        {
+            for (const hid_t segmentId : segmentIds)
+                segmentClose(segmentId, chunkCacheBytes_);
+            if (0 <= fileId)
+                H5Fclose(fileId);
+            return false;
+        }
+
+        // The reads of this instance follow the new virtual dataset, the segment datasets no longer mapped are deleted with their rows.
+        H5Dclose(datasetId_);
+        datasetId_ = datasetId;
+        columns_.front().first = datasetId;
+        std::vector<std::string> unmapped;
+        for (size_t i = 0; i < segments_.size(); ++i)
+        {
+            const std::string& path = segments_[i].datasetPath_;
+            segmentClose(segmentIds_[i], chunkCacheBytes_);
+            if (segments.end() == std::find_if(segments.begin(), segments.end(), [&path](const DataSegment& s) { return path == s.datasetPath_; })
+                && unmapped.end() == std::find(unmapped.begin(), unmapped.end(), path))
+                unmapped.push_back(path);
+        }
+        for (const auto& path : unmapped)
+            H5Ldelete(fileId, path.c_str(), H5P_DEFAULT);
+        H5Fclose(fileId);
+        segments_.swap(segments);
+        segmentIds_.swap(segmentIds);
+        return true;
+    }
+
+    hid_t Data::createSegmentNoLock(std::string& datasetPath) const
+    {
+        // The new segment is numbered after the largest number in use.
+        unsigned long number{ 0 };
+        const size_t infixLength = strlen(segmentNameInfix);
+        for (const auto& segment : segments_)
+        {
+            const size_t position = segment.datasetPath_.rfind(segmentNameInfix);
+            if (std::string::npos != position)
+                number = std::max(number, std::strtoul(segment.datasetPath_.c_str() + position + infixLength, nullptr, 10) + 1);
+        }
+        std::string path;
+        const hid_t fileId = pathNoLock(path) ? H5Iget_file_id(datasetId_) : -1;
+        const hid_t dcpl_id = H5Dget_create_plist(segmentIds_.back());
+        hid_t datasetId{ -1 };
+        if (0 <= fileId && 0 <= dcpl_id)
+        {
+            // The numbers of the segment datasets left over by an interrupted write are skipped.
+            do
+                datasetPath = path + segmentNameInfix + std::to_string(number++);
+            while (0 < H5Lexists(fileId, datasetPath.c_str(), H5P_DEFAULT));
+            hsize_t dims[1] = { 0 };
+            hsize_t max_dims[1] = { H5S_UNLIMITED };
+            const hid_t space_id = H5Screate_simple(1, dims, max_dims);
+            if (0 <= space_id)
+            {
+                // The new segment gets the chunk cache of the other datasets of the data, within the budget.
+                const hid_t dapl_id = H5Pcreate(H5P_DATASET_ACCESS);
+                const size_t chunkCacheBytes = 0 <= dapl_id ? chunkCacheSet(dapl_id, options_, datasetChunkBytes(segmentIds_.back())) : 0;
+                datasetId = H5Dcreate2(fileId, datasetPath.c_str(), standardTypeId_, space_id, H5P_DEFAULT, dcpl_id, 0 <= dapl_id ? dapl_id : H5P_DEFAULT);
+                if (0 <= datasetId)
+                    chunkCacheBytes_ += chunkCacheBytes;
+                else
+                    chunkCacheRelease(chunkCacheBytes);
+                if (0 <= dapl_id)
+                    H5Pclose(dapl_id);
+                H5Sclose(space_id);
+            }
+        }
+        if (0 <= dcpl_id)
+            H5Pclose(dcpl_id);
+        if (0 <= fileId)
+            H5Fclose(fileId);
+        return datasetId;
+    }
+
+    void Data::countReadNoLock(const hsize_t itemOffset, const hsize_t itemCount, const hsize_t chunkRows) const
+    {
+        const hsize_t rowOffset = columns_.head_ + itemOffset;
+        readCount_.fetch_add(1UL, std::memory_order_relaxed);
+        readItemCount_.fetch_add(itemCount, std::memory_order_relaxed);
+        if (0 < itemCount)
+            readChunkCount_.fetch_add((rowOffset + itemCount - 1) / chunkRows - rowOffset / chunkRows + 1, std::memory_order_relaxed);
+    }
+
+    bool Data::countNoLock(hsize_t& itemCount) const
+    {
+        LibraryLock libraryLock(theLibraryMutex);
+        if (countRowsNoLock(itemCount))
+            return true;
+        traceDataGetItemCountError(datasetPath_, filePath_);
+        return false;
+    }
+
+    bool Data::summaryNoLock(DataSummary& summary) const
+    {
+        // Another handle of the data may have written it since, the cached summary is kept while the item count and the head of the dataset,
+        // which read no chunk, match it.
+        if (summaryCached_.load(std::memory_order_acquire))
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            hsize_t dataCount;
+            if (countRowsNoLock(dataCount) && summaryCached_.load(std::memory_order_acquire) && dataCount == summaryCount_.load(std::memory_order_relaxed))
+            {
+                summary.count_ = dataCount;
+                summary.firstTicks_ = summaryFirstTicks_.load(std::memory_order_relaxed);
+                summary.lastTicks_ = summaryLastTicks_.load(std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return loadSummaryNoLock(summary);
+    }
+
+    bool Data::loadSummaryNoLock(DataSummary& summary) const
+    {
+        summary = { 0UL, 0L, 0L };
+        LibraryLock libraryLock(theLibraryMutex);
+        if (!countRowsNoLock(summary.count_))
+        {
+            traceDataGetItemCountError(datasetPath_, filePath_);
+            return false;
+        }
+        if (0 < summary.count_)
+        {
+            unsigned char buffer[256];
+            if (!readItem(columns_, 0, static_cast<void*>(buffer)))
+            {
+                traceDataReadFirstItemError(datasetPath_, filePath_);
+                return false;
+            }
+            summary.firstTicks_ = *reinterpret_cast<long long*>(buffer);
+            if (!readItem(columns_, summary.count_ - 1, static_cast<void*>(buffer)))
+            {
+                traceDataReadLastItemError(datasetPath_, filePath_);
+                return false;
+            }
+            summary.lastTicks_ = *reinterpret_cast<long long*>(buffer);
+        }
+
+        // Concurrent readers may get here at the same time, they store the same values.
+        summaryCount_.store(summary.count_, std::memory_order_relaxed);
+        summaryFirstTicks_.store(summary.firstTicks_, std::memory_order_relaxed);
+        summaryLastTicks_.store(summary.lastTicks_, std::memory_order_relaxed);
+        summaryCached_.store(true, std::memory_order_release);
+        return true;
+    }
+
+    template <typename T> bool Data::spreadList(std::vector<T>& input, const bool verbose)
+    {
+        return spreadList(const_cast<T*>(input.data()), static_cast<size_t>(input.size()), verbose);
+    }
+
+    template <typename T> bool Data::spreadList(T* input, const size_t inputCount, const bool verbose)
+    {
+        size_t iStart = 0, iCount = 0, j;
+        long long lStart = input[0].ticks_;
+        bool spread = false;
+        T t{};
+        for (size_t i = 1; i < inputCount; ++i)
+        {
+            const long long l = input[i].ticks_;
+            if (lStart == l)
+                ++iCount;
+            else
+            {
+                if (0 < iCount)
+                {
+                    if (verbose)
+                    {
+                        traceSpreadingDuplicateInputTimeTick<T>(iStart, input[iStart]);
+                        for (j = iStart + 1; j < i; ++j)
+                        {
+                            traceSpreadingDuplicateInputTimeTick<T>(j, input[j], lStart + 1);
+                            t = input[j];
+                            t.ticks_ = ++lStart;
+                            input[j] = t;
+                        }
+                    }
+                    else
+                    {
+                        for (j = iStart + 1; j < i; ++j)
+                        {
+                            t = input[j];
+                            t.ticks_ = ++lStart;
+                            input[j] = t;
+                        }
+                    }
+                    iCount = 0;
+                    spread = true;
+                }
+                iStart = i;
+                lStart = input[i].ticks_;
+            }
+        }
+        if (0 < iCount)
+        {
+            iCount += iStart;
+            if (verbose)
+            {
+                traceSpreadingDuplicateInputTimeTick<T>(iStart, input[iStart]);
+                for (j = iStart + 1; j <= iCount; ++j)
+                {
+                    traceSpreadingDuplicateInputTimeTick<T>(j, input[j], lStart + 1);
+                    t = input[j];
+                    t.ticks_ = ++lStart;
+                    input[j] = t;
+                }
+            }
+            else
+            {
+                for (j = iStart + 1; j <= iCount; ++j)
+                {
+                    t = input[j];
+                    t.ticks_ = ++lStart;
+                    input[j] = t;
+                }
+            }
+            spread = true;
+        }
+        return spread;
+    }
+
+    template <typename T> bool Data::deleteIndexRange(const hsize_t indexFrom, const hsize_t indexTo) const
+    {
+        if (readOnly_)
+            return false;
+        if (indexTo < indexFrom)
+            return true;
+        const hsize_t count = indexTo - indexFrom + 1;
+        if (count > 0)
+        {
+            WriteLock lock(mutex_);
+            LibraryLock libraryLock(theLibraryMutex);
+            summaryCached_.store(false, std::memory_order_relaxed);
+            if (!deleteRowsNoLock(indexFrom, count, sizeof(T)))
+                return false;
+            tickIndex_->deleted(indexFrom, count);
+        }
+        return true;
+    }
+
+    template <typename T> bool Data::deleteTickRange(const long long ticksFrom, const long long ticksTo) const
+    {
+        if (readOnly_)
+            return false;
+        if (ticksTo < ticksFrom)
+            return true;
+        hsize_t indexFrom, indexTo;
+        bool matchFrom, matchTo;
+        WriteLock lock(mutex_);
+        if (!ticksToIndexNoLock<T>(ticksFrom, indexFrom, matchFrom) ||
+            !ticksToIndexNoLock<T>(ticksTo, indexTo, matchTo))
+            return false;
+        if (!matchFrom)
+            ++indexFrom;
+        const hsize_t count = indexTo - indexFrom + 1;
+        if (count > 0)
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            summaryCached_.store(false, std::memory_order_relaxed);
+            if (!deleteRowsNoLock(indexFrom, count, sizeof(T)))
+                return false;
+            tickIndex_->deleted(indexFrom, count);
+        }
+        return true;
+    }
+
+    template <typename T> bool Data::addData(const T* input, const hsize_t inputCount, DuplicateTimeTicks duplicateTimeTicks, bool verbose) const
+    {
+        if (readOnly_)
+            return false;
+        const long long inputFirstTicks = input[0].ticks_;
+        const long long inputLastTicks = input[inputCount - 1].ticks_;
+        {
+            long long l1 = inputFirstTicks;
+            for (hsize_t i = 1; i < inputCount; ++i)
+            {
+                const long long l2 = input[i].ticks_;
+                if (l1 >= l2)
+                {
+                    traceNonIncreasingInputTicksError<T>(input[i - 1], input[i]);
+                    return false;
+                }
+                l1 = l2;
+            }
+        }
+        WriteLock lock(mutex_);
+        std::unique_lock<std::mutex> libraryLock(theLibraryMutex);
+        const bool cached = summaryCached_.load(std::memory_order_relaxed);
+        summaryCached_.store(false, std::memory_order_relaxed);
+
+        // The zone maps change for the stored items within the ticks of the input, the appended input updates them without reading the items back.
+        // A data stored without the zone maps is not given them by the writes.
+        const bool zones = loadZonesNoLock(false) || 0 <= zonesId_;
+        hsize_t zonesOffset{ 0 }, zonesEnd{ 0 }, dataCount{ 0 };
+        bool appending{ false };
+        if (zones && countRowsNoLock(dataCount))
+        {
+            T dataFirst{}, dataLast{};
+            appending = 0 == dataCount || (readItem(columns_, dataCount - 1, static_cast<void*>(&dataLast)) && dataLast.ticks_ < inputFirstTicks);
+
+            // The stored items before the first ticks of the input and the ones after its last ticks stay as they are.
+            const auto precedingCount = [this, &dataFirst, dataCount](const long long ticks, const bool inclusive, hsize_t& count)
+            {
+                bool match;
+                if (!tickIndex_->lowerNeighborIndex<T>(columns_, dataCount, maximumTickIndexBytes_, ticks, count, match))
+                    return false;
+                if (0 < count || match || dataFirst.ticks_ < ticks)
+                    count += match && !inclusive ? 0 : 1;
+                return true;
+            };
+            if (appending)
+                zonesOffset = dataCount;
+            else if (!readItem(columns_, 0, static_cast<void*>(&dataFirst)) || !precedingCount(inputFirstTicks, false, zonesOffset) || !precedingCount(inputLastTicks, true, zonesEnd))
+            {
+                zonesOffset = 0;
+                zonesEnd = dataCount;
+            }
+        }
+        if (!addDataNoLock<T>(input, inputCount, duplicateTimeTicks, verbose, libraryLock))
+        {
+            if (zones)
+                dropZonesNoLock(zonesOffset);
+            return false;
+        }
+        if (zones)
+        {
+            // The items after the input move along by the number of the added ones.
+            hsize_t count;
+            if (appending)
+                appendZonesNoLock(static_cast<const void*>(input), inputCount);
+            else if (countRowsNoLock(count) && count >= dataCount)
+                spliceZonesNoLock(zonesOffset, zonesEnd - zonesOffset, zonesEnd - zonesOffset + count - dataCount);
+            else
+                dropZonesNoLock(zonesOffset);
+        }
+
+        // The SWMR readers see the written items once they are flushed.
+        if (swmr_)
+        {
+            storeZonesNoLock();
+            for (const auto& column : columns_)
+                if (0 > H5Dflush(column.first))
+                    traceDataFlushError(datasetPath_, filePath_);
+            if (0 <= zonesId_ && 0 > H5Dflush(zonesId_))
+                traceDataFlushError(datasetPath_, filePath_);
+        }
+        if (cached && countRowsNoLock(dataCount))
+        {
+            // The input may only widen the range of the stored time ticks.
+            const bool empty = 0UL == summaryCount_.load(std::memory_order_relaxed);
+            const long long firstTicks = summaryFirstTicks_.load(std::memory_order_relaxed);
+            const long long lastTicks = summaryLastTicks_.load(std::memory_order_relaxed);
+            summaryCount_.store(dataCount, std::memory_order_relaxed);
+            summaryFirstTicks_.store(empty || inputFirstTicks < firstTicks ? inputFirstTicks : firstTicks, std::memory_order_relaxed);
+            summaryLastTicks_.store(empty || inputLastTicks > lastTicks ? inputLastTicks : lastTicks, std::memory_order_relaxed);
+            summaryCached_.store(true, std::memory_order_release);
+        }
+        return true;
+    }
+
+    template <typename T> bool Data::addDataNoLock(const T* input, const hsize_t inputCount, const DuplicateTimeTicks duplicateTimeTicks, const bool verbose, std::unique_lock<std::mutex>& libraryLock) const
+    {
+        T inputFirst = input[0], inputLast = input[inputCount - 1];
+        const long long inputFirstTicks = inputFirst.ticks_;
+        const long long inputLastTicks = inputLast.ticks_;
+        hsize_t dataCount;
+        if (!countRowsNoLock(dataCount))
+        {
+            traceDataGetItemCountError(datasetPath_, filePath_);
+            return false;
+        }
+        if (0 == dataCount) // Empty dataset
+        {
+            if (!appendItemsNoLock(inputCount, static_cast<const void*>(input), libraryLock))
+                return traceDataAppendFailError(inputCount, datasetPath_, filePath_);
+            tickIndex_->appended(input, inputCount, maximumTickIndexBytes_);
+            return true;
+        }
+        T dataFirst{}, dataLast{};
+        if (!readItem(columns_, 0, static_cast<void*>(&dataFirst)))
+        {
+            traceDataReadFirstItemError(datasetPath_, filePath_);
+            return false;
+        }
+        if (!readItem(columns_, dataCount - 1, static_cast<void*>(&dataLast)))
+        {
+            traceDataReadLastItemError(datasetPath_, filePath_);
+            return false;
+        }
+        const long long dataFirstTicks = dataFirst.ticks_;
+        const long long dataLastTicks = dataLast.ticks_;
+        if (inputFirstTicks > dataLastTicks) //      dddddddd
+        {                                    //               iiii
+            if (!appendItemsNoLock(inputCount, static_cast<const void*>(input), libraryLock))
+                return traceDataAppendFailError(inputCount, datasetPath_, filePath_);
+            tickIndex_->appended(input, inputCount, maximumTickIndexBytes_);
+            return true;
+        }
+        if (inputFirstTicks == dataLastTicks) //      ddddddd[d]
+        {                                     //             [i]iii
+            if (inputFirst.isDifferent(dataLast))
+            {
+                const hsize_t count1 = dataCount - 1;
+                if (DuplicateTimeTicks::Update == duplicateTimeTicks)
+                {
+                    if (verbose)
+                        traceDataDuplicateTicksUpdateInfo<T>(count1, dataLast, 0, inputFirst);
+                    if (!writeItem(columns_, count1, static_cast<void*>(&inputFirst)))
+                        return traceDataDuplicateTicksUpdateError<T>(count1, dataLast, 0, inputFirst);
+                }
+                else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
+                    traceDataDuplicateTicksSkipError<T>(count1, dataLast, 0, inputFirst);
+                else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
+                    return traceDataDuplicateTicksFailError<T>(count1, dataLast, 0, inputFirst);
+            }
+            if (1 < inputCount)
+            {
+                if (!appendItemsNoLock(inputCount - 1, static_cast<const void*>(input + 1), libraryLock))
+                    traceDataAppendOffsetFailError(inputCount - 1, 1, datasetPath_, filePath_);
+                else
+                    tickIndex_->appended(input + 1, inputCount - 1, maximumTickIndexBytes_);
+            }
+            return true;
+        }
+        if (!shrinkNoLock()) // The items other than appended ones are written to the data without the preallocated rows.
+            return false;
+        if (segmentedNoLock()) //    sss|sss|ss      sss|iiiii|s|ss
+        {                      //   ii  i  i    ->
+            if (!spliceDataNoLock<T>(input, inputCount, duplicateTimeTicks, verbose, libraryLock))
+                return traceDataMergeFailError(inputCount, datasetPath_, filePath_);
+            return true;
+        }
+        if (inputLastTicks < dataFirstTicks) //      dddddddd
+        {                                    // iiii
+            if (!prependItems(columns_, inputCount, static_cast<void*>(const_cast<T*>(input)), sizeof(T)))
+                return traceDataPrependFailError(inputCount, datasetPath_, filePath_);
+            tickIndex_->inserted(0, inputCount);
+            return true;
+        }
+        if (inputLastTicks == dataFirstTicks) //      [d]ddddddd
+        {                                     //   iii[i]
+            const hsize_t count1 = inputCount - 1;
+            if (inputFirst.isDifferent(dataFirst))
+            {
+                if (DuplicateTimeTicks::Update == duplicateTimeTicks)
+                {
+                    if (verbose)
+                        traceDataDuplicateTicksUpdateInfo<T>(0, dataFirst, count1, inputLast);
+                    if (!writeItem(columns_, 0, static_cast<void*>(&inputLast)))
+                        return traceDataDuplicateTicksUpdateError<T>(0, dataFirst, count1, inputLast);
+                }
+                else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
+                    traceDataDuplicateTicksSkipError<T>(0, dataFirst, count1, inputLast);
+                else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
+                    return traceDataDuplicateTicksFailError<T>(0, dataFirst, count1, inputLast);
+            }
+            if (0 < count1)
+            {
+                if (!prependItems(columns_, count1, static_cast<void*>(const_cast<T*>(input)), sizeof(T)))
+                    return traceDataPrependFailError(count1, datasetPath_, filePath_);
+                tickIndex_->inserted(0, count1);
+            }
+            return true;
+        }
+        if (inputLastTicks > dataLastTicks)
+        {
+            hsize_t index; bool match;
+            if (inputFirstTicks > dataFirstTicks) // dddddddddddd[d]
+            {                                     //          iii[i]iiiiiii
+                index = lowerNeighborIndex<T>(input, inputCount, dataLastTicks, match);
+                if (match)
+                {
+                    T t = *(input + index);
+                    if (t.isDifferent(dataLast))
+                    {
+                        const hsize_t count1 = dataCount - 1;
+                        if (DuplicateTimeTicks::Update == duplicateTimeTicks)
+                        {
+                            if (verbose)
+                                traceDataDuplicateTicksUpdateInfo<T>(count1, dataLast, index, t);
+                            if (!writeItem(columns_, count1, static_cast<void*>(&t)))
+                                return traceDataDuplicateTicksUpdateError<T>(count1, dataLast, index, t);
+                        }
+                        else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
+                            traceDataDuplicateTicksSkipError<T>(count1, dataLast, index, t);
+                        else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
+                            return traceDataDuplicateTicksFailError<T>(count1, dataLast, index, t);
+                    }
+                    if (0 < index)
+                    {
+                        if (!mergeItems(*tickIndex_, maximumTickIndexBytes_, maximumReadBufferBytes_, columns_, 0, index, input, duplicateTimeTicks, verbose))
+                            return traceDataMergeFailError(index, datasetPath_, filePath_);
+                    }
+                }
+                else if (0 <= index)
+                {
+                    if (!mergeItems(*tickIndex_, maximumTickIndexBytes_, maximumReadBufferBytes_, columns_, 0, index + 1, input, duplicateTimeTicks, verbose))
+                        return traceDataMergeFailError(index, datasetPath_, filePath_);
+                }
+                if (++index < inputCount)
+                {
+                    if (!appendItemsNoLock(inputCount - index, static_cast<const void*>(input + index), libraryLock))
+                        return traceDataAppendOffsetFailError(inputCount - index, index, datasetPath_, filePath_);
+                    tickIndex_->appended(input + index, inputCount - index, maximumTickIndexBytes_);
+                }
+            }
+            else //     [d]ddddddd[d]
+            {    // iiii[i]iiiiiii[i]iiiiiii
+                index = lowerNeighborIndex<T>(input, inputCount, dataFirstTicks, match);
+                if (match)
+                {
+                    T t = *(input + index);
+                    if (t.isDifferent(dataFirst))
+                    {
+                        if (DuplicateTimeTicks::Update == duplicateTimeTicks)
+                        {
+                            if (verbose)
+                                traceDataDuplicateTicksUpdateInfo<T>(0, dataFirst, index, t);
+                            if (!writeItem(columns_, 0, static_cast<void*>(&t)))
+                                return traceDataDuplicateTicksUpdateError<T>(0, dataFirst, index, t);
+                        }
+                        else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
+                            traceDataDuplicateTicksSkipError<T>(0, dataFirst, index, t);
+                        else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
+                            return traceDataDuplicateTicksFailError<T>(0, dataFirst, index, t);
+                    }
+                    if (0 < index)
+                    {
+                        if (!prependItems(columns_, index, static_cast<void*>(const_cast<T*>(input)), sizeof(T)))
+                            return traceDataPrependFailError(index, datasetPath_, filePath_);
+                        tickIndex_->inserted(0, index);
+                    }
+                }
+                else
+                {
+                    if (!prependItems(columns_, index + 1, static_cast<void*>(const_cast<T*>(input)), sizeof(T)))
+                        return traceDataPrependFailError(index, datasetPath_, filePath_);
+                    tickIndex_->inserted(0, index + 1);
+                }
+                ++index; // The upper neighbor.
+                hsize_t index2 = lowerNeighborIndex<T>(input, inputCount, dataLastTicks, match);
+                if (match)
+                {
+                    T t = *(input + index2);
+                    if (t.isDifferent(dataLast))
+                    {
+                        const hsize_t count1 = dataCount - 1;
+                        if (DuplicateTimeTicks::Update == duplicateTimeTicks)
+                        {
+                            if (verbose)
+                                traceDataDuplicateTicksUpdateInfo<T>(count1, dataLast, index, t);
+                            if (!writeItem(columns_, count1, static_cast<void*>(&t)))
+                                return traceDataDuplicateTicksUpdateError<T>(count1, dataLast, index, t);
+                        }
+                        else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
+                            traceDataDuplicateTicksSkipError<T>(count1, dataLast, index, t);
+                        else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
+                            return traceDataDuplicateTicksFailError<T>(count1, dataLast, index, t);
+                    }
+                }
+                if (index <= index2)
+                {
+                    if (!mergeItems(*tickIndex_, maximumTickIndexBytes_, maximumReadBufferBytes_, columns_, index, index2 - index + 1, input, duplicateTimeTicks, verbose))
+                        return traceDataMergeOffsetFailError(index2 - index + 1, index, datasetPath_, filePath_);
+                }
+                ++index2; // The upper neighbor.
+                if (index2 < inputCount)
+                {
+                    if (!appendItemsNoLock(inputCount - index2, static_cast<const void*>(input + index2), libraryLock))
+                        return traceDataAppendOffsetFailError(inputCount - index2, index2, datasetPath_, filePath_);
+                    tickIndex_->appended(input + index2, inputCount - index2, maximumTickIndexBytes_);
+                }
+            }
+        }
+        else
+        {
+            if (inputFirstTicks > dataFirstTicks) // ddd[d]ddd[d]ddddd
+            {                                     //    [i]iii[i]
+                if (!mergeItems<T>(*tickIndex_, maximumTickIndexBytes_, maximumReadBufferBytes_, columns_, 0, inputCount, input, duplicateTimeTicks, verbose))
+                    return traceDataMergeFailError(inputCount, datasetPath_, filePath_);
+            }
+            else //      [d]dddddddd
+            {    // iiiii[i]ii
+                bool match;
+                hsize_t index = lowerNeighborIndex<T>(input, inputCount, dataFirstTicks, match);
+                if (match)
+                {
+                    T t = *(input + index);
+                    if (t.isDifferent(dataFirst))
+                    {
+                        if (DuplicateTimeTicks::Update == duplicateTimeTicks)
+                        {
+                            if (verbose)
+                                traceDataDuplicateTicksUpdateInfo<T>(0, dataFirst, index, t);
+                            if (!writeItem(columns_, 0, static_cast<void*>(&t)))
+                                return traceDataDuplicateTicksUpdateError<T>(0, dataFirst, index, t);
+                        }
+                        else if (DuplicateTimeTicks::Skip == duplicateTimeTicks)
+                            traceDataDuplicateTicksSkipError<T>(0, dataFirst, index, t);
+                        else //if (DuplicateTimeTicks::Fail == duplicateTimeTicks)
+                            return traceDataDuplicateTicksFailError<T>(0, dataFirst, index, t);
+                    }
+                    if (0 < index)
+                    {
+                        if (!prependItems(columns_, index, static_cast<void*>(const_cast<T*>(input)), sizeof(T)))
+                            return traceDataPrependFailError(index, datasetPath_, filePath_);
+                        tickIndex_->inserted(0, index);
+                    }
+                }
+                else if (0 <= index)
+                {
+                    if (!prependItems(columns_, index + 1, static_cast<void*>(const_cast<T*>(input)), sizeof(T)))
+                        return traceDataPrependFailError(index, datasetPath_, filePath_);
+                    tickIndex_->inserted(0, index + 1);
+                }
+                if (++index < inputCount)
+                {
+                    if (!mergeItems(*tickIndex_, maximumTickIndexBytes_, maximumReadBufferBytes_, columns_, index, inputCount - index, input, duplicateTimeTicks, verbose))
+                        return traceDataMergeOffsetFailError(inputCount - index, index, datasetPath_, filePath_);
+                }
+            }
+        }
+        return true;
+    }
+
+    template <typename T> bool Data::spliceDataNoLock(const T* input, const hsize_t inputCount, const DuplicateTimeTicks duplicateTimeTicks, const bool verbose, std::unique_lock<std::mutex>& libraryLock) const
+    {
+        // The window spans the stored items from the first one not preceding the input to the last one not following it.
+        hsize_t dataCount, windowStart, windowEnd;
+        bool match;
+        T dataValue{};
+        if (!countRowsNoLock(dataCount) ||
+            !tickIndex_->lowerNeighborIndex<T>(columns_, dataCount, maximumTickIndexBytes_, input->ticks_, windowStart, match))
+            return false;
+        if (!match && windowStart < dataCount)
+        {
+            if (!readItem(columns_, windowStart, static_cast<void*>(&dataValue)))
+                return false;
+            if (dataValue.ticks_ < input->ticks_)
+                ++windowStart;
+        }
+        if (!tickIndex_->lowerNeighborIndex<T>(columns_, dataCount, maximumTickIndexBytes_, input[inputCount - 1].ticks_, windowEnd, match))
+            return false;
+        if (windowEnd < dataCount)
+        {
+            if (!match && !readItem(columns_, windowEnd, static_cast<void*>(&dataValue)))
+                return false;
+            if (match || dataValue.ticks_ < input[inputCount - 1].ticks_)
+                ++windowEnd;
+        }
+        if (windowEnd < windowStart)
+            windowEnd = windowStart;
+        const hsize_t windowCount = windowEnd - windowStart;
+        std::vector<T> window(static_cast<size_t>(windowCount));
+        if (0 < windowCount && !readItemRange(columns_, windowStart, windowCount, static_cast<void*>(window.data())))
+            return false;
+        std::vector<T> merged;
+        hsize_t insertedCount, updatedLast;
+        bool updated;
+        if (!mergeSorted(input, input, inputCount, window.data(), windowStart, windowCount, duplicateTimeTicks, verbose, merged, insertedCount, updatedLast, updated))
+            return false;
+        if (0 == insertedCount)
+        {
+            // Nothing has moved, rewrite the updated items only.
+            if (updated)
+                return writeItemRange(columns_, windowStart, updatedLast + 1, static_cast<const void*>(merged.data()));
+            return true;
+        }
+
+        // The merged window goes to a new segment replacing the rows of the window, the stored items around it stay where they are.
+        std::string segmentPath;
+        const hid_t segmentId = createSegmentNoLock(segmentPath);
+        if (0 > segmentId)
+            return traceDataSpliceSegmentsError(datasetPath_, filePath_);
+        const hsize_t mergedCount = static_cast<hsize_t>(merged.size());
+        if (!appendRowsNoLock(segmentId, mergedCount, static_cast<const void*>(merged.data()), libraryLock))
+        {
+            segmentDrop(segmentId, segmentPath, chunkCacheBytes_);
+            return traceDataSpliceSegmentsError(datasetPath_, filePath_);
+        }
+        if (!spliceSegmentsNoLock(windowStart, windowCount, segmentId, segmentPath, mergedCount))
+            return false;
+        tickIndex_->deleted(windowStart, windowCount);
+        tickIndex_->inserted(windowStart, mergedCount);
+        return true;
+    }
+
+    template <typename T> bool Data::addData(std::vector<T>& input, const DuplicateTimeTicks duplicateTimeTicks, const bool verbose) const
+    {
+        return addData<T>(input.data(), hsize_t(input.size()), duplicateTimeTicks, verbose);
+    }
+
+    template <typename T> bool Data::fetchData(Collect<T> collect, const long long ticksFrom, const long long ticksTo) const
+    {
+        ReadLock lock(mutex_);
+        return fetchDataNoLock<T>(collect, ticksFrom, ticksTo);
+    }
+
+    template <typename T> bool Data::tickRangeToIndexRangeNoLock(const long long ticksFrom, const long long ticksTo, hsize_t& itemOffset, hsize_t& itemCount) const
+    {
+        itemOffset = 0L;
+        itemCount = 0L;
+        DataSummary summary{};
+        if (!summaryNoLock(summary))
+            return false;
+        if (0L >= summary.count_ || ticksFrom > summary.lastTicks_)
+            return true;
+        if (0L < ticksTo && (ticksTo < summary.firstTicks_ || ticksTo < ticksFrom))
+            return true;
+        hsize_t itemEnd = summary.count_;
+        LibraryLock libraryLock(theLibraryMutex);
+        bool match;
+        if (ticksFrom > summary.firstTicks_)
+        {
+            if (!tickIndex_->lowerNeighborIndex<T>(columns_, summary.count_, maximumTickIndexBytes_, ticksFrom, itemOffset, match))
+                return false;
+            if (!match)
+                ++itemOffset;
+        }
+        if (0L < ticksTo && ticksTo < summary.lastTicks_)
+        {
+            if (!tickIndex_->lowerNeighborIndex<T>(columns_, summary.count_, maximumTickIndexBytes_, ticksTo, itemEnd, match))
+                return false;
+            ++itemEnd;
+        }
+        if (itemEnd > itemOffset)
+            itemCount = itemEnd - itemOffset;
+        return true;
+    }
+
+    template <typename T> bool Data::fetchDataNoLock(Collect<T> collect, const long long ticksFrom, const long long ticksTo) const
+    {
+        hsize_t itemOffset, itemCount;
+        if (!tickRangeToIndexRangeNoLock<T>(ticksFrom, ticksTo, itemOffset, itemCount))
+            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+        if (0L >= itemCount)
+            return true;
+        if (!collectItemsNoLock<T>(collect, itemOffset, itemCount))
+            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+        return true;
+    }
+
+    template <typename T> bool Data::collectItemsNoLock(const Collect<T>& collect, const hsize_t itemOffset, const hsize_t itemCount) const
+    {
+        std::unique_lock<std::mutex> libraryLock(theLibraryMutex);
+        const hsize_t chunkRows = chunkRowsNoLock();
+        // When the range does not fit in the read buffer, the pages hold whole chunks if the buffer allows,
+        // and never straddle a chunk boundary otherwise, so that a scan decompresses every chunk only once.
+        hsize_t pageRows = itemCount;
+        const hsize_t bytesLimit = maximumReadBufferBytes();
+        if (0 < bytesLimit && bytesLimit < itemCount * sizeof(T))
+        {
+            pageRows = bytesLimit / sizeof(T);
+            if (0 >= pageRows)
+                return false;
+            if (pageRows >= chunkRows)
+                pageRows -= pageRows % chunkRows;
+        }
+        try
+        {
+            // The chunk boundaries of the dataset lie past its head.
+            std::vector<T> page(static_cast<size_t>(pageRows));
+            const hsize_t head = columns_.head_;
+            const hsize_t itemEnd = itemOffset + itemCount;
+            for (hsize_t i = itemOffset; i < itemEnd;)
+            {
+                hsize_t pageEnd = head + i + pageRows;
+                if (pageRows >= chunkRows)
+                    pageEnd -= pageEnd % chunkRows;
+                else if (pageEnd > ((head + i) / chunkRows + 1) * chunkRows)
+                    pageEnd = ((head + i) / chunkRows + 1) * chunkRows;
+                pageEnd -= head;
+                if (pageEnd > itemEnd)
+                    pageEnd = itemEnd;
+                if (!readItemsNoLock(i, pageEnd - i, static_cast<void*>(page.data()), libraryLock))
+                    return false;
+                countReadNoLock(i, pageEnd - i, chunkRows);
+                libraryLock.unlock();
+                collect(page.data(), pageEnd - i);
+                libraryLock.lock();
+                i = pageEnd;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            traceDataExceptionWhileCollectingItemsError(e, datasetPath_, filePath_);
+            return false;
+        }
+        return true;
+    }
+
+    template <typename T> bool Data::fetchDataWhere(Collect<T> collect, const long long ticksFrom, const long long ticksTo, const DataPredicate& predicate) const
+    {
+        hsize_t itemOffset, itemCount;
+        if (!validPredicate(predicate, sizeof(T) / 8))
+            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+        ReadLock lock(mutex_);
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            seedTickIndexNoLock();
+        }
+        if (!tickRangeToIndexRangeNoLock<T>(ticksFrom, ticksTo, itemOffset, itemCount))
+            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+        if (0L >= itemCount)
+            return true;
+        if (!collectMatchingItemsNoLock<T>(collect, itemOffset, itemCount, predicate))
+            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+        return true;
+    }
+
+    template <typename T> bool Data::collectMatchingItemsNoLock(const Collect<T>& collect, const hsize_t itemOffset, const hsize_t itemCount, const DataPredicate& predicate) const
+    {
+        std::unique_lock<std::mutex> libraryLock(theLibraryMutex);
+        const hsize_t chunkRows = chunkRowsNoLock();
+        const bool zones = !predicate.terms_.empty() && loadZonesNoLock(true);
+        const std::vector<hsize_t> starts = zones ? zoneStarts(zones_) : std::vector<hsize_t>();
+
+        // Returns the end of the zone holding an item, or of its chunk without the zone maps, and whether the zone map excludes the zone.
+        const hsize_t head = columns_.head_;
+        const auto zoneEnd = [this, &predicate, &starts, zones, chunkRows, head](const hsize_t item, bool& excluded)
+        {
+            const size_t zone = zones ? zoneOf(starts, item) : 0;
+            excluded = zones && zone < zones_.size() && zoneExcludes(predicate, zones_[zone]);
+            return zones && zone < zones_.size() ? starts[zone + 1] : ((head + item) / chunkRows + 1) * chunkRows - head;
+        };
+        hsize_t pageRows = itemCount;
+        const hsize_t bytesLimit = maximumReadBufferBytes();
+        if (0 < bytesLimit && bytesLimit < itemCount * sizeof(T))
+        {
+            pageRows = bytesLimit / sizeof(T);
+            if (0 >= pageRows)
+                return false;
+            if (pageRows >= chunkRows)
+                pageRows -= pageRows % chunkRows;
+        }
+        try
+        {
+            std::vector<T> page(static_cast<size_t>(pageRows));
+            const hsize_t itemEnd = itemOffset + itemCount;
+            for (hsize_t i = itemOffset; i < itemEnd;)
+            {
+                // The excluded zones are skipped, a page extends over the following zones which are not excluded and fit in it.
+                bool excluded;
+                const hsize_t chunkEnd = std::min(itemEnd, zoneEnd(i, excluded));
+                if (excluded)
+                {
+                    i = chunkEnd;
+                    continue;
+                }
+                hsize_t pageEnd = std::min(chunkEnd, i + pageRows);
+                for (bool extend = pageEnd == chunkEnd; extend && pageEnd < itemEnd;)
+                {
+                    const hsize_t nextEnd = std::min(itemEnd, zoneEnd(pageEnd, excluded));
+                    extend = !excluded && nextEnd - i <= pageRows;
+                    if (extend)
+                        pageEnd = nextEnd;
+                }
+                if (!readItemsNoLock(i, pageEnd - i, static_cast<void*>(page.data()), libraryLock))
+                    return false;
+                countReadNoLock(i, pageEnd - i, chunkRows);
+                libraryLock.unlock();
+                const size_t matched = filterItems(page.data(), static_cast<size_t>(pageEnd - i), predicate);
+                if (0 < matched)
+                    collect(page.data(), matched);
+                libraryLock.lock();
+                i = pageEnd;
+            }
+        }
+        catch (const std::exception& e)
+        {
+            traceDataExceptionWhileCollectingItemsError(e, datasetPath_, filePath_);
+            return false;
+        }
+        return true;
+    }
+
+    template <typename T> bool Data::fetchDownsampledData(Collect<T> collect, const long long ticksFrom, const long long ticksTo, const hsize_t targetPoints,
+        const DownsamplingMethod method) const
+    {
+        hsize_t itemOffset, itemCount;
+        const hsize_t minimumPoints = DownsamplingMethod::EveryNth == method ? 1 : DownsamplingMethod::MinMaxEnvelope == method ? 2 : 3;
+        if (targetPoints < minimumPoints || DownsamplingMethod::EveryNth > method || DownsamplingMethod::LargestTriangleThreeBuckets < method)
+            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+        ReadLock lock(mutex_);
+        if (!tickRangeToIndexRangeNoLock<T>(ticksFrom, ticksTo, itemOffset, itemCount))
+            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+        if (0L >= itemCount)
+            return true;
+
+        // The pages of the range pass through the downsampler, which hands the chosen items to the callback.
+        bool status;
+        if (itemCount <= targetPoints)
+            status = collectItemsNoLock<T>(collect, itemOffset, itemCount);
+        else
+        {
+            Downsampler<T> downsampler(collect, itemCount, targetPoints, method);
+            status = collectItemsNoLock<T>([&downsampler](const T* items, const hsize_t count) { downsampler.add(items, count); }, itemOffset, itemCount);
+        }
+        if (!status)
+            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+        return true;
+    }
+
+    template <typename T> bool Data::ticksToIndexNoLock(const long long ticks, hsize_t& index, bool& match) const
+    {
+        LibraryLock libraryLock(theLibraryMutex);
+        if (0L >= ticks)
+        {
+zeroIndex:
+            index = 0L;
+            match = true;
+            return true;
+        }
+        T t{};
+        if (!readItem(columns_, 0, static_cast<void*>(&t)))
+        {
+failed:
+            index = 0L;
+            match = true;
+            return traceDataGetTimeTickIndexError(ticks, datasetPath_, filePath_);
+        }
+        const long long firstTicks = t.ticks_;
+        if (ticks <= firstTicks)
+            goto zeroIndex; // NOLINT
+        hsize_t itemCount;
+        if (!countRowsNoLock(itemCount))
+            goto failed; // NOLINT
+        if (0L >= itemCount)
+            goto zeroIndex; // NOLINT
+        if (!readItem(columns_, itemCount - 1, static_cast<void*>(&t)))
+            goto failed; // NOLINT
+        const long long lastTicks = t.ticks_;
+        if (ticks >= lastTicks)
+        {
+            index = itemCount - 1;
+            match = true;
+            return true;
+        }
+        if (!tickIndex_->lowerNeighborIndex<T>(columns_, itemCount, maximumTickIndexBytes_, ticks, itemCount, match))
+            goto failed; // NOLINT
+        index = itemCount;
+        return true;
+    }
+
+    template <typename T> bool Data::ticksToIndex(const long long ticks, hsize_t& index, bool& match) const
+    {
+        ReadLock lock(mutex_);
+        return ticksToIndexNoLock<T>(ticks, index, match);
+    }
+
+    template <typename T> bool Data::ticksToIndexRange(const long long ticksFrom, const long long ticksTo, hsize_t& indexFrom, hsize_t& indexTo, bool& matchFrom, bool& matchTo) const
+    {
+        ReadLock lock(mutex_);
+        const bool statusFrom = ticksToIndexNoLock<T>(ticksFrom, indexFrom, matchFrom);
+        const bool statusTo = ticksToIndexNoLock<T>(ticksTo, indexTo, matchTo);
+        return statusFrom && statusTo;
+    }
+
+    template <typename T> bool Data::fetchFromIndexRange(Collect<T> collect, const hsize_t index, hsize_t count) const
+    {
+        hsize_t dataCount;
+        ReadLock lock(mutex_);
+        if (!countNoLock(dataCount))
+            return traceDataFetchIndexRangeError(index, count, datasetPath_, filePath_);
+        if (index >= dataCount)
+            return false;
+        if (index + count > dataCount)
+            count = dataCount - index;
+        if (!collectItemsNoLock<T>(collect, index, count))
+            return traceDataFetchIndexRangeError(index, count, datasetPath_, filePath_);
+        return true;
+    }
+
+    template <typename T> bool Data::fetchLastItems(Collect<T> collect, const hsize_t count) const
+    {
+        hsize_t dataCount;
+        ReadLock lock(mutex_);
+        if (!countNoLock(dataCount))
+            return traceDataFetchIndexRangeError(0, count, datasetPath_, filePath_);
+        const hsize_t itemCount = std::min(count, dataCount);
+        if (0L >= itemCount)
+            return true;
+        if (!collectItemsNoLock<T>(collect, dataCount - itemCount, itemCount))
+            return traceDataFetchIndexRangeError(dataCount - itemCount, itemCount, datasetPath_, filePath_);
+        return true;
+    }
+
+    template <typename T> bool Data::fetchTickRangeIntoBuffer(T* buffer, const hsize_t capacity, hsize_t& written, const long long ticksFrom, const long long ticksTo) const
+    {
+        written = 0L;
+        hsize_t itemOffset, itemCount;
+        ReadLock lock(mutex_);
+        if (!tickRangeToIndexRangeNoLock<T>(ticksFrom, ticksTo, itemOffset, itemCount))
+            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+        if (itemCount > capacity)
+            itemCount = capacity;
+        if (0L >= itemCount)
+            return true;
+        std::unique_lock<std::mutex> libraryLock(theLibraryMutex);
+        if (!readItemsNoLock(itemOffset, itemCount, static_cast<void*>(buffer), libraryLock))
+            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+        countReadNoLock(itemOffset, itemCount, chunkRowsNoLock());
+        written = itemCount;
+        return true;
+    }
+
+    template <typename T> bool Data::fetchIndexRangeIntoBuffer(T* buffer, const hsize_t capacity, hsize_t& written, const hsize_t index, hsize_t count) const
+    {
+        written = 0L;
+        hsize_t dataCount;
+        ReadLock lock(mutex_);
+        if (!countNoLock(dataCount))
+            return traceDataFetchIndexRangeError(index, count, datasetPath_, filePath_);
+        if (index >= dataCount)
+            return false;
+        if (index + count > dataCount)
+            count = dataCount - index;
+        if (count > capacity)
+            count = capacity;
+        if (0L >= count)
+            return true;
+        std::unique_lock<std::mutex> libraryLock(theLibraryMutex);
+        if (!readItemsNoLock(index, count, static_cast<void*>(buffer), libraryLock))
+            return traceDataFetchIndexRangeError(index, count, datasetPath_, filePath_);
+        countReadNoLock(index, count, chunkRowsNoLock());
+        written = count;
+        return true;
+    }
+
+    template <typename T> bool Data::fetchTickRangeIntoProjection(Projection& projection, const unsigned fields, const long long ticksFrom, const long long ticksTo) const
+    {
+        hsize_t itemOffset, itemCount;
+        ReadLock lock(mutex_);
+        if (!tickRangeToIndexRangeNoLock<T>(ticksFrom, ticksTo, itemOffset, itemCount))
+            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+        if (!projectItemsNoLock(projection, fields, itemOffset, itemCount))
+            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+        return true;
+    }
+
+    bool Data::fetchIndexRangeIntoProjection(Projection& projection, const unsigned fields, const hsize_t index, hsize_t count) const
+    {
+        hsize_t dataCount;
+        ReadLock lock(mutex_);
+        if (!countNoLock(dataCount))
+            return traceDataFetchIndexRangeError(index, count, datasetPath_, filePath_);
+        if (index >= dataCount)
+            return false;
+        if (index + count > dataCount)
+            count = dataCount - index;
+        if (!projectItemsNoLock(projection, fields, index, count))
+            return traceDataFetchIndexRangeError(index, count, datasetPath_, filePath_);
+        return true;
+    }
+
+    bool Data::projectItemsNoLock(Projection& projection, const unsigned fields, const hsize_t itemOffset, const hsize_t itemCount) const
+    {
+        projection.count_ = 0;
+        LibraryLock libraryLock(theLibraryMutex);
+        const int members = H5Tget_nmembers(nativeTypeId_);
+        if (0 >= members || static_cast<int>(Projection::maximumFields) < members || 0 == fields || 0 != (fields >> members))
+            return false;
+        if (!projection.reserve(fields, itemCount))
+            return false;
+
+        // A memory type holding a single field makes the library convert only this field, straight into its column.
+        hid_t memoryTypes[Projection::maximumFields]{};
+        bool status{ true };
+        for (int m = 0; status && m < members; ++m)
+        {
+            if (0 != (fields & (1U << m)))
+                status = 0 < (memoryTypes[m] = fieldType(nativeTypeId_, m));
+        }
+
+        // The fields of a chunk are read one after another, so that the chunk stays in the chunk cache meanwhile.
+        // In the columnar layout every field is read from its own dataset and the other fields are not read at all.
+        const hsize_t chunkRows = chunkRowsNoLock();
+        const hsize_t head = columns_.head_;
+        const hsize_t itemEnd = itemOffset + itemCount;
+        for (hsize_t i = itemOffset; status && i < itemEnd;)
+        {
+            const hsize_t pageEnd = std::min(itemEnd, ((head + i) / chunkRows + 1) * chunkRows - head);
+            for (int m = 0; status && m < members; ++m)
+            {
+                if (0 != (fields & (1U << m)))
+                    status = readItemRange(1 == columns_.size() ? datasetId_ : columns_[m].first, memoryTypes[m], head + i, pageEnd - i, projection.columns_[m] + (i - itemOffset) * 8);
+            }
+            if (status)
+                countReadNoLock(i, pageEnd - i, chunkRows);
+            i = pageEnd;
+        }
+        for (const hid_t memoryType : memoryTypes)
+        {
+            if (0 < memoryType)
+                H5Tclose(memoryType);
+        }
+        if (status)
+            projection.count_ = itemCount;
+        return status;
+    }
+
+    template <typename T> bool Data::aggregateFromTickRange(DataAggregate& aggregate, const long long ticksFrom, const long long ticksTo, const AggregateSpec& spec) const
+    {
+        // The volume-weighted price needs the prices and the volumes of trades, the time-weighted ones the ask and the bid prices of quotes.
+        constexpr bool trades = std::is_same<T, Trade>::value;
+        constexpr bool quotes = std::is_same<T, Quote>::value || std::is_same<T, QuotePriceOnly>::value;
+        hsize_t itemOffset, itemCount;
+        aggregate = DataAggregate{};
+        ReadLock lock(mutex_);
+        {
+            LibraryLock libraryLock(theLibraryMutex);
+            seedTickIndexNoLock();
+        }
+        if ((spec.volumeWeighted_ && !trades) || (spec.timeWeighted_ && !quotes)
+            || !tickRangeToIndexRangeNoLock<T>(ticksFrom, ticksTo, itemOffset, itemCount)
+            || !aggregateItemsNoLock(aggregate, spec, itemOffset, itemCount))
+            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+        return true;
+    }
+
+    bool Data::aggregateItemsNoLock(DataAggregate& aggregate, const AggregateSpec& spec, const hsize_t itemOffset, const hsize_t itemCount) const
+    {
+        aggregate = DataAggregate{};
+        LibraryLock libraryLock(theLibraryMutex);
+        const int members = H5Tget_nmembers(nativeTypeId_);
+        if (0 >= members || static_cast<int>(DataZone::maximumFields) < members - 1 || 0 != (spec.fields_ >> members))
+            return false;
+        if (0 == itemCount)
+            return true;
+
+        // The first and the last items are read whole.
+        const size_t itemSize = H5Tget_size(nativeTypeId_);
+        const size_t fieldBytes = static_cast<size_t>(members - 1) * 8;
+        std::vector<unsigned char> item(itemSize);
+        if (itemSize < 8 + fieldBytes || !readItem(columns_, itemOffset, item.data()))
+            return false;
+        std::memcpy(&aggregate.firstTicks_, item.data(), 8);
+        std::memcpy(aggregate.first_, item.data() + 8, fieldBytes);
+        if (!readItem(columns_, itemOffset + itemCount - 1, item.data()))
+            return false;
+        std::memcpy(&aggregate.lastTicks_, item.data(), 8);
+        std::memcpy(aggregate.last_, item.data() + 8, fieldBytes);
+        aggregate.count_ = itemCount;
+
+        // The price and the volume of a trade, as well as the ask and the bid prices of a quote, follow the ticks.
+        // The weighted aggregates need the items, otherwise the whole chunks are taken from the zone maps.
+        const unsigned fields = spec.fields_ & ~1U;
+        unsigned streamed = fields;
+        if (spec.volumeWeighted_)
+            streamed |= 0x06;
+        if (spec.timeWeighted_)
+            streamed |= 0x07;
+        if (0 == streamed)
+            return true;
+        const bool zones = !spec.volumeWeighted_ && !spec.timeWeighted_ && loadZonesNoLock(true);
+
+        const hsize_t chunkRows = chunkRowsNoLock();
+        const size_t pageRows = static_cast<size_t>(std::min(chunkRows, itemCount));
+        // In the compound layout a page of whole items is read at once and the needed fields are gathered from it,
+        // which is cheaper than letting the library convert every field by itself. In the columnar layout every field is read from its own dataset.
+        const bool compound = 1 == columns_.size();
+        std::vector<unsigned char> items(compound ? pageRows * itemSize : 0);
+        hid_t memoryTypes[Projection::maximumFields]{};
+        std::vector<double> columns[Projection::maximumFields];
+        std::vector<long long> ticks;
+        bool status{ true };
+        for (int m = 0; status && m < members; ++m)
+        {
+            if (0 == (streamed & (1U << m)))
+                continue;
+            if (!compound)
+                status = 0 < (memoryTypes[m] = fieldType(nativeTypeId_, m));
+            if (0 == m)
+                ticks.resize(pageRows);
+            else
+                columns[m].resize(pageRows);
+        }
+
+        // The fields of a chunk are read one after another into the columns and reduced, so that the chunk stays in the chunk cache meanwhile.
+        // A time-weighted quote is weighted by the ticks until the next quote, which may be in the next chunk.
+        bool reduced[DataZone::maximumFields]{};
+        double weightedSum{ 0 }, volumeSum{ 0 }, midSum{ 0 }, spreadSum{ 0 }, previousMid{ 0 }, previousSpread{ 0 };
+        long long previousTicks{ 0 };
+        bool previous{ false };
+        const hsize_t head = columns_.head_;
+        const hsize_t itemEnd = itemOffset + itemCount;
+        const std::vector<hsize_t> starts = zones ? zoneStarts(zones_) : std::vector<hsize_t>();
+        for (hsize_t i = itemOffset; status && i < itemEnd;)
+        {
+            // A page is the part of a zone in the range, or of a chunk without the zone maps, and the whole zones are taken from their zone maps.
+            const size_t zoneIndex = zones ? zoneOf(starts, i) : 0;
+            const bool zoned = zones && zoneIndex < zones_.size();
+            const hsize_t pageEnd = std::min(itemEnd, zoned ? starts[zoneIndex + 1] : ((head + i) / chunkRows + 1) * chunkRows - head);
+            const size_t pageCount = static_cast<size_t>(pageEnd - i);
+            if (zoned && starts[zoneIndex] == i && starts[zoneIndex + 1] == pageEnd)
+            {
+                const DataZone& zone = zones_[zoneIndex];
+                for (int m = 1; m < members; ++m)
+                {
+                    if (0 == (fields & (1U << m)))
+                        continue;
+                    const int k = m - 1;
+                    if (!reduced[k] || zone.minimum_[k] < aggregate.minimum_[k])
+                        aggregate.minimum_[k] = zone.minimum_[k];
+                    if (!reduced[k] || zone.maximum_[k] > aggregate.maximum_[k])
+                        aggregate.maximum_[k] = zone.maximum_[k];
+                    aggregate.sum_[k] += zone.sum_[k];
+                    reduced[k] = true;
+                }
+                i = pageEnd;
+                continue;
+            }
+            if (compound)
+            {
+                status = readItemRange(datasetId_, nativeTypeId_, head + i, pageCount, items.data());
+                for (int m = 0; status && m < members; ++m)
                 {
-                    if (!prependItems(datasetId_, nativeTypeId_, index + 1, static_cast<void*>(const_cast<T*>(input)), sizeof(T)))
-                        return traceDataPrependFailError(index, datasetPath_, filePath_);
+                    if (0 == (streamed & (1U << m)))
+                        continue;
+                    unsigned char* column = 0 == m ? reinterpret_cast<unsigned char*>(ticks.data()) : reinterpret_cast<unsigned char*>(columns[m].data());
+                    const unsigned char* field = items.data() + static_cast<size_t>(m) * 8;
+                    for (size_t r = 0; r < pageCount; ++r, field += itemSize)
+                        std::memcpy(column + r * 8, field, 8);
                 }
-                if (++index < inputCount)
+            }
+            for (int m = 0; !compound && status && m < members; ++m)
+            {
+                if (0 != (streamed & (1U << m)))
+                    status = readItemRange(columns_[m].first, memoryTypes[m], head + i, pageCount,
+                        0 == m ? static_cast<void*>(ticks.data()) : static_cast<void*>(columns[m].data()));
+            }
+            if (!status)
+                break;
+            countReadNoLock(i, pageCount, chunkRows);
+            for (int m = 1; m < members; ++m)
+            {
+                if (0 == (fields & (1U << m)))
+                    continue;
+                const int k = m - 1;
+                reduceColumn(columns[m].data(), pageCount, reduced[k], aggregate.minimum_[k], aggregate.maximum_[k], aggregate.sum_[k]);
+                reduced[k] = true;
+            }
+            if (spec.volumeWeighted_)
+                reduceVolumeWeighted(columns[1].data(), columns[2].data(), pageCount, weightedSum, volumeSum);
+            if (spec.timeWeighted_)
+            {
+                const double* askPrices = columns[1].data();
+                const double* bidPrices = columns[2].data();
+                if (previous)
                 {
-                    if (!mergeItems(datasetId_, nativeTypeId_, index, inputCount - index, input, duplicateTimeTicks, verbose))
-                        return traceDataMergeOffsetFailError(inputCount - index, index, datasetPath_, filePath_);
+                    const double weight = static_cast<double>(ticks[0] - previousTicks);
+                    midSum += previousMid * weight;
+                    spreadSum += previousSpread * weight;
                 }
+                reduceTimeWeighted(ticks.data(), askPrices, bidPrices, pageCount, midSum, spreadSum);
+                previousTicks = ticks[pageCount - 1];
+                previousMid = 0.5 * (askPrices[pageCount - 1] + bidPrices[pageCount - 1]);
+                previousSpread = askPrices[pageCount - 1] - bidPrices[pageCount - 1];
+                previous = true;
             }
+            i = pageEnd;
+        }
+        for (const hid_t memoryType : memoryTypes)
+        {
+            if (0 < memoryType)
+                H5Tclose(memoryType);
+        }
+        if (!status)
+        {
+            aggregate = DataAggregate{};
+            return false;
+        }
+
+        if (spec.volumeWeighted_ && 0 != volumeSum)
+            aggregate.volumeWeightedPrice_ = weightedSum / volumeSum;
+        if (spec.timeWeighted_)
+        {
+            // The weights sum up to the ticks between the first and the last quotes.
+            const double duration = static_cast<double>(aggregate.lastTicks_ - aggregate.firstTicks_);
+            aggregate.timeWeightedMid_ = 0 < duration ? midSum / duration : previousMid;
+            aggregate.timeWeightedSpread_ = 0 < duration ? spreadSum / duration : previousSpread;
         }
         return true;
     }
 
-    template <typename T> bool Data::addData(std::vector<T>& input, const DuplicateTimeTicks duplicateTimeTicks, const bool verbose) const
+    template <typename T> std::shared_ptr<Cursor<T>> Data::cursorFromTickRange(const long long ticksFrom, const long long ticksTo, const bool reverse) const
     {
-        return addData<T>(input.data(), hsize_t(input.size()), duplicateTimeTicks, verbose);
+        hsize_t itemOffset, itemCount;
+        ReadLock lock(mutex_);
+        if (!tickRangeToIndexRangeNoLock<T>(ticksFrom, ticksTo, itemOffset, itemCount))
+        {
+            traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+            return std::shared_ptr<Cursor<T>>();
+        }
+        return cursorNoLock<T>(itemOffset, itemCount, reverse);
     }
 
-    template <typename T> bool Data::fetchData(Collect<T> collect, const long long ticksFrom, const long long ticksTo) const
+    template <typename T> std::shared_ptr<Cursor<T>> Data::cursorFromIndexRange(const hsize_t index, hsize_t count, const bool reverse) const
     {
-        std::lock_guard<std::mutex> lock(theMutex);
-        return fetchDataNoLock<T>(collect, ticksFrom, ticksTo);
+        hsize_t dataCount;
+        ReadLock lock(mutex_);
+        if (!countNoLock(dataCount))
+        {
+            traceDataFetchIndexRangeError(index, count, datasetPath_, filePath_);
+            return std::shared_ptr<Cursor<T>>();
+        }
+        if (index >= dataCount)
+            return std::shared_ptr<Cursor<T>>();
+        if (index + count > dataCount)
+            count = dataCount - index;
+        return cursorNoLock<T>(index, count, reverse);
     }
 
-    template <typename T> bool Data::fetchDataNoLock(Collect<T> collect, const long long ticksFrom, long long ticksTo) const
+    template <typename T> std::shared_ptr<Appender<T>> Data::appender(const AppenderOptions& options) const
     {
-        hsize_t itemOffset, itemCount;
-        long long lastTicks;
-        T t{};
-        if (0L >= ticksFrom)
+        if (readOnly_ || 0 == options.capacity_)
+            return std::shared_ptr<Appender<T>>();
+        hsize_t flushItems = options.flushItems_;
+        if (0 == flushItems)
         {
-lessThanFirst:
-            itemOffset = 0L;
-            if (!countItems(datasetId_, itemCount))
-                return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
-            if (0L >= itemCount)
-                return true;
-            if (0L < ticksTo)
-            {
-                if (!readItem(datasetId_, nativeTypeId_, itemCount - 1, static_cast<void*>(&t)))
-                    return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
-                lastTicks = t.ticks_;
-                if (ticksTo < lastTicks)
-                {
-                    hsize_t index;
-                    bool match;
-                    if (!lowerNeighborIndex<T>(datasetId_, nativeTypeId_, ticksTo, index, match))
-                        return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
-                    itemCount = ++index;
-                }
-            }
+            ReadLock lock(mutex_);
+            LibraryLock libraryLock(theLibraryMutex);
+            flushItems = chunkRowsNoLock();
         }
-        else // ticksFrom > 0
+        if (flushItems > options.capacity_)
+            flushItems = options.capacity_;
+        return std::shared_ptr<Appender<T>>(new Appender<T>(shared_from_this(), options, flushItems));
+    }
+
+    template <typename T> std::shared_ptr<Cursor<T>> Data::cursorNoLock(const hsize_t itemOffset, const hsize_t itemCount, const bool reverse) const
+    {
+        hsize_t chunkRows;
         {
-            if (!readItem(datasetId_, nativeTypeId_, 0, static_cast<void*>(&t)))
-                return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
-            const long long firstTicks = t.ticks_;
-            if (0L < ticksTo)
-            {
-                if (ticksTo < firstTicks)
-                    return true;
-            }
-            if (ticksFrom <= firstTicks)
-                goto lessThanFirst; // NOLINT
-            if (!countItems(datasetId_, itemCount))
-                return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
-            if (0L >= itemCount)
-                return true;
-            if (!readItem(datasetId_, nativeTypeId_, itemCount - 1, static_cast<void*>(&t)))
-                return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
-            lastTicks = t.ticks_;
-            if (ticksFrom > lastTicks)
-                return true;
-            if (0L >= ticksTo)
-            {
-                ticksTo = lastTicks;
-                if (ticksTo < firstTicks)
-                    return true;
-            }
-            bool match;
-            if (!lowerNeighborIndex<T>(datasetId_, nativeTypeId_, ticksFrom, itemOffset, match))
-                return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
-            if (!match)
-                ++itemOffset;
-            if (ticksTo < lastTicks)
-            {
-                hsize_t index;
-                if (!lowerNeighborIndex<T>(datasetId_, nativeTypeId_, ticksTo, index, match))
-                    return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
-                itemCount = ++index - itemOffset;
-            }
-            else // ticksTo >= lastTicks
-                itemCount -= itemOffset;
+            LibraryLock libraryLock(theLibraryMutex);
+            chunkRows = chunkRowsNoLock();
         }
-        if (0L >= itemCount)
-            return true;
-        // Get the dataspace handle.
-        hid_t memorySpace_id;
-        const hid_t space_id = H5Dget_space(datasetId_);
-        if (0 > space_id)
-            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
-        hsize_t dims[1], offsets[1];
-        void* ptr;
-        const hsize_t bytesTotal = itemCount * sizeof(T);
+        // A page holds as many whole chunks as fit in the read buffer, but at least one.
+        hsize_t pageRows = chunkRows;
         const hsize_t bytesLimit = maximumReadBufferBytes();
-        if (0 == bytesLimit || bytesLimit > bytesTotal)
+        if (bytesLimit > chunkRows * sizeof(T))
+            pageRows = chunkRows * (bytesLimit / (chunkRows * sizeof(T)));
+        return std::shared_ptr<Cursor<T>>(new Cursor<T>(shared_from_this(), itemOffset, itemCount, pageRows, chunkRows, reverse));
+    }
+
+    // ----------------------------------------------------------------------
+    // Projection
+    // ----------------------------------------------------------------------
+
+    const double* Projection::column(const unsigned field) const
+    {
+        for (unsigned i = 1; i < maximumFields; ++i)
         {
-            dims[0] = itemCount;
-            // Allocate memory block for stored data.
-            ptr = static_cast<void*>(calloc(size_t(itemCount), sizeof(T)));
-            if (nullptr == ptr)
-            {
-closeSpace:
-                H5Sclose(space_id);
-                return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
-            }
-            // Create a simple memory dataspace.
-            memorySpace_id = H5Screate_simple(1, dims, nullptr);
-            if (0 > memorySpace_id)
-            {
-deallocate:
-                free(ptr);
-                goto closeSpace; // NOLINT
-            }
-            // Define a hyperslab in the dataset.
-            offsets[0] = itemOffset;
-            if (0 > H5Sselect_hyperslab(space_id, H5S_SELECT_SET, offsets, nullptr, dims, nullptr))
+            if ((1U << i) == field)
+                return reinterpret_cast<const double*>(columns_[i]);
+        }
+        return nullptr;
+    }
+
+    bool Projection::reserve(const unsigned fields, const hsize_t count)
+    {
+        // Every column starts at a multiple of the alignment.
+        const size_t columnBytes = (static_cast<size_t>(count) * 8 + alignment - 1) / alignment * alignment;
+        size_t columns{ 0 };
+        for (unsigned i = 0; i < maximumFields; ++i)
+            columns += 0 != (fields & (1U << i)) ? 1 : 0;
+        const size_t bytes = std::max(columns * columnBytes, alignment);
+        if (bytes > storageBytes_)
+        {
+            storage_.reset();
+            storageBytes_ = 0;
+            storage_.reset(static_cast<unsigned char*>(::operator new[](bytes, std::align_val_t(alignment), std::nothrow)));
+            if (!storage_)
+                return false;
+            storageBytes_ = bytes;
+        }
+        size_t column{ 0 };
+        for (unsigned i = 0; i < maximumFields; ++i)
+            columns_[i] = 0 != (fields & (1U << i)) ? storage_.get() + columnBytes * column++ : nullptr;
+        fields_ = fields;
+        return true;
+    }
+
+    void Projection::Deleter::operator()(unsigned char* storage) const
+    {
+        ::operator delete[](storage, std::align_val_t(alignment));
+    }
+
+    // ----------------------------------------------------------------------
+    // Cursor
+    // ----------------------------------------------------------------------
+
+    template <typename T> Cursor<T>::Cursor(std::shared_ptr<const Data> data, const hsize_t index, const hsize_t count, const hsize_t pageRows, const hsize_t chunkRows,
+        const bool reverse)
+        : data_(std::move(data)), offset_(index), end_(index + count), pageRows_(pageRows), chunkRows_(chunkRows), reverse_(reverse), pageIndex_(index)
+    {
+        if (offset_ >= end_)
+        {
+            done_ = true;
+            return;
+        }
+        const hsize_t rows = std::min(pageRows_, end_ - offset_);
+        pages_[0].resize(size_t(rows));
+        pages_[1].resize(size_t(rows));
+        thread_ = std::thread(&Cursor<T>::readAhead, this);
+    }
+
+    template <typename T> Cursor<T>::~Cursor()
+    {
+        close();
+    }
+
+    template <typename T> void Cursor<T>::close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        condition_.notify_all();
+        if (thread_.joinable())
+            thread_.join();
+        std::vector<T>().swap(pages_[0]);
+        std::vector<T>().swap(pages_[1]);
+        pageFilled_[0] = pageFilled_[1] = holding_ = false;
+        done_ = true;
+    }
+
+    template <typename T> void Cursor<T>::readAhead()
+    {
+        const hsize_t capacity = pages_[0].size();
+        hsize_t offset = offset_, end = end_;
+        while (offset < end)
+        {
+            const int slot = static_cast<int>(produced_ % 2);
             {
-closeMemorySpace:
-                H5Sclose(memorySpace_id);
-                goto deallocate; // NOLINT
+                std::unique_lock<std::mutex> lock(mutex_);
+                condition_.wait(lock, [this, slot] { return stop_ || !pageFilled_[slot]; });
+                if (stop_)
+                    return;
             }
-            // Read in the stored items.
-            if (0 > H5Dread(datasetId_, nativeTypeId_, memorySpace_id, space_id, H5P_DEFAULT, ptr))
-                goto closeMemorySpace; // NOLINT
-            try
+            // The first page ends at a chunk boundary, so that every page read decompresses only its own chunks.
+            // Reading backwards, the first page starts at a chunk boundary instead.
+            hsize_t pageStart = offset, pageEnd = end;
+            if (reverse_)
             {
-                collect(static_cast<const T*>(ptr), dims[0]);
+                const hsize_t chunkEnd = ((end - 1) / chunkRows_ + 1) * chunkRows_;
+                if (chunkEnd >= offset + pageRows_)
+                    pageStart = chunkEnd - pageRows_;
             }
-            catch (const std::exception& e)
+            else if ((offset / chunkRows_) * chunkRows_ + pageRows_ < end)
+                pageEnd = (offset / chunkRows_) * chunkRows_ + pageRows_;
+            hsize_t written;
+            const bool status = data_->fetchIndexRangeIntoBuffer<T>(pages_[slot].data(), capacity, written, pageStart, pageEnd - pageStart);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!status)
             {
-                free(ptr);
-                H5Sclose(memorySpace_id);
-                H5Sclose(space_id);
-                traceDataExceptionWhileCollectingItemsError(e, datasetPath_, filePath_);
-                return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
-            }
-        }
-        else
-        {
-            hsize_t itemLimit = bytesLimit / sizeof(T);
-            if (0 >= itemLimit)
-                goto closeSpace; // NOLINT
-            // Allocate memory block for stored data.
-            ptr = static_cast<void*>(calloc(size_t(itemLimit), sizeof(T)));
-            if (nullptr == ptr)
-                goto closeSpace; // NOLINT
-            dims[0] = itemLimit;
-            // Create a simple memory dataspace.
-            memorySpace_id = H5Screate_simple(1, dims, nullptr);
-            if (0 > memorySpace_id)
-                goto deallocate; // NOLINT
-            for (hsize_t i = itemOffset;;)
-            {
-                // Define a hyperslab in the dataset.
-                offsets[0] = i;
-                if (0 > H5Sselect_hyperslab(space_id, H5S_SELECT_SET, offsets, nullptr, dims, nullptr))
-                    goto closeMemorySpace; // NOLINT
-                // Read in the <indexLimit> stored items starting from <i>.
-                if (0 > H5Dread(datasetId_, nativeTypeId_, memorySpace_id, space_id, H5P_DEFAULT, ptr))
-                    goto closeMemorySpace; // NOLINT
-                // Add items to the list.
-                try
-                {
-                    collect(static_cast<const T*>(ptr), itemLimit);
-                }
-                catch (const std::exception& e)
-                {
-                    free(ptr);
-                    H5Sclose(memorySpace_id);
-                    H5Sclose(space_id);
-                    traceDataExceptionWhileCollectingItemsError(e, datasetPath_, filePath_);
-                    return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
-                }
-                itemCount -= itemLimit;
-                i += itemLimit;
-                if (itemCount < itemLimit)
-                {
-                    itemLimit = itemCount;
-                    if (0 >= itemLimit)
-                        break;
-                    dims[0] = itemLimit;
-                    if (0 > H5Sclose(memorySpace_id))
-                        goto deallocate; // NOLINT
-                    memorySpace_id = H5Screate_simple(1, dims, nullptr);
-                    if (0 > memorySpace_id)
-                        goto deallocate; // NOLINT
-                }
+                failed_ = true;
+                break;
             }
+            pageOffsets_[slot] = pageStart;
+            pageCounts_[slot] = written;
+            pageFilled_[slot] = true;
+            ++produced_;
+            condition_.notify_all();
+            if (written < pageEnd - pageStart)
+                break;
+            if (reverse_)
+                end = pageStart;
+            else
+                offset = pageEnd;
         }
-        free(ptr);
-        if (0 > H5Sclose(memorySpace_id))
+        std::lock_guard<std::mutex> lock(mutex_);
+        done_ = true;
+        condition_.notify_all();
+    }
+
+    template <typename T> bool Cursor<T>::next(const T*& page, hsize_t& count)
+    {
+        page = nullptr;
+        count = 0L;
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (holding_)
         {
-            H5Sclose(space_id);
-            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+            pageFilled_[(consumed_ - 1) % 2] = false;
+            holding_ = false;
+            condition_.notify_all();
         }
-        if (0 > H5Sclose(space_id))
-            return traceDataFetchTimeTickRangeError(ticksFrom, ticksTo, datasetPath_, filePath_);
+        const int slot = static_cast<int>(consumed_ % 2);
+        condition_.wait(lock, [this, slot] { return pageFilled_[slot] || done_; });
+        if (!pageFilled_[slot])
+            return !failed_;
+        page = pages_[slot].data();
+        count = pageCounts_[slot];
+        pageIndex_ = pageOffsets_[slot];
+        holding_ = true;
+        ++consumed_;
         return true;
     }
 
-    template <typename T> bool Data::ticksToIndexNoLock(const long long ticks, hsize_t& index, bool& match) const
+    template class Cursor<Quote>;
+    template class Cursor<QuotePriceOnly>;
+    template class Cursor<Trade>;
+    template class Cursor<TradePriceOnly>;
+    template class Cursor<Ohlcv>;
+    template class Cursor<OhlcvPriceOnly>;
+    template class Cursor<Scalar>;
+
+    // ----------------------------------------------------------------------
+    // Appender
+    // ----------------------------------------------------------------------
+
+    template <typename T> Appender<T>::Appender(std::shared_ptr<const Data> data, const AppenderOptions& options, const hsize_t flushItems)
+        : data_(std::move(data)), ring_(static_cast<size_t>(options.capacity_)), batch_(static_cast<size_t>(flushItems)), flushItems_(flushItems),
+        flushInterval_(options.flushMilliseconds_), overflow_(options.overflow_), duplicateTimeTicks_(options.duplicateTimeTicks_)
+    {
+        thread_ = std::thread(&Appender<T>::writeBehind, this);
+    }
+
+    template <typename T> Appender<T>::~Appender()
+    {
+        close();
+    }
+
+    template <typename T> void Appender<T>::close()
     {
-        if (0L >= ticks)
         {
-zeroIndex:
-            index = 0L;
-            match = true;
-            return true;
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_.store(true, std::memory_order_release);
+            stop_ = true;
         }
-        T t{};
-        if (!readItem(datasetId_, nativeTypeId_, 0, static_cast<void*>(&t)))
+        wakeWriter_.notify_all();
+        wakeAppender_.notify_all();
+        if (thread_.joinable())
+            thread_.join();
+    }
+
+    template <typename T> bool Appender<T>::append(const T& item)
+    {
+        return append(&item, 1);
+    }
+
+    template <typename T> bool Appender<T>::append(const T* items, const hsize_t count)
+    {
+        // The single appending thread owns the head, the background thread owns the tail.
+        if (closed_.load(std::memory_order_acquire))
         {
-failed:
-            index = 0L;
-            match = true;
-            return traceDataGetTimeTickIndexError(ticks, datasetPath_, filePath_);
+            rejected_.fetch_add(count, std::memory_order_relaxed);
+            return false;
         }
-        const long long firstTicks = t.ticks_;
-        if (ticks <= firstTicks)
-            goto zeroIndex; // NOLINT
-        hsize_t itemCount;
-        if (!countItems(datasetId_, itemCount))
-            goto failed; // NOLINT
-        if (0L >= itemCount)
-            goto zeroIndex; // NOLINT
-        if (!readItem(datasetId_, nativeTypeId_, itemCount - 1, static_cast<void*>(&t)))
-            goto failed; // NOLINT
-        const long long lastTicks = t.ticks_;
-        if (ticks >= lastTicks)
+        const unsigned long long capacity = ring_.size();
+        unsigned long long head = head_.load(std::memory_order_relaxed);
+        for (hsize_t i = 0; i < count; ++i)
         {
-            index = itemCount - 1;
-            match = true;
-            return true;
+            if (head - tail_.load(std::memory_order_acquire) == capacity)
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (AppenderOverflow::Reject == overflow_ || closed_.load(std::memory_order_relaxed))
+                {
+                    appended_.fetch_add(i, std::memory_order_relaxed);
+                    rejected_.fetch_add(count - i, std::memory_order_relaxed);
+                    return false;
+                }
+                wakeWriter_.notify_one();
+                wakeAppender_.wait(lock, [this, head, capacity] { return closed_.load(std::memory_order_relaxed) || head - tail_.load(std::memory_order_acquire) < capacity; });
+                if (closed_.load(std::memory_order_relaxed))
+                {
+                    appended_.fetch_add(i, std::memory_order_relaxed);
+                    rejected_.fetch_add(count - i, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+            ring_[static_cast<size_t>(head % capacity)] = items[i];
+            head_.store(++head, std::memory_order_release);
+
+            // Wake the background thread once the queue reaches the flush size, not on every item.
+            if (head - tail_.load(std::memory_order_acquire) == flushItems_)
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                wakeWriter_.notify_one();
+            }
         }
-        if (!lowerNeighborIndex<T>(datasetId_, nativeTypeId_, ticks, itemCount, match))
-            goto failed; // NOLINT
-        index = itemCount;
+        appended_.fetch_add(count, std::memory_order_relaxed);
         return true;
     }
 
-    template <typename T> bool Data::ticksToIndex(const long long ticks, hsize_t& index, bool& match) const
+    template <typename T> bool Appender<T>::flush()
     {
-        std::lock_guard<std::mutex> lock(theMutex);
-        return ticksToIndexNoLock<T>(ticks, index, match);
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!stop_)
+        {
+            const unsigned long long request = flushRequests_.fetch_add(1, std::memory_order_relaxed) + 1;
+            wakeWriter_.notify_one();
+            wakeAppender_.wait(lock, [this, request] { return stop_ || flushesDone_ >= request; });
+        }
+        return 0 == failed_.load(std::memory_order_relaxed);
     }
 
-    template <typename T> bool Data::ticksToIndexRange(const long long ticksFrom, const long long ticksTo, hsize_t& indexFrom, hsize_t& indexTo, bool& matchFrom, bool& matchTo) const
+    template <typename T> AppenderStatistics Appender<T>::statistics() const
     {
-        std::lock_guard<std::mutex> lock(theMutex);
-        const bool statusFrom = ticksToIndexNoLock<T>(ticksFrom, indexFrom, matchFrom);
-        const bool statusTo = ticksToIndexNoLock<T>(ticksTo, indexTo, matchTo);
-        return statusFrom && statusTo;
+        return { queueDepth(), appended_.load(std::memory_order_relaxed), rejected_.load(std::memory_order_relaxed),
+            flushed_.load(std::memory_order_relaxed), failed_.load(std::memory_order_relaxed), flushes_.load(std::memory_order_relaxed),
+            lastFlushMicroseconds_.load(std::memory_order_relaxed), maximumFlushMicroseconds_.load(std::memory_order_relaxed) };
     }
 
-    template <typename T> bool Data::fetchFromIndexRange(Collect<T> collect, const hsize_t index, hsize_t count) const
+    template <typename T> void Appender<T>::writeBehind()
     {
-        void* ptr{ nullptr };
-        try
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;)
         {
-            hsize_t itemCount{ hsize_t(0) };
-            std::lock_guard<std::mutex> lock(theMutex);
-            if (!countItems(datasetId_, itemCount))
-                return traceDataFetchIndexRangeError(index, count, datasetPath_, filePath_);
-            if (index < itemCount)
-            {
-                if (index + count > itemCount)
-                    count = itemCount - index;
-                ptr = static_cast<void*>(calloc(size_t(count + 1), sizeof(T)));
-                if (nullptr == ptr)
-                    return traceDataFetchIndexRangeError(index, count, datasetPath_, filePath_);
-                if (!readItemRange(datasetId_, nativeTypeId_, index, count, ptr))
-                    return traceDataFetchIndexRangeError(index, count, datasetPath_, filePath_);
-                collect(static_cast<const T*>(ptr), count);
-                free(ptr);
-                ptr = nullptr;
-                return true;
-            }
+            const auto ready = [this] { return stop_ || flushRequests_.load(std::memory_order_relaxed) != flushesDone_ || queueDepth() >= flushItems_; };
+            if (0 == flushInterval_.count())
+                wakeWriter_.wait(lock, ready);
+            else
+                wakeWriter_.wait_for(lock, flushInterval_, ready);
+            const unsigned long long requests = flushRequests_.load(std::memory_order_relaxed);
+            const bool stop = stop_;
+            lock.unlock();
+            writeQueued();
+            lock.lock();
+            flushesDone_ = requests;
+            wakeAppender_.notify_all();
+            if (stop)
+                return;
         }
-        catch (const std::exception& e)
+    }
+
+    template <typename T> void Appender<T>::writeQueued()
+    {
+        const unsigned long long capacity = ring_.size();
+        unsigned long long tail = tail_.load(std::memory_order_relaxed);
+        for (;;)
         {
-            if (nullptr != ptr)
-                free(ptr);
-            traceDataExceptionWhileCollectingItemsError(e, datasetPath_, filePath_);
-            return traceDataFetchIndexRangeError(index, count, datasetPath_, filePath_);
+            const unsigned long long head = head_.load(std::memory_order_acquire);
+            if (head == tail)
+                return;
+
+            // Copy a batch out of the ring and free its slots before writing, so the appending thread is not held up by the write.
+            const hsize_t count = std::min<unsigned long long>(head - tail, batch_.size());
+            const size_t first = static_cast<size_t>(tail % capacity);
+            const size_t firstCount = std::min(static_cast<size_t>(count), ring_.size() - first);
+            std::copy_n(ring_.begin() + first, firstCount, batch_.begin());
+            std::copy_n(ring_.begin(), static_cast<size_t>(count) - firstCount, batch_.begin() + firstCount);
+            tail += count;
+            tail_.store(tail, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                wakeAppender_.notify_all();
+            }
+
+            const auto started = std::chrono::steady_clock::now();
+            const bool status = data_->addData<T>(batch_.data(), count, duplicateTimeTicks_, false);
+            const long long microseconds = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started).count();
+            (status ? flushed_ : failed_).fetch_add(count, std::memory_order_relaxed);
+            flushes_.fetch_add(1, std::memory_order_relaxed);
+            lastFlushMicroseconds_.store(microseconds, std::memory_order_relaxed);
+            if (microseconds > maximumFlushMicroseconds_.load(std::memory_order_relaxed))
+                maximumFlushMicroseconds_.store(microseconds, std::memory_order_relaxed);
         }
-        return false;
     }
 
+    template class Appender<Quote>;
+    template class Appender<QuotePriceOnly>;
+    template class Appender<Trade>;
+    template class Appender<TradePriceOnly>;
+    template class Appender<Ohlcv>;
+    template class Appender<OhlcvPriceOnly>;
+    template class Appender<Scalar>;
+
     // ----------------------------------------------------------------------
     // QuoteData
     // ----------------------------------------------------------------------
@@ -4546,14 +9534,84 @@ failed:
         return fetchData<Quote>(collect, hsize_t(0), hsize_t(0));
     }
 
-    bool QuoteData::fetchTickRange(const CollectQuote& collect, const long long from, const long long to) const
+    bool QuoteData::fetchTickRange(const CollectQuote& collect, const long long from, const long long to) const
+    {
+        return fetchData<Quote>(collect, from, to);
+    }
+
+    bool QuoteData::fetchTickRangeWhere(const CollectQuote& collect, const long long from, const long long to, const DataPredicate& predicate) const
+    {
+        return fetchDataWhere<Quote>(collect, from, to, predicate);
+    }
+
+    bool QuoteData::fetchDownsampled(const CollectQuote& collect, const long long from, const long long to, const hsize_t targetPoints, const DownsamplingMethod method) const
+    {
+        return fetchDownsampledData<Quote>(collect, from, to, targetPoints, method);
+    }
+
+    bool QuoteData::fetchIndexRange(const CollectQuote& collect, const hsize_t index, const hsize_t count) const
+    {
+        return fetchFromIndexRange<Quote>(collect, index, count);
+    }
+
+    bool QuoteData::fetchLast(const CollectQuote& collect, const hsize_t count) const
+    {
+        return fetchLastItems<Quote>(collect, count);
+    }
+
+    bool QuoteData::fetchTickRangeInto(Quote* buffer, const hsize_t capacity, hsize_t& written, const long long from, const long long to) const
+    {
+        return fetchTickRangeIntoBuffer<Quote>(buffer, capacity, written, from, to);
+    }
+
+    bool QuoteData::fetchIndexRangeInto(Quote* buffer, const hsize_t capacity, hsize_t& written, const hsize_t index, const hsize_t count) const
+    {
+        return fetchIndexRangeIntoBuffer<Quote>(buffer, capacity, written, index, count);
+    }
+
+    bool QuoteData::fetchTickRangeProjection(Projection& projection, const unsigned fields, const long long from, const long long to) const
+    {
+        return fetchTickRangeIntoProjection<Quote>(projection, fields, from, to);
+    }
+
+    bool QuoteData::fetchIndexRangeProjection(Projection& projection, const unsigned fields, const hsize_t index, const hsize_t count) const
+    {
+        return fetchIndexRangeIntoProjection(projection, fields, index, count);
+    }
+
+    bool QuoteData::aggregateTickRange(DataAggregate& aggregate, const long long from, const long long to, const AggregateSpec& spec) const
+    {
+        return aggregateFromTickRange<Quote>(aggregate, from, to, spec);
+    }
+
+    std::shared_ptr<QuoteCursor> QuoteData::openTickRangeCursor(const long long from, const long long to) const
+    {
+        return cursorFromTickRange<Quote>(from, to, false);
+    }
+
+    std::shared_ptr<QuoteCursor> QuoteData::openIndexRangeCursor(const hsize_t index, const hsize_t count) const
+    {
+        return cursorFromIndexRange<Quote>(index, count, false);
+    }
+
+    std::shared_ptr<QuoteCursor> QuoteData::openTickRangeReverseCursor(const long long from, const long long to) const
+    {
+        return cursorFromTickRange<Quote>(from, to, true);
+    }
+
+    std::shared_ptr<QuoteCursor> QuoteData::openIndexRangeReverseCursor(const hsize_t index, const hsize_t count) const
+    {
+        return cursorFromIndexRange<Quote>(index, count, true);
+    }
+
+    bool QuoteData::followFrom(hsize_t& index, const CollectQuote& collect) const
     {
-        return fetchData<Quote>(collect, from, to);
+        return followData<Quote>(collect, index);
     }
 
-    bool QuoteData::fetchIndexRange(const CollectQuote& collect, const hsize_t index, const hsize_t count) const
+    std::shared_ptr<QuoteAppender> QuoteData::openAppender(const AppenderOptions& options) const
     {
-        return fetchFromIndexRange<Quote>(collect, index, count);
+        return appender<Quote>(options);
     }
 
     bool QuoteData::ticksIndex(const long long ticks, hsize_t& index, bool& match) const
@@ -4630,11 +9688,81 @@ failed:
         return fetchData<QuotePriceOnly>(collect, from, to);
     }
 
+    bool QuotePriceOnlyData::fetchTickRangeWhere(const CollectQuotePriceOnly& collect, const long long from, const long long to, const DataPredicate& predicate) const
+    {
+        return fetchDataWhere<QuotePriceOnly>(collect, from, to, predicate);
+    }
+
+    bool QuotePriceOnlyData::fetchDownsampled(const CollectQuotePriceOnly& collect, const long long from, const long long to, const hsize_t targetPoints, const DownsamplingMethod method) const
+    {
+        return fetchDownsampledData<QuotePriceOnly>(collect, from, to, targetPoints, method);
+    }
+
     bool QuotePriceOnlyData::fetchIndexRange(const CollectQuotePriceOnly& collect, const hsize_t index, const hsize_t count) const
     {
         return fetchFromIndexRange<QuotePriceOnly>(collect, index, count);
     }
 
+    bool QuotePriceOnlyData::fetchLast(const CollectQuotePriceOnly& collect, const hsize_t count) const
+    {
+        return fetchLastItems<QuotePriceOnly>(collect, count);
+    }
+
+    bool QuotePriceOnlyData::fetchTickRangeInto(QuotePriceOnly* buffer, const hsize_t capacity, hsize_t& written, const long long from, const long long to) const
+    {
+        return fetchTickRangeIntoBuffer<QuotePriceOnly>(buffer, capacity, written, from, to);
+    }
+
+    bool QuotePriceOnlyData::fetchIndexRangeInto(QuotePriceOnly* buffer, const hsize_t capacity, hsize_t& written, const hsize_t index, const hsize_t count) const
+    {
+        return fetchIndexRangeIntoBuffer<QuotePriceOnly>(buffer, capacity, written, index, count);
+    }
+
+    bool QuotePriceOnlyData::fetchTickRangeProjection(Projection& projection, const unsigned fields, const long long from, const long long to) const
+    {
+        return fetchTickRangeIntoProjection<QuotePriceOnly>(projection, fields, from, to);
+    }
+
+    bool QuotePriceOnlyData::fetchIndexRangeProjection(Projection& projection, const unsigned fields, const hsize_t index, const hsize_t count) const
+    {
+        return fetchIndexRangeIntoProjection(projection, fields, index, count);
+    }
+
+    bool QuotePriceOnlyData::aggregateTickRange(DataAggregate& aggregate, const long long from, const long long to, const AggregateSpec& spec) const
+    {
+        return aggregateFromTickRange<QuotePriceOnly>(aggregate, from, to, spec);
+    }
+
+    std::shared_ptr<QuotePriceOnlyCursor> QuotePriceOnlyData::openTickRangeCursor(const long long from, const long long to) const
+    {
+        return cursorFromTickRange<QuotePriceOnly>(from, to, false);
+    }
+
+    std::shared_ptr<QuotePriceOnlyCursor> QuotePriceOnlyData::openIndexRangeCursor(const hsize_t index, const hsize_t count) const
+    {
+        return cursorFromIndexRange<QuotePriceOnly>(index, count, false);
+    }
+
+    std::shared_ptr<QuotePriceOnlyCursor> QuotePriceOnlyData::openTickRangeReverseCursor(const long long from, const long long to) const
+    {
+        return cursorFromTickRange<QuotePriceOnly>(from, to, true);
+    }
+
+    std::shared_ptr<QuotePriceOnlyCursor> QuotePriceOnlyData::openIndexRangeReverseCursor(const hsize_t index, const hsize_t count) const
+    {
+        return cursorFromIndexRange<QuotePriceOnly>(index, count, true);
+    }
+
+    bool QuotePriceOnlyData::followFrom(hsize_t& index, const CollectQuotePriceOnly& collect) const
+    {
+        return followData<QuotePriceOnly>(collect, index);
+    }
+
+    std::shared_ptr<QuotePriceOnlyAppender> QuotePriceOnlyData::openAppender(const AppenderOptions& options) const
+    {
+        return appender<QuotePriceOnly>(options);
+    }
+
     bool QuotePriceOnlyData::ticksIndex(const long long ticks, hsize_t& index, bool& match) const
     {
         return ticksToIndex<QuotePriceOnly>(ticks, index, match);
@@ -4709,11 +9837,81 @@ failed:
         return fetchData<Trade>(collect, from, to);
     }
 
+    bool TradeData::fetchTickRangeWhere(const CollectTrade& collect, const long long from, const long long to, const DataPredicate& predicate) const
+    {
+        return fetchDataWhere<Trade>(collect, from, to, predicate);
+    }
+
+    bool TradeData::fetchDownsampled(const CollectTrade& collect, const long long from, const long long to, const hsize_t targetPoints, const DownsamplingMethod method) const
+    {
+        return fetchDownsampledData<Trade>(collect, from, to, targetPoints, method);
+    }
+
     bool TradeData::fetchIndexRange(const CollectTrade& collect, const hsize_t index, const hsize_t count) const
     {
         return fetchFromIndexRange<Trade>(collect, index, count);
     }
 
+    bool TradeData::fetchLast(const CollectTrade& collect, const hsize_t count) const
+    {
+        return fetchLastItems<Trade>(collect, count);
+    }
+
+    bool TradeData::fetchTickRangeInto(Trade* buffer, const hsize_t capacity, hsize_t& written, const long long from, const long long to) const
+    {
+        return fetchTickRangeIntoBuffer<Trade>(buffer, capacity, written, from, to);
+    }
+
+    bool TradeData::fetchIndexRangeInto(Trade* buffer, const hsize_t capacity, hsize_t& written, const hsize_t index, const hsize_t count) const
+    {
+        return fetchIndexRangeIntoBuffer<Trade>(buffer, capacity, written, index, count);
+    }
+
+    bool TradeData::fetchTickRangeProjection(Projection& projection, const unsigned fields, const long long from, const long long to) const
+    {
+        return fetchTickRangeIntoProjection<Trade>(projection, fields, from, to);
+    }
+
+    bool TradeData::fetchIndexRangeProjection(Projection& projection, const unsigned fields, const hsize_t index, const hsize_t count) const
+    {
+        return fetchIndexRangeIntoProjection(projection, fields, index, count);
+    }
+
+    bool TradeData::aggregateTickRange(DataAggregate& aggregate, const long long from, const long long to, const AggregateSpec& spec) const
+    {
+        return aggregateFromTickRange<Trade>(aggregate, from, to, spec);
+    }
+
+    std::shared_ptr<TradeCursor> TradeData::openTickRangeCursor(const long long from, const long long to) const
+    {
+        return cursorFromTickRange<Trade>(from, to, false);
+    }
+
+    std::shared_ptr<TradeCursor> TradeData::openIndexRangeCursor(const hsize_t index, const hsize_t count) const
+    {
+        return cursorFromIndexRange<Trade>(index, count, false);
+    }
+
+    std::shared_ptr<TradeCursor> TradeData::openTickRangeReverseCursor(const long long from, const long long to) const
+    {
+        return cursorFromTickRange<Trade>(from, to, true);
+    }
+
+    std::shared_ptr<TradeCursor> TradeData::openIndexRangeReverseCursor(const hsize_t index, const hsize_t count) const
+    {
+        return cursorFromIndexRange<Trade>(index, count, true);
+    }
+
+    bool TradeData::followFrom(hsize_t& index, const CollectTrade& collect) const
+    {
+        return followData<Trade>(collect, index);
+    }
+
+    std::shared_ptr<TradeAppender> TradeData::openAppender(const AppenderOptions& options) const
+    {
+        return appender<Trade>(options);
+    }
+
     bool TradeData::ticksIndex(const long long ticks, hsize_t& index, bool& match) const
     {
         return ticksToIndex<Trade>(ticks, index, match);
@@ -4788,11 +9986,81 @@ failed:
         return fetchData<TradePriceOnly>(collect, from, to);
     }
 
+    bool TradePriceOnlyData::fetchTickRangeWhere(const CollectTradePriceOnly& collect, const long long from, const long long to, const DataPredicate& predicate) const
+    {
+        return fetchDataWhere<TradePriceOnly>(collect, from, to, predicate);
+    }
+
+    bool TradePriceOnlyData::fetchDownsampled(const CollectTradePriceOnly& collect, const long long from, const long long to, const hsize_t targetPoints, const DownsamplingMethod method) const
+    {
+        return fetchDownsampledData<TradePriceOnly>(collect, from, to, targetPoints, method);
+    }
+
     bool TradePriceOnlyData::fetchIndexRange(const CollectTradePriceOnly& collect, const hsize_t index, const hsize_t count) const
     {
         return fetchFromIndexRange<TradePriceOnly>(collect, index, count);
     }
 
+    bool TradePriceOnlyData::fetchLast(const CollectTradePriceOnly& collect, const hsize_t count) const
+    {
+        return fetchLastItems<TradePriceOnly>(collect, count);
+    }
+
+    bool TradePriceOnlyData::fetchTickRangeInto(TradePriceOnly* buffer, const hsize_t capacity, hsize_t& written, const long long from, const long long to) const
+    {
+        return fetchTickRangeIntoBuffer<TradePriceOnly>(buffer, capacity, written, from, to);
+    }
+
+    bool TradePriceOnlyData::fetchIndexRangeInto(TradePriceOnly* buffer, const hsize_t capacity, hsize_t& written, const hsize_t index, const hsize_t count) const
+    {
+        return fetchIndexRangeIntoBuffer<TradePriceOnly>(buffer, capacity, written, index, count);
+    }
+
+    bool TradePriceOnlyData::fetchTickRangeProjection(Projection& projection, const unsigned fields, const long long from, const long long to) const
+    {
+        return fetchTickRangeIntoProjection<TradePriceOnly>(projection, fields, from, to);
+    }
+
+    bool TradePriceOnlyData::fetchIndexRangeProjection(Projection& projection, const unsigned fields, const hsize_t index, const hsize_t count) const
+    {
+        return fetchIndexRangeIntoProjection(projection, fields, index, count);
+    }
+
+    bool TradePriceOnlyData::aggregateTickRange(DataAggregate& aggregate, const long long from, const long long to, const AggregateSpec& spec) const
+    {
+        return aggregateFromTickRange<TradePriceOnly>(aggregate, from, to, spec);
+    }
+
+    std::shared_ptr<TradePriceOnlyCursor> TradePriceOnlyData::openTickRangeCursor(const long long from, const long long to) const
+    {
+        return cursorFromTickRange<TradePriceOnly>(from, to, false);
+    }
+
+    std::shared_ptr<TradePriceOnlyCursor> TradePriceOnlyData::openIndexRangeCursor(const hsize_t index, const hsize_t count) const
+    {
+        return cursorFromIndexRange<TradePriceOnly>(index, count, false);
+    }
+
+    std::shared_ptr<TradePriceOnlyCursor> TradePriceOnlyData::openTickRangeReverseCursor(const long long from, const long long to) const
+    {
+        return cursorFromTickRange<TradePriceOnly>(from, to, true);
+    }
+
+    std::shared_ptr<TradePriceOnlyCursor> TradePriceOnlyData::openIndexRangeReverseCursor(const hsize_t index, const hsize_t count) const
+    {
+        return cursorFromIndexRange<TradePriceOnly>(index, count, true);
+    }
+
+    bool TradePriceOnlyData::followFrom(hsize_t& index, const CollectTradePriceOnly& collect) const
+    {
+        return followData<TradePriceOnly>(collect, index);
+    }
+
+    std::shared_ptr<TradePriceOnlyAppender> TradePriceOnlyData::openAppender(const AppenderOptions& options) const
+    {
+        return appender<TradePriceOnly>(options);
+    }
+
     bool TradePriceOnlyData::ticksIndex(const long long ticks, hsize_t& index, bool& match) const
     {
         return ticksToIndex<TradePriceOnly>(ticks, index, match);
@@ -4867,11 +10135,81 @@ failed:
         return fetchData<Ohlcv>(collect, from, to);
     }
 
+    bool OhlcvData::fetchTickRangeWhere(const CollectOhlcv& collect, const long long from, const long long to, const DataPredicate& predicate) const
+    {
+        return fetchDataWhere<Ohlcv>(collect, from, to, predicate);
+    }
+
+    bool OhlcvData::fetchDownsampled(const CollectOhlcv& collect, const long long from, const long long to, const hsize_t targetPoints, const DownsamplingMethod method) const
+    {
+        return fetchDownsampledData<Ohlcv>(collect, from, to, targetPoints, method);
+    }
+
     bool OhlcvData::fetchIndexRange(const CollectOhlcv& collect, const hsize_t index, const hsize_t count) const
     {
         return fetchFromIndexRange<Ohlcv>(collect, index, count);
     }
 
+    bool OhlcvData::fetchLast(const CollectOhlcv& collect, const hsize_t count) const
+    {
+        return fetchLastItems<Ohlcv>(collect, count);
+    }
+
+    bool OhlcvData::fetchTickRangeInto(Ohlcv* buffer, const hsize_t capacity, hsize_t& written, const long long from, const long long to) const
+    {
+        return fetchTickRangeIntoBuffer<Ohlcv>(buffer, capacity, written, from, to);
+    }
+
+    bool OhlcvData::fetchIndexRangeInto(Ohlcv* buffer, const hsize_t capacity, hsize_t& written, const hsize_t index, const hsize_t count) const
+    {
+        return fetchIndexRangeIntoBuffer<Ohlcv>(buffer, capacity, written, index, count);
+    }
+
+    bool OhlcvData::fetchTickRangeProjection(Projection& projection, const unsigned fields, const long long from, const long long to) const
+    {
+        return fetchTickRangeIntoProjection<Ohlcv>(projection, fields, from, to);
+    }
+
+    bool OhlcvData::fetchIndexRangeProjection(Projection& projection, const unsigned fields, const hsize_t index, const hsize_t count) const
+    {
+        return fetchIndexRangeIntoProjection(projection, fields, index, count);
+    }
+
+    bool OhlcvData::aggregateTickRange(DataAggregate& aggregate, const long long from, const long long to, const AggregateSpec& spec) const
+    {
+        return aggregateFromTickRange<Ohlcv>(aggregate, from, to, spec);
+    }
+
+    std::shared_ptr<OhlcvCursor> OhlcvData::openTickRangeCursor(const long long from, const long long to) const
+    {
+        return cursorFromTickRange<Ohlcv>(from, to, false);
+    }
+
+    std::shared_ptr<OhlcvCursor> OhlcvData::openIndexRangeCursor(const hsize_t index, const hsize_t count) const
+    {
+        return cursorFromIndexRange<Ohlcv>(index, count, false);
+    }
+
+    std::shared_ptr<OhlcvCursor> OhlcvData::openTickRangeReverseCursor(const long long from, const long long to) const
+    {
+        return cursorFromTickRange<Ohlcv>(from, to, true);
+    }
+
+    std::shared_ptr<OhlcvCursor> OhlcvData::openIndexRangeReverseCursor(const hsize_t index, const hsize_t count) const
+    {
+        return cursorFromIndexRange<Ohlcv>(index, count, true);
+    }
+
+    bool OhlcvData::followFrom(hsize_t& index, const CollectOhlcv& collect) const
+    {
+        return followData<Ohlcv>(collect, index);
+    }
+
+    std::shared_ptr<OhlcvAppender> OhlcvData::openAppender(const AppenderOptions& options) const
+    {
+        return appender<Ohlcv>(options);
+    }
+
     bool OhlcvData::ticksIndex(const long long ticks, hsize_t& index, bool& match) const
     {
         return ticksToIndex<Ohlcv>(ticks, index, match);
@@ -4946,11 +10284,81 @@ failed:
         return fetchData<OhlcvPriceOnly>(collect, from, to);
     }
 
+    bool OhlcvPriceOnlyData::fetchTickRangeWhere(const CollectOhlcvPriceOnly& collect, const long long from, const long long to, const DataPredicate& predicate) const
+    {
+        return fetchDataWhere<OhlcvPriceOnly>(collect, from, to, predicate);
+    }
+
+    bool OhlcvPriceOnlyData::fetchDownsampled(const CollectOhlcvPriceOnly& collect, const long long from, const long long to, const hsize_t targetPoints, const DownsamplingMethod method) const
+    {
+        return fetchDownsampledData<OhlcvPriceOnly>(collect, from, to, targetPoints, method);
+    }
+
     bool OhlcvPriceOnlyData::fetchIndexRange(const CollectOhlcvPriceOnly& collect, const hsize_t index, const hsize_t count) const
     {
         return fetchFromIndexRange<OhlcvPriceOnly>(collect, index, count);
     }
 
+    bool OhlcvPriceOnlyData::fetchLast(const CollectOhlcvPriceOnly& collect, const hsize_t count) const
+    {
+        return fetchLastItems<OhlcvPriceOnly>(collect, count);
+    }
+
+    bool OhlcvPriceOnlyData::fetchTickRangeInto(OhlcvPriceOnly* buffer, const hsize_t capacity, hsize_t& written, const long long from, const long long to) const
+    {
+        return fetchTickRangeIntoBuffer<OhlcvPriceOnly>(buffer, capacity, written, from, to);
+    }
+
+    bool OhlcvPriceOnlyData::fetchIndexRangeInto(OhlcvPriceOnly* buffer, const hsize_t capacity, hsize_t& written, const hsize_t index, const hsize_t count) const
+    {
+        return fetchIndexRangeIntoBuffer<OhlcvPriceOnly>(buffer, capacity, written, index, count);
+    }
+
+    bool OhlcvPriceOnlyData::fetchTickRangeProjection(Projection& projection, const unsigned fields, const long long from, const long long to) const
+    {
+        return fetchTickRangeIntoProjection<OhlcvPriceOnly>(projection, fields, from, to);
+    }
+
+    bool OhlcvPriceOnlyData::fetchIndexRangeProjection(Projection& projection, const unsigned fields, const hsize_t index, const hsize_t count) const
+    {
+        return fetchIndexRangeIntoProjection(projection, fields, index, count);
+    }
+
+    bool OhlcvPriceOnlyData::aggregateTickRange(DataAggregate& aggregate, const long long from, const long long to, const AggregateSpec& spec) const
+    {
+        return aggregateFromTickRange<OhlcvPriceOnly>(aggregate, from, to, spec);
+    }
+
+    std::shared_ptr<OhlcvPriceOnlyCursor> OhlcvPriceOnlyData::openTickRangeCursor(const long long from, const long long to) const
+    {
+        return cursorFromTickRange<OhlcvPriceOnly>(from, to, false);
+    }
+
+    std::shared_ptr<OhlcvPriceOnlyCursor> OhlcvPriceOnlyData::openIndexRangeCursor(const hsize_t index, const hsize_t count) const
+    {
+        return cursorFromIndexRange<OhlcvPriceOnly>(index, count, false);
+    }
+
+    std::shared_ptr<OhlcvPriceOnlyCursor> OhlcvPriceOnlyData::openTickRangeReverseCursor(const long long from, const long long to) const
+    {
+        return cursorFromTickRange<OhlcvPriceOnly>(from, to, true);
+    }
+
+    std::shared_ptr<OhlcvPriceOnlyCursor> OhlcvPriceOnlyData::openIndexRangeReverseCursor(const hsize_t index, const hsize_t count) const
+    {
+        return cursorFromIndexRange<OhlcvPriceOnly>(index, count, true);
+    }
+
+    bool OhlcvPriceOnlyData::followFrom(hsize_t& index, const CollectOhlcvPriceOnly& collect) const
+    {
+        return followData<OhlcvPriceOnly>(collect, index);
+    }
+
+    std::shared_ptr<OhlcvPriceOnlyAppender> OhlcvPriceOnlyData::openAppender(const AppenderOptions& options) const
+    {
+        return appender<OhlcvPriceOnly>(options);
+    }
+
     bool OhlcvPriceOnlyData::ticksIndex(const long long ticks, hsize_t& index, bool& match) const
     {
         return ticksToIndex<OhlcvPriceOnly>(ticks, index, match);
@@ -5025,11 +10433,81 @@ failed:
         return fetchData<Scalar>(collect, from, to);
     }
 
+    bool ScalarData::fetchTickRangeWhere(const CollectScalar& collect, const long long from, const long long to, const DataPredicate& predicate) const
+    {
+        return fetchDataWhere<Scalar>(collect, from, to, predicate);
+    }
+
+    bool ScalarData::fetchDownsampled(const CollectScalar& collect, const long long from, const long long to, const hsize_t targetPoints, const DownsamplingMethod method) const
+    {
+        return fetchDownsampledData<Scalar>(collect, from, to, targetPoints, method);
+    }
+
     bool ScalarData::fetchIndexRange(const CollectScalar& collect, const hsize_t index, const hsize_t count) const
     {
         return fetchFromIndexRange<Scalar>(collect, index, count);
     }
 
+    bool ScalarData::fetchLast(const CollectScalar& collect, const hsize_t count) const
+    {
+        return fetchLastItems<Scalar>(collect, count);
+    }
+
+    bool ScalarData::fetchTickRangeInto(Scalar* buffer, const hsize_t capacity, hsize_t& written, const long long from, const long long to) const
+    {
+        return fetchTickRangeIntoBuffer<Scalar>(buffer, capacity, written, from, to);
+    }
+
+    bool ScalarData::fetchIndexRangeInto(Scalar* buffer, const hsize_t capacity, hsize_t& written, const hsize_t index, const hsize_t count) const
+    {
+        return fetchIndexRangeIntoBuffer<Scalar>(buffer, capacity, written, index, count);
+    }
+
+    bool ScalarData::fetchTickRangeProjection(Projection& projection, const unsigned fields, const long long from, const long long to) const
+    {
+        return fetchTickRangeIntoProjection<Scalar>(projection, fields, from, to);
+    }
+
+    bool ScalarData::fetchIndexRangeProjection(Projection& projection, const unsigned fields, const hsize_t index, const hsize_t count) const
+    {
+        return fetchIndexRangeIntoProjection(projection, fields, index, count);
+    }
+
+    bool ScalarData::aggregateTickRange(DataAggregate& aggregate, const long long from, const long long to, const AggregateSpec& spec) const
+    {
+        return aggregateFromTickRange<Scalar>(aggregate, from, to, spec);
+    }
+
+    std::shared_ptr<ScalarCursor> ScalarData::openTickRangeCursor(const long long from, const long long to) const
+    {
+        return cursorFromTickRange<Scalar>(from, to, false);
+    }
+
+    std::shared_ptr<ScalarCursor> ScalarData::openIndexRangeCursor(const hsize_t index, const hsize_t count) const
+    {
+        return cursorFromIndexRange<Scalar>(index, count, false);
+    }
+
+    std::shared_ptr<ScalarCursor> ScalarData::openTickRangeReverseCursor(const long long from, const long long to) const
+    {
+        return cursorFromTickRange<Scalar>(from, to, true);
+    }
+
+    std::shared_ptr<ScalarCursor> ScalarData::openIndexRangeReverseCursor(const hsize_t index, const hsize_t count) const
+    {
+        return cursorFromIndexRange<Scalar>(index, count, true);
+    }
+
+    bool ScalarData::followFrom(hsize_t& index, const CollectScalar& collect) const
+    {
+        return followData<Scalar>(collect, index);
+    }
+
+    std::shared_ptr<ScalarAppender> ScalarData::openAppender(const AppenderOptions& options) const
+    {
+        return appender<Scalar>(options);
+    }
+
     bool ScalarData::ticksIndex(const long long ticks, hsize_t& index, bool& match) const
     {
         return ticksToIndex<Scalar>(ticks, index, match);
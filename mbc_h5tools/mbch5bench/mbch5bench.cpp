@@ -0,0 +1,1515 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "option_parser.h"
+#include "../../mbc/include/mbc/h5.h"
+
+namespace m5 = mbc::h5;
+
+typedef std::chrono::steady_clock Clock;
+
+// Keeps the benchmarked computations from being optimized away.
+static std::atomic<long long> theSink{ 0L };
+
+static int help()
+{
+    std::cerr
+        << "Benchmarks the h5 data access." << std::endl
+        << "Arguments: benchmark {-f|--file name} {-t|--threads count} {-n|--count count} {-s|--seconds seconds} {-h|--help}" << std::endl
+        << R"(-f|--file     a scratch h5 file name, default value is mbch5bench.h5, the file is deleted afterwards)" << std::endl
+        << R"(-t|--threads  the maximal number of concurrent threads, default value is the number of hardware threads)" << std::endl
+        << R"(-n|--count    the number of items per dataset, default value is 1000000)" << std::endl
+        << R"(-s|--seconds  the duration of a single measurement, default value is 2)" << std::endl
+        << std::endl
+        << "Benchmarks:" << std::endl
+        << R"(contention    throughput of 1..N reader threads each scanning its own instrument,)" << std::endl
+        << R"(              and the latency of lastTicks() on an unrelated file measured meanwhile)" << std::endl
+        << R"(ticksindex    ticksIndex() lookups per second at random ticks, with the in-memory tick index and without it)" << std::endl
+        << R"(merge         backfills interleaved gaps into an existing dataset with a single add() and with an add() per gap,)" << std::endl
+        << R"(              compared to the recorded per-item merge baseline with -n 200000)" << std::endl
+        << R"(poll          summary() calls per second polling 100 datasets, with the first call on each reading the file)" << std::endl
+        << R"(fetchinto     fetches of the last 4096 quotes per second, with a collect callback and into a reused buffer)" << std::endl
+        << R"(cursor        scans all quotes doing some work per quote, with paged fetchTickRange() and with a read-ahead cursor)" << std::endl
+        << R"(paging        scans all quotes with several read buffer sizes and reports the chunks the pages touched,)" << std::endl
+        << R"(              compared to the chunks the same number of byte-sized pages would touch)" << std::endl
+        << R"(layout        write and read throughput and file size of every data type per chunk size and compression setting)" << std::endl
+        << R"(codec         write and read throughput and file size of irregular quotes and trades per compression codec)" << std::endl
+        << R"(appender      adds quotes one at a time, with an add() per quote and through a write-behind appender)" << std::endl
+        << R"(decompress    scans all quotes in a single read with 1..N decompression threads, per compression codec)" << std::endl
+        << R"(compress      adds all quotes in a single add() with 1..N compression threads, per compression codec)" << std::endl
+        << R"(columnar      write, read and close-only projection throughput and file size of bars in the compound and the columnar layout)" << std::endl
+        << R"(aggregate     minimum, maximum, sum and volume-weighted price of a range of trades, fetched and reduced and with aggregateTickRange())" << std::endl
+        << R"(where         selective filters of all trades, fetched and filtered in the callback and with fetchTickRangeWhere())" << std::endl
+        << R"(segmented     prepends and inserts into a stored series in the compound and the segmented layout, and the scan before and after compact())" << std::endl
+        << R"(preallocate   adds quotes in batches of 10 with exact-size appends and with preallocated rows)" << std::endl
+        << std::endl
+        << "Examples:" << std::endl
+        << R"(contention -t 8 -n 2000000)" << std::endl
+        << R"(ticksindex -n 10000000 -s 5)" << std::endl
+        << R"(merge -n 200000)" << std::endl
+        << R"(poll -n 1000 -s 1)" << std::endl
+        << R"(fetchinto -n 2000000)" << std::endl
+        << R"(cursor -n 5000000)" << std::endl
+        << R"(paging -n 2000000)" << std::endl
+        << R"(layout -n 1000000)" << std::endl
+        << R"(codec -n 2000000)" << std::endl
+        << R"(appender -n 1000000)" << std::endl
+        << R"(decompress -t 8 -n 5000000)" << std::endl
+        << R"(compress -t 8 -n 5000000)" << std::endl
+        << R"(columnar -n 5000000)" << std::endl
+        << R"(aggregate -n 5000000)" << std::endl
+        << R"(where -n 5000000)" << std::endl
+        << R"(segmented -n 5000000)" << std::endl
+        << R"(preallocate -n 200000)" << std::endl
+        << std::endl;
+    return -1;
+}
+
+static unsigned long long toNumber(const std::string& value, const unsigned long long defaultValue)
+{
+    if (value.empty())
+        return defaultValue;
+    try
+    {
+        return std::stoull(value);
+    }
+    catch (...)
+    {
+        return defaultValue;
+    }
+}
+
+static std::vector<m5::Quote> makeQuotes(const hsize_t count, const long long firstTicks)
+{
+    std::vector<m5::Quote> quotes(static_cast<size_t>(count));
+    double price{ 100. };
+    for (hsize_t i = 0; i < count; ++i)
+    {
+        price += (i % 7 < 3 ? -0.01 : 0.01);
+        quotes[i] = { firstTicks + static_cast<long long>(i) * 10000L, price + 0.01, price, 100. + static_cast<double>(i % 10), 200. - static_cast<double>(i % 10) };
+    }
+    return quotes;
+}
+
+static double percentile(std::vector<double>& samples, const double fraction)
+{
+    if (samples.empty())
+        return 0.;
+    const size_t index{ static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1)) };
+    std::nth_element(samples.begin(), samples.begin() + static_cast<long>(index), samples.end());
+    return samples[index];
+}
+
+// ----------------------------------------------------------------------
+// contention
+// ----------------------------------------------------------------------
+
+static int contention(const std::string& fileName, const unsigned threadLimit, const hsize_t itemCount, const unsigned seconds)
+{
+    const std::string probeFileName{ fileName + ".probe.h5" };
+    remove(fileName.c_str());
+    remove(probeFileName.c_str());
+    {
+        const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+        const std::vector<m5::Quote> quotes = makeQuotes(itemCount, 630822816000000000L);
+        for (unsigned i = 0; i < threadLimit; ++i)
+        {
+            const std::string path{ "/contention/i" + std::to_string(i) };
+            const std::shared_ptr<m5::Instrument> instrument = file->openInstrument(path.c_str(), true);
+            const std::shared_ptr<m5::QuoteData> data = instrument->openQuoteData(true);
+            if (!data || !data->add(quotes.data(), itemCount, m5::DuplicateTimeTicks::Fail, false))
+            {
+                std::cerr << "failed to populate " << path << std::endl;
+                return -1;
+            }
+        }
+        const std::shared_ptr<m5::File> probeFile = m5::File::openReadWrite(probeFileName.c_str(), true);
+        const std::shared_ptr<m5::QuoteData> probeData = probeFile->openInstrument("/probe", true)->openQuoteData(true);
+        if (!probeData || !probeData->add(quotes.data(), std::min<hsize_t>(itemCount, 1000UL), m5::DuplicateTimeTicks::Fail, false))
+        {
+            std::cerr << "failed to populate the probe file" << std::endl;
+            return -1;
+        }
+    }
+
+    const std::shared_ptr<m5::File> file = m5::File::openReadOnly(fileName.c_str());
+    std::vector<std::shared_ptr<m5::Instrument>> instruments;
+    std::vector<std::shared_ptr<m5::QuoteData>> datas;
+    for (unsigned i = 0; i < threadLimit; ++i)
+    {
+        const std::string path{ "/contention/i" + std::to_string(i) };
+        instruments.push_back(file->openInstrument(path.c_str()));
+        datas.push_back(instruments.back()->openQuoteData());
+    }
+    const std::shared_ptr<m5::File> probeFile = m5::File::openReadOnly(probeFileName.c_str());
+    const std::shared_ptr<m5::Instrument> probeInstrument = probeFile->openInstrument("/probe");
+    const std::shared_ptr<m5::QuoteData> probeData = probeInstrument->openQuoteData();
+
+    std::cout << "contention: " << itemCount << " quotes per instrument, " << seconds << " s per measurement" << std::endl;
+    std::cout << "threads  scans/s    Mquotes/s  scaling  lastTicks p50 us    p99 us" << std::endl;
+    double baseline{ 0. };
+    for (unsigned threadCount = 1; threadCount <= threadLimit; ++threadCount)
+    {
+        std::atomic<bool> stop{ false };
+        std::atomic<unsigned long long> scans{ 0ULL };
+        std::atomic<unsigned long long> rows{ 0ULL };
+        std::vector<std::thread> threads;
+        for (unsigned i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([&stop, &scans, &rows, &datas, i]
+            {
+                double sum{ 0. };
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    unsigned long long n{ 0ULL };
+                    const bool status = datas[i]->fetchAll([&sum, &n](const m5::Quote* ptr, const hsize_t count) noexcept
+                    {
+                        for (hsize_t k = 0; k < count; ++k, ++ptr)
+                            sum += 0.5 * (ptr->askPrice_ + ptr->bidPrice_);
+                        n += count;
+                    });
+                    if (!status)
+                        break;
+                    scans.fetch_add(1ULL, std::memory_order_relaxed);
+                    rows.fetch_add(n, std::memory_order_relaxed);
+                }
+                theSink.fetch_add(static_cast<long long>(sum), std::memory_order_relaxed);
+            });
+        }
+
+        std::vector<double> latencies;
+        const auto started{ Clock::now() };
+        const auto deadline{ started + std::chrono::seconds(seconds) };
+        while (Clock::now() < deadline)
+        {
+            const auto t0{ Clock::now() };
+            const long long ticks{ probeData->lastTicks() };
+            const auto t1{ Clock::now() };
+            if (0L == ticks)
+                std::cerr << "lastTicks() failed" << std::endl;
+            latencies.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        stop.store(true);
+        for (auto& thread : threads)
+            thread.join();
+        const double elapsed{ std::chrono::duration<double>(Clock::now() - started).count() };
+
+        const double scansPerSecond{ static_cast<double>(scans.load()) / elapsed };
+        if (1 == threadCount)
+            baseline = scansPerSecond;
+        std::cout << std::setw(7) << threadCount
+            << std::fixed << std::setprecision(2)
+            << std::setw(10) << scansPerSecond
+            << std::setw(12) << static_cast<double>(rows.load()) / elapsed / 1e6
+            << std::setw(9) << (baseline > 0. ? scansPerSecond / baseline : 0.)
+            << std::setw(18) << percentile(latencies, 0.5)
+            << std::setw(10) << percentile(latencies, 0.99)
+            << std::endl;
+    }
+
+    for (auto& data : datas)
+        data->close();
+    for (auto& instrument : instruments)
+        instrument->close();
+    file->close();
+    probeData->close();
+    probeInstrument->close();
+    probeFile->close();
+    remove(fileName.c_str());
+    remove(probeFileName.c_str());
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// ticksindex
+// ----------------------------------------------------------------------
+
+static int ticksIndex(const std::string& fileName, const hsize_t itemCount, const unsigned seconds)
+{
+    remove(fileName.c_str());
+    constexpr long long firstTicks{ 630822816000000000L };
+    const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+    const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/ticksindex", true);
+    const std::shared_ptr<m5::QuoteData> data = instrument->openQuoteData(true);
+    const std::vector<m5::Quote> quotes = makeQuotes(itemCount, firstTicks);
+    if (!data || !data->add(quotes.data(), itemCount, m5::DuplicateTimeTicks::Fail, false))
+    {
+        std::cerr << "failed to populate the dataset" << std::endl;
+        return -1;
+    }
+
+    std::cout << "ticksindex: " << itemCount << " quotes, " << seconds << " s per measurement" << std::endl;
+    std::cout << "index bytes  lookups/s   us/lookup" << std::endl;
+    for (const hsize_t maximumTickIndexBytes : { m5::Data::defaultMaximumTickIndexBytes(), hsize_t(0) })
+    {
+        data->setMaximumTickIndexBytes(maximumTickIndexBytes);
+        unsigned long long lookups{ 0ULL }, random{ 88172645463325252ULL };
+        const auto started{ Clock::now() };
+        const auto deadline{ started + std::chrono::seconds(seconds) };
+        while (Clock::now() < deadline)
+        {
+            for (int i = 0; i < 64; ++i, ++lookups)
+            {
+                random ^= random << 13;
+                random ^= random >> 7;
+                random ^= random << 17;
+                const long long ticks{ firstTicks + static_cast<long long>(random % (itemCount * 10000ULL)) };
+                hsize_t index;
+                bool match;
+                if (!data->ticksIndex(ticks, index, match))
+                {
+                    std::cerr << "ticksIndex() failed" << std::endl;
+                    return -1;
+                }
+                theSink.fetch_add(static_cast<long long>(index), std::memory_order_relaxed);
+            }
+        }
+        const double elapsed{ std::chrono::duration<double>(Clock::now() - started).count() };
+        std::cout << std::setw(11) << maximumTickIndexBytes
+            << std::fixed << std::setprecision(2)
+            << std::setw(11) << static_cast<double>(lookups) / elapsed
+            << std::setw(12) << elapsed * 1e6 / static_cast<double>(lookups)
+            << std::endl;
+    }
+
+    data->close();
+    instrument->close();
+    file->close();
+    remove(fileName.c_str());
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// merge
+// ----------------------------------------------------------------------
+
+// The seconds the merge took before it became a single pass, when every backfilled item rewrote the tail of the dataset,
+// measured with -n 200000 per gap count (1, 10, 100) and mode (single add, add per gap). The old path is gone from the library.
+static constexpr hsize_t theMergeBaselineCount{ 200000 };
+static constexpr double theMergeBaselineSeconds[3][2]{ { 21.488, 24.573 }, { 13.699, 13.207 }, { 12.281, 12.250 } };
+
+static int merge(const std::string& fileName, const hsize_t itemCount)
+{
+    constexpr long long firstTicks{ 630822816000000000L };
+    const std::vector<m5::Quote> quotes = makeQuotes(itemCount, firstTicks);
+    const bool baseline{ theMergeBaselineCount == itemCount };
+
+    std::cout << "merge: " << itemCount << " quotes, the backfill is a quote in the middle of every stored interval within each gap" << std::endl;
+    if (!baseline)
+        std::cout << "the per-item merge baseline is recorded for -n " << theMergeBaselineCount << " only" << std::endl;
+    std::cout << "  gaps  per gap  mode         seconds    Mquotes/s" << (baseline ? "  per-item s  speedup" : "") << std::endl;
+    int gapIndex{ 0 };
+    for (const hsize_t gapCount : { hsize_t(1), hsize_t(10), hsize_t(100) })
+    {
+        // Gaps of the same size evenly spread over the second half of the dataset.
+        const hsize_t gapItems{ std::max<hsize_t>(1, itemCount / 2 / gapCount / 4) };
+        const hsize_t gapDistance{ itemCount / 2 / gapCount };
+        std::vector<m5::Quote> backfill;
+        for (hsize_t g = 0; g < gapCount; ++g)
+        {
+            const hsize_t first{ itemCount / 2 + g * gapDistance };
+            for (hsize_t i = first; i < first + gapItems && i + 1 < itemCount; ++i)
+            {
+                m5::Quote quote = quotes[i];
+                quote.ticks_ += 5000L;
+                backfill.push_back(quote);
+            }
+        }
+
+        for (const bool single : { true, false })
+        {
+            remove(fileName.c_str());
+            const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+            const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/merge", true);
+            const std::shared_ptr<m5::QuoteData> data = instrument->openQuoteData(true);
+            if (!data || !data->add(quotes.data(), itemCount, m5::DuplicateTimeTicks::Fail, false))
+            {
+                std::cerr << "failed to populate the dataset" << std::endl;
+                return -1;
+            }
+
+            const auto started{ Clock::now() };
+            bool status{ true };
+            if (single)
+                status = data->add(backfill.data(), backfill.size(), m5::DuplicateTimeTicks::Fail, false);
+            else
+            {
+                for (hsize_t i = 0; i < backfill.size() && status; i += gapItems)
+                    status = data->add(backfill.data() + i, std::min<hsize_t>(gapItems, backfill.size() - i), m5::DuplicateTimeTicks::Fail, false);
+            }
+            data->flush();
+            const double elapsed{ std::chrono::duration<double>(Clock::now() - started).count() };
+            if (!status || data->count() != itemCount + backfill.size())
+            {
+                std::cerr << "failed to merge the backfill" << std::endl;
+                return -1;
+            }
+            std::cout << std::setw(6) << gapCount
+                << std::setw(9) << gapItems
+                << "  " << std::left << std::setw(11) << (single ? "single add" : "add per gap") << std::right
+                << std::fixed << std::setprecision(3)
+                << std::setw(9) << elapsed
+                << std::setw(13) << static_cast<double>(backfill.size()) / elapsed / 1e6;
+            if (baseline)
+            {
+                const double perItem{ theMergeBaselineSeconds[gapIndex][single ? 0 : 1] };
+                std::cout << std::setw(12) << perItem << std::setw(9) << std::setprecision(1) << perItem / elapsed;
+            }
+            std::cout << std::endl;
+
+            data->close();
+            instrument->close();
+            file->close();
+        }
+        ++gapIndex;
+    }
+    remove(fileName.c_str());
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// poll
+// ----------------------------------------------------------------------
+
+static int poll(const std::string& fileName, const hsize_t itemCount, const unsigned seconds)
+{
+    constexpr int dataCount{ 100 };
+    remove(fileName.c_str());
+    {
+        const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+        const std::vector<m5::Quote> quotes = makeQuotes(itemCount, 630822816000000000L);
+        for (int i = 0; i < dataCount; ++i)
+        {
+            const std::string path{ "/poll/i" + std::to_string(i) };
+            const std::shared_ptr<m5::QuoteData> data = file->openInstrument(path.c_str(), true)->openQuoteData(true);
+            if (!data || !data->add(quotes.data(), itemCount, m5::DuplicateTimeTicks::Fail, false))
+            {
+                std::cerr << "failed to populate " << path << std::endl;
+                return -1;
+            }
+        }
+    }
+
+    const std::shared_ptr<m5::File> file = m5::File::openReadOnly(fileName.c_str());
+    std::vector<std::shared_ptr<m5::Instrument>> instruments;
+    std::vector<std::shared_ptr<m5::QuoteData>> datas;
+    for (int i = 0; i < dataCount; ++i)
+    {
+        const std::string path{ "/poll/i" + std::to_string(i) };
+        instruments.push_back(file->openInstrument(path.c_str()));
+        datas.push_back(instruments.back()->openQuoteData());
+    }
+
+    std::cout << "poll: " << dataCount << " datasets of " << itemCount << " quotes, " << seconds << " s" << std::endl;
+    auto started{ Clock::now() };
+    for (const auto& data : datas)
+        theSink.fetch_add(data->summary().lastTicks_, std::memory_order_relaxed);
+    const double first{ std::chrono::duration<double, std::nano>(Clock::now() - started).count() / dataCount };
+
+    unsigned long long calls{ 0ULL };
+    started = Clock::now();
+    const auto deadline{ started + std::chrono::seconds(seconds) };
+    while (Clock::now() < deadline)
+    {
+        for (const auto& data : datas)
+        {
+            const m5::DataSummary summary{ data->summary() };
+            theSink.fetch_add(summary.lastTicks_ - summary.firstTicks_ + static_cast<long long>(summary.count_), std::memory_order_relaxed);
+        }
+        calls += dataCount;
+    }
+    const double elapsed{ std::chrono::duration<double, std::nano>(Clock::now() - started).count() };
+    std::cout << std::fixed << std::setprecision(1)
+        << "first call " << first << " ns, cached calls " << elapsed / static_cast<double>(calls) << " ns" << std::endl;
+
+    for (auto& data : datas)
+        data->close();
+    for (auto& instrument : instruments)
+        instrument->close();
+    file->close();
+    remove(fileName.c_str());
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// fetchinto
+// ----------------------------------------------------------------------
+
+static int fetchInto(const std::string& fileName, const hsize_t itemCount, const unsigned seconds)
+{
+    constexpr hsize_t tailCount{ 4096 };
+    remove(fileName.c_str());
+    const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+    const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/fetchinto", true);
+    const std::shared_ptr<m5::QuoteData> data = instrument->openQuoteData(true);
+    const std::vector<m5::Quote> quotes = makeQuotes(itemCount, 630822816000000000L);
+    if (!data || !data->add(quotes.data(), itemCount, m5::DuplicateTimeTicks::Fail, false))
+    {
+        std::cerr << "failed to populate the dataset" << std::endl;
+        return -1;
+    }
+    const hsize_t tail{ std::min(tailCount, itemCount) };
+    const long long fromTicks{ quotes[itemCount - tail].ticks_ };
+
+    std::cout << "fetchinto: " << itemCount << " quotes, the last " << tail << " fetched, " << seconds << " s per variant" << std::endl;
+    std::vector<m5::Quote> buffer(static_cast<size_t>(tail));
+    for (int variant = 0; variant < 2; ++variant)
+    {
+        unsigned long long fetches{ 0ULL };
+        const auto started{ Clock::now() };
+        const auto deadline{ started + std::chrono::seconds(seconds) };
+        while (Clock::now() < deadline)
+        {
+            if (0 == variant)
+            {
+                if (!data->fetchTickRange([](const m5::Quote* ptr, const hsize_t cnt) noexcept
+                {
+                    theSink.fetch_add(ptr[cnt - 1].ticks_, std::memory_order_relaxed);
+                }, fromTicks, 0L))
+                    return -1;
+            }
+            else
+            {
+                hsize_t written;
+                if (!data->fetchTickRangeInto(buffer.data(), tail, written, fromTicks, 0L))
+                    return -1;
+                theSink.fetch_add(buffer[written - 1].ticks_, std::memory_order_relaxed);
+            }
+            ++fetches;
+        }
+        const double elapsed{ std::chrono::duration<double, std::micro>(Clock::now() - started).count() };
+        std::cout << std::fixed << std::setprecision(1) << (0 == variant ? "collect: " : "into:    ")
+            << static_cast<double>(fetches) * 1e6 / elapsed << " fetches/s, "
+            << elapsed / static_cast<double>(fetches) << " us per fetch" << std::endl;
+    }
+
+    data->close();
+    instrument->close();
+    file->close();
+    remove(fileName.c_str());
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// cursor
+// ----------------------------------------------------------------------
+
+static long long consume(const m5::Quote* quotes, const hsize_t count)
+{
+    // Stands for the per-quote work of a consumer, roughly as long as the decompression of a quote.
+    double sum{ 0. };
+    for (hsize_t i = 0; i < count; ++i)
+    {
+        double value{ quotes[i].askPrice_ - quotes[i].bidPrice_ };
+        for (int j = 0; j < 24; ++j)
+            value = value * 0.999 + quotes[i].askSize_ * 1e-9;
+        sum += value;
+    }
+    return static_cast<long long>(sum);
+}
+
+static int cursor(const std::string& fileName, const hsize_t itemCount)
+{
+    remove(fileName.c_str());
+    {
+        const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+        const std::shared_ptr<m5::QuoteData> data = file->openInstrument("/cursor", true)->openQuoteData(true);
+        const std::vector<m5::Quote> quotes = makeQuotes(itemCount, 630822816000000000L);
+        if (!data || !data->add(quotes.data(), itemCount, m5::DuplicateTimeTicks::Fail, false))
+        {
+            std::cerr << "failed to populate the dataset" << std::endl;
+            return -1;
+        }
+    }
+
+    const std::shared_ptr<m5::File> file = m5::File::openReadOnly(fileName.c_str());
+    const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/cursor");
+    const std::shared_ptr<m5::QuoteData> data = instrument->openQuoteData();
+    std::cout << "cursor: " << itemCount << " quotes, " << data->maximumReadBufferBytes() << " bytes per page" << std::endl;
+
+    auto started{ Clock::now() };
+    hsize_t fetched{ 0 };
+    if (!data->fetchTickRange([&fetched](const m5::Quote* ptr, const hsize_t cnt)
+    {
+        theSink.fetch_add(consume(ptr, cnt), std::memory_order_relaxed);
+        fetched += cnt;
+    }, 0L, 0L))
+        return -1;
+    const double paged{ std::chrono::duration<double, std::milli>(Clock::now() - started).count() };
+
+    started = Clock::now();
+    hsize_t scanned{ 0 };
+    const std::shared_ptr<m5::QuoteCursor> quoteCursor = data->openTickRangeCursor(0L, 0L);
+    const m5::Quote* page;
+    hsize_t count;
+    while (quoteCursor && quoteCursor->next(page, count) && 0 < count)
+    {
+        theSink.fetch_add(consume(page, count), std::memory_order_relaxed);
+        scanned += count;
+    }
+    const double ahead{ std::chrono::duration<double, std::milli>(Clock::now() - started).count() };
+
+    std::cout << std::fixed << std::setprecision(1)
+        << "paged fetchTickRange: " << fetched << " quotes, " << paged << " ms" << std::endl
+        << "read-ahead cursor:    " << scanned << " quotes, " << ahead << " ms" << std::endl;
+
+    if (quoteCursor)
+        quoteCursor->close();
+    data->close();
+    instrument->close();
+    file->close();
+    remove(fileName.c_str());
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// paging
+// ----------------------------------------------------------------------
+
+static int paging(const std::string& fileName, const hsize_t itemCount)
+{
+    constexpr hsize_t chunkRows{ 1024 * 20 };
+    remove(fileName.c_str());
+    {
+        const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+        const std::shared_ptr<m5::QuoteData> data = file->openInstrument("/paging", true)->openQuoteData(true);
+        const std::vector<m5::Quote> quotes = makeQuotes(itemCount, 630822816000000000L);
+        if (!data || !data->add(quotes.data(), itemCount, m5::DuplicateTimeTicks::Fail, false))
+        {
+            std::cerr << "failed to populate the dataset" << std::endl;
+            return -1;
+        }
+    }
+
+    const std::shared_ptr<m5::File> file = m5::File::openReadOnly(fileName.c_str());
+    const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/paging");
+    const std::shared_ptr<m5::QuoteData> data = instrument->openQuoteData();
+    std::cout << "paging: " << itemCount << " quotes, " << chunkRows << " quotes per chunk" << std::endl;
+    for (const hsize_t bytes : { 256UL * 1024UL, 1024UL * 1024UL, 3UL * 1024UL * 1024UL })
+    {
+        // The chunks the pages of bytes / sizeof(Quote) quotes would touch without the alignment.
+        const hsize_t pageRows{ bytes / sizeof(m5::Quote) };
+        hsize_t unalignedChunks{ 0 };
+        for (hsize_t i = 0; i < itemCount; i += pageRows)
+            unalignedChunks += (std::min(i + pageRows, itemCount) - 1) / chunkRows - i / chunkRows + 1;
+
+        data->setMaximumReadBufferBytes(bytes);
+        data->resetReadStatistics();
+        const auto started{ Clock::now() };
+        if (!data->fetchTickRange([](const m5::Quote* ptr, const hsize_t cnt) noexcept
+        {
+            theSink.fetch_add(ptr[cnt - 1].ticks_, std::memory_order_relaxed);
+        }, 0L, 0L))
+            return -1;
+        const double elapsed{ std::chrono::duration<double, std::milli>(Clock::now() - started).count() };
+        const m5::DataReadStatistics statistics{ data->readStatistics() };
+        std::cout << std::fixed << std::setprecision(1) << std::setw(8) << bytes << " bytes: "
+            << statistics.reads_ << " pages, " << statistics.chunks_ << " chunks touched (unaligned "
+            << unalignedChunks << "), " << elapsed << " ms" << std::endl;
+    }
+
+    data->close();
+    instrument->close();
+    file->close();
+    remove(fileName.c_str());
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// layout
+// ----------------------------------------------------------------------
+
+static void makeItem(m5::Quote& item, const long long ticks, const double price, const hsize_t i)
+{
+    item = { ticks, price + 0.01, price, 100. + static_cast<double>(i % 10), 200. - static_cast<double>(i % 10) };
+}
+
+static void makeItem(m5::QuotePriceOnly& item, const long long ticks, const double price, const hsize_t)
+{
+    item = { ticks, price + 0.01, price };
+}
+
+static void makeItem(m5::Trade& item, const long long ticks, const double price, const hsize_t i)
+{
+    item = { ticks, price, 100. + static_cast<double>(i % 10) };
+}
+
+static void makeItem(m5::TradePriceOnly& item, const long long ticks, const double price, const hsize_t)
+{
+    item = { ticks, price };
+}
+
+static void makeItem(m5::Ohlcv& item, const long long ticks, const double price, const hsize_t i)
+{
+    item = { ticks, price, price + 0.05, price - 0.05, price + 0.01, 1000. + static_cast<double>(i % 100) };
+}
+
+static void makeItem(m5::OhlcvPriceOnly& item, const long long ticks, const double price, const hsize_t)
+{
+    item = { ticks, price, price + 0.05, price - 0.05, price + 0.01 };
+}
+
+static void makeItem(m5::Scalar& item, const long long ticks, const double price, const hsize_t)
+{
+    item = { ticks, price };
+}
+
+template <typename T, typename Open> static bool layoutMeasure(const std::string& fileName, const char* typeName, const char* settingName,
+    const m5::DatasetCreationOptions& options, const std::vector<T>& items, const Open& open)
+{
+    const auto itemCount{ static_cast<hsize_t>(items.size()) };
+    remove(fileName.c_str());
+    auto started{ Clock::now() };
+    {
+        const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+        const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/layout", true);
+        const auto data = open(instrument, true, options);
+        if (!data || !data->add(items.data(), itemCount, m5::DuplicateTimeTicks::Fail, false))
+            return false;
+        data->close();
+        instrument->close();
+        file->close();
+    }
+    const double written{ std::chrono::duration<double>(Clock::now() - started).count() };
+    std::ifstream stream(fileName, std::ios::binary | std::ios::ate);
+    const auto fileBytes{ static_cast<double>(stream.tellg()) };
+    stream.close();
+
+    started = Clock::now();
+    hsize_t fetched{ 0 };
+    {
+        const std::shared_ptr<m5::File> file = m5::File::openReadOnly(fileName.c_str());
+        const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/layout");
+        const auto data = open(instrument, false, options);
+        if (!data || !data->fetchAll([&fetched](const T*, const hsize_t cnt) noexcept { fetched += cnt; }))
+            return false;
+        data->close();
+        instrument->close();
+        file->close();
+    }
+    const double read{ std::chrono::duration<double>(Clock::now() - started).count() };
+    remove(fileName.c_str());
+
+    const auto count{ static_cast<double>(itemCount) };
+    std::cout << std::fixed << std::setprecision(2) << std::left << std::setw(16) << typeName << std::setw(22) << settingName << std::right
+        << std::setw(10) << count / written / 1e6 << std::setw(10) << static_cast<double>(fetched) / read / 1e6
+        << std::setw(10) << fileBytes / 1048576. << std::setw(10) << fileBytes / count << std::endl;
+    return true;
+}
+
+template <typename T, typename Open> static bool layoutRow(const std::string& fileName, const char* typeName, const char* settingName,
+    const m5::DatasetCreationOptions& options, const hsize_t itemCount, const Open& open)
+{
+    std::vector<T> items(static_cast<size_t>(itemCount));
+    double price{ 100. };
+    for (hsize_t i = 0; i < itemCount; ++i)
+    {
+        price += (i % 7 < 3 ? -0.01 : 0.01);
+        makeItem(items[i], 630822816000000000L + static_cast<long long>(i) * 10000L, price, i);
+    }
+    return layoutMeasure(fileName, typeName, settingName, options, items, open);
+}
+
+static void printLayoutHeader()
+{
+    std::cout << std::left << std::setw(16) << "type" << std::setw(22) << "setting" << std::right
+        << std::setw(10) << "write" << std::setw(10) << "read" << std::setw(10) << "MiB" << std::setw(10) << "B/item" << std::endl;
+}
+
+static int layout(const std::string& fileName, const hsize_t itemCount)
+{
+    struct Setting
+    {
+        const char* name_;
+        m5::DatasetCreationOptions options_;
+    };
+    const Setting settings[]{
+        { "20480 shuffle deflate9", { 20480, 9, true, true } },
+        { "20480 shuffle deflate6", { 20480, 6, true, true } },
+        { "20480 shuffle deflate1", { 20480, 1, true, true } },
+        { "20480 deflate6", { 20480, 6, false, true } },
+        { "20480 uncompressed", { 20480, 0, false, false } },
+        { "20480 timeseries", { 20480, 0, false, true, m5::CompressionCodec::TimeSeries } },
+        { "4096 shuffle deflate6", { 4096, 6, true, true } },
+        { "65536 shuffle deflate6", { 65536, 6, true, true } }
+    };
+
+    std::cout << "layout: " << itemCount << " items per dataset, write and read in millions of items per second" << std::endl;
+    printLayoutHeader();
+    for (const Setting& setting : settings)
+    {
+        const char* name{ setting.name_ };
+        const m5::DatasetCreationOptions& options{ setting.options_ };
+        if (!layoutRow<m5::Quote>(fileName, "quote", name, options, itemCount,
+            [](const std::shared_ptr<m5::Instrument>& i, const bool c, const m5::DatasetCreationOptions& o) { return i->openQuoteData(c, o); }) ||
+            !layoutRow<m5::QuotePriceOnly>(fileName, "quote price", name, options, itemCount,
+            [](const std::shared_ptr<m5::Instrument>& i, const bool c, const m5::DatasetCreationOptions& o) { return i->openQuotePriceOnlyData(c, o); }) ||
+            !layoutRow<m5::Trade>(fileName, "trade", name, options, itemCount,
+            [](const std::shared_ptr<m5::Instrument>& i, const bool c, const m5::DatasetCreationOptions& o) { return i->openTradeData(c, o); }) ||
+            !layoutRow<m5::TradePriceOnly>(fileName, "trade price", name, options, itemCount,
+            [](const std::shared_ptr<m5::Instrument>& i, const bool c, const m5::DatasetCreationOptions& o) { return i->openTradePriceOnlyData(c, o); }) ||
+            !layoutRow<m5::Ohlcv>(fileName, "ohlcv", name, options, itemCount,
+            [](const std::shared_ptr<m5::Instrument>& i, const bool c, const m5::DatasetCreationOptions& o) { return i->openOhlcvData(m5::OhlcvKind::Default, m5::DataTimeFrame::Minute1, c, o); }) ||
+            !layoutRow<m5::OhlcvPriceOnly>(fileName, "ohlcv price", name, options, itemCount,
+            [](const std::shared_ptr<m5::Instrument>& i, const bool c, const m5::DatasetCreationOptions& o) { return i->openOhlcvPriceOnlyData(m5::OhlcvKind::Default, m5::DataTimeFrame::Minute1, c, o); }) ||
+            !layoutRow<m5::Scalar>(fileName, "scalar", name, options, itemCount,
+            [](const std::shared_ptr<m5::Instrument>& i, const bool c, const m5::DatasetCreationOptions& o) { return i->openScalarData(m5::DataTimeFrame::Minute1, c, o); }))
+        {
+            std::cerr << "failed to write or read " << name << std::endl;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// codec
+// ----------------------------------------------------------------------
+
+static int codec(const std::string& fileName, const hsize_t itemCount)
+{
+    // Irregular ticks, a random walk of the prices in cents and round lot sizes, like the recorded market data.
+    std::vector<m5::Quote> quotes(static_cast<size_t>(itemCount));
+    std::vector<m5::Trade> trades(static_cast<size_t>(itemCount));
+    unsigned long long random{ 88172645463325252ULL };
+    const auto next = [&random](const unsigned long long limit)
+    {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        return static_cast<long long>(random % limit);
+    };
+    long long ticks{ 630822816000000000L }, askCents{ 10001 }, bidCents{ 10000 }, tradeCents{ 10000 };
+    for (hsize_t i = 0; i < itemCount; ++i)
+    {
+        ticks += 1 + next(20000000);
+        bidCents = std::max(1LL, bidCents + next(5) - 2);
+        askCents = bidCents + 1 + next(3);
+        quotes[i] = { ticks, static_cast<double>(askCents) / 100., static_cast<double>(bidCents) / 100., static_cast<double>(100 * (1 + next(50))), static_cast<double>(100 * (1 + next(50))) };
+        tradeCents = std::max(1LL, tradeCents + next(7) - 3);
+        trades[i] = { ticks, static_cast<double>(tradeCents) / 100., static_cast<double>(1 + next(1000)) };
+    }
+
+    struct Setting
+    {
+        const char* name_;
+        m5::DatasetCreationOptions options_;
+    };
+    const Setting settings[]{
+        { "shuffle deflate9", { 20480, 9, true, true } },
+        { "shuffle deflate6", { 20480, 6, true, true } },
+        { "shuffle deflate1", { 20480, 1, true, true } },
+        { "timeseries", { 20480, 0, false, true, m5::CompressionCodec::TimeSeries } },
+        { "uncompressed", { 20480, 0, false, false } }
+    };
+
+    std::cout << "codec: " << itemCount << " irregular items per dataset, write and read in millions of items per second" << std::endl;
+    printLayoutHeader();
+    for (const Setting& setting : settings)
+    {
+        if (!layoutMeasure(fileName, "quote", setting.name_, setting.options_, quotes,
+            [](const std::shared_ptr<m5::Instrument>& i, const bool c, const m5::DatasetCreationOptions& o) { return i->openQuoteData(c, o); }) ||
+            !layoutMeasure(fileName, "trade", setting.name_, setting.options_, trades,
+            [](const std::shared_ptr<m5::Instrument>& i, const bool c, const m5::DatasetCreationOptions& o) { return i->openTradeData(c, o); }))
+        {
+            std::cerr << "failed to write or read " << setting.name_ << std::endl;
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// appender
+// ----------------------------------------------------------------------
+
+static int appender(const std::string& fileName, const hsize_t itemCount)
+{
+    const std::vector<m5::Quote> quotes = makeQuotes(itemCount, 630822816000000000L);
+
+    // An add() per quote is slow, so it is measured on a prefix.
+    const hsize_t addCount{ std::min<hsize_t>(itemCount, 20000) };
+    remove(fileName.c_str());
+    double addSeconds;
+    {
+        const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+        const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/appender", true);
+        const std::shared_ptr<m5::QuoteData> data = instrument->openQuoteData(true);
+        const auto started{ Clock::now() };
+        for (hsize_t i = 0; i < addCount; ++i)
+            if (!data->add(&quotes[i], 1, m5::DuplicateTimeTicks::Fail, false))
+                return -1;
+        addSeconds = std::chrono::duration<double>(Clock::now() - started).count();
+        data->close();
+        instrument->close();
+        file->close();
+    }
+
+    remove(fileName.c_str());
+    double appendSeconds, flushSeconds;
+    m5::AppenderStatistics statistics{};
+    hsize_t stored;
+    {
+        const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+        const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/appender", true);
+        const std::shared_ptr<m5::QuoteData> data = instrument->openQuoteData(true);
+        const std::shared_ptr<m5::QuoteAppender> appender = data->openAppender();
+        const auto started{ Clock::now() };
+        for (hsize_t i = 0; i < itemCount; ++i)
+            if (!appender->append(quotes[i]))
+                return -1;
+        appendSeconds = std::chrono::duration<double>(Clock::now() - started).count();
+        if (!appender->flush())
+            return -1;
+        flushSeconds = std::chrono::duration<double>(Clock::now() - started).count();
+        statistics = appender->statistics();
+        appender->close();
+        stored = data->count();
+        data->close();
+        instrument->close();
+        file->close();
+    }
+    remove(fileName.c_str());
+
+    std::cout << std::fixed << std::setprecision(3)
+        << "appender: " << itemCount << " quotes appended one at a time" << std::endl
+        << "add() per quote   " << addCount << " quotes  " << static_cast<double>(addCount) / addSeconds / 1e3 << " Kquotes/s" << std::endl
+        << "appender append   " << itemCount << " quotes  " << static_cast<double>(itemCount) / appendSeconds / 1e3 << " Kquotes/s queued, "
+        << static_cast<double>(itemCount) / flushSeconds / 1e3 << " Kquotes/s written" << std::endl
+        << "appender flushes  " << statistics.flushes_ << ", last " << statistics.lastFlushMicroseconds_ << " us, maximum "
+        << statistics.maximumFlushMicroseconds_ << " us, " << stored << " quotes stored" << std::endl;
+    return stored == itemCount ? 0 : -1;
+}
+
+// ----------------------------------------------------------------------
+// decompress
+// ----------------------------------------------------------------------
+
+static int decompress(const std::string& fileName, const unsigned threadLimit, const hsize_t itemCount)
+{
+    const std::vector<m5::Quote> quotes = makeQuotes(itemCount, 630822816000000000L);
+    struct Setting
+    {
+        const char* name_;
+        m5::DatasetCreationOptions options_;
+    };
+    const Setting settings[]{
+        { "shuffle deflate9", { 20480, 9, true, true } },
+        { "timeseries", { 20480, 0, false, true, m5::CompressionCodec::TimeSeries } }
+    };
+
+    std::cout << std::fixed << std::setprecision(3)
+        << "decompress: " << itemCount << " quotes scanned by fetchAll() with an unlimited read buffer, in millions of quotes per second" << std::endl;
+    for (const Setting& setting : settings)
+    {
+        remove(fileName.c_str());
+        const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+        const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/decompress", true);
+        const std::shared_ptr<m5::QuoteData> data = instrument->openQuoteData(true, setting.options_);
+        if (!data->add(quotes.data(), itemCount, m5::DuplicateTimeTicks::Fail, false))
+            return -1;
+        data->setMaximumReadBufferBytes(0);
+        for (unsigned threads = 1; threads <= threadLimit; threads *= 2)
+        {
+            data->setDecompressionThreads(threads);
+            hsize_t fetched{ 0 };
+            bool identical{ true };
+            const auto started{ Clock::now() };
+            const bool status = data->fetchAll([&quotes, &fetched, &identical](const m5::Quote* ptr, const hsize_t cnt)
+            {
+                identical = identical && 0 == memcmp(quotes.data() + fetched, ptr, static_cast<size_t>(cnt) * sizeof(m5::Quote));
+                fetched += cnt;
+            });
+            const double elapsed = std::chrono::duration<double>(Clock::now() - started).count();
+            if (!status || !identical || itemCount != fetched)
+                return -1;
+            std::cout << std::left << std::setw(18) << setting.name_ << std::right << " threads " << std::setw(3) << threads << "  "
+                << static_cast<double>(itemCount) / elapsed / 1e6 << " Mquotes/s" << std::endl;
+        }
+        data->close();
+        instrument->close();
+        file->close();
+    }
+    remove(fileName.c_str());
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// compress
+// ----------------------------------------------------------------------
+
+static int compress(const std::string& fileName, const unsigned threadLimit, const hsize_t itemCount)
+{
+    const std::vector<m5::Quote> quotes = makeQuotes(itemCount, 630822816000000000L);
+    struct Setting
+    {
+        const char* name_;
+        m5::DatasetCreationOptions options_;
+    };
+    const Setting settings[]{
+        { "shuffle deflate9", { 20480, 9, true, true } },
+        { "timeseries", { 20480, 0, false, true, m5::CompressionCodec::TimeSeries } }
+    };
+
+    std::cout << std::fixed << std::setprecision(3)
+        << "compress: " << itemCount << " quotes added by a single add() to an empty dataset, in millions of quotes per second" << std::endl;
+    for (const Setting& setting : settings)
+    {
+        for (unsigned threads = 1; threads <= threadLimit; threads *= 2)
+        {
+            remove(fileName.c_str());
+            const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+            const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/compress", true);
+            const std::shared_ptr<m5::QuoteData> data = instrument->openQuoteData(true, setting.options_);
+            data->setCompressionThreads(threads);
+            const auto started{ Clock::now() };
+            if (!data->add(quotes.data(), itemCount, m5::DuplicateTimeTicks::Fail, false))
+                return -1;
+            file->flush();
+            const double elapsed = std::chrono::duration<double>(Clock::now() - started).count();
+            data->close();
+            instrument->close();
+            file->close();
+            std::ifstream stream(fileName, std::ios::binary | std::ios::ate);
+            std::cout << std::left << std::setw(18) << setting.name_ << std::right << " threads " << std::setw(3) << threads << "  "
+                << static_cast<double>(itemCount) / elapsed / 1e6 << " Mquotes/s, " << static_cast<double>(stream.tellg()) / static_cast<double>(itemCount)
+                << " bytes/quote" << std::endl;
+        }
+    }
+    remove(fileName.c_str());
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// columnar
+// ----------------------------------------------------------------------
+
+static int columnar(const std::string& fileName, const hsize_t itemCount)
+{
+    // Minute bars of a random walk in cents with round lot volumes.
+    std::vector<m5::Ohlcv> bars(static_cast<size_t>(itemCount));
+    unsigned long long random{ 88172645463325252ULL };
+    const auto next = [&random](const unsigned long long limit)
+    {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        return static_cast<long long>(random % limit);
+    };
+    long long cents{ 10000 };
+    for (hsize_t i = 0; i < itemCount; ++i)
+    {
+        const long long open{ cents };
+        cents = std::max(1LL, cents + next(21) - 10);
+        const long long high{ std::max(open, cents) + next(5) }, low{ std::max(1LL, std::min(open, cents) - next(5)) };
+        bars[i] = { 630822816000000000L + static_cast<long long>(i) * 600000000L, static_cast<double>(open) / 100., static_cast<double>(high) / 100.,
+            static_cast<double>(low) / 100., static_cast<double>(cents) / 100., static_cast<double>(100 * (1 + next(500))) };
+    }
+
+    struct Setting
+    {
+        const char* name_;
+        m5::DatasetCreationOptions options_;
+    };
+    const Setting settings[]{
+        { "compound deflate6", { 20480, 6, true, true } },
+        { "columnar deflate6", { 20480, 6, true, true, m5::CompressionCodec::Deflate, true } },
+        { "compound timeseries", { 20480, 0, false, true, m5::CompressionCodec::TimeSeries } },
+        { "columnar timeseries", { 20480, 0, false, true, m5::CompressionCodec::TimeSeries, true } }
+    };
+
+    std::cout << std::fixed << std::setprecision(2)
+        << "columnar: " << itemCount << " bars per dataset, write, read and close-only projection in millions of bars per second" << std::endl
+        << std::left << std::setw(22) << "setting" << std::right << std::setw(10) << "write" << std::setw(10) << "read" << std::setw(10) << "close"
+        << std::setw(10) << "B/item" << std::endl;
+    for (const Setting& setting : settings)
+    {
+        remove(fileName.c_str());
+        auto started{ Clock::now() };
+        {
+            const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+            const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/columnar", true);
+            const std::shared_ptr<m5::OhlcvData> data = instrument->openOhlcvData(m5::OhlcvKind::Default, m5::DataTimeFrame::Minute1, true, setting.options_);
+            if (!data || !data->add(bars.data(), itemCount, m5::DuplicateTimeTicks::Fail, false))
+                return -1;
+            data->close();
+            instrument->close();
+            file->close();
+        }
+        const double written{ std::chrono::duration<double>(Clock::now() - started).count() };
+        std::ifstream stream(fileName, std::ios::binary | std::ios::ate);
+        const auto fileBytes{ static_cast<double>(stream.tellg()) };
+        stream.close();
+
+        // Every measurement opens the file anew, so that no chunk is cached.
+        const auto measure = [&fileName](const std::function<bool(const m5::OhlcvData&)>& scan)
+        {
+            const std::shared_ptr<m5::File> file = m5::File::openReadOnly(fileName.c_str());
+            const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/columnar");
+            const std::shared_ptr<m5::OhlcvData> data = instrument->openOhlcvData(m5::OhlcvKind::Default, m5::DataTimeFrame::Minute1, false);
+            const auto started{ Clock::now() };
+            const bool status = data && scan(*data);
+            const double elapsed{ std::chrono::duration<double>(Clock::now() - started).count() };
+            if (data)
+                data->close();
+            instrument->close();
+            file->close();
+            return status ? elapsed : -1.;
+        };
+        const double read = measure([](const m5::OhlcvData& data)
+        {
+            return data.fetchAll([](const m5::Ohlcv* ptr, const hsize_t cnt) noexcept { theSink.fetch_add(static_cast<long long>(ptr[cnt - 1].close_), std::memory_order_relaxed); });
+        });
+        const double close = measure([itemCount](const m5::OhlcvData& data)
+        {
+            m5::Projection projection;
+            if (!data.fetchIndexRangeProjection(projection, m5::Ohlcv::closeField, 0, itemCount))
+                return false;
+            theSink.fetch_add(static_cast<long long>(projection.column(m5::Ohlcv::closeField)[projection.count() - 1]), std::memory_order_relaxed);
+            return true;
+        });
+        if (0. > read || 0. > close)
+            return -1;
+
+        const auto count{ static_cast<double>(itemCount) };
+        std::cout << std::left << std::setw(22) << setting.name_ << std::right << std::setw(10) << count / written / 1e6 << std::setw(10) << count / read / 1e6
+            << std::setw(10) << count / close / 1e6 << std::setw(10) << fileBytes / count << std::endl;
+    }
+    remove(fileName.c_str());
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// aggregate
+// ----------------------------------------------------------------------
+
+static int aggregate(const std::string& fileName, const hsize_t itemCount)
+{
+    // Trades of a random walk in cents with round lot volumes, a millisecond apart.
+    std::vector<m5::Trade> trades(static_cast<size_t>(itemCount));
+    unsigned long long random{ 88172645463325252ULL };
+    const auto next = [&random](const unsigned long long limit)
+    {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        return static_cast<long long>(random % limit);
+    };
+    long long cents{ 10000 };
+    for (hsize_t i = 0; i < itemCount; ++i)
+    {
+        cents = std::max(1LL, cents + next(5) - 2);
+        trades[i] = { 630822816000000000L + static_cast<long long>(i) * 10000L, static_cast<double>(cents) / 100., static_cast<double>(100 * (1 + next(50))) };
+    }
+
+    // The range leaves out the first and the last twentieth of the trades, so that it starts and ends inside chunks.
+    const long long from{ trades[static_cast<size_t>(itemCount / 20)].ticks_ }, to{ trades[static_cast<size_t>(itemCount - 1 - itemCount / 20)].ticks_ };
+    const double rangeCount{ static_cast<double>(itemCount - 2 * (itemCount / 20)) };
+    struct Setting
+    {
+        const char* name_;
+        m5::DatasetCreationOptions options_;
+    };
+    const Setting settings[]{
+        { "deflate6", { 20480, 6, true, true } },
+        { "timeseries", { 20480, 0, false, true, m5::CompressionCodec::TimeSeries } }
+    };
+
+    std::cout << std::fixed << std::setprecision(2)
+        << "aggregate: " << itemCount << " trades per dataset, aggregation of " << static_cast<hsize_t>(rangeCount) << " trades in millions of trades per second" << std::endl
+        << std::left << std::setw(14) << "setting" << std::right << std::setw(16) << "fetch+reduce" << std::setw(16) << "min/max/sum" << std::setw(16) << "vwap" << std::endl;
+    for (const Setting& setting : settings)
+    {
+        remove(fileName.c_str());
+        {
+            const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+            const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/aggregate", true);
+            const std::shared_ptr<m5::TradeData> data = instrument->openTradeData(true, setting.options_);
+            if (!data || !data->add(trades.data(), itemCount, m5::DuplicateTimeTicks::Fail, false))
+                return -1;
+            data->close();
+            instrument->close();
+            file->close();
+        }
+
+        // Every measurement opens the file anew, so that no chunk is cached.
+        const auto measure = [&fileName](const std::function<bool(const m5::TradeData&)>& scan)
+        {
+            const std::shared_ptr<m5::File> file = m5::File::openReadOnly(fileName.c_str());
+            const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/aggregate");
+            const std::shared_ptr<m5::TradeData> data = instrument->openTradeData(false);
+            const auto started{ Clock::now() };
+            const bool status = data && scan(*data);
+            const double elapsed{ std::chrono::duration<double>(Clock::now() - started).count() };
+            if (data)
+                data->close();
+            instrument->close();
+            file->close();
+            return status ? elapsed : -1.;
+        };
+        const double reduced = measure([from, to](const m5::TradeData& data)
+        {
+            double minimum{ 1e300 }, maximum{ -1e300 }, sum{ 0 }, volume{ 0 }, weighted{ 0 };
+            const bool status = data.fetchTickRange([&](const m5::Trade* ptr, const hsize_t cnt) noexcept
+            {
+                for (hsize_t i = 0; i < cnt; ++i)
+                {
+                    minimum = std::min(minimum, ptr[i].price_);
+                    maximum = std::max(maximum, ptr[i].price_);
+                    sum += ptr[i].price_;
+                    volume += ptr[i].volume_;
+                    weighted += ptr[i].price_ * ptr[i].volume_;
+                }
+            }, from, to);
+            theSink.fetch_add(static_cast<long long>(minimum + maximum + sum + weighted / volume), std::memory_order_relaxed);
+            return status;
+        });
+        const double zoned = measure([from, to](const m5::TradeData& data)
+        {
+            m5::DataAggregate result{};
+            const bool status = data.aggregateTickRange(result, from, to, m5::AggregateSpec{ m5::Trade::priceField | m5::Trade::volumeField, false, false });
+            theSink.fetch_add(static_cast<long long>(result.minimum_[0] + result.maximum_[0] + result.sum_[0] + result.sum_[1]), std::memory_order_relaxed);
+            return status;
+        });
+        const double streamed = measure([from, to](const m5::TradeData& data)
+        {
+            m5::DataAggregate result{};
+            const bool status = data.aggregateTickRange(result, from, to, m5::AggregateSpec{ m5::Trade::priceField | m5::Trade::volumeField, true, false });
+            theSink.fetch_add(static_cast<long long>(result.minimum_[0] + result.maximum_[0] + result.sum_[0] + result.volumeWeightedPrice_), std::memory_order_relaxed);
+            return status;
+        });
+        if (0. > reduced || 0. > zoned || 0. > streamed)
+            return -1;
+
+        std::cout << std::left << std::setw(14) << setting.name_ << std::right << std::setw(16) << rangeCount / reduced / 1e6
+            << std::setw(16) << rangeCount / zoned / 1e6 << std::setw(16) << rangeCount / streamed / 1e6 << std::endl;
+    }
+    remove(fileName.c_str());
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// where
+// ----------------------------------------------------------------------
+
+static int where(const std::string& fileName, const hsize_t itemCount)
+{
+    // Trades of a random walk in cents with round lot volumes, a millisecond apart.
+    std::vector<m5::Trade> trades(static_cast<size_t>(itemCount));
+    unsigned long long random{ 88172645463325252ULL };
+    const auto next = [&random](const unsigned long long limit)
+    {
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        return static_cast<long long>(random % limit);
+    };
+    long long cents{ 10000 };
+    for (hsize_t i = 0; i < itemCount; ++i)
+    {
+        cents = std::max(1LL, cents + next(5) - 2);
+        trades[i] = { 630822816000000000L + static_cast<long long>(i) * 10000L, static_cast<double>(cents) / 100., static_cast<double>(100 * (1 + next(50))) };
+    }
+
+    // The largest lots are scattered over all chunks, the price band around the middle trade is met in a few of them.
+    struct Filter
+    {
+        const char* name_;
+        m5::DataPredicate predicate_;
+    };
+    const double middle{ trades[static_cast<size_t>(itemCount / 2)].price_ };
+    const Filter filters[]{
+        { "volume >= 5000", { { { m5::Trade::volumeField, 0, m5::PredicateComparison::GreaterOrEqual, 5000. } } } },
+        { "price band", { { { m5::Trade::priceField, 0, m5::PredicateComparison::Between, middle - 0.05, middle + 0.05 } } } }
+    };
+    const auto matches = [](const m5::DataPredicate& predicate, const m5::Trade& trade)
+    {
+        const m5::PredicateTerm& term = predicate.terms_.front();
+        const double value = m5::Trade::volumeField == term.field_ ? trade.volume_ : trade.price_;
+        return m5::PredicateComparison::Between == term.comparison_ ? value >= term.value_ && value <= term.upperValue_ : value >= term.value_;
+    };
+    struct Setting
+    {
+        const char* name_;
+        m5::DatasetCreationOptions options_;
+    };
+    const Setting settings[]{
+        { "deflate6", { 20480, 6, true, true } },
+        { "timeseries", { 20480, 0, false, true, m5::CompressionCodec::TimeSeries } }
+    };
+
+    std::cout << std::fixed << std::setprecision(2)
+        << "where: " << itemCount << " trades per dataset, filtered in millions of trades per second" << std::endl
+        << std::left << std::setw(14) << "setting" << std::setw(18) << "filter" << std::right << std::setw(10) << "matched"
+        << std::setw(16) << "fetch+filter" << std::setw(16) << "where" << std::setw(10) << "chunks" << std::endl;
+    for (const Setting& setting : settings)
+    {
+        remove(fileName.c_str());
+        {
+            const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+            const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/where", true);
+            const std::shared_ptr<m5::TradeData> data = instrument->openTradeData(true, setting.options_);
+            if (!data || !data->add(trades.data(), itemCount, m5::DuplicateTimeTicks::Fail, false))
+                return -1;
+            data->close();
+            instrument->close();
+            file->close();
+        }
+
+        // Every measurement opens the file anew, so that no chunk is cached.
+        hsize_t chunks{ 0 };
+        const auto measure = [&fileName, &chunks](const std::function<bool(const m5::TradeData&)>& scan)
+        {
+            const std::shared_ptr<m5::File> file = m5::File::openReadOnly(fileName.c_str());
+            const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/where");
+            const std::shared_ptr<m5::TradeData> data = instrument->openTradeData(false);
+            const auto started{ Clock::now() };
+            const bool status = data && scan(*data);
+            const double elapsed{ std::chrono::duration<double>(Clock::now() - started).count() };
+            if (data)
+            {
+                chunks = data->readStatistics().chunks_;
+                data->close();
+            }
+            instrument->close();
+            file->close();
+            return status ? elapsed : -1.;
+        };
+        for (const Filter& filter : filters)
+        {
+            hsize_t filtered{ 0 }, matched{ 0 };
+            const double fetched = measure([&filter, &matches, &filtered](const m5::TradeData& data)
+            {
+                return data.fetchAll([&filter, &matches, &filtered](const m5::Trade* ptr, const hsize_t cnt) noexcept
+                {
+                    for (hsize_t i = 0; i < cnt; ++i)
+                    {
+                        if (matches(filter.predicate_, ptr[i]))
+                            ++filtered;
+                    }
+                });
+            });
+            const double pushed = measure([&filter, &matched](const m5::TradeData& data)
+            {
+                return data.fetchTickRangeWhere([&matched](const m5::Trade*, const hsize_t cnt) noexcept { matched += cnt; }, 0L, 0L, filter.predicate_);
+            });
+            if (0. > fetched || 0. > pushed || filtered != matched)
+                return -1;
+
+            const auto count{ static_cast<double>(itemCount) };
+            std::cout << std::left << std::setw(14) << setting.name_ << std::setw(18) << filter.name_ << std::right << std::setw(10) << matched
+                << std::setw(16) << count / fetched / 1e6 << std::setw(16) << count / pushed / 1e6 << std::setw(10) << chunks << std::endl;
+        }
+    }
+    remove(fileName.c_str());
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// segmented
+// ----------------------------------------------------------------------
+
+static int segmented(const std::string& fileName, const hsize_t itemCount)
+{
+    // The last 90% of the quotes are stored, the first 10% are prepended in 10 batches walking back in time,
+    // then 10 quotes are inserted between the stored ones at evenly spread places.
+    constexpr long long firstTicks{ 630822816000000000L };
+    constexpr hsize_t batchCount{ 10 };
+    const std::vector<m5::Quote> quotes = makeQuotes(itemCount, firstTicks);
+    const hsize_t headCount{ itemCount / 10 / batchCount * batchCount };
+    const hsize_t batchItems{ headCount / batchCount };
+    std::vector<m5::Quote> inserts;
+    for (hsize_t g = 0; g < batchCount; ++g)
+    {
+        m5::Quote quote = quotes[headCount + (itemCount - headCount - 1) * g / batchCount];
+        quote.ticks_ += 5000L;
+        inserts.push_back(quote);
+    }
+    struct Setting
+    {
+        const char* name_;
+        m5::DatasetCreationOptions options_;
+    };
+    Setting settings[]{ { "compound", {} }, { "segmented", {} } };
+    settings[1].options_.segmented_ = true;
+
+    std::cout << std::fixed << std::setprecision(3)
+        << "segmented: " << itemCount << " quotes, " << batchCount << " prepends of " << batchItems << " quotes and " << batchCount << " single-quote inserts" << std::endl
+        << std::left << std::setw(11) << "layout" << std::right << std::setw(12) << "prepend s" << std::setw(12) << "insert s"
+        << std::setw(10) << "segments" << std::setw(14) << "scan Mq/s" << std::setw(12) << "compact s" << std::setw(14) << "scan Mq/s" << std::endl;
+    for (const Setting& setting : settings)
+    {
+        remove(fileName.c_str());
+        const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+        const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/segmented", true);
+        const std::shared_ptr<m5::QuoteData> data = instrument->openQuoteData(true, setting.options_);
+        if (!data || !data->add(quotes.data() + headCount, itemCount - headCount, m5::DuplicateTimeTicks::Fail, false))
+        {
+            std::cerr << "failed to populate the dataset" << std::endl;
+            return -1;
+        }
+
+        auto started{ Clock::now() };
+        bool status{ true };
+        for (hsize_t b = batchCount; 0 < b && status; --b)
+            status = data->add(quotes.data() + (b - 1) * batchItems, batchItems, m5::DuplicateTimeTicks::Fail, false);
+        data->flush();
+        const double prepended{ std::chrono::duration<double>(Clock::now() - started).count() };
+        started = Clock::now();
+        for (hsize_t i = 0; i < inserts.size() && status; ++i)
+            status = data->add(&inserts[i], 1, m5::DuplicateTimeTicks::Fail, false);
+        data->flush();
+        const double inserted{ std::chrono::duration<double>(Clock::now() - started).count() };
+        std::vector<m5::DataSegment> segments;
+        if (!status || !data->fetchSegments(segments) || data->count() != itemCount + inserts.size())
+        {
+            std::cerr << "failed to splice the quotes" << std::endl;
+            return -1;
+        }
+
+        const auto scan = [&data]()
+        {
+            long long sink{ 0 };
+            const auto begun{ Clock::now() };
+            const bool scanned = data->fetchAll([&sink](const m5::Quote* ptr, const hsize_t cnt) noexcept { sink += ptr[cnt - 1].ticks_; });
+            theSink += sink;
+            return scanned ? std::chrono::duration<double>(Clock::now() - begun).count() : -1.;
+        };
+        const double scannedBefore = scan();
+        started = Clock::now();
+        status = data->compact(itemCount);
+        const double compacted{ std::chrono::duration<double>(Clock::now() - started).count() };
+        const double scannedAfter = scan();
+        if (!status || 0. > scannedBefore || 0. > scannedAfter)
+        {
+            std::cerr << "failed to compact the segments" << std::endl;
+            return -1;
+        }
+
+        const auto count{ static_cast<double>(itemCount) };
+        std::cout << std::left << std::setw(11) << setting.name_ << std::right << std::setw(12) << prepended << std::setw(12) << inserted
+            << std::setw(10) << segments.size() << std::setw(14) << count / scannedBefore / 1e6 << std::setw(12) << compacted
+            << std::setw(14) << count / scannedAfter / 1e6 << std::endl;
+
+        data->close();
+        instrument->close();
+        file->close();
+    }
+    remove(fileName.c_str());
+    return 0;
+}
+
+// ----------------------------------------------------------------------
+// preallocate
+// ----------------------------------------------------------------------
+
+static int preallocate(const std::string& fileName, const hsize_t itemCount)
+{
+    // A live recorder adds a few quotes at a time, each add() extends the dataset unless the rows are preallocated.
+    constexpr hsize_t batchItems{ 10 };
+    const std::vector<m5::Quote> quotes = makeQuotes(itemCount, 630822816000000000L);
+
+    std::cout << std::fixed << std::setprecision(3)
+        << "preallocate: " << itemCount << " quotes added " << batchItems << " at a time" << std::endl
+        << std::left << std::setw(14) << "appends" << std::right << std::setw(12) << "add s" << std::setw(14) << "Kquotes/s"
+        << std::setw(12) << "close s" << std::setw(14) << "file bytes" << std::endl;
+    for (const bool preallocated : { false, true })
+    {
+        remove(fileName.c_str());
+        const std::shared_ptr<m5::File> file = m5::File::openReadWrite(fileName.c_str(), true);
+        const std::shared_ptr<m5::Instrument> instrument = file->openInstrument("/preallocate", true);
+        const std::shared_ptr<m5::QuoteData> data = instrument->openQuoteData(true);
+        if (!data)
+            return -1;
+        data->setPreallocate(preallocated);
+        auto started{ Clock::now() };
+        for (hsize_t i = 0; i < itemCount; i += batchItems)
+            if (!data->add(quotes.data() + i, std::min(batchItems, itemCount - i), m5::DuplicateTimeTicks::Fail, false))
+            {
+                std::cerr << "failed to add the quotes" << std::endl;
+                return -1;
+            }
+        const double added{ std::chrono::duration<double>(Clock::now() - started).count() };
+        started = Clock::now();
+        const hsize_t stored = data->count();
+        data->close();
+        const double closed{ std::chrono::duration<double>(Clock::now() - started).count() };
+        instrument->close();
+        file->close();
+        if (stored != itemCount)
+        {
+            std::cerr << "failed to store the quotes" << std::endl;
+            return -1;
+        }
+
+        std::ifstream stream(fileName, std::ios::binary | std::ios::ate);
+        std::cout << std::left << std::setw(14) << (preallocated ? "preallocated" : "exact-size") << std::right << std::setw(12) << added
+            << std::setw(14) << static_cast<double>(itemCount) / added / 1e3 << std::setw(12) << closed
+            << std::setw(14) << static_cast<long long>(stream.tellg()) << std::endl;
+    }
+    remove(fileName.c_str());
+    return 0;
+}
+
+int main(const int argc, const char* argv[])  // NOLINT(bugprone-exception-escape)
+{
+    const option_parser parser{ argc, argv };
+    if (parser.is_help(1U))
+        return help();
+
+    const std::string& benchmark = parser.get_option(0U);
+    const std::string& file = parser.get_option("-f", "--file");
+    const std::string fileName{ file.empty() ? "mbch5bench.h5" : file };
+    const unsigned hardwareThreads{ std::max(1U, std::thread::hardware_concurrency()) };
+    const auto threads{ static_cast<unsigned>(std::max(1ULL, toNumber(parser.get_option("-t", "--threads"), hardwareThreads))) };
+    const hsize_t count{ std::max(1ULL, toNumber(parser.get_option("-n", "--count"), 1000000ULL)) };
+    const auto seconds{ static_cast<unsigned>(std::max(1ULL, toNumber(parser.get_option("-s", "--seconds"), 2ULL))) };
+
+    if (benchmark == "contention")
+        return contention(fileName, threads, count, seconds);
+    if (benchmark == "ticksindex")
+        return ticksIndex(fileName, count, seconds);
+    if (benchmark == "merge")
+        return merge(fileName, count);
+    if (benchmark == "poll")
+        return poll(fileName, count, seconds);
+    if (benchmark == "fetchinto")
+        return fetchInto(fileName, count, seconds);
+    if (benchmark == "cursor")
+        return cursor(fileName, count);
+    if (benchmark == "paging")
+        return paging(fileName, count);
+    if (benchmark == "layout")
+        return layout(fileName, count);
+    if (benchmark == "codec")
+        return codec(fileName, count);
+    if (benchmark == "appender")
+        return appender(fileName, count);
+    if (benchmark == "decompress")
+        return decompress(fileName, threads, count);
+    if (benchmark == "compress")
+        return compress(fileName, threads, count);
+    if (benchmark == "columnar")
+        return columnar(fileName, count);
+    if (benchmark == "aggregate")
+        return aggregate(fileName, count);
+    if (benchmark == "where")
+        return where(fileName, count);
+    if (benchmark == "segmented")
+        return segmented(fileName, count);
+    if (benchmark == "preallocate")
+        return preallocate(fileName, count);
+
+    std::cerr << "unknown benchmark: " << benchmark << std::endl;
+    return help();
+}
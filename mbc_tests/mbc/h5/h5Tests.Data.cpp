@@ -1,12 +1,61 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <thread>
 #include "mbc/testharness.h"
 #include "mbc/h5.h"
 
 namespace h5 { namespace m5 = mbc::h5;
 
 using Data = m5::Data;
+using File = m5::File;
+using Instrument = m5::Instrument;
+using DataTimeFrame = m5::DataTimeFrame;
+using ScalarData = m5::ScalarData;
+using Scalar = m5::Scalar;
+using ScalarCursor = m5::ScalarCursor;
+using ScalarAppender = m5::ScalarAppender;
+using AppenderOptions = m5::AppenderOptions;
+using AppenderOverflow = m5::AppenderOverflow;
+using DuplicateTimeTicks = m5::DuplicateTimeTicks;
+using DatasetCreationOptions = m5::DatasetCreationOptions;
+using Projection = m5::Projection;
+using Quote = m5::Quote;
+using QuoteData = m5::QuoteData;
+using Trade = m5::Trade;
+using TradeData = m5::TradeData;
+using AggregateSpec = m5::AggregateSpec;
+using DataAggregate = m5::DataAggregate;
+using DataSegment = m5::DataSegment;
+using DataInfo = m5::DataInfo;
+using DataPredicate = m5::DataPredicate;
+using PredicateComparison = m5::PredicateComparison;
+using DownsamplingMethod = m5::DownsamplingMethod;
+using CompressionCodec = m5::CompressionCodec;
 
 TESTGROUP("h5 data")
 {
+    static bool verifyTicksIndex(const std::shared_ptr<ScalarData>& data, const std::vector<long long>& ticks)
+    {
+        // Probe a sample of stored ticks and of the gaps between them, the ends are handled before the index is consulted.
+        for (size_t i = 1; i + 1 < ticks.size(); i += 101)
+        {
+            hsize_t index;
+            bool match;
+            if (!data->ticksIndex(ticks[i], index, match) || i != index || !match)
+                return false;
+            if (ticks[i] + 1 < ticks[i + 1])
+            {
+                if (!data->ticksIndex(ticks[i] + 1, index, match) || i != index || match)
+                    return false;
+            }
+        }
+        return true;
+    }
+
     // ---------------------------------------------------------------------------
     // Default maximum read buffer bytes
     // ---------------------------------------------------------------------------
@@ -27,5 +76,2196 @@ TESTGROUP("h5 data")
         Data::setDefaultMaximumReadBufferBytes(valueOld);
     }
 
+    // ---------------------------------------------------------------------------
+    // Default maximum tick index bytes
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("default maximum tick index bytes has correct value")
+    {
+        ASSERT_EQUAL(1024UL * 1024UL, Data::defaultMaximumTickIndexBytes()) << ": default";
+    }
+
+    TESTCASE("when set, default maximum tick index bytes has correct value")
+    {
+        const auto valueNew = 123UL;
+        const auto valueOld{ Data::defaultMaximumTickIndexBytes() };
+
+        Data::setDefaultMaximumTickIndexBytes(valueNew);
+
+        ASSERT_EQUAL(valueNew, Data::defaultMaximumTickIndexBytes()) << ": default";
+        Data::setDefaultMaximumTickIndexBytes(valueOld);
+    }
+
+    // ---------------------------------------------------------------------------
+    // Default decompression threads
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("default decompression threads has correct value")
+    {
+        ASSERT_EQUAL(1U, Data::defaultDecompressionThreads()) << ": default";
+    }
+
+    TESTCASE("when set, default decompression threads has correct value")
+    {
+        const auto valueNew = 3U;
+        const auto valueOld{ Data::defaultDecompressionThreads() };
+
+        Data::setDefaultDecompressionThreads(valueNew);
+
+        ASSERT_EQUAL(valueNew, Data::defaultDecompressionThreads()) << ": default";
+        Data::setDefaultDecompressionThreads(valueOld);
+    }
+
+    // ---------------------------------------------------------------------------
+    // Default compression threads
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("default compression threads has correct value")
+    {
+        ASSERT_EQUAL(0U, Data::defaultCompressionThreads()) << ": default";
+    }
+
+    TESTCASE("when set, default compression threads has correct value")
+    {
+        const auto valueNew = 3U;
+        const auto valueOld{ Data::defaultCompressionThreads() };
+
+        Data::setDefaultCompressionThreads(valueNew);
+
+        ASSERT_EQUAL(valueNew, Data::defaultCompressionThreads()) << ": default";
+        Data::setDefaultCompressionThreads(valueOld);
+    }
+
+    // ---------------------------------------------------------------------------
+    // Tick index
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("ticks index follows appends, merges, prepends and deletions across chunks")
+    {
+        const char* fileName{ "data_ticks_index_follows_appends_merges_prepends_and_deletions_across_chunks.h5" };
+
+        // Unlimited, thinned out to a couple of samples, and disabled.
+        for (const hsize_t maximumTickIndexBytes : { 1024UL * 1024UL, 40UL, 0UL })
+        {
+            remove(fileName);
+            const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+            const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+            const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+            data->setMaximumTickIndexBytes(maximumTickIndexBytes);
+
+            // Three chunks and a bit, in two appends.
+            std::vector<long long> ticks;
+            std::vector<Scalar> input;
+            for (long long i = 1; i <= 70000; ++i)
+            {
+                ticks.push_back(i * 10L);
+                input.push_back({ i * 10L, static_cast<double>(i) });
+            }
+            const bool statusAdd1 = data->add(input.data(), 30000, DuplicateTimeTicks::Fail, false);
+            const bool statusIndex1 = verifyTicksIndex(data, std::vector<long long>(ticks.begin(), ticks.begin() + 30000));
+            const bool statusAdd2 = data->add(input.data() + 30000, 40000, DuplicateTimeTicks::Fail, false);
+            const bool statusIndex2 = verifyTicksIndex(data, ticks);
+
+            // Merge into the second chunk.
+            input.clear();
+            for (long long i = 25000; i < 25100; ++i)
+            {
+                input.push_back({ i * 10L + 5L, 0. });
+                ticks.push_back(i * 10L + 5L);
+            }
+            std::sort(ticks.begin(), ticks.end());
+            const bool statusMerge = data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+            const bool statusIndex3 = verifyTicksIndex(data, ticks);
+
+            // Prepend.
+            input.clear();
+            for (long long i = 1; i < 10; ++i)
+                input.push_back({ i, 0. });
+            ticks.insert(ticks.begin(), { 1L, 2L, 3L, 4L, 5L, 6L, 7L, 8L, 9L });
+            const bool statusPrepend = data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+            const bool statusIndex4 = verifyTicksIndex(data, ticks);
+
+            // Delete across the first chunk boundary.
+            const bool statusDelete = data->deleteTickRange(200000L, 210000L);
+            ticks.erase(std::remove_if(ticks.begin(), ticks.end(), [](const long long t) { return 200000L <= t && t <= 210000L; }), ticks.end());
+            const bool statusIndex5 = verifyTicksIndex(data, ticks);
+
+            data->close();
+            instrument->close();
+            file->close();
+
+            remove(fileName);
+
+            ASSERT_IS_TRUE(statusAdd1 && statusAdd2 && statusMerge && statusPrepend && statusDelete) << ": " << std::to_string(maximumTickIndexBytes) << " bytes, write operations should return true";
+            ASSERT_IS_TRUE(statusIndex1) << ": " << std::to_string(maximumTickIndexBytes) << " bytes, ticks index should be correct after the first append";
+            ASSERT_IS_TRUE(statusIndex2) << ": " << std::to_string(maximumTickIndexBytes) << " bytes, ticks index should be correct after the second append";
+            ASSERT_IS_TRUE(statusIndex3) << ": " << std::to_string(maximumTickIndexBytes) << " bytes, ticks index should be correct after the merge";
+            ASSERT_IS_TRUE(statusIndex4) << ": " << std::to_string(maximumTickIndexBytes) << " bytes, ticks index should be correct after the prepend";
+            ASSERT_IS_TRUE(statusIndex5) << ": " << std::to_string(maximumTickIndexBytes) << " bytes, ticks index should be correct after the deletion";
+        }
+    }
+
+    TESTCASE("ticks index detects a dataset modified through another data object")
+    {
+        const char* fileName{ "data_ticks_index_detects_a_dataset_modified_through_another_data_object.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<ScalarData> data1 = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+        const std::shared_ptr<ScalarData> data2 = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+        std::vector<long long> ticks;
+        std::vector<Scalar> input;
+        for (long long i = 1; i <= 50000; ++i)
+        {
+            ticks.push_back(i * 10L);
+            input.push_back({ i * 10L, static_cast<double>(i) });
+        }
+        const bool statusAdd = data1->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+        const bool statusIndex1 = verifyTicksIndex(data1, ticks);
+
+        // Same item count, but the rows have moved.
+        const Scalar inserted[]{ {15L, 0.} };
+        const bool statusModify = data2->add(inserted, 1, DuplicateTimeTicks::Fail, false) && data2->deleteIndexRange(49990, 49990);
+        ticks.insert(ticks.begin() + 1, 15L);
+        ticks.erase(ticks.begin() + 49990);
+        const bool statusIndex2 = verifyTicksIndex(data1, ticks);
+
+        data1->close();
+        data2->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd && statusModify) << ": write operations should return true";
+        ASSERT_IS_TRUE(statusIndex1) << ": ticks index should be correct initially";
+        ASSERT_IS_TRUE(statusIndex2) << ": ticks index should be correct after the modification";
+    }
+
+    // ---------------------------------------------------------------------------
+    // Summary
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("summary follows adds and deletions")
+    {
+        const char* fileName{ "data_summary_follows_adds_and_deletions.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+        const m5::DataSummary summaryEmpty = data->summary();
+
+        const Scalar input1[]{ {30L, 3.}, {40L, 4.}, {50L, 5.} };
+        const bool statusAdd1 = data->add(input1, 3, DuplicateTimeTicks::Fail, false);
+        const m5::DataSummary summaryAdd1 = data->summary();
+
+        const Scalar input2[]{ {10L, 1.}, {35L, 3.5}, {60L, 6.}, {70L, 7.} };
+        const bool statusAdd2 = data->add(input2, 4, DuplicateTimeTicks::Fail, false);
+        const m5::DataSummary summaryAdd2 = data->summary();
+
+        const bool statusDelete1 = data->deleteTickRange(60L, 70L);
+        const m5::DataSummary summaryDelete1 = data->summary();
+
+        const bool statusDelete2 = data->deleteIndexRange(0, 0);
+        const m5::DataSummary summaryDelete2 = data->summary();
+        const hsize_t count = data->count();
+        const long long firstTicks = data->firstTicks();
+        const long long lastTicks = data->lastTicks();
+
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd1 && statusAdd2 && statusDelete1 && statusDelete2) << ": write operations should return true";
+        ASSERT_EQUAL(0UL, summaryEmpty.count_) << ": empty count";
+        ASSERT_EQUAL(0L, summaryEmpty.firstTicks_) << ": empty first ticks";
+        ASSERT_EQUAL(0L, summaryEmpty.lastTicks_) << ": empty last ticks";
+        ASSERT_EQUAL(3UL, summaryAdd1.count_) << ": count after the first add";
+        ASSERT_EQUAL(30L, summaryAdd1.firstTicks_) << ": first ticks after the first add";
+        ASSERT_EQUAL(50L, summaryAdd1.lastTicks_) << ": last ticks after the first add";
+        ASSERT_EQUAL(7UL, summaryAdd2.count_) << ": count after the second add";
+        ASSERT_EQUAL(10L, summaryAdd2.firstTicks_) << ": first ticks after the second add";
+        ASSERT_EQUAL(70L, summaryAdd2.lastTicks_) << ": last ticks after the second add";
+        ASSERT_EQUAL(5UL, summaryDelete1.count_) << ": count after the tail deletion";
+        ASSERT_EQUAL(10L, summaryDelete1.firstTicks_) << ": first ticks after the tail deletion";
+        ASSERT_EQUAL(50L, summaryDelete1.lastTicks_) << ": last ticks after the tail deletion";
+        ASSERT_EQUAL(4UL, summaryDelete2.count_) << ": count after the head deletion";
+        ASSERT_EQUAL(30L, summaryDelete2.firstTicks_) << ": first ticks after the head deletion";
+        ASSERT_EQUAL(50L, summaryDelete2.lastTicks_) << ": last ticks after the head deletion";
+        ASSERT_EQUAL(summaryDelete2.count_, count) << ": count should match the summary";
+        ASSERT_EQUAL(summaryDelete2.firstTicks_, firstTicks) << ": first ticks should match the summary";
+        ASSERT_EQUAL(summaryDelete2.lastTicks_, lastTicks) << ": last ticks should match the summary";
+    }
+
+    TESTCASE("summary and index ranges of a second handle follow the writes of the first one")
+    {
+        const char* fileName{ "data_summary_and_index_ranges_of_a_second_handle_follow_the_writes_of_the_first_one.h5" };
+        remove(fileName);
+
+        std::vector<Scalar> input;
+        for (long long i = 1; i <= 10; ++i)
+            input.push_back({ i * 1000L, static_cast<double>(i) });
+        const auto fetch = [](const std::shared_ptr<ScalarData>& data, const hsize_t last)
+        {
+            std::vector<Scalar> fetched;
+            const auto collect = [&fetched](const Scalar* items, hsize_t count) noexcept { fetched.insert(fetched.end(), items, items + count); };
+            const bool status = 0 == last ? data->fetchAll(collect) : data->fetchLast(collect, last);
+            return status ? fetched : std::vector<Scalar>();
+        };
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<ScalarData> writer = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+        const std::shared_ptr<ScalarData> reader = instrument->openScalarData(DataTimeFrame::Aperiodic, false);
+        const bool statusAdd1 = writer->add(input.data(), 5, DuplicateTimeTicks::Fail, false);
+        const m5::DataSummary summary1 = reader->summary();
+
+        // The second handle has cached its summary, the writes of the first one change the item count.
+        const bool statusAdd2 = writer->add(input.data() + 5, 5, DuplicateTimeTicks::Fail, false) && writer->deleteAllBeforeIndex(3UL);
+        const m5::DataSummary summary2 = reader->summary();
+        const std::vector<Scalar> all = fetch(reader, 0);
+        const std::vector<Scalar> last = fetch(reader, 2);
+        hsize_t written{ 0 };
+        Scalar buffer[10];
+        const bool statusBuffer = reader->fetchIndexRangeInto(buffer, 10, written, 0, 10);
+
+        reader->close();
+        writer->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd1 && statusAdd2)                        << ": write operations should return true";
+        ASSERT_IS_TRUE(5UL == summary1.count_ && 1000L == summary1.firstTicks_ && 5000L == summary1.lastTicks_) << ": first summary should match the file";
+        ASSERT_IS_TRUE(6UL == summary2.count_ && 5000L == summary2.firstTicks_ && 10000L == summary2.lastTicks_) << ": summary should follow the other handle";
+        ASSERT_IS_TRUE(6 == all.size() && 5000L == all.front().ticks_ && 10000L == all.back().ticks_) << ": fetch all should return every item";
+        ASSERT_IS_TRUE(2 == last.size() && 9000L == last.front().ticks_ && 10000L == last.back().ticks_) << ": fetch last should return the tail";
+        ASSERT_IS_TRUE(statusBuffer && 6UL == written && 5000L == buffer[0].ticks_) << ": index range should be clamped by the item count of the file";
+    }
+
+    // ---------------------------------------------------------------------------
+    // Merge
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("merge of interleaved input across chunks honours the duplicate time ticks policy")
+    {
+        const char* fileName{ "data_merge_of_interleaved_input_across_chunks_honours_the_duplicate_time_ticks_policy.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+        std::vector<Scalar> stored, input;
+        for (long long i = 1; i <= 50000; ++i)
+            stored.push_back({ i * 10L, static_cast<double>(i) });
+        const bool statusAdd = data->add(stored.data(), stored.size(), DuplicateTimeTicks::Fail, false);
+
+        // Every 7th interval gets a new item, every 11th stored item gets a different value.
+        for (long long i = 2; i < 50000; ++i)
+        {
+            if (0 == i % 11)
+                input.push_back({ i * 10L, -1. });
+            if (0 == i % 7)
+                input.push_back({ i * 10L + 5L, -2. });
+        }
+        const bool statusFail = data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+        const hsize_t countFail = data->count();
+        const bool statusUpdate = data->add(input.data(), input.size(), DuplicateTimeTicks::Update, false);
+
+        std::vector<Scalar> expected;
+        size_t j = 0;
+        for (const Scalar& item : stored)
+        {
+            while (j < input.size() && input[j].ticks_ < item.ticks_)
+                expected.push_back(input[j++]);
+            if (j < input.size() && input[j].ticks_ == item.ticks_)
+                expected.push_back(input[j++]);
+            else
+                expected.push_back(item);
+        }
+        std::vector<Scalar> fetched;
+        const bool statusFetch = data->fetchAll([&fetched](const Scalar* ptr, const hsize_t cnt) noexcept
+        {
+            try
+            {
+                fetched.insert(fetched.end(), ptr, ptr + cnt);
+            }
+            catch (...)
+            {
+            }
+        });
+        bool same = expected.size() == fetched.size();
+        for (size_t i = 0; same && i < expected.size(); ++i)
+            same = expected[i].ticks_ == fetched[i].ticks_ && expected[i].value_ == fetched[i].value_;
+
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd) << ": add should return true";
+        ASSERT_IS_FALSE(statusFail) << ": add should return false when duplicate ticks fail";
+        ASSERT_EQUAL(50000UL, countFail) << ": failed add should not change the data";
+        ASSERT_IS_TRUE(statusUpdate) << ": add should return true when duplicate ticks update";
+        ASSERT_IS_TRUE(statusFetch) << ": fetchAll should return true";
+        ASSERT_IS_TRUE(same) << ": merged data should be sorted with the duplicates updated";
+    }
+
+    TESTCASE("merge walks the rest of the data in pages of the read buffer")
+    {
+        const char* fileName{ "data_merge_walks_the_rest_of_the_data_in_pages_of_the_read_buffer.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+        std::vector<Scalar> stored, inserted, updated;
+        for (long long i = 1; i <= 100000; ++i)
+            stored.push_back({ i * 10L, static_cast<double>(i) });
+        const bool statusAdd = data->add(stored.data(), stored.size(), DuplicateTimeTicks::Fail, false);
+
+        // Pages of a single chunk; the input is spread over the chunks, every 13th stored item is updated.
+        data->setMaximumReadBufferBytes(0);
+        for (long long i = 10000; i < 90000; ++i)
+        {
+            if (0 == i % 13)
+                inserted.push_back({ i * 10L, -1. });
+            if (0 == i % 7)
+                inserted.push_back({ i * 10L + 5L, -2. });
+        }
+        const bool statusInsert = data->add(inserted.data(), inserted.size(), DuplicateTimeTicks::Update, false);
+
+        // Updates only, nothing moves.
+        for (long long i = 20000; i < 60000; i += 17)
+            updated.push_back({ i * 10L, -3. });
+        const bool statusUpdate = data->add(updated.data(), updated.size(), DuplicateTimeTicks::Update, false);
+
+        std::vector<Scalar> expected;
+        size_t j = 0, k = 0;
+        for (const Scalar& item : stored)
+        {
+            while (j < inserted.size() && inserted[j].ticks_ < item.ticks_)
+                expected.push_back(inserted[j++]);
+            Scalar merged = item;
+            if (j < inserted.size() && inserted[j].ticks_ == item.ticks_)
+                merged = inserted[j++];
+            while (k < updated.size() && updated[k].ticks_ < item.ticks_)
+                ++k;
+            if (k < updated.size() && updated[k].ticks_ == item.ticks_)
+                merged = updated[k];
+            expected.push_back(merged);
+        }
+        std::vector<Scalar> fetched;
+        const bool statusFetch = data->fetchAll([&fetched](const Scalar* ptr, const hsize_t cnt) noexcept
+        {
+            try
+            {
+                fetched.insert(fetched.end(), ptr, ptr + cnt);
+            }
+            catch (...)
+            {
+            }
+        });
+        bool same = expected.size() == fetched.size();
+        for (size_t i = 0; same && i < expected.size(); ++i)
+            same = expected[i].ticks_ == fetched[i].ticks_ && expected[i].value_ == fetched[i].value_;
+
+        // The ticks index follows the rewritten rows.
+        hsize_t rangeCount{ 0 };
+        long long rangeFirst{ 0 };
+        const bool statusRange = data->fetchTickRange([&rangeCount, &rangeFirst](const Scalar* ptr, const hsize_t cnt) noexcept
+        {
+            if (0 == rangeCount && 0 < cnt)
+                rangeFirst = ptr->ticks_;
+            rangeCount += cnt;
+        }, 700005L, 700100L);
+
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd) << ": add should return true";
+        ASSERT_IS_TRUE(statusInsert) << ": merge of the inserted items should return true";
+        ASSERT_IS_TRUE(statusUpdate) << ": merge of the updated items should return true";
+        ASSERT_IS_TRUE(statusFetch) << ": fetchAll should return true";
+        ASSERT_IS_TRUE(same) << ": merged data should be sorted with the duplicates updated";
+        ASSERT_IS_TRUE(statusRange) << ": fetchTickRange should return true";
+        ASSERT_EQUAL(12UL, rangeCount) << ": tick range should hold the stored and the inserted items";
+        ASSERT_EQUAL(700005L, rangeFirst) << ": tick range should start at the inserted item";
+    }
+
+    // ---------------------------------------------------------------------------
+    // Paging
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("paged fetches are aligned to chunks and counted in read statistics")
+    {
+        const char* fileName{ "data_paged_fetches_are_aligned_to_chunks_and_counted_in_read_statistics.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+        std::vector<Scalar> input;
+        for (long long i = 1; i <= 50000; ++i)
+            input.push_back({ i * 10L, static_cast<double>(i) });
+        const bool statusAdd = data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+
+        std::vector<hsize_t> pageCounts;
+        long long ticks{ 0L };
+        bool ordered{ true };
+        const auto collect = [&pageCounts, &ticks, &ordered](const Scalar* ptr, const hsize_t cnt)
+        {
+            pageCounts.push_back(cnt);
+            for (hsize_t i = 0; i < cnt; ++i)
+            {
+                ticks += 10L;
+                ordered = ordered && ticks == ptr[i].ticks_;
+            }
+        };
+
+        // A budget of one and a half chunks is rounded down to whole chunks.
+        data->setMaximumReadBufferBytes(30720 * sizeof(Scalar));
+        data->resetReadStatistics();
+        ticks = 50000L;
+        const bool statusWhole = data->fetchTickRange(collect, 50010L, 0L);
+        const m5::DataReadStatistics statisticsWhole = data->readStatistics();
+        const std::vector<hsize_t> pageCountsWhole{ pageCounts };
+
+        // A budget of less than a chunk never straddles a chunk boundary.
+        data->setMaximumReadBufferBytes(8000 * sizeof(Scalar));
+        data->resetReadStatistics();
+        pageCounts.clear();
+        ticks = 190000L;
+        const bool statusPartial = data->fetchIndexRange(collect, 19000UL, 12000UL);
+        const m5::DataReadStatistics statisticsPartial = data->readStatistics();
+        const std::vector<hsize_t> pageCountsPartial{ pageCounts };
+
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        const std::vector<hsize_t> expectedWhole{ 15480UL, 20480UL, 9040UL };
+        const std::vector<hsize_t> expectedPartial{ 1480UL, 8000UL, 2520UL };
+        ASSERT_IS_TRUE(statusAdd)                            << ": status add should be true";
+        ASSERT_IS_TRUE(statusWhole && statusPartial)         << ": status fetch should be true";
+        ASSERT_IS_TRUE(ordered)                              << ": fetched items should be in order";
+        ASSERT_IS_TRUE(expectedWhole == pageCountsWhole)     << ": whole chunk pages should have expected counts";
+        ASSERT_IS_TRUE(expectedPartial == pageCountsPartial) << ": partial chunk pages should have expected counts";
+        ASSERT_EQUAL(3UL, statisticsWhole.reads_)            << ": whole chunk reads should have expected value";
+        ASSERT_EQUAL(45000UL, statisticsWhole.items_)        << ": whole chunk items should have expected value";
+        ASSERT_EQUAL(3UL, statisticsWhole.chunks_)           << ": whole chunk chunks should have expected value";
+        ASSERT_EQUAL(3UL, statisticsPartial.reads_)          << ": partial chunk reads should have expected value";
+        ASSERT_EQUAL(12000UL, statisticsPartial.items_)      << ": partial chunk items should have expected value";
+        ASSERT_EQUAL(3UL, statisticsPartial.chunks_)         << ": partial chunk chunks should have expected value";
+    }
+
+    // ---------------------------------------------------------------------------
+    // Parallel decompression
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("parallel decompression reads the same bytes as the library")
+    {
+        const char* fileName{ "data_parallel_decompression_reads_the_same_bytes_as_the_library.h5" };
+        remove(fileName);
+
+        DatasetCreationOptions shuffled{ 1000, 9, true, true };
+        DatasetCreationOptions deflated{ 1000, 1, false, true };
+        DatasetCreationOptions uncompressed{ 1000, 0, false, false };
+        DatasetCreationOptions encoded{ 1000, 0, false, true };
+        encoded.codec_ = CompressionCodec::TimeSeries;
+        std::vector<DatasetCreationOptions> options{ shuffled, deflated, uncompressed, encoded };
+
+        // The chunk cache holding a single chunk leaves the reads of several chunks to the parallel path.
+        for (auto& option : options)
+            option.chunkCacheBytes_ = 1000 * sizeof(Scalar);
+
+        // Irregular ticks and noisy values, with a partial last chunk.
+        std::vector<Scalar> input;
+        unsigned long long random{ 12345UL };
+        long long ticks{ 0L };
+        for (hsize_t i = 0; i < 10500; ++i)
+        {
+            random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+            ticks += 1L + static_cast<long long>(random >> 58);
+            input.push_back({ ticks, 0 == i % 7 ? static_cast<double>(random >> 11) : 100.0 + static_cast<double>(random >> 54) / 100.0 });
+        }
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        bool statusAdd{ true }, statusFetch{ true }, identical{ true };
+        for (size_t k = 0; k < options.size(); ++k)
+        {
+            const std::string path = "/foo/bar" + std::to_string(k);
+            const std::shared_ptr<Instrument> instrument = file->openInstrument(path.c_str(), true);
+            const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true, options[k]);
+            statusAdd = statusAdd && data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+            data->setMaximumReadBufferBytes(0);
+
+            // Whole, chunk-aligned and unaligned ranges, the last one ending in the partial chunk.
+            const std::vector<std::pair<hsize_t, hsize_t>> ranges{ { 0, 10500 }, { 2000, 4000 }, { 999, 2 }, { 1234, 9266 } };
+            for (const auto& range : ranges)
+            {
+                std::vector<Scalar> serial(range.second), parallel(range.second);
+                hsize_t writtenSerial, writtenParallel;
+                data->setDecompressionThreads(1);
+                statusFetch = statusFetch && data->fetchIndexRangeInto(serial.data(), range.second, writtenSerial, range.first, range.second);
+                data->setDecompressionThreads(4);
+                statusFetch = statusFetch && data->fetchIndexRangeInto(parallel.data(), range.second, writtenParallel, range.first, range.second);
+                identical = identical && range.second == writtenSerial && range.second == writtenParallel
+                    && 0 == memcmp(serial.data(), parallel.data(), range.second * sizeof(Scalar))
+                    && 0 == memcmp(input.data() + range.first, parallel.data(), range.second * sizeof(Scalar));
+            }
+
+            // Collecting fetches go through the same read.
+            hsize_t collected{ 0 };
+            statusFetch = statusFetch && data->fetchAll([&input, &collected, &identical](const Scalar* ptr, const hsize_t cnt)
+            {
+                identical = identical && 0 == memcmp(input.data() + collected, ptr, cnt * sizeof(Scalar));
+                collected += cnt;
+            });
+            identical = identical && input.size() == collected;
+
+            data->close();
+            instrument->close();
+        }
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)   << ": status add should be true";
+        ASSERT_IS_TRUE(statusFetch) << ": status fetch should be true";
+        ASSERT_IS_TRUE(identical)   << ": parallel reads should be identical to serial reads and to the input";
+    }
+
+    // ---------------------------------------------------------------------------
+    // Parallel compression
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("parallel compression of appended chunks is read back by the library")
+    {
+        const char* fileName{ "data_parallel_compression_of_appended_chunks_is_read_back_by_the_library.h5" };
+        remove(fileName);
+
+        DatasetCreationOptions shuffled{ 1000, 9, true, true };
+        DatasetCreationOptions deflated{ 1000, 1, false, true };
+        DatasetCreationOptions uncompressed{ 1000, 0, false, false };
+        DatasetCreationOptions encoded{ 1000, 0, false, true };
+        encoded.codec_ = CompressionCodec::TimeSeries;
+        const std::vector<DatasetCreationOptions> options{ shuffled, deflated, uncompressed, encoded };
+
+        std::vector<Scalar> input;
+        unsigned long long random{ 54321UL };
+        long long ticks{ 0L };
+        for (hsize_t i = 0; i < 12300; ++i)
+        {
+            random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+            ticks += 1L + static_cast<long long>(random >> 58);
+            input.push_back({ ticks, 0 == i % 5 ? static_cast<double>(random >> 11) : 100.0 + static_cast<double>(random >> 54) / 100.0 });
+        }
+
+        // An append into an empty dataset, one with a partial head and tail chunk, and one of whole chunks.
+        const std::vector<std::pair<hsize_t, hsize_t>> appends{ { 0, 2300 }, { 2300, 5500 }, { 7800, 200 }, { 8000, 4000 }, { 12000, 300 } };
+        bool statusAdd{ true }, statusFetch{ true }, identical{ true };
+        {
+            const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+            for (size_t k = 0; k < options.size(); ++k)
+            {
+                const std::string path = "/foo/bar" + std::to_string(k);
+                const std::shared_ptr<Instrument> instrument = file->openInstrument(path.c_str(), true);
+                const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true, options[k]);
+                data->setCompressionThreads(4);
+                for (const auto& append : appends)
+                    statusAdd = statusAdd && data->add(input.data() + append.first, append.second, DuplicateTimeTicks::Fail, false);
+                data->close();
+                instrument->close();
+            }
+            file->close();
+        }
+        {
+            const std::shared_ptr<File> file = File::openReadOnly(fileName);
+            for (size_t k = 0; k < options.size(); ++k)
+            {
+                const std::string path = "/foo/bar" + std::to_string(k);
+                const std::shared_ptr<Instrument> instrument = file->openInstrument(path.c_str(), false);
+                const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, false);
+                for (const unsigned threads : { 1U, 4U })
+                {
+                    std::vector<Scalar> output(input.size());
+                    hsize_t written;
+                    data->setDecompressionThreads(threads);
+                    statusFetch = statusFetch && data->fetchIndexRangeInto(output.data(), output.size(), written, 0, output.size());
+                    identical = identical && input.size() == written && 0 == memcmp(input.data(), output.data(), input.size() * sizeof(Scalar));
+                }
+                data->close();
+                instrument->close();
+            }
+            file->close();
+        }
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)   << ": status add should be true";
+        ASSERT_IS_TRUE(statusFetch) << ": status fetch should be true";
+        ASSERT_IS_TRUE(identical)   << ": items read through the library and in parallel should be identical to the input";
+    }
+
+    // ---------------------------------------------------------------------------
+    // Projection
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("projection fetch returns aligned columns of the selected fields")
+    {
+        const char* fileName{ "data_projection_fetch_returns_aligned_columns_of_the_selected_fields.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<QuoteData> data = instrument->openQuoteData(true, DatasetCreationOptions{ 1000, 9, true, true });
+        std::vector<Quote> input;
+        for (long long i = 1; i <= 3500; ++i)
+            input.push_back({ i * 10L, 100.0 + static_cast<double>(i), 99.0 + static_cast<double>(i), static_cast<double>(i % 13), static_cast<double>(i % 17) });
+        const bool statusAdd = data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+
+        // A tick range across four chunks, starting and ending inside a chunk.
+        Projection projection;
+        const unsigned fields{ Quote::ticksField | Quote::bidPriceField | Quote::askPriceField };
+        const bool statusTicks = data->fetchTickRangeProjection(projection, fields, 5000L, 34000L);
+        const hsize_t countTicks = projection.count();
+        const unsigned fieldsTicks = projection.fields();
+        bool valuesTicks{ nullptr != projection.ticks() && nullptr != projection.column(Quote::bidPriceField) && nullptr != projection.column(Quote::askPriceField) };
+        bool aligned{ valuesTicks };
+        for (hsize_t i = 0; valuesTicks && i < countTicks; ++i)
+        {
+            const Quote& q = input[static_cast<size_t>(i) + 499];
+            valuesTicks = q.ticks_ == projection.ticks()[i] && q.bidPrice_ == projection.column(Quote::bidPriceField)[i] && q.askPrice_ == projection.column(Quote::askPriceField)[i];
+        }
+        for (const void* column : { static_cast<const void*>(projection.ticks()), static_cast<const void*>(projection.column(Quote::bidPriceField)), static_cast<const void*>(projection.column(Quote::askPriceField)) })
+            aligned = aligned && 0 == reinterpret_cast<uintptr_t>(column) % Projection::alignment;
+        const bool unselected = nullptr == projection.column(Quote::askSizeField) && nullptr == projection.column(Quote::bidSizeField);
+
+        // A single field of an index range reuses the projection.
+        const bool statusIndex = data->fetchIndexRangeProjection(projection, Quote::bidSizeField, 3000UL, 1000UL);
+        const hsize_t countIndex = projection.count();
+        bool valuesIndex{ nullptr == projection.ticks() && nullptr != projection.column(Quote::bidSizeField) };
+        for (hsize_t i = 0; valuesIndex && i < countIndex; ++i)
+            valuesIndex = input[static_cast<size_t>(i) + 3000].bidSize_ == projection.column(Quote::bidSizeField)[i];
+
+        // A mask with a bit past the last field is rejected.
+        const bool statusInvalid = data->fetchIndexRangeProjection(projection, 0x20, 0UL, 10UL);
+
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)                  << ": status add should be true";
+        ASSERT_IS_TRUE(statusTicks && statusIndex) << ": status fetch should be true";
+        ASSERT_IS_FALSE(statusInvalid)             << ": status fetch of an invalid mask should be false";
+        ASSERT_EQUAL(2901UL, countTicks)           << ": tick range count should have expected value";
+        ASSERT_EQUAL(fields, fieldsTicks)          << ": tick range fields should have expected value";
+        ASSERT_EQUAL(500UL, countIndex)            << ": index range count should have expected value";
+        ASSERT_IS_TRUE(valuesTicks)                << ": tick range columns should hold the input fields";
+        ASSERT_IS_TRUE(valuesIndex)                << ": index range column should hold the input field";
+        ASSERT_IS_TRUE(aligned)                    << ": columns should be aligned";
+        ASSERT_IS_TRUE(unselected)                 << ": unselected columns should be null";
+    }
+
+    TESTCASE("columnar layout stores the fields in datasets of their own")
+    {
+        const char* fileName{ "data_columnar_layout_stores_the_fields_in_datasets_of_their_own.h5" };
+        bool statusAdd{ true }, statusDelete{ true }, statusFetch{ true }, statusProjection{ true }, statusReopen{ true };
+        bool identical{ true }, identicalReopen{ true }, identicalProjection{ true }, contentTree{ true };
+        for (const CompressionCodec codec : { CompressionCodec::Deflate, CompressionCodec::TimeSeries })
+        {
+            remove(fileName);
+
+            // Appended, merged and prepended items, then a deleted range, exercise every path writing the field datasets.
+            std::vector<Quote> base, middle, head;
+            for (long long i = 1; i <= 3000; ++i)
+                base.push_back({ i * 10L, 100.0 + static_cast<double>(i) / 100.0, 99.0 + static_cast<double>(i) / 100.0, static_cast<double>(i % 13), static_cast<double>(i % 17) });
+            for (long long i = 1000; i <= 1100; ++i)
+                middle.push_back({ i * 10L + 5L, 200.0 + static_cast<double>(i), 199.0 + static_cast<double>(i), 1.0, 2.0 });
+            for (long long i = 1; i <= 5; ++i)
+                head.push_back({ i, 50.0 + static_cast<double>(i), 49.0 + static_cast<double>(i), 3.0, 4.0 });
+            std::vector<Quote> expected(base);
+            expected.insert(expected.end(), middle.begin(), middle.end());
+            expected.insert(expected.end(), head.begin(), head.end());
+            std::sort(expected.begin(), expected.end(), [](const Quote& a, const Quote& b) { return a.ticks_ < b.ticks_; });
+            expected.erase(expected.begin() + 2000, expected.begin() + 2100);
+
+            const auto equal = [&expected](const std::shared_ptr<QuoteData>& data)
+            {
+                std::vector<Quote> fetched;
+                const bool status = data->fetchAll([&fetched](const Quote* ptr, const hsize_t cnt) noexcept { fetched.insert(fetched.end(), ptr, ptr + cnt); });
+                return status && fetched.size() == expected.size() && std::equal(fetched.begin(), fetched.end(), expected.begin(),
+                    [](const Quote& a, const Quote& b) { return a.ticks_ == b.ticks_ && !a.isDifferent(b); });
+            };
+
+            const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+            const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+            const std::shared_ptr<QuoteData> data = instrument->openQuoteData(true, DatasetCreationOptions{ 1000, 9, true, true, codec, true });
+            statusAdd = statusAdd && data->add(base.data(), base.size(), DuplicateTimeTicks::Fail, false)
+                && data->add(middle.data(), middle.size(), DuplicateTimeTicks::Fail, false) && data->add(head.data(), head.size(), DuplicateTimeTicks::Fail, false);
+            statusDelete = statusDelete && data->deleteIndexRange(2000UL, 2099UL);
+            statusFetch = statusFetch && data->count() == expected.size();
+            identical = identical && equal(data);
+
+            Projection projection;
+            statusProjection = statusProjection && data->fetchIndexRangeProjection(projection, Quote::ticksField | Quote::bidPriceField, 100UL, 2500UL);
+            for (hsize_t i = 0; identicalProjection && i < projection.count(); ++i)
+            {
+                const Quote& q = expected[static_cast<size_t>(i) + 100];
+                identicalProjection = q.ticks_ == projection.ticks()[i] && q.bidPrice_ == projection.column(Quote::bidPriceField)[i];
+            }
+            identicalProjection = identicalProjection && 2500UL == projection.count();
+            data->close();
+            instrument->close();
+            file->close();
+
+            // The layout is detected on opening, whatever the creation options are.
+            const std::shared_ptr<File> fileReopened = File::openReadOnly(fileName);
+            const std::shared_ptr<Instrument> instrumentReopened = fileReopened->openInstrument("/foo/bar");
+            const std::shared_ptr<QuoteData> dataReopened = instrumentReopened->openQuoteData(false);
+            statusReopen = statusReopen && nullptr != dataReopened;
+            identicalReopen = identicalReopen && nullptr != dataReopened && equal(dataReopened);
+            if (nullptr != dataReopened)
+                dataReopened->close();
+            instrumentReopened->close();
+            const std::shared_ptr<m5::GroupInfo> root = fileReopened->contentTree(false);
+            fileReopened->close();
+            const m5::GroupInfo* bar = 1 == root->groupsCount() && 1 == root->groups()[0]->groupsCount() ? root->groups()[0]->groups()[0] : nullptr;
+            contentTree = contentTree && nullptr != bar && 0 == bar->groupsCount() && 1 == bar->datasetsCount() && std::string("q____") == bar->datasets()[0]->name();
+        }
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)           << ": status add should be true";
+        ASSERT_IS_TRUE(statusDelete)        << ": status delete should be true";
+        ASSERT_IS_TRUE(statusFetch)         << ": count should have expected value";
+        ASSERT_IS_TRUE(identical)           << ": fetched items should match the expected ones";
+        ASSERT_IS_TRUE(statusProjection)    << ": status projection should be true";
+        ASSERT_IS_TRUE(identicalProjection) << ": projection columns should match the expected fields";
+        ASSERT_IS_TRUE(statusReopen)        << ": status reopen should be true";
+        ASSERT_IS_TRUE(identicalReopen)     << ": reopened items should match the expected ones";
+        ASSERT_IS_TRUE(contentTree)         << ": content tree should list the columnar data as a data";
+    }
+
+    TESTCASE("zone maps follow the appended, merged and deleted items")
+    {
+        const char* fileName{ "data_zone_maps_follow_the_appended_merged_and_deleted_items.h5" };
+        remove(fileName);
+
+        const auto current = [](const std::shared_ptr<QuoteData>& data)
+        {
+            std::vector<Quote> items;
+            std::vector<m5::DataZone> zones;
+            if (!data->fetchAll([&items](const Quote* ptr, const hsize_t cnt) noexcept { items.insert(items.end(), ptr, ptr + cnt); }) || !data->fetchZones(zones))
+                return false;
+            size_t first = 0;
+            for (const m5::DataZone& zone : zones)
+            {
+                if (0 == zone.count_ || 1000 < zone.count_ || items.size() < first + zone.count_)
+                    return false;
+                const size_t last = first + zone.count_ - 1;
+                bool equal = zone.firstTicks_ == items[first].ticks_ && zone.lastTicks_ == items[last].ticks_;
+                double minimum{ items[first].bidPrice_ }, maximum{ items[first].bidPrice_ }, sum{ 0. };
+                for (size_t i = first; i <= last; ++i)
+                {
+                    minimum = std::min(minimum, items[i].bidPrice_);
+                    maximum = std::max(maximum, items[i].bidPrice_);
+                    sum += items[i].bidPrice_;
+                }
+                equal = equal && minimum == zone.minimum_[1] && maximum == zone.maximum_[1] && std::fabs(sum - zone.sum_[1]) < 1e-6 && 0. == zone.sum_[4];
+                if (!equal)
+                    return false;
+                first = last + 1;
+            }
+            return items.size() == first;
+        };
+
+        std::vector<Quote> input, middle, head;
+        for (long long i = 1; i <= 3500; ++i)
+            input.push_back({ i * 10L, 100.0 + static_cast<double>(i % 101), 99.0 + static_cast<double>(i % 97), 1.0, 2.0 });
+        for (long long i = 1000; i <= 1100; ++i)
+            middle.push_back({ i * 10L + 5L, 300.0, static_cast<double>(i % 7), 1.0, 2.0 });
+        for (long long i = 1; i <= 5; ++i)
+            head.push_back({ i, 50.0, 500.0, 1.0, 2.0 });
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<QuoteData> data = instrument->openQuoteData(true, DatasetCreationOptions{ 1000, 9, true, true });
+        const bool statusAppend = data->add(input.data(), 2500, DuplicateTimeTicks::Fail, false) && data->add(input.data() + 2500, 1000, DuplicateTimeTicks::Fail, false);
+        const bool zonesAppend = current(data);
+        const bool statusMerge = data->add(middle.data(), middle.size(), DuplicateTimeTicks::Fail, false) && data->add(head.data(), head.size(), DuplicateTimeTicks::Fail, false);
+        const bool zonesMerge = current(data);
+
+        // The prepended items make a zone of their own, the zones after them move along instead of being rebuilt.
+        std::vector<m5::DataZone> shifted;
+        const bool zonesShifted = data->fetchZones(shifted) && !shifted.empty() && 5UL == shifted.front().count_ && 1000UL == shifted.back().count_ + 500UL;
+        const bool statusDelete = data->deleteIndexRange(1500UL, 2099UL);
+        const bool zonesDelete = current(data);
+        data->close();
+        instrument->close();
+
+        // The zone maps of a data written before them are missing, the writes do not create them and the data builds them on request.
+        const bool statusDrop = file->deleteObject("/foo/bar/q____.zones", false);
+        file->close();
+        const std::shared_ptr<File> fileReadOnly = File::openReadOnly(fileName);
+        const std::shared_ptr<Instrument> instrumentReadOnly = fileReadOnly->openInstrument("/foo/bar");
+        const std::shared_ptr<QuoteData> dataReadOnly = instrumentReadOnly->openQuoteData(false);
+        std::vector<m5::DataZone> zones;
+        const bool zonesMissing = !dataReadOnly->fetchZones(zones) && zones.empty();
+        dataReadOnly->close();
+        instrumentReadOnly->close();
+        fileReadOnly->close();
+        const std::shared_ptr<File> fileRebuilt = File::openReadWrite(fileName, false);
+        const std::shared_ptr<Instrument> instrumentRebuilt = fileRebuilt->openInstrument("/foo/bar");
+        const std::shared_ptr<QuoteData> dataRebuilt = instrumentRebuilt->openQuoteData(false);
+        const Quote appended{ 40000L, 100.0, 99.0, 1.0, 2.0 };
+        const bool zonesNotCreated = dataRebuilt->add(&appended, 1, DuplicateTimeTicks::Fail, false) && !dataRebuilt->fetchZones(zones);
+        const bool zonesRebuilt = dataRebuilt->buildZones() && current(dataRebuilt);
+        dataRebuilt->close();
+        const std::shared_ptr<m5::GroupInfo> root = fileRebuilt->contentTree(false);
+        instrumentRebuilt->close();
+        fileRebuilt->close();
+        const bool hidden = 1 == root->groups()[0]->groups()[0]->datasetsCount();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAppend && statusMerge && statusDelete) << ": status write should be true";
+        ASSERT_IS_TRUE(zonesAppend)                                 << ": zone maps should follow the appended items";
+        ASSERT_IS_TRUE(zonesMerge)                                  << ": zone maps should follow the merged items";
+        ASSERT_IS_TRUE(zonesShifted)                                << ": zone maps after the prepended items should be moved along";
+        ASSERT_IS_TRUE(zonesDelete)                                 << ": zone maps should follow the deleted items";
+        ASSERT_IS_TRUE(statusDrop)                                  << ": status delete zone maps should be true";
+        ASSERT_IS_TRUE(zonesMissing)                                << ": read-only data should have no missing zone maps";
+        ASSERT_IS_TRUE(zonesNotCreated)                             << ": writes should not create the missing zone maps";
+        ASSERT_IS_TRUE(zonesRebuilt)                                << ": writable data should build the missing zone maps on request";
+        ASSERT_IS_TRUE(hidden)                                      << ": content tree should not list the zone maps";
+    }
+
+    TESTCASE("aggregates of a tick range match the reduced items")
+    {
+        const char* fileName{ "data_aggregates_of_a_tick_range_match_the_reduced_items.h5" };
+        remove(fileName);
+
+        const auto close = [](const double a, const double b) { return std::fabs(a - b) <= 1e-9 * std::max(1.0, std::fabs(b)); };
+        std::vector<Trade> trades;
+        std::vector<Quote> quotes;
+        for (long long i = 1; i <= 3500; ++i)
+        {
+            trades.push_back({ i * 10L, 100.0 + static_cast<double>(i % 101), static_cast<double>(1 + i % 7) });
+            quotes.push_back({ i * 10L + (i % 3), 100.0 + static_cast<double>(i % 89), 99.0 + static_cast<double>(i % 83), 1.0, 2.0 });
+        }
+
+        // The ranges start and end inside the chunks, so that the partial chunks are streamed and the whole ones are taken from the zone maps.
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        DatasetCreationOptions columnar{ 1000, 9, true, true };
+        columnar.columnar_ = true;
+        const std::shared_ptr<TradeData> tradeData = instrument->openTradeData(true, DatasetCreationOptions{ 1000, 9, true, true });
+        const std::shared_ptr<QuoteData> quoteData = instrument->openQuoteData(true, columnar);
+        const bool statusAdd = tradeData->add(trades.data(), trades.size(), DuplicateTimeTicks::Fail, false)
+            && quoteData->add(quotes.data(), quotes.size(), DuplicateTimeTicks::Fail, false);
+
+        const size_t first = 499, last = 3209;
+        DataAggregate basic{}, weighted{}, timeWeighted{}, empty{}, misapplied{};
+        const bool statusBasic = tradeData->aggregateTickRange(basic, trades[first].ticks_, trades[last].ticks_,
+            AggregateSpec{ Trade::priceField | Trade::volumeField, false, false });
+        const bool statusWeighted = tradeData->aggregateTickRange(weighted, trades[first].ticks_, trades[last].ticks_,
+            AggregateSpec{ Trade::priceField, true, false });
+        const bool statusTimeWeighted = quoteData->aggregateTickRange(timeWeighted, quotes[first].ticks_, quotes[last].ticks_,
+            AggregateSpec{ Quote::bidPriceField, false, true });
+        const bool statusEmpty = tradeData->aggregateTickRange(empty, 100000L, 200000L, AggregateSpec{ Trade::priceField, true, false });
+        const bool statusMisapplied = quoteData->aggregateTickRange(misapplied, 0L, 0L, AggregateSpec{ 0, true, false });
+        tradeData->close();
+        quoteData->close();
+        instrument->close();
+        file->close();
+        remove(fileName);
+
+        double minimum{ trades[first].price_ }, maximum{ trades[first].price_ }, sum{ 0 }, volume{ 0 }, weightedSum{ 0 }, volumeMaximum{ 0 };
+        double midSum{ 0 }, spreadSum{ 0 }, bidMinimum{ quotes[first].bidPrice_ };
+        for (size_t i = first; i <= last; ++i)
+        {
+            minimum = std::min(minimum, trades[i].price_);
+            maximum = std::max(maximum, trades[i].price_);
+            sum += trades[i].price_;
+            volume += trades[i].volume_;
+            volumeMaximum = std::max(volumeMaximum, trades[i].volume_);
+            weightedSum += trades[i].price_ * trades[i].volume_;
+            bidMinimum = std::min(bidMinimum, quotes[i].bidPrice_);
+            if (i < last)
+            {
+                const double duration = static_cast<double>(quotes[i + 1].ticks_ - quotes[i].ticks_);
+                midSum += 0.5 * (quotes[i].askPrice_ + quotes[i].bidPrice_) * duration;
+                spreadSum += (quotes[i].askPrice_ - quotes[i].bidPrice_) * duration;
+            }
+        }
+        const double span = static_cast<double>(quotes[last].ticks_ - quotes[first].ticks_);
+        const bool matchBasic = last - first + 1 == basic.count_ && trades[first].ticks_ == basic.firstTicks_ && trades[last].ticks_ == basic.lastTicks_
+            && trades[first].price_ == basic.first_[0] && trades[last].volume_ == basic.last_[1]
+            && minimum == basic.minimum_[0] && maximum == basic.maximum_[0] && close(basic.sum_[0], sum)
+            && volumeMaximum == basic.maximum_[1] && close(basic.sum_[1], volume) && 0. == basic.volumeWeightedPrice_;
+        const bool matchWeighted = close(weighted.volumeWeightedPrice_, weightedSum / volume) && close(weighted.sum_[0], sum) && 0. == weighted.sum_[1];
+        const bool matchTimeWeighted = last - first + 1 == timeWeighted.count_ && bidMinimum == timeWeighted.minimum_[1]
+            && close(timeWeighted.timeWeightedMid_, midSum / span) && close(timeWeighted.timeWeightedSpread_, spreadSum / span);
+
+        ASSERT_IS_TRUE(statusAdd)                          << ": status add should be true";
+        ASSERT_IS_TRUE(statusBasic && matchBasic)          << ": minimum, maximum and sum should match the reduced items";
+        ASSERT_IS_TRUE(statusWeighted && matchWeighted)    << ": volume-weighted price should match the reduced items";
+        ASSERT_IS_TRUE(statusTimeWeighted && matchTimeWeighted) << ": time-weighted mid price and spread should match the reduced items";
+        ASSERT_IS_TRUE(statusEmpty && 0 == empty.count_)   << ": aggregates of an empty range should be empty";
+        ASSERT_IS_FALSE(statusMisapplied)                  << ": volume-weighted price of quotes should fail";
+    }
+
+    TESTCASE("fetch where passes only the matching items and skips the excluded chunks")
+    {
+        const char* fileName{ "data_fetch_where_passes_only_the_matching_items_and_skips_the_excluded_chunks.h5" };
+        remove(fileName);
+
+        // The prices rise by ten every chunk, so the zone maps exclude all chunks but one from a price band.
+        std::vector<Trade> trades;
+        std::vector<Quote> quotes;
+        for (long long i = 0; i < 5000; ++i)
+        {
+            trades.push_back({ (i + 1) * 10L, 100.0 + static_cast<double>(i / 1000 * 10 + i % 7), static_cast<double>(1 + i % 50) });
+            quotes.push_back({ (i + 1) * 10L, 100.0 + static_cast<double>(i % 5) * 0.5, 99.5 - static_cast<double>(i % 3) * 0.5, 1.0, 2.0 });
+        }
+        const size_t first = 500, last = 4800;
+        const DataPredicate band{ { { Trade::volumeField, 0, PredicateComparison::Greater, 40. }, { Trade::priceField, 0, PredicateComparison::Between, 120., 129. } } };
+        const DataPredicate spread{ { { Quote::askPriceField, Quote::bidPriceField, PredicateComparison::GreaterOrEqual, 1.5 } } };
+        const DataPredicate ticks{ { { Trade::ticksField, 0, PredicateComparison::Greater, 0. } } };
+        std::vector<Trade> expectedTrades, fetchedTrades, fetchedAll;
+        std::vector<Quote> expectedQuotes, fetchedQuotes;
+        for (size_t i = first; i <= last; ++i)
+        {
+            if (trades[i].volume_ > 40. && trades[i].price_ >= 120. && trades[i].price_ <= 129.)
+                expectedTrades.push_back(trades[i]);
+            if (quotes[i].askPrice_ - quotes[i].bidPrice_ >= 1.5)
+                expectedQuotes.push_back(quotes[i]);
+        }
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<TradeData> tradeData = instrument->openTradeData(true, DatasetCreationOptions{ 1000, 9, true, true });
+        const std::shared_ptr<QuoteData> quoteData = instrument->openQuoteData(true, DatasetCreationOptions{ 1000, 9, true, true });
+        const bool statusAdd = tradeData->add(trades.data(), trades.size(), DuplicateTimeTicks::Fail, false)
+            && quoteData->add(quotes.data(), quotes.size(), DuplicateTimeTicks::Fail, false);
+        tradeData->resetReadStatistics();
+        const bool statusBand = tradeData->fetchTickRangeWhere([&fetchedTrades](const Trade* ptr, const hsize_t cnt) noexcept { fetchedTrades.insert(fetchedTrades.end(), ptr, ptr + cnt); },
+            trades[first].ticks_, trades[last].ticks_, band);
+        const hsize_t chunks = tradeData->readStatistics().chunks_;
+        const bool statusSpread = quoteData->fetchTickRangeWhere([&fetchedQuotes](const Quote* ptr, const hsize_t cnt) noexcept { fetchedQuotes.insert(fetchedQuotes.end(), ptr, ptr + cnt); },
+            quotes[first].ticks_, quotes[last].ticks_, spread);
+        const bool statusAll = tradeData->fetchTickRangeWhere([&fetchedAll](const Trade* ptr, const hsize_t cnt) noexcept { fetchedAll.insert(fetchedAll.end(), ptr, ptr + cnt); },
+            trades[first].ticks_, trades[last].ticks_, DataPredicate{});
+        const bool statusTicks = tradeData->fetchTickRangeWhere([](const Trade*, const hsize_t) noexcept {}, 0L, 0L, ticks);
+        tradeData->close();
+        quoteData->close();
+        instrument->close();
+        file->close();
+        remove(fileName);
+
+        const auto sameTrades = [](const std::vector<Trade>& a, const std::vector<Trade>& b)
+        {
+            return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+                [](const Trade& x, const Trade& y) { return x.ticks_ == y.ticks_ && x.price_ == y.price_ && x.volume_ == y.volume_; });
+        };
+        const bool matchQuotes = expectedQuotes.size() == fetchedQuotes.size() && std::equal(expectedQuotes.begin(), expectedQuotes.end(), fetchedQuotes.begin(),
+            [](const Quote& x, const Quote& y) { return x.ticks_ == y.ticks_ && x.askPrice_ == y.askPrice_ && x.bidPrice_ == y.bidPrice_; });
+
+        ASSERT_IS_TRUE(statusAdd)                                                  << ": status add should be true";
+        ASSERT_IS_TRUE(statusBand && !expectedTrades.empty() && sameTrades(expectedTrades, fetchedTrades)) << ": fetched trades should be the matching ones";
+        ASSERT_IS_TRUE(1 == chunks)                                                << ": only the chunk the zone maps do not exclude should be read";
+        ASSERT_IS_TRUE(statusSpread && !expectedQuotes.empty() && matchQuotes)    << ": fetched quotes should be the ones with the matching spread";
+        ASSERT_IS_TRUE(statusAll && sameTrades(std::vector<Trade>(trades.begin() + first, trades.begin() + last + 1), fetchedAll)) << ": predicate without terms should match every item";
+        ASSERT_IS_FALSE(statusTicks)                                               << ": predicate comparing the ticks should fail";
+    }
+
+    TESTCASE("downsampled fetch chooses the items in a single pass over the pages")
+    {
+        const char* fileName{ "data_downsampled_fetch_chooses_the_items_in_a_single_pass_over_the_pages.h5" };
+        remove(fileName);
+
+        // A slow wave with a single spike, read in pages of a few hundred items.
+        std::vector<Scalar> input;
+        for (long long i = 0; i < 10000; ++i)
+            input.push_back({ (i + 1) * 10L, 3777 == i ? 1000.0 : std::sin(static_cast<double>(i) / 500.0) });
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true, DatasetCreationOptions{ 1000, 9, true, true });
+        const bool statusAdd = data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+        data->setMaximumReadBufferBytes(300 * sizeof(Scalar));
+        const auto fetch = [&data](std::vector<Scalar>& items, const long long from, const long long to, const hsize_t targetPoints, const DownsamplingMethod method)
+        {
+            return data->fetchDownsampled([&items](const Scalar* ptr, const hsize_t cnt) noexcept { items.insert(items.end(), ptr, ptr + cnt); }, from, to, targetPoints, method);
+        };
+        std::vector<Scalar> nth, envelope, triangles, few, invalid;
+        const bool statusNth = fetch(nth, 0L, 0L, 1000, DownsamplingMethod::EveryNth);
+        const bool statusEnvelope = fetch(envelope, 0L, 0L, 200, DownsamplingMethod::MinMaxEnvelope);
+        const bool statusTriangles = fetch(triangles, 0L, 0L, 100, DownsamplingMethod::LargestTriangleThreeBuckets);
+        const bool statusFew = fetch(few, input[100].ticks_, input[149].ticks_, 100, DownsamplingMethod::LargestTriangleThreeBuckets);
+        const bool statusInvalid = fetch(invalid, 0L, 0L, 2, DownsamplingMethod::LargestTriangleThreeBuckets);
+        data->close();
+        instrument->close();
+        file->close();
+        remove(fileName);
+
+        const auto ordered = [](const std::vector<Scalar>& items)
+        {
+            return items.end() == std::adjacent_find(items.begin(), items.end(), [](const Scalar& a, const Scalar& b) { return a.ticks_ >= b.ticks_; });
+        };
+        const auto contains = [](const std::vector<Scalar>& items, const long long ticks)
+        {
+            return std::any_of(items.begin(), items.end(), [ticks](const Scalar& item) { return ticks == item.ticks_; });
+        };
+        bool matchNth = 1000 == nth.size();
+        for (size_t i = 0; matchNth && i < nth.size(); ++i)
+            matchNth = input[i * 10].ticks_ == nth[i].ticks_;
+        const auto lowest = std::min_element(input.begin(), input.end(), [](const Scalar& a, const Scalar& b) { return a.value_ < b.value_; });
+        const bool matchEnvelope = 200 >= envelope.size() && 100 < envelope.size() && ordered(envelope) && contains(envelope, input[3777].ticks_) && contains(envelope, lowest->ticks_);
+        const bool matchTriangles = 100 == triangles.size() && ordered(triangles) && input.front().ticks_ == triangles.front().ticks_
+            && input.back().ticks_ == triangles.back().ticks_ && contains(triangles, input[3777].ticks_);
+        const bool matchFew = 50 == few.size() && input[100].ticks_ == few.front().ticks_ && input[149].ticks_ == few.back().ticks_;
+
+        ASSERT_IS_TRUE(statusAdd)                       << ": status add should be true";
+        ASSERT_IS_TRUE(statusNth && matchNth)           << ": every n-th item should be fetched";
+        ASSERT_IS_TRUE(statusEnvelope && matchEnvelope) << ": envelope should hold the extremes in order";
+        ASSERT_IS_TRUE(statusTriangles && matchTriangles) << ": largest triangles should hold the ends and the spike in order";
+        ASSERT_IS_TRUE(statusFew && matchFew)           << ": all items of a range shorter than the target should be fetched";
+        ASSERT_IS_FALSE(statusInvalid)                  << ": largest triangles of two points should fail";
+    }
+
+    // ---------------------------------------------------------------------------
+    // Cursor
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("cursor yields chunk-aligned pages of a range in order")
+    {
+        const char* fileName{ "data_cursor_yields_chunk_aligned_pages_of_a_range_in_order.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+        std::vector<Scalar> input;
+        for (long long i = 1; i <= 50000; ++i)
+            input.push_back({ i * 10L, static_cast<double>(i) });
+        const bool statusAdd = data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+
+        const auto scan = [](const std::shared_ptr<ScalarCursor>& cursor, std::vector<hsize_t>& pageIndices, std::vector<hsize_t>& pageCounts, long long& ticks)
+        {
+            const Scalar* page;
+            hsize_t count;
+            while (cursor->next(page, count))
+            {
+                if (0 == count)
+                    return true;
+                pageIndices.push_back(cursor->index());
+                pageCounts.push_back(count);
+                for (hsize_t i = 0; i < count; ++i, ticks += 10L)
+                    if (ticks != page[i].ticks_ || static_cast<double>(ticks / 10L) != page[i].value_)
+                        return false;
+            }
+            return false;
+        };
+
+        // Pages of a single chunk, the first one ends at the chunk boundary.
+        data->setMaximumReadBufferBytes(0);
+        std::vector<hsize_t> tickIndices, tickCounts;
+        long long tickTicks{ 100010L };
+        const std::shared_ptr<ScalarCursor> tickCursor = data->openTickRangeCursor(100010L, 0L);
+        const bool statusTick = tickCursor && scan(tickCursor, tickIndices, tickCounts, tickTicks);
+
+        // Pages of two chunks.
+        data->setMaximumReadBufferBytes(2 * 20480 * sizeof(Scalar));
+        std::vector<hsize_t> indexIndices, indexCounts;
+        long long indexTicks{ 50010L };
+        const std::shared_ptr<ScalarCursor> indexCursor = data->openIndexRangeCursor(5000UL, 100000UL);
+        const bool statusIndex = indexCursor && scan(indexCursor, indexIndices, indexCounts, indexTicks);
+
+        // Closed after the first page.
+        const Scalar* page;
+        hsize_t countFirst{ 0 }, countClosed{ 99 };
+        const std::shared_ptr<ScalarCursor> closedCursor = data->openIndexRangeCursor(0UL, 50000UL);
+        const bool statusFirst = closedCursor && closedCursor->next(page, countFirst);
+        if (closedCursor)
+            closedCursor->close();
+        const bool statusClosed = closedCursor && closedCursor->next(page, countClosed);
+
+        // Empty ranges.
+        hsize_t countEmpty{ 99 };
+        const std::shared_ptr<ScalarCursor> emptyCursor = data->openTickRangeCursor(600000L, 700000L);
+        const bool statusEmpty = emptyCursor && emptyCursor->next(page, countEmpty);
+        const std::shared_ptr<ScalarCursor> outsideCursor = data->openIndexRangeCursor(50000UL, 1UL);
+
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        const std::vector<hsize_t> expectedTickIndices{ 10000UL, 20480UL, 40960UL };
+        const std::vector<hsize_t> expectedTickCounts{ 10480UL, 20480UL, 9040UL };
+        const std::vector<hsize_t> expectedIndexIndices{ 5000UL, 40960UL };
+        const std::vector<hsize_t> expectedIndexCounts{ 35960UL, 9040UL };
+        ASSERT_IS_TRUE(statusAdd)                           << ": status add should be true";
+        ASSERT_IS_TRUE(statusTick)                          << ": tick range cursor should yield the expected items";
+        ASSERT_IS_TRUE(expectedTickIndices == tickIndices)  << ": tick range cursor pages should start at the expected indices";
+        ASSERT_IS_TRUE(expectedTickCounts == tickCounts)    << ": tick range cursor pages should have the expected counts";
+        ASSERT_EQUAL(500010L, tickTicks)                    << ": tick range cursor should yield all items";
+        ASSERT_IS_TRUE(statusIndex)                         << ": index range cursor should yield the expected items";
+        ASSERT_IS_TRUE(expectedIndexIndices == indexIndices) << ": index range cursor pages should start at the expected indices";
+        ASSERT_IS_TRUE(expectedIndexCounts == indexCounts)  << ": index range cursor pages should have the expected counts";
+        ASSERT_IS_TRUE(statusFirst && statusClosed)         << ": closed cursor should return true";
+        ASSERT_EQUAL(40960UL, countFirst)                   << ": first page should have expected count";
+        ASSERT_EQUAL(0UL, countClosed)                      << ": closed cursor should yield no pages";
+        ASSERT_IS_TRUE(statusEmpty)                         << ": empty cursor should return true";
+        ASSERT_EQUAL(0UL, countEmpty)                       << ": empty cursor should yield no pages";
+        ASSERT_IS_TRUE(nullptr == outsideCursor)            << ": index range cursor outside the data should not open";
+    }
+
+    TESTCASE("fetch last and reverse cursor read the tail of the data")
+    {
+        const char* fileName{ "data_fetch_last_and_reverse_cursor_read_the_tail_of_the_data.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+        std::vector<Scalar> input;
+        for (long long i = 1; i <= 50000; ++i)
+            input.push_back({ i * 10L, static_cast<double>(i) });
+        const bool statusAdd = data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+
+        std::vector<Scalar> last, all;
+        const bool statusLast = data->fetchLast([&last](const Scalar* items, hsize_t count) noexcept { last.insert(last.end(), items, items + count); }, 100UL);
+        const bool statusAll = data->fetchLast([&all](const Scalar* items, hsize_t count) noexcept { all.insert(all.end(), items, items + count); }, 60000UL);
+        hsize_t countNone{ 0 };
+        const bool statusNone = data->fetchLast([&countNone](const Scalar*, hsize_t count) noexcept { countNone += count; }, 0UL);
+
+        // Pages of two chunks, walked from the last one, the first page ends at the end of the range.
+        data->setMaximumReadBufferBytes(2 * 20480 * sizeof(Scalar));
+        std::vector<hsize_t> pageIndices, pageCounts;
+        bool matchPages{ true };
+        const Scalar* page;
+        hsize_t count;
+        const std::shared_ptr<ScalarCursor> cursor = data->openIndexRangeReverseCursor(5000UL, 100000UL);
+        bool statusCursor = nullptr != cursor;
+        while (statusCursor && (statusCursor = cursor->next(page, count)) && 0 < count)
+        {
+            pageIndices.push_back(cursor->index());
+            pageCounts.push_back(count);
+            for (hsize_t i = 0; i < count; ++i)
+                if (input[cursor->index() + i].ticks_ != page[i].ticks_)
+                    matchPages = false;
+        }
+
+        // The tick range of a single chunk.
+        hsize_t tickCount{ 0 };
+        long long tickFirst{ 0 };
+        const std::shared_ptr<ScalarCursor> tickCursor = data->openTickRangeReverseCursor(204810L, 204900L);
+        const bool statusTick = tickCursor && tickCursor->next(page, tickCount) && 0 < tickCount;
+        if (statusTick)
+            tickFirst = page[0].ticks_;
+
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        const std::vector<hsize_t> expectedIndices{ 20480UL, 5000UL };
+        const std::vector<hsize_t> expectedCounts{ 29520UL, 15480UL };
+        const bool matchLast = 100 == last.size() && 499010L == last.front().ticks_ && 500000L == last.back().ticks_;
+        ASSERT_IS_TRUE(statusAdd)                                   << ": status add should be true";
+        ASSERT_IS_TRUE(statusLast && matchLast)                     << ": last items should be fetched in order";
+        ASSERT_IS_TRUE(statusAll && input.size() == all.size())     << ": all items should be fetched when there are fewer of them";
+        ASSERT_IS_TRUE(statusNone && 0UL == countNone)              << ": no items should be fetched for a zero count";
+        ASSERT_IS_TRUE(statusCursor && matchPages)                  << ": reverse cursor should yield the expected items";
+        ASSERT_IS_TRUE(expectedIndices == pageIndices)              << ": reverse cursor pages should start at the expected indices";
+        ASSERT_IS_TRUE(expectedCounts == pageCounts)                << ": reverse cursor pages should have the expected counts";
+        ASSERT_IS_TRUE(statusTick && 10UL == tickCount && 204810L == tickFirst) << ": reverse tick range cursor should yield the range";
+    }
+
+    TESTCASE("cursor keeps its data alive and fails once the data is closed")
+    {
+        const char* fileName{ "data_cursor_keeps_its_data_alive_and_fails_once_the_data_is_closed.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+        std::vector<Scalar> input;
+        for (long long i = 1; i <= 50000; ++i)
+            input.push_back({ i * 10L, static_cast<double>(i) });
+        const bool statusAdd = data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+        data->setMaximumReadBufferBytes(0);
+
+        // The only handle of the data is released while the cursor reads ahead.
+        const std::shared_ptr<ScalarCursor> cursor = data->openIndexRangeCursor(0UL, 50000UL);
+        const std::weak_ptr<ScalarData> released = data;
+        data.reset();
+        const bool aliveReleased = !released.expired();
+        const Scalar* page;
+        hsize_t count, total{ 0 };
+        bool statusReleased = nullptr != cursor;
+        while (statusReleased && (statusReleased = cursor->next(page, count)) && 0 < count)
+            total += count;
+        if (cursor)
+            cursor->close();
+
+        // The data is closed after the first page.
+        data = instrument->openScalarData(DataTimeFrame::Aperiodic, false);
+        if (data)
+            data->setMaximumReadBufferBytes(0);
+        const std::shared_ptr<ScalarCursor> closedCursor = data ? data->openIndexRangeCursor(0UL, 50000UL) : nullptr;
+        hsize_t countFirst{ 0 };
+        const bool statusFirst = closedCursor && closedCursor->next(page, countFirst);
+        if (data)
+            data->close();
+        bool statusClosed{ nullptr != closedCursor };
+        while (statusClosed && (statusClosed = closedCursor->next(page, count)) && 0 < count)
+        {
+        }
+
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)                           << ": status add should be true";
+        ASSERT_IS_TRUE(aliveReleased)                       << ": released data should stay alive while the cursor is open";
+        ASSERT_IS_TRUE(statusReleased)                      << ": cursor over released data should yield its items";
+        ASSERT_EQUAL(50000UL, total)                        << ": cursor over released data should yield all items";
+        ASSERT_IS_TRUE(statusFirst && 0 < countFirst)       << ": first page should be read before the data is closed";
+        ASSERT_IS_FALSE(statusClosed)                       << ": cursor over closed data should fail";
+    }
+
+    // ---------------------------------------------------------------------------
+    // Segmented layout
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("segmented data splices prepends, inserts and deletes without rewriting the tail")
+    {
+        const char* fileName{ "data_segmented_data_splices_prepends_inserts_and_deletes_without_rewriting_the_tail.h5" };
+        remove(fileName);
+
+        DatasetCreationOptions options{ 100, 1, true, true };
+        options.segmented_ = true;
+        std::vector<Scalar> input, prepended, inserted, expected;
+        for (long long i = 100; i < 1100; ++i)
+            input.push_back({ i * 10L, static_cast<double>(i) });
+        for (long long i = 1; i <= 50; ++i)
+            prepended.push_back({ i * 10L, static_cast<double>(i) });
+        for (long long i = 300; i < 310; ++i)
+            inserted.push_back({ i * 10L + 5L, static_cast<double>(-i) });
+        expected.insert(expected.end(), prepended.begin(), prepended.end());
+        expected.insert(expected.end(), input.begin(), input.end());
+        expected.insert(expected.end(), inserted.begin(), inserted.end());
+        std::sort(expected.begin(), expected.end(), [](const Scalar& a, const Scalar& b) { return a.ticks_ < b.ticks_; });
+        expected.erase(expected.begin() + 1000, expected.begin() + 1020);
+        const auto fetch = [](const std::shared_ptr<ScalarData>& data, std::vector<Scalar>& fetched)
+        {
+            fetched.clear();
+            return data->fetchAll([&fetched](const Scalar* items, hsize_t count) noexcept { fetched.insert(fetched.end(), items, items + count); });
+        };
+        const auto match = [&expected](const std::vector<Scalar>& fetched)
+        {
+            if (expected.size() != fetched.size())
+                return false;
+            for (size_t i = 0; i < expected.size(); ++i)
+                if (expected[i].ticks_ != fetched[i].ticks_ || expected[i].value_ != fetched[i].value_)
+                    return false;
+            return true;
+        };
+
+        std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true, options);
+        const bool statusAdd = data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false)
+            && data->add(prepended.data(), prepended.size(), DuplicateTimeTicks::Fail, false)
+            && data->add(inserted.data(), inserted.size(), DuplicateTimeTicks::Fail, false)
+            && data->deleteIndexRange(1000UL, 1019UL);
+        std::vector<DataSegment> segments;
+        const bool statusSegments = data->fetchSegments(segments);
+        hsize_t index{ 0 };
+        bool matchIndex{ false };
+        const bool statusIndex = data->ticksIndex(3035L, index, matchIndex);
+        std::vector<Scalar> fetched;
+        const bool statusFetch = fetch(data, fetched);
+        const bool matchFetch = match(fetched);
+        const hsize_t countSpliced = data->count();
+        data->close();
+        instrument->close();
+
+        // The segments are mapped by their absolute paths, which follow a moved instrument.
+        const bool statusMove = file->moveInstrument("/foo/bar", "/baz");
+        file->close();
+        file = File::openReadWrite(fileName, false);
+        instrument = file->openInstrument("/baz", false);
+        data = instrument->openScalarData(DataTimeFrame::Aperiodic, false);
+        const bool statusReopen = nullptr != data && fetch(data, fetched);
+        const bool matchReopen = match(fetched);
+        hsize_t datasetCount{ 0 };
+        const bool statusEnumerate = file->enumerateDatasets([&datasetCount](const DataInfo&) noexcept { ++datasetCount; }, false);
+
+        std::vector<DataSegment> compacted;
+        const bool statusCompact = nullptr != data && data->compact(100000UL) && data->fetchSegments(compacted);
+        const Scalar appended{ 20000L, 2000.0 };
+        expected.push_back(appended);
+        const bool statusAppend = nullptr != data && data->add(&appended, 1UL, DuplicateTimeTicks::Fail, false) && fetch(data, fetched);
+        const bool matchCompact = match(fetched);
+        if (nullptr != data)
+            data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)                                       << ": status add should be true";
+        ASSERT_IS_TRUE(statusSegments && 5 == segments.size())          << ": prepend, insert and delete should splice segments in";
+        ASSERT_IS_TRUE(0UL == segments.front().offset_ && 50UL == segments.front().count_) << ": prepended items should make the first segment";
+        ASSERT_IS_TRUE(statusIndex && matchIndex && 257UL == index)     << ": ticks index should span the segments";
+        ASSERT_IS_TRUE(statusFetch && matchFetch)                       << ": spliced items should be fetched as a single series";
+        ASSERT_IS_TRUE(expected.size() - 1 == countSpliced)             << ": count should span the segments";
+        ASSERT_IS_TRUE(statusMove && statusReopen && matchReopen)       << ": segments should be read after the instrument is moved";
+        ASSERT_IS_TRUE(statusEnumerate && 1UL == datasetCount)          << ": segment datasets should not be enumerated";
+        ASSERT_IS_TRUE(statusCompact && 1 == compacted.size())          << ": compact should coalesce the small segments";
+        ASSERT_IS_TRUE(statusAppend && matchCompact)                    << ": compacted data should keep the items and take appends";
+    }
+
+    TESTCASE("data open while its instrument is moved creates its datasets at the new path")
+    {
+        const char* fileName{ "data_data_open_while_its_instrument_is_moved_creates_its_datasets_at_the_new_path.h5" };
+        remove(fileName);
+
+        DatasetCreationOptions options{ 100, 1, true, true };
+        options.zoneMaps_ = false;
+        options.segmented_ = true;
+        DatasetCreationOptions columnarOptions{ 100, 1, true, true };
+        columnarOptions.zoneMaps_ = false;
+        columnarOptions.columnar_ = true;
+        std::vector<Scalar> input, prepended;
+        for (long long i = 100; i < 1100; ++i)
+            input.push_back({ i * 10L, static_cast<double>(i) });
+        for (long long i = 1; i <= 50; ++i)
+            prepended.push_back({ i * 10L, static_cast<double>(i) });
+
+        std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true, options);
+        std::shared_ptr<ScalarData> columnar = instrument->openScalarData(DataTimeFrame::Second1, true, columnarOptions);
+        const bool statusAdd = data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false)
+            && columnar->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+
+        // The zone maps and the segments are created next to the datasets, wherever they are now.
+        const bool statusMove = file->moveInstrument("/foo/bar", "/baz");
+        const bool statusZones = data->buildZones() && columnar->buildZones();
+        const bool statusSplice = data->deleteIndexRange(0UL, 99UL) && data->add(prepended.data(), prepended.size(), DuplicateTimeTicks::Fail, false);
+        std::vector<DataSegment> segments;
+        const bool statusSegments = data->fetchSegments(segments);
+        const bool matchSegments = 2 == segments.size() && std::all_of(segments.begin(), segments.end(), [](const DataSegment& segment) { return 0 == segment.datasetPath_.rfind("/baz/", 0); });
+        const bool statusCompact = data->compact(100000UL);
+        data->close();
+        columnar->close();
+        instrument->close();
+        file->close();
+
+        file = File::openReadOnly(fileName);
+        instrument = file->openInstrument("/baz", false);
+        data = nullptr != instrument ? instrument->openScalarData(DataTimeFrame::Aperiodic, false) : nullptr;
+        columnar = nullptr != instrument ? instrument->openScalarData(DataTimeFrame::Second1, false) : nullptr;
+        std::vector<m5::DataZone> zones, columnarZones;
+        const bool statusReopen = nullptr != data && nullptr != columnar && data->fetchZones(zones) && columnar->fetchZones(columnarZones);
+        const hsize_t count = nullptr != data ? data->count() : 0;
+        hsize_t datasetCount{ 0 };
+        const bool statusEnumerate = file->enumerateDatasets([&datasetCount](const DataInfo&) noexcept { ++datasetCount; }, false);
+        if (nullptr != data)
+            data->close();
+        if (nullptr != columnar)
+            columnar->close();
+        if (nullptr != instrument)
+            instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)                                       << ": status add should be true";
+        ASSERT_IS_TRUE(statusMove)                                      << ": status move should be true";
+        ASSERT_IS_TRUE(statusZones)                                     << ": zone maps should be built after the move";
+        ASSERT_IS_TRUE(statusSplice)                                    << ": trim and prepend should splice segments after the move";
+        ASSERT_IS_TRUE(statusSegments && matchSegments)                 << ": segments should be created at the new path";
+        ASSERT_IS_TRUE(statusCompact)                                   << ": compact should create its segment at the new path";
+        ASSERT_IS_TRUE(statusReopen && !zones.empty() && !columnarZones.empty()) << ": zone maps should be found at the new path";
+        ASSERT_EQUAL(950UL, count)                                      << ": spliced items should be found at the new path";
+        ASSERT_IS_TRUE(statusEnumerate && 2UL == datasetCount)          << ": no datasets should be left at the old path";
+    }
+
+    TESTCASE("trimming the head of a data opened segmented maps the rows after it until the compaction")
+    {
+        const char* fileName{ "data_trimming_the_head_of_a_data_opened_segmented_maps_the_rows_after_it_until_the_compaction.h5" };
+        remove(fileName);
+
+        DatasetCreationOptions options{ 100, 1, true, true };
+        std::vector<Scalar> input;
+        for (long long i = 1; i <= 1000; ++i)
+            input.push_back({ i * 10L, static_cast<double>(i) });
+        const auto fetch = [](const std::shared_ptr<ScalarData>& data, const std::vector<Scalar>& expected, const hsize_t first)
+        {
+            std::vector<Scalar> fetched;
+            return data->fetchAll([&fetched](const Scalar* items, hsize_t count) noexcept { fetched.insert(fetched.end(), items, items + count); })
+                && expected.size() - first == fetched.size() && std::equal(fetched.begin(), fetched.end(), expected.begin() + static_cast<std::ptrdiff_t>(first),
+                    [](const Scalar& a, const Scalar& b) { return a.ticks_ == b.ticks_ && a.value_ == b.value_; });
+        };
+
+        std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+
+        // The data opened without the segmented option keeps its dataset, the trim moves its head past the trimmed rows.
+        std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Second1, true, options);
+        std::vector<DataSegment> segments;
+        const bool statusKept = data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false) && data->deleteAllBeforeIndex(199UL)
+            && data->fetchSegments(segments) && fetch(data, input, 200);
+        const bool matchKept = 1 == segments.size() && 200UL == segments.front().rowOffset_ && 800UL == segments.front().count_
+            && std::string::npos == segments.front().datasetPath_.find(".segment.");
+        data->close();
+
+        // The existing data opened with the segmented option switches to the segmented layout when its head is trimmed.
+        data = instrument->openScalarData(DataTimeFrame::Aperiodic, true, options);
+        const bool statusAdd = data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+        data->close();
+        DatasetCreationOptions segmentedOptions{ options };
+        segmentedOptions.segmented_ = true;
+        data = instrument->openScalarData(DataTimeFrame::Aperiodic, false, segmentedOptions);
+
+        // A chunk-aligned trim drops the leading zone maps, the rest of the rows stays where it is.
+        const bool statusAligned = data->deleteAllBeforeIndex(199UL);
+        std::vector<m5::DataZone> zones;
+        const bool statusSegments = data->fetchSegments(segments) && data->fetchZones(zones);
+        hsize_t index{ 0 };
+        bool match{ false };
+        const bool statusIndex = data->ticksIndex(3000L, index, match);
+        const bool matchAligned = 800UL == data->count() && 2010L == data->firstTicks() && fetch(data, input, 200);
+        const bool matchSegments = 1 == segments.size() && 200UL == segments.front().rowOffset_ && 800UL == segments.front().count_;
+        const bool matchZones = 8 == zones.size() && 2010L == zones.front().firstTicks_ && 100UL == zones.front().count_;
+
+        // An unaligned trim rebuilds the zone maps.
+        const bool statusUnaligned = data->deleteAllBeforeTick(2500L);
+        const bool matchUnaligned = data->fetchZones(zones) && 8 == zones.size() && 2510L == zones.front().firstTicks_ && fetch(data, input, 250);
+        data->close();
+        instrument->close();
+        file->close();
+
+        // The trim is persisted, the appended items follow the mapped rows.
+        file = File::openReadWrite(fileName, false);
+        instrument = file->openInstrument("/foo/bar", false);
+        data = instrument->openScalarData(DataTimeFrame::Aperiodic, false);
+        const Scalar appended{ 20000L, 2000.0 };
+        input.push_back(appended);
+        const bool statusReopen = data->add(&appended, 1UL, DuplicateTimeTicks::Fail, false) && 751UL == data->count() && fetch(data, input, 250);
+
+        // The compaction rewrites the mapped rows without the trimmed ones.
+        std::vector<DataSegment> compacted;
+        const bool statusCompact = data->compact(0UL) && data->fetchSegments(compacted) && fetch(data, input, 250);
+        const bool matchCompact = 1 == compacted.size() && 0UL == compacted.front().rowOffset_ && 751UL == compacted.front().count_;
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusKept && matchKept)                         << ": trim without the segmented option should keep the dataset";
+        ASSERT_IS_TRUE(statusAdd)                                       << ": status add should be true";
+        ASSERT_IS_TRUE(statusAligned && matchAligned)                   << ": trimmed data should start after the trimmed items";
+        ASSERT_IS_TRUE(statusSegments && matchSegments)                 << ": trimmed rows should be skipped by the mapping";
+        ASSERT_IS_TRUE(matchZones)                                      << ": zone maps of the trimmed chunks should be dropped";
+        ASSERT_IS_TRUE(statusIndex && match && 99UL == index)           << ": ticks index should honour the trim";
+        ASSERT_IS_TRUE(statusUnaligned && matchUnaligned)               << ": unaligned trim should rebuild the zone maps";
+        ASSERT_IS_TRUE(statusReopen)                                    << ": trim should be persisted";
+        ASSERT_IS_TRUE(statusCompact && matchCompact)                   << ": compaction should reclaim the trimmed rows";
+    }
+
+    TESTCASE("trimming the head of a data opened with the default options rewrites no row until the compaction")
+    {
+        const char* fileName{ "data_trimming_the_head_of_a_data_opened_with_the_default_options_rewrites_no_row_until_the_compaction.h5" };
+        remove(fileName);
+
+        DatasetCreationOptions options{ 100, 1, true, true };
+        std::vector<Scalar> input;
+        for (long long i = 1; i <= 1000; ++i)
+            input.push_back({ i * 10L, static_cast<double>(i) });
+        const auto fetch = [](const std::shared_ptr<ScalarData>& data, const std::vector<Scalar>& expected, const hsize_t first)
+        {
+            std::vector<Scalar> fetched;
+            return data->fetchAll([&fetched](const Scalar* items, hsize_t count) noexcept { fetched.insert(fetched.end(), items, items + count); })
+                && expected.size() - first == fetched.size() && std::equal(fetched.begin(), fetched.end(), expected.begin() + static_cast<std::ptrdiff_t>(first),
+                    [](const Scalar& a, const Scalar& b) { return a.ticks_ == b.ticks_ && a.value_ == b.value_; });
+        };
+        const auto head = [](const std::shared_ptr<ScalarData>& data, hsize_t& rowOffset)
+        {
+            std::vector<DataSegment> segments;
+            const bool status = data->fetchSegments(segments) && 1 == segments.size() && std::string::npos == segments.front().datasetPath_.find(".segment.");
+            rowOffset = status ? segments.front().rowOffset_ : 0UL;
+            return status;
+        };
+
+        std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true, options);
+        std::shared_ptr<ScalarData> other = instrument->openScalarData(DataTimeFrame::Aperiodic, false, options);
+        const bool statusAdd = data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false) && data->buildZones() && 1000UL == other->count();
+
+        // The trim moves the head of the dataset past the trimmed rows, the rows after them stay where they are.
+        hsize_t rowOffset{ 0 };
+        const bool statusTrim = data->deleteAllBeforeIndex(249UL) && head(data, rowOffset);
+        const bool matchTrim = 250UL == rowOffset && 750UL == data->count() && 2510L == data->firstTicks() && 10000L == data->lastTicks() && fetch(data, input, 250);
+
+        // Every read path takes the items past the head.
+        hsize_t index{ 0 };
+        bool match{ false };
+        std::vector<Scalar> range;
+        const bool statusRange = data->ticksIndex(3000L, index, match)
+            && data->fetchIndexRange([&range](const Scalar* items, hsize_t count) noexcept { range.insert(range.end(), items, items + count); }, 10UL, 5UL);
+        const bool matchRange = match && 49UL == index && 5 == range.size() && 2610L == range.front().ticks_;
+        Projection projection;
+        m5::DataAggregate aggregate;
+        AggregateSpec spec;
+        spec.fields_ = Scalar::valueField;
+        const bool statusProjection = data->fetchIndexRangeProjection(projection, Scalar::ticksField | Scalar::valueField, 0UL, 750UL)
+            && data->aggregateTickRange(aggregate, 0L, 20000L, spec);
+        const bool matchProjection = 750UL == projection.count() && 2510L == projection.ticks()[0] && 1000.0 == projection.column(Scalar::valueField)[749]
+            && 750UL == aggregate.count_ && 469125.0 == aggregate.sum_[0];
+        std::vector<m5::DataZone> zones;
+        hsize_t cursorCount{ 0 };
+        long long cursorFirst{ 0L };
+        std::shared_ptr<ScalarCursor> cursor = data->openIndexRangeCursor(0UL, 750UL);
+        const Scalar* page;
+        hsize_t pageCount;
+        while (nullptr != cursor && cursor->next(page, pageCount) && 0 < pageCount)
+        {
+            if (0 == cursorCount)
+                cursorFirst = page->ticks_;
+            cursorCount += pageCount;
+        }
+        const bool matchZones = data->fetchZones(zones) && !zones.empty() && 2510L == zones.front().firstTicks_ && 750UL == cursorCount && 2510L == cursorFirst;
+
+        // Another handle of the data follows the head, also when the count is the same as before the trim.
+        std::vector<Scalar> appended;
+        for (long long i = 1001; i <= 1250; ++i)
+            appended.push_back({ i * 10L, static_cast<double>(i) });
+        input.insert(input.end(), appended.begin(), appended.end());
+        const bool statusOther = data->add(appended.data(), appended.size(), DuplicateTimeTicks::Fail, false)
+            && 1000UL == other->count() && 2510L == other->firstTicks() && 12500L == other->lastTicks();
+
+        // The items prepended or inserted go past the head.
+        const Scalar prepended{ 2505L, 250.5 };
+        const Scalar inserted{ 5005L, 500.5 };
+        input.insert(input.begin() + 250, prepended);
+        input.insert(input.begin() + 501, inserted);
+        const bool statusInsert = data->add(&prepended, 1UL, DuplicateTimeTicks::Fail, false) && data->add(&inserted, 1UL, DuplicateTimeTicks::Fail, false)
+            && head(data, rowOffset) && 250UL == rowOffset && 1002UL == data->count() && fetch(data, input, 250);
+        other->close();
+        data->close();
+        instrument->close();
+        file->close();
+
+        // The head is persisted, the compaction moves the items over the trimmed rows.
+        file = File::openReadWrite(fileName, false);
+        instrument = file->openInstrument("/foo/bar", false);
+        data = instrument->openScalarData(DataTimeFrame::Aperiodic, false);
+        const bool statusReopen = head(data, rowOffset) && 250UL == rowOffset && 1002UL == data->count() && fetch(data, input, 250);
+        const bool statusCompact = data->compact(0UL) && head(data, rowOffset) && 0UL == rowOffset && 1002UL == data->count() && fetch(data, input, 250)
+            && data->ticksIndex(3000L, index, match) && match && 50UL == index;
+
+        // Trimming all items empties the dataset.
+        const bool statusEmpty = data->deleteAllBeforeIndex(99UL) && head(data, rowOffset) && 100UL == rowOffset
+            && data->deleteAllBeforeIndex(901UL) && head(data, rowOffset) && 0UL == rowOffset && 0UL == data->count();
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)                                       << ": status add should be true";
+        ASSERT_IS_TRUE(statusTrim && matchTrim)                         << ": trim should move the head and keep the rows after it";
+        ASSERT_IS_TRUE(statusRange && matchRange)                       << ": ticks index and index ranges should honour the head";
+        ASSERT_IS_TRUE(statusProjection && matchProjection)             << ": projections and aggregates should honour the head";
+        ASSERT_IS_TRUE(matchZones)                                      << ": zone maps and cursors should honour the head";
+        ASSERT_IS_TRUE(statusOther)                                     << ": another handle should follow the head";
+        ASSERT_IS_TRUE(statusInsert)                                    << ": inserted items should go past the head";
+        ASSERT_IS_TRUE(statusReopen)                                    << ": head should be persisted";
+        ASSERT_IS_TRUE(statusCompact)                                   << ": compaction should reclaim the trimmed rows";
+        ASSERT_IS_TRUE(statusEmpty)                                     << ": trimming all items should empty the dataset";
+    }
+
+    // ---------------------------------------------------------------------------
+    // Preallocation
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("preallocated data keeps the item count across small appends")
+    {
+        const char* fileName{ "data_preallocated_data_keeps_the_item_count_across_small_appends.h5" };
+        remove(fileName);
+
+        DatasetCreationOptions options{ 100, 1, true, true };
+        std::vector<Scalar> input;
+        for (long long i = 1; i <= 1000; ++i)
+            input.push_back({ i * 10L, static_cast<double>(i) });
+        const auto fetch = [](const std::shared_ptr<ScalarData>& data, const std::vector<Scalar>& expected)
+        {
+            std::vector<Scalar> fetched;
+            return data->fetchAll([&fetched](const Scalar* items, hsize_t count) noexcept { fetched.insert(fetched.end(), items, items + count); })
+                && expected.size() == fetched.size() && std::equal(fetched.begin(), fetched.end(), expected.begin(),
+                    [](const Scalar& a, const Scalar& b) { return a.ticks_ == b.ticks_ && a.value_ == b.value_; });
+        };
+
+        std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true, options);
+        data->setPreallocate(true);
+        bool statusAppend{ true };
+        for (size_t i = 0; i < input.size(); i += 10)
+            statusAppend = data->add(input.data() + i, 10UL, DuplicateTimeTicks::Fail, false) && statusAppend;
+
+        // The reads stop at the last item, not at the last preallocated row.
+        hsize_t index{ 0 };
+        bool match{ false };
+        const bool statusIndex = data->ticksIndex(10000L, index, match) && match && 999UL == index;
+        const bool matchAppended = 1000UL == data->count() && 10000L == data->lastTicks() && fetch(data, input);
+
+        // The item count kept in memory between the appends growing the dataset is written on a flush.
+        data->flush();
+        std::shared_ptr<File> reader = File::openReadOnly(fileName);
+        std::shared_ptr<Instrument> readerInstrument = nullptr != reader ? reader->openInstrument("/foo/bar", false) : nullptr;
+        std::shared_ptr<ScalarData> readerData = nullptr != readerInstrument ? readerInstrument->openScalarData(DataTimeFrame::Aperiodic, false) : nullptr;
+        const bool matchFlushed = nullptr != readerData && 1000UL == readerData->count() && fetch(readerData, input);
+        if (nullptr != readerData)
+            readerData->close();
+        if (nullptr != readerInstrument)
+            readerInstrument->close();
+        if (nullptr != reader)
+            reader->close();
+
+        // An insert drops the preallocated rows before merging the items.
+        const Scalar inserted{ 15L, 0.5 };
+        input.insert(input.begin() + 1, inserted);
+        const bool statusInsert = data->add(&inserted, 1UL, DuplicateTimeTicks::Fail, false) && 1001UL == data->count() && fetch(data, input);
+
+        // The appends preallocate again, shrinking to fit drops the rows.
+        const Scalar appended{ 20000L, 2000.0 };
+        input.push_back(appended);
+        const bool statusShrink = data->add(&appended, 1UL, DuplicateTimeTicks::Fail, false) && data->shrinkToFit() && 1002UL == data->count() && fetch(data, input);
+        data->close();
+        instrument->close();
+        file->close();
+
+        // The data reopened without preallocation sees the items only.
+        file = File::openReadWrite(fileName, false);
+        instrument = file->openInstrument("/foo/bar", false);
+        data = instrument->openScalarData(DataTimeFrame::Aperiodic, false);
+        const bool matchReopen = !data->preallocate() && 1002UL == data->count() && 20000L == data->lastTicks() && fetch(data, input);
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAppend && matchAppended)                   << ": preallocated data should hold the appended items";
+        ASSERT_IS_TRUE(matchFlushed)                                    << ": flushed item count should be seen by a reader";
+        ASSERT_IS_TRUE(statusIndex)                                     << ": ticks index should honour the item count";
+        ASSERT_IS_TRUE(statusInsert)                                    << ": insert into preallocated data should merge the items";
+        ASSERT_IS_TRUE(statusShrink)                                    << ": shrinking to fit should keep the items";
+        ASSERT_IS_TRUE(matchReopen)                                     << ": item count should be persisted";
+    }
+
+    // ---------------------------------------------------------------------------
+    // Chunk cache
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("chunk cache is derived from the chunk size and the access pattern within the budget")
+    {
+        const char* fileName{ "data_chunk_cache_is_derived_from_the_chunk_size_and_the_access_pattern_within_the_budget.h5" };
+        remove(fileName);
+
+        std::vector<Scalar> input;
+        for (long long i = 1; i <= 5000; ++i)
+            input.push_back({ i * 10L, static_cast<double>(i) });
+        const auto fetch = [&input](const std::shared_ptr<ScalarData>& data)
+        {
+            hsize_t fetched{ 0 };
+            return nullptr != data && data->fetchAll([&fetched](const Scalar*, hsize_t count) noexcept { fetched += count; }) && input.size() == fetched;
+        };
+        const size_t budget = File::chunkCacheBudget();
+        const size_t baseline = File::chunkCacheBytes();
+
+        // A scalar of 16 bytes in chunks of 1000 items makes chunks of 16000 bytes.
+        DatasetCreationOptions sequential{ 1000, 1, true, true };
+        sequential.chunkCacheBytes_ = 0;
+        sequential.chunkCacheSlots_ = 0;
+        sequential.accessPattern_ = m5::DataAccessPattern::Sequential;
+        sequential.zoneMaps_ = false;
+        DatasetCreationOptions random{ sequential };
+        random.accessPattern_ = m5::DataAccessPattern::Random;
+
+        std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        std::shared_ptr<ScalarData> data1 = instrument->openScalarData(DataTimeFrame::Aperiodic, true, sequential);
+        const bool statusAdd = nullptr != data1 && data1->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+        const bool matchDerived = nullptr != data1 && 32000U == data1->chunkCacheBytes() && baseline + 32000U == File::chunkCacheBytes() && fetch(data1);
+
+        // The existing dataset opened with a random access gets the bytes left in the budget.
+        File::setChunkCacheBudget(baseline + 32000U + 100000U);
+        std::shared_ptr<ScalarData> data2 = instrument->openScalarData(DataTimeFrame::Aperiodic, false, random);
+        const bool matchBudget = nullptr != data2 && 100000U == data2->chunkCacheBytes() && baseline + 132000U == File::chunkCacheBytes() && fetch(data2);
+
+        // The spent budget still leaves a chunk, to the derived and to the explicit sizes.
+        std::shared_ptr<ScalarData> data3 = instrument->openScalarData(DataTimeFrame::Aperiodic, false, random);
+        const bool matchSpent = nullptr != data3 && 16000U == data3->chunkCacheBytes() && fetch(data3);
+        std::shared_ptr<ScalarData> data5 = instrument->openScalarData(DataTimeFrame::Aperiodic, false);
+        const bool matchSpentExplicit = nullptr != data5 && 16000U == data5->chunkCacheBytes() && fetch(data5);
+        data5->close();
+        data3->close();
+        data2->close();
+        data1->close();
+        const bool matchReleased = baseline == File::chunkCacheBytes();
+        File::setChunkCacheBudget(budget);
+
+        // The explicit sizes of the default options are kept.
+        std::shared_ptr<ScalarData> data4 = instrument->openScalarData(DataTimeFrame::Aperiodic, false);
+        const bool matchDefault = nullptr != data4 && 16U * 1024U * 1024U == data4->chunkCacheBytes() && fetch(data4);
+        data4->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)                                       << ": status add should be true";
+        ASSERT_IS_TRUE(matchDerived)                                    << ": sequential access cache should hold two chunks";
+        ASSERT_IS_TRUE(matchBudget)                                     << ": random access cache should be capped by the budget";
+        ASSERT_IS_TRUE(matchSpent)                                      << ": spent budget should leave a chunk to the derived cache";
+        ASSERT_IS_TRUE(matchSpentExplicit)                              << ": spent budget should leave a chunk to the explicit cache";
+        ASSERT_IS_TRUE(matchReleased)                                   << ": closed data should return its cache to the budget";
+        ASSERT_IS_TRUE(matchDefault)                                    << ": default options should keep the fixed chunk cache";
+    }
+
+    TESTCASE("chunk cache of the segments and the zone maps of a data is taken from the budget")
+    {
+        const char* fileName{ "data_chunk_cache_of_the_segments_and_the_zone_maps_of_a_data_is_taken_from_the_budget.h5" };
+        remove(fileName);
+
+        std::vector<Scalar> input, prepended;
+        for (long long i = 100; i < 2100; ++i)
+            input.push_back({ i * 10L, static_cast<double>(i) });
+        for (long long i = 1; i <= 50; ++i)
+            prepended.push_back({ i * 10L, static_cast<double>(i) });
+        const size_t baseline = File::chunkCacheBytes();
+
+        // A scalar of 16 bytes in chunks of 1000 items makes chunks of 16000 bytes, a sequential access caches two of them per segment.
+        // The zone maps of 192 bytes in chunks of 256 of them cache two chunks as well.
+        constexpr size_t zonesCacheBytes{ 2U * 256U * 192U };
+        DatasetCreationOptions options{ 1000, 1, true, true };
+        options.chunkCacheBytes_ = 0;
+        options.chunkCacheSlots_ = 0;
+        options.accessPattern_ = m5::DataAccessPattern::Sequential;
+        options.segmented_ = true;
+
+        std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true, options);
+        const bool statusAdd = nullptr != data && data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false)
+            && data->add(prepended.data(), prepended.size(), DuplicateTimeTicks::Fail, false);
+        std::vector<DataSegment> segments;
+        const bool statusSegments = statusAdd && data->fetchSegments(segments);
+        const bool matchSegments = 2 == segments.size() && segments.size() * 32000U + zonesCacheBytes == data->chunkCacheBytes()
+            && baseline + data->chunkCacheBytes() == File::chunkCacheBytes();
+        data->close();
+        const bool matchReleased = baseline == File::chunkCacheBytes();
+
+        // The segments of the reopened data are opened with the cache of its options.
+        data = instrument->openScalarData(DataTimeFrame::Aperiodic, false, options);
+        segments.clear();
+        const bool matchReopen = nullptr != data && data->fetchSegments(segments) && 2 == segments.size() && 64000U == data->chunkCacheBytes();
+        data->close();
+        const bool matchReleasedReopen = baseline == File::chunkCacheBytes();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)                                       << ": status add should be true";
+        ASSERT_IS_TRUE(statusSegments)                                  << ": status fetch segments should be true";
+        ASSERT_IS_TRUE(matchSegments)                                   << ": each segment and the zone maps should have a chunk cache from the budget";
+        ASSERT_IS_TRUE(matchReleased)                                   << ": closed data should return the caches of its segments and zone maps";
+        ASSERT_IS_TRUE(matchReopen)                                     << ": reopened segments should have the cache of the options";
+        ASSERT_IS_TRUE(matchReleasedReopen)                             << ": closed reopened data should return the caches of its segments";
+    }
+
+    // ---------------------------------------------------------------------------
+    // SWMR
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("swmr reader follows the items appended by the writer")
+    {
+        const char* fileName{ "data_swmr_reader_follows_the_items_appended_by_the_writer.h5" };
+        remove(fileName);
+
+        const auto append = [](const std::shared_ptr<ScalarData>& data, const long long from, const long long to)
+        {
+            std::vector<Scalar> input;
+            for (long long i = from; i <= to; ++i)
+                input.push_back({ i * 10L, static_cast<double>(i) });
+            return data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+        };
+        std::vector<hsize_t> followed;
+        long long ticks{ 10L };
+        bool ordered{ true };
+        const m5::CollectScalar collect = [&followed, &ticks, &ordered](const Scalar* items, const hsize_t count) noexcept
+        {
+            followed.back() += count;
+            for (hsize_t i = 0; i < count; ++i, ticks += 10L)
+                ordered = ordered && ticks == items[i].ticks_;
+        };
+
+        const std::shared_ptr<File> writerFile = File::openReadWrite(fileName, true, m5::FileDriver::Sec2, false, true);
+        const std::shared_ptr<Instrument> writerInstrument = writerFile ? writerFile->openInstrument("/foo/bar", true) : nullptr;
+        const std::shared_ptr<ScalarData> writer = writerInstrument ? writerInstrument->openScalarData(DataTimeFrame::Aperiodic, true) : nullptr;
+        const bool statusFirstAdd = writer && append(writer, 1L, 1000L);
+
+        const std::shared_ptr<File> readerFile = File::openReadOnly(fileName, m5::FileDriver::Sec2, true);
+        const std::shared_ptr<Instrument> readerInstrument = readerFile ? readerFile->openInstrument("/foo/bar") : nullptr;
+        const std::shared_ptr<ScalarData> reader = readerInstrument ? readerInstrument->openScalarData(DataTimeFrame::Aperiodic, false) : nullptr;
+        hsize_t index{ 0 };
+        followed.push_back(0);
+        const bool statusFirstFollow = reader && reader->followFrom(index, collect);
+        const hsize_t firstIndex{ index };
+
+        const bool statusSecondAdd = writer && append(writer, 1001L, 1500L);
+        followed.push_back(0);
+        const bool statusSecondFollow = reader && reader->followFrom(index, collect);
+        const hsize_t secondIndex{ index };
+        followed.push_back(0);
+        const bool statusThirdFollow = reader && reader->followFrom(index, collect);
+
+        const bool statusThirdAdd = writer && append(writer, 1501L, 1600L);
+        const bool statusRefresh = reader && reader->refresh();
+        const hsize_t refreshedCount = reader ? reader->count() : 0;
+
+        if (reader)
+            reader->close();
+        if (readerInstrument)
+            readerInstrument->close();
+        if (readerFile)
+            readerFile->close();
+        if (writer)
+            writer->close();
+        if (writerInstrument)
+            writerInstrument->close();
+        if (writerFile)
+            writerFile->close();
+
+        remove(fileName);
+
+        const std::vector<hsize_t> expectedFollowed{ 1000UL, 500UL, 0UL };
+        ASSERT_IS_TRUE(nullptr != writer && nullptr != reader)                  << ": swmr writer and reader should open";
+        ASSERT_IS_TRUE(statusFirstAdd && statusSecondAdd && statusThirdAdd)     << ": status add should be true";
+        ASSERT_IS_TRUE(statusFirstFollow && statusSecondFollow && statusThirdFollow) << ": status follow should be true";
+        ASSERT_IS_TRUE(expectedFollowed == followed)                            << ": follow should fetch only the items appended since the last call";
+        ASSERT_IS_TRUE(ordered)                                                 << ": followed items should be in order";
+        ASSERT_EQUAL(1000UL, firstIndex)                                        << ": index should advance past the first items";
+        ASSERT_EQUAL(1500UL, secondIndex)                                       << ": index should advance past the appended items";
+        ASSERT_EQUAL(1500UL, index)                                             << ": index should not advance without new items";
+        ASSERT_IS_TRUE(statusRefresh)                                           << ": status refresh should be true";
+        ASSERT_EQUAL(1600UL, refreshedCount)                                    << ": refreshed count should include the appended items";
+    }
+
+    // ---------------------------------------------------------------------------
+    // Appender
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("appender writes the queued items in batches")
+    {
+        const char* fileName{ "data_appender_writes_the_queued_items_in_batches.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+        const std::shared_ptr<ScalarAppender> appender = data->openAppender({ 1000, 256, 0, AppenderOverflow::Block, DuplicateTimeTicks::Fail });
+        bool statusAppend{ nullptr != appender };
+        for (long long i = 1; i <= 5000 && statusAppend; ++i)
+            statusAppend = appender->append({ i * 10L, static_cast<double>(i) });
+        const bool statusFlush = appender && appender->flush();
+        const m5::AppenderStatistics statistics = appender ? appender->statistics() : m5::AppenderStatistics{};
+        const hsize_t count = data->count();
+        long long ticks{ 10L };
+        bool ordered{ true };
+        const bool statusFetch = data->fetchAll([&ticks, &ordered](const Scalar* items, const hsize_t itemCount) noexcept
+        {
+            for (hsize_t i = 0; i < itemCount; ++i, ticks += 10L)
+                ordered = ordered && ticks == items[i].ticks_ && static_cast<double>(ticks / 10L) == items[i].value_;
+        });
+
+        // Closed appenders reject the items.
+        if (appender)
+            appender->close();
+        const bool statusClosed = appender && appender->append({ 60000L, 1. });
+        const hsize_t rejected = appender ? appender->statistics().rejected_ : 0;
+
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAppend)                  << ": status append should be true";
+        ASSERT_IS_TRUE(statusFlush)                   << ": status flush should be true";
+        ASSERT_EQUAL(5000UL, count)                   << ": all appended items should be written after the flush";
+        ASSERT_EQUAL(0UL, statistics.queueDepth_)     << ": queue should be empty after the flush";
+        ASSERT_EQUAL(5000UL, statistics.appended_)    << ": all items should be counted as appended";
+        ASSERT_EQUAL(5000UL, statistics.flushed_)     << ": all items should be counted as flushed";
+        ASSERT_EQUAL(0UL, statistics.failed_)         << ": no items should fail";
+        ASSERT_IS_TRUE(20 <= statistics.flushes_)     << ": flushes should write at most 256 items each";
+        ASSERT_IS_TRUE(statistics.maximumFlushMicroseconds_ >= statistics.lastFlushMicroseconds_) << ": maximum flush duration should not be less than the last one";
+        ASSERT_IS_TRUE(statusFetch && ordered)        << ": written items should be in order";
+        ASSERT_IS_FALSE(statusClosed)                 << ": closed appender should reject items";
+        ASSERT_EQUAL(1UL, rejected)                   << ": rejected item should be counted";
+    }
+
+    TESTCASE("appender counts the items queued before a batch overflows")
+    {
+        const char* fileName{ "data_appender_counts_the_items_queued_before_a_batch_overflows.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+        const std::shared_ptr<ScalarAppender> appender = data->openAppender({ 8, 8, 0, AppenderOverflow::Reject, DuplicateTimeTicks::Fail });
+        std::vector<Scalar> items;
+        for (long long i = 1; i <= 1000; ++i)
+            items.push_back({ i * 10L, static_cast<double>(i) });
+
+        // The queue holds fewer items than the batch, the ones queued before it is full are written.
+        const bool statusAppend = appender && appender->append(items.data(), items.size());
+        if (appender)
+            appender->close();
+        const m5::AppenderStatistics statistics = appender ? appender->statistics() : m5::AppenderStatistics{};
+        const hsize_t count = data->count();
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_FALSE(statusAppend)                                   << ": overflowing batch should not be queued entirely";
+        ASSERT_EQUAL(1000UL, statistics.appended_ + statistics.rejected_) << ": every item should be counted as appended or rejected";
+        ASSERT_IS_TRUE(8 <= statistics.appended_)                       << ": items queued before the overflow should be counted";
+        ASSERT_EQUAL(statistics.appended_, statistics.flushed_)         << ": all counted items should be written";
+        ASSERT_EQUAL(statistics.appended_, count)                       << ": written items should match the appended ones";
+    }
+
+    TESTCASE("appender flushes by time and counts failed writes")
+    {
+        const char* fileName{ "data_appender_flushes_by_time_and_counts_failed_writes.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+        const std::shared_ptr<ScalarAppender> appender = data->openAppender({ 1000, 1000, 10, AppenderOverflow::Block, DuplicateTimeTicks::Fail });
+        const Scalar items[]{ { 10L, 1. }, { 20L, 2. }, { 30L, 3. } };
+        const bool statusAppend = appender && appender->append(items, 3);
+
+        // Far less than the flush size, written when the interval elapses.
+        hsize_t flushed{ 0 };
+        for (int i = 0; i < 500 && 3 > flushed; ++i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            flushed = appender ? appender->statistics().flushed_ : 0;
+        }
+
+        // The ticks which do not increase fail the write.
+        const bool statusAppendOld = appender && appender->append({ 20L, 4. });
+        const bool statusFlush = appender && appender->flush();
+        const hsize_t failed = appender ? appender->statistics().failed_ : 0;
+        if (appender)
+            appender->close();
+        const hsize_t count = data->count();
+
+        // Read-only data and zero capacity queues cannot have appenders.
+        const std::shared_ptr<ScalarAppender> zeroCapacity = data->openAppender({ 0, 0, 0, AppenderOverflow::Reject, DuplicateTimeTicks::Fail });
+        data->close();
+        instrument->close();
+        file->close();
+        const std::shared_ptr<File> readOnlyFile = File::openReadOnly(fileName);
+        const std::shared_ptr<Instrument> readOnlyInstrument = readOnlyFile->openInstrument("/foo/bar");
+        const std::shared_ptr<ScalarData> readOnlyData = readOnlyInstrument->openScalarData(DataTimeFrame::Aperiodic, false);
+        const std::shared_ptr<ScalarAppender> readOnly = readOnlyData->openAppender();
+        readOnlyData->close();
+        readOnlyInstrument->close();
+        readOnlyFile->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAppend && statusAppendOld) << ": status append should be true";
+        ASSERT_EQUAL(3UL, flushed)                      << ": queued items should be written when the interval elapses";
+        ASSERT_IS_FALSE(statusFlush)                    << ": status flush should be false after a failed write";
+        ASSERT_EQUAL(1UL, failed)                       << ": failed item should be counted";
+        ASSERT_EQUAL(3UL, count)                        << ": failed item should not be written";
+        ASSERT_IS_TRUE(nullptr == zeroCapacity)         << ": appender with zero capacity should not open";
+        ASSERT_IS_TRUE(nullptr == readOnly)             << ": appender of read-only data should not open";
+    }
+
+    TESTCASE("appender keeps its data alive and fails its flushes once the data is closed")
+    {
+        const char* fileName{ "data_appender_keeps_its_data_alive_and_fails_its_flushes_once_the_data_is_closed.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo/bar", true);
+        std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+
+        // The only handle of the data is released before the queued items are written.
+        const std::shared_ptr<ScalarAppender> appender = data->openAppender({ 1000, 1000, 0, AppenderOverflow::Block, DuplicateTimeTicks::Fail });
+        const std::weak_ptr<ScalarData> released = data;
+        data.reset();
+        const bool aliveReleased = !released.expired();
+        bool statusAppend{ nullptr != appender };
+        for (long long i = 1; i <= 100 && statusAppend; ++i)
+            statusAppend = appender->append({ i * 10L, static_cast<double>(i) });
+        const bool statusFlush = appender && appender->flush();
+        if (appender)
+            appender->close();
+        data = instrument->openScalarData(DataTimeFrame::Aperiodic, false);
+        const hsize_t count = data ? data->count() : 0;
+
+        // The data is closed before the queued items are written.
+        const std::shared_ptr<ScalarAppender> closedAppender = data ? data->openAppender({ 1000, 1000, 0, AppenderOverflow::Block, DuplicateTimeTicks::Fail }) : nullptr;
+        if (data)
+            data->close();
+        const bool statusAppendClosed = closedAppender && closedAppender->append({ 2000L, 1. });
+        const bool statusFlushClosed = closedAppender && closedAppender->flush();
+        const hsize_t failed = closedAppender ? closedAppender->statistics().failed_ : 0;
+        if (closedAppender)
+            closedAppender->close();
+
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(aliveReleased)                   << ": released data should stay alive while the appender is open";
+        ASSERT_IS_TRUE(statusAppend && statusFlush)     << ": appender of released data should write its items";
+        ASSERT_EQUAL(100UL, count)                      << ": items of the released data should be stored";
+        ASSERT_IS_TRUE(statusAppendClosed)              << ": appender of closed data should queue items";
+        ASSERT_IS_FALSE(statusFlushClosed)              << ": appender of closed data should fail to flush";
+        ASSERT_EQUAL(1UL, failed)                       << ": item failed to flush should be counted";
+    }
+
+    // ---------------------------------------------------------------------------
+    // Locking
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("collect callback can access another data without a deadlock")
+    {
+        const char* fileName{ "data_collect_callback_can_access_another_data_without_a_deadlock.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument1 = file->openInstrument("/foo/bar1", true);
+        const std::shared_ptr<Instrument> instrument2 = file->openInstrument("/foo/bar2", true);
+        const std::shared_ptr<ScalarData> data1 = instrument1->openScalarData(DataTimeFrame::Aperiodic, true);
+        const std::shared_ptr<ScalarData> data2 = instrument2->openScalarData(DataTimeFrame::Aperiodic, true);
+        const Scalar input1[]{ {1L, 1.}, {2L, 2.}, {3L, 3.} };
+        const Scalar input2[]{ {7L, 7.}, {8L, 8.} };
+        const bool statusAdd1 = data1->add(input1, 3, DuplicateTimeTicks::Fail, false);
+        const bool statusAdd2 = data2->add(input2, 2, DuplicateTimeTicks::Fail, false);
+
+        long long ticks{ 0L };
+        hsize_t count{ 0UL };
+        const bool statusFetch = data1->fetchAll([&ticks, &count, &data2](const Scalar*, const hsize_t cnt) noexcept
+        {
+            ticks = data2->lastTicks();
+            count += cnt;
+        });
+        data1->close();
+        data2->close();
+        instrument1->close();
+        instrument2->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd1) << ": add should return true";
+        ASSERT_IS_TRUE(statusAdd2) << ": add should return true";
+        ASSERT_IS_TRUE(statusFetch) << ": fetchAll should return true";
+        ASSERT_EQUAL(3UL, count) << ": fetchAll should collect all items";
+        ASSERT_EQUAL(8L, ticks) << ": last ticks of another data should be available within the callback";
+    }
+
+    TESTCASE("concurrent readers of different data fetch all items")
+    {
+        const char* fileName{ "data_concurrent_readers_of_different_data_fetch_all_items.h5" };
+        remove(fileName);
+
+        constexpr int threadCount{ 4 };
+        constexpr hsize_t itemCount{ 1000UL };
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        std::vector<std::shared_ptr<Instrument>> instruments;
+        std::vector<std::shared_ptr<ScalarData>> datas;
+        std::vector<Scalar> input;
+        for (hsize_t i = 0; i < itemCount; ++i)
+            input.push_back({ static_cast<long long>(i + 1), static_cast<double>(i) });
+        bool statusAdd{ true };
+        for (int i = 0; i < threadCount; ++i)
+        {
+            const std::string path{ "/foo/bar" + std::to_string(i) };
+            instruments.push_back(file->openInstrument(path.c_str(), true));
+            datas.push_back(instruments.back()->openScalarData(DataTimeFrame::Aperiodic, true));
+            statusAdd = datas.back()->add(input.data(), itemCount, DuplicateTimeTicks::Fail, false) && statusAdd;
+        }
+
+        std::atomic<int> failures{ 0 };
+        std::vector<std::thread> threads;
+        for (int i = 0; i < threadCount; ++i)
+        {
+            threads.emplace_back([&failures, &datas, i, itemCount]
+            {
+                for (int k = 0; k < 10; ++k)
+                {
+                    hsize_t count{ 0UL };
+                    const bool status = datas[i]->fetchAll([&count](const Scalar*, const hsize_t cnt) noexcept { count += cnt; });
+                    if (!status || itemCount != count || itemCount != datas[i]->count() || static_cast<long long>(itemCount) != datas[i]->lastTicks())
+                        ++failures;
+                }
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+
+        for (int i = 0; i < threadCount; ++i)
+        {
+            datas[i]->close();
+            instruments[i]->close();
+        }
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd) << ": add should return true";
+        ASSERT_EQUAL(0, failures.load()) << ": every concurrent fetch should succeed";
+    }
+
 }
 }
@@ -1,3 +1,6 @@
+#include <chrono>
+#include <string>
+#include <thread>
 #include "mbc/testharness.h"
 #include "mbc/h5.h"
 
@@ -109,6 +112,81 @@ TESTGROUP("h5 file")
         ASSERT_IS_FALSE(status) << ": enumerate datasets should return false";
     }
 
+    // ---------------------------------------------------------------------------
+    // Corking
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("bounded corking flushes the metadata cache when it grows past the size bound")
+    {
+        const char* fileName{ "file_bounded_corking_flushes_the_metadata_cache_when_it_grows_past_the_size_bound.h5" };
+        remove(fileName);
+
+        const auto add = [](const std::shared_ptr<File>& file, const int index)
+        {
+            const std::shared_ptr<Instrument> instrument = file->openInstrument(("/foo/" + std::to_string(index)).c_str(), true);
+            const std::shared_ptr<ScalarData> data = nullptr != instrument ? instrument->openScalarData(DataTimeFrame::Aperiodic, true) : nullptr;
+            const Scalar scalar{ 1000L + index, static_cast<double>(index) };
+            const bool status = nullptr != data && data->add(&scalar, 1UL, m5::DuplicateTimeTicks::Fail, false);
+            if (nullptr != data)
+                data->close();
+            if (nullptr != instrument)
+                instrument->close();
+            return status;
+        };
+
+        // The instruments are added until the cache is flushed, then for a while after, so that the flushed entries are evicted.
+        std::shared_ptr<File> file = File::openReadWrite(fileName, true, FileDriver::Sec2, m5::CorkOptions{ 256 * 1024, 0 });
+        bool statusAdd{ true };
+        int count{ 0 };
+        while (statusAdd && 0 == file->corkFlushes() && count < 5000)
+            statusAdd = add(file, count++);
+        for (const int last = count + 100; statusAdd && count < last; )
+            statusAdd = add(file, count++);
+        const hsize_t flushes = file->corkFlushes();
+        const size_t bytes = file->metadataCacheBytes();
+        file->close();
+
+        file = File::openReadOnly(fileName);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument(("/foo/" + std::to_string(count - 1)).c_str());
+        const std::shared_ptr<ScalarData> data = nullptr != instrument ? instrument->openScalarData(DataTimeFrame::Aperiodic) : nullptr;
+        const bool statusReopen = nullptr != data && 1UL == data->count() && 999L + count == data->lastTicks();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)                     << ": status add should be true";
+        ASSERT_IS_TRUE(0 < flushes)                   << ": metadata cache should be flushed";
+        ASSERT_IS_TRUE(bytes < 1024 * 1024)           << ": metadata cache should stay bounded";
+        ASSERT_IS_TRUE(statusReopen)                  << ": corked metadata should be written";
+    }
+
+    TESTCASE("bounded corking flushes the metadata cache when the time bound passes")
+    {
+        const char* fileName{ "file_bounded_corking_flushes_the_metadata_cache_when_the_time_bound_passes.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true, FileDriver::Sec2, m5::CorkOptions{ 0, 20 });
+        const std::shared_ptr<Instrument> instrument = file->openInstrument("/foo", true);
+        const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true);
+        bool statusAdd{ true };
+        const auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+        for (long long ticks = 1; statusAdd && std::chrono::steady_clock::now() < until; ++ticks)
+        {
+            const Scalar scalar{ ticks, 1. };
+            statusAdd = data->add(&scalar, 1UL, m5::DuplicateTimeTicks::Fail, false);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const hsize_t flushes = file->corkFlushes();
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)                     << ": status add should be true";
+        ASSERT_IS_TRUE(2 <= flushes)                  << ": metadata cache should be flushed periodically";
+    }
+
     // ---------------------------------------------------------------------------
     // Open instrument
     // ---------------------------------------------------------------------------
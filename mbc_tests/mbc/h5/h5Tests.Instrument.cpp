@@ -1,3 +1,5 @@
+#include <cstring>
+#include <limits>
 #include "mbc/testharness.h"
 #include "mbc/h5.h"
 
@@ -19,6 +21,12 @@ using QuoteData = m5::QuoteData;
 using QuotePriceOnlyData = m5::QuotePriceOnlyData;
 using OhlcvData = m5::OhlcvData;
 using OhlcvPriceOnlyData = m5::OhlcvPriceOnlyData;
+using DatasetCreationOptions = m5::DatasetCreationOptions;
+using DuplicateTimeTicks = m5::DuplicateTimeTicks;
+using CompressionCodec = m5::CompressionCodec;
+using Quote = m5::Quote;
+using Scalar = m5::Scalar;
+using Trade = m5::Trade;
 
 void createEnumerationDatasets(const char* fileName);
 void createEnumerationDatasetsInReverseOrder(const char* fileName);
@@ -1313,5 +1321,171 @@ TESTGROUP("h5 instrument")
         ASSERT_IS_FALSE(isNullptr) << ": data handle should not be nullptr";
     }
 
+    // ---------------------------------------------------------------------------
+    // Dataset creation options
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("creates data with the specified dataset creation options")
+    {
+        const char* instrumentName = "/foo/bar";
+        const char* fileName{ "instrument_creates_data_with_the_specified_dataset_creation_options.h5" };
+        remove(fileName);
+
+        std::vector<Scalar> input;
+        for (long long i = 1; i <= 10000; ++i)
+            input.push_back({ i, static_cast<double>(i) });
+        const DatasetCreationOptions options{ 4096, 6, false, true };
+        std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        std::shared_ptr<Instrument> instrument = file->openInstrument(instrumentName, true);
+        std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Aperiodic, true, options);
+        const bool statusAdd = data != nullptr && data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+        data->close();
+        instrument->close();
+        file->close();
+
+        // The options of an existing dataset are ignored.
+        const DatasetCreationOptions ignored{ 1000, 1, true, true };
+        file = File::openReadOnly(fileName);
+        instrument = file->openInstrument(instrumentName, false);
+        data = instrument->openScalarData(DataTimeFrame::Aperiodic, false, ignored);
+        data->setMaximumReadBufferBytes(0);
+        const std::shared_ptr<m5::ScalarCursor> cursor = data->openIndexRangeCursor(0, 10000);
+        const Scalar* page;
+        hsize_t count{ 0 };
+        const bool statusNext = cursor != nullptr && cursor->next(page, count);
+        cursor->close();
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)  << ": status add should be true";
+        ASSERT_IS_TRUE(statusNext) << ": status next should be true";
+        ASSERT_EQUAL(4096UL, count) << ": page should hold a chunk of the specified size";
+    }
+
+    TESTCASE("creates data with the default dataset creation options of the file")
+    {
+        const char* instrumentName = "/foo/bar";
+        const char* fileName{ "instrument_creates_data_with_the_default_dataset_creation_options_of_the_file.h5" };
+        remove(fileName);
+
+        std::vector<Trade> input;
+        for (long long i = 1; i <= 5000; ++i)
+            input.push_back({ i, static_cast<double>(i), 1. });
+        const DatasetCreationOptions defaultOptions{};
+        const DatasetCreationOptions options{ 2048, 0, false, false };
+        std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const DatasetCreationOptions initialOptions = file->datasetCreationOptions();
+        file->setDatasetCreationOptions(options);
+        const DatasetCreationOptions setOptions = file->datasetCreationOptions();
+        std::shared_ptr<Instrument> instrument = file->openInstrument(instrumentName, true);
+        std::shared_ptr<TradeData> data = instrument->openTradeData(true);
+        const bool statusAdd = data != nullptr && data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+        data->setMaximumReadBufferBytes(0);
+        const std::shared_ptr<m5::TradeCursor> cursor = data->openIndexRangeCursor(0, 5000);
+        const Trade* page;
+        hsize_t count{ 0 };
+        const bool statusNext = cursor != nullptr && cursor->next(page, count);
+        cursor->close();
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_EQUAL(defaultOptions.chunkRows_, initialOptions.chunkRows_)       << ": initial chunk rows should have default value";
+        ASSERT_EQUAL(defaultOptions.deflateLevel_, initialOptions.deflateLevel_) << ": initial deflate level should have default value";
+        ASSERT_IS_TRUE(initialOptions.shuffle_ && initialOptions.compress_)      << ": initial options should shuffle and compress";
+        ASSERT_EQUAL(2048UL, setOptions.chunkRows_)                              << ": chunk rows should have the value set";
+        ASSERT_IS_FALSE(setOptions.compress_)                                    << ": compress should have the value set";
+        ASSERT_IS_TRUE(statusAdd)                                                << ": status add should be true";
+        ASSERT_IS_TRUE(statusNext)                                               << ": status next should be true";
+        ASSERT_EQUAL(2048UL, count)                                              << ": page should hold a chunk of the default size of the file";
+    }
+
+    TESTCASE("round-trips data through the time series codec")
+    {
+        const char* instrumentName = "/foo/bar";
+        const char* fileName{ "instrument_round_trips_data_through_the_time_series_codec.h5" };
+        remove(fileName);
+
+        // Chunks of decimal prices with regular ticks, of irregular doubles and of random bits, the last chunk is partial.
+        std::vector<Quote> input;
+        unsigned long long bits{ 88172645463325252ULL };
+        long long ticks{ 630822816000000000LL };
+        for (long long i = 0; i < 2500; ++i)
+        {
+            bits ^= bits << 13;
+            bits ^= bits >> 7;
+            bits ^= bits << 17;
+            ticks += i < 1000 ? 10000000 : 1 + static_cast<long long>(bits % 100000);
+            Quote quote{ ticks, 100.25 + static_cast<double>(i % 7) * 0.01, 100.24, 100. + static_cast<double>(i % 10), 200. };
+            if (1000 <= i && 2000 > i)
+                quote = { ticks, 1. / static_cast<double>(i), -0., 1e300 * static_cast<double>(i), std::numeric_limits<double>::quiet_NaN() };
+            else if (2000 <= i)
+            {
+                double random;
+                std::memcpy(&random, &bits, sizeof(double));
+                quote = { ticks, random, -random, static_cast<double>(bits >> 11), 1e-300 };
+            }
+            input.push_back(quote);
+        }
+
+        DatasetCreationOptions options{ 1000, 0, false, true };
+        options.codec_ = CompressionCodec::TimeSeries;
+        std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        std::shared_ptr<Instrument> instrument = file->openInstrument(instrumentName, true);
+        std::shared_ptr<QuoteData> data = instrument->openQuoteData(true, options);
+        const bool statusAdd = data != nullptr && data->add(input.data(), input.size(), DuplicateTimeTicks::Fail, false);
+        data->close();
+        instrument->close();
+        file->close();
+
+        std::vector<Quote> output(input.size());
+        hsize_t written{ 0 };
+        file = File::openReadOnly(fileName);
+        instrument = file->openInstrument(instrumentName, false);
+        data = instrument->openQuoteData(false);
+        const bool statusFetch = data != nullptr && data->fetchIndexRangeInto(output.data(), output.size(), written, 0, output.size());
+        data->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)                                                                         << ": status add should be true";
+        ASSERT_IS_TRUE(statusFetch)                                                                       << ": status fetch should be true";
+        ASSERT_EQUAL(input.size(), static_cast<size_t>(written))                                          << ": all items should be fetched";
+        ASSERT_IS_TRUE(0 == std::memcmp(input.data(), output.data(), input.size() * sizeof(Quote)))       << ": fetched items should be bitwise equal to the added items";
+    }
+
+    TESTCASE("cannot create data with invalid dataset creation options")
+    {
+        const char* instrumentName = "/foo/bar";
+        const char* fileName{ "instrument_cannot_create_data_with_invalid_dataset_creation_options.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument(instrumentName, true);
+        const std::shared_ptr<QuoteData> zeroChunk = instrument->openQuoteData(true, { 0, 6, true, true });
+        const std::shared_ptr<OhlcvData> zeroLevel = instrument->openOhlcvData(OhlcvKind::Default, DataTimeFrame::Day1, true, { 1024, 0, true, true });
+        const std::shared_ptr<OhlcvData> largeLevel = instrument->openOhlcvAdjustedData(OhlcvKind::Default, DataTimeFrame::Day1, true, { 1024, 10, true, true });
+        const std::shared_ptr<OhlcvPriceOnlyData> uncompressed = instrument->openOhlcvPriceOnlyData(OhlcvKind::Default, DataTimeFrame::Day1, true, { 1024, 0, true, false });
+        const bool uncompressedCreated = uncompressed != nullptr;
+        if (uncompressed)
+            uncompressed->close();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(nullptr == zeroChunk)  << ": data with zero chunk rows should not be created";
+        ASSERT_IS_TRUE(nullptr == zeroLevel)  << ": data with zero deflate level should not be created";
+        ASSERT_IS_TRUE(nullptr == largeLevel) << ": data with too large deflate level should not be created";
+        ASSERT_IS_TRUE(uncompressedCreated)   << ": uncompressed data should ignore the deflate level";
+    }
+
 }
 }
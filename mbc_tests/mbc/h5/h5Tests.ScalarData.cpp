@@ -1099,6 +1099,133 @@ TESTGROUP("h5 scalar data")
         dataVector.clear();
     }
 
+    // ---------------------------------------------------------------------------
+    // Fetch into buffer
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("fetches tick range into buffer correctly when both ticks inside range")
+    {
+        const char* fileName{ "scalar_data_fetches_tick_range_into_buffer_correctly_when_both_ticks_inside_range.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument(dataInstrument, true);
+        const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Minute3, true);
+
+        std::vector<Scalar> vec{
+            {2L, 1.2},
+            {3L, 1.3},
+            {4L, 1.4},
+            {5L, 1.5},
+            {6L, 1.6}
+        };
+        const bool statusAdd = data->add(vec.data(), vec.size(), DuplicateTimeTicks::Update, false);
+
+        Scalar buffer[5]{};
+        unsigned long long written{ 99UL };
+        const bool statusFetch = data->fetchTickRangeInto(buffer, 5UL, written, 3L, 5L);
+
+        data->flush();
+        data->close();
+        instrument->flush();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)               << ": status add should be true";
+        ASSERT_IS_TRUE(statusFetch)             << ": status fetch should be true";
+        ASSERT_EQUAL(3UL, written)              << ": written should have expected value";
+        ASSERT_IS_TRUE(1.3 == buffer[0].value_) << ": buffer[0] should have expected value";
+        ASSERT_IS_TRUE(1.4 == buffer[1].value_) << ": buffer[1] should have expected value";
+        ASSERT_IS_TRUE(1.5 == buffer[2].value_) << ": buffer[2] should have expected value";
+        ASSERT_EQUAL(0L, buffer[3].ticks_)      << ": buffer[3] should be untouched";
+    }
+
+    TESTCASE("fetches tick range into buffer up to its capacity")
+    {
+        const char* fileName{ "scalar_data_fetches_tick_range_into_buffer_up_to_its_capacity.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument(dataInstrument, true);
+        const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Minute3, true);
+
+        std::vector<Scalar> vec{
+            {2L, 1.2},
+            {3L, 1.3},
+            {4L, 1.4},
+            {5L, 1.5},
+            {6L, 1.6}
+        };
+        const bool statusAdd = data->add(vec.data(), vec.size(), DuplicateTimeTicks::Update, false);
+
+        Scalar buffer[3]{};
+        unsigned long long written{ 99UL };
+        const bool statusFetch = data->fetchTickRangeInto(buffer, 2UL, written, 0L, 0L);
+        unsigned long long writtenAfter{ 99UL };
+        const bool statusFetchAfter = data->fetchTickRangeInto(buffer + 2, 1UL, writtenAfter, 7L, 9L);
+
+        data->flush();
+        data->close();
+        instrument->flush();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)               << ": status add should be true";
+        ASSERT_IS_TRUE(statusFetch)             << ": status fetch should be true";
+        ASSERT_IS_TRUE(statusFetchAfter)        << ": status fetch after last should be true";
+        ASSERT_EQUAL(2UL, written)              << ": written should have expected value";
+        ASSERT_EQUAL(0UL, writtenAfter)         << ": written after last should have expected value";
+        ASSERT_IS_TRUE(1.2 == buffer[0].value_) << ": buffer[0] should have expected value";
+        ASSERT_IS_TRUE(1.3 == buffer[1].value_) << ": buffer[1] should have expected value";
+        ASSERT_EQUAL(0L, buffer[2].ticks_)      << ": buffer[2] should be untouched";
+    }
+
+    TESTCASE("fetches index range into buffer correctly and fails when index outside range")
+    {
+        const char* fileName{ "scalar_data_fetches_index_range_into_buffer_correctly_and_fails_when_index_outside_range.h5" };
+        remove(fileName);
+
+        const std::shared_ptr<File> file = File::openReadWrite(fileName, true);
+        const std::shared_ptr<Instrument> instrument = file->openInstrument(dataInstrument, true);
+        const std::shared_ptr<ScalarData> data = instrument->openScalarData(DataTimeFrame::Minute3, true);
+
+        std::vector<Scalar> vec{
+            {2L, 1.2},
+            {3L, 1.3},
+            {4L, 1.4},
+            {5L, 1.5},
+            {6L, 1.6}
+        };
+        const bool statusAdd = data->add(vec.data(), vec.size(), DuplicateTimeTicks::Update, false);
+
+        Scalar buffer[4]{};
+        unsigned long long written{ 99UL };
+        const bool statusFetch = data->fetchIndexRangeInto(buffer, 4UL, written, 3UL, 6UL);
+        unsigned long long writtenOutside{ 99UL };
+        const bool statusFetchOutside = data->fetchIndexRangeInto(buffer + 2, 2UL, writtenOutside, 5UL, 1UL);
+
+        data->flush();
+        data->close();
+        instrument->flush();
+        instrument->close();
+        file->close();
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)               << ": status add should be true";
+        ASSERT_IS_TRUE(statusFetch)             << ": status fetch should be true";
+        ASSERT_IS_FALSE(statusFetchOutside)     << ": status fetch outside should be false";
+        ASSERT_EQUAL(2UL, written)              << ": written should have expected value";
+        ASSERT_EQUAL(0UL, writtenOutside)       << ": written outside should have expected value";
+        ASSERT_IS_TRUE(1.5 == buffer[0].value_) << ": buffer[0] should have expected value";
+        ASSERT_IS_TRUE(1.6 == buffer[1].value_) << ": buffer[1] should have expected value";
+        ASSERT_EQUAL(0L, buffer[2].ticks_)      << ": buffer[2] should be untouched";
+    }
+
     // ---------------------------------------------------------------------------
     // Ticks index
     // ---------------------------------------------------------------------------
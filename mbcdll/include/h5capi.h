@@ -1147,6 +1147,19 @@ extern "C" {
         Update = 2
     };
 
+    //! The downsampling method enumeration. The charted value of an item is the mid price of a quote, the price of a trade,
+    //! the closing price of an ohlcv and the value of a scalar; the envelope of an ohlcv follows its lowest and highest prices.
+    enum class DownsamplingMethod
+    {
+        //! Every n-th item starting from the first one.
+        EveryNth = 0,
+        //! The items with the lowest and the highest charted values in every bucket, in their order; two points per bucket.
+        MinMaxEnvelope = 1,
+        //! The largest-triangle-three-buckets: the first and the last items, and the item of every bucket
+        //! forming the largest triangle with the item chosen in the previous bucket and the average of the next bucket.
+        LargestTriangleThreeBuckets = 2
+    };
+
     //! Gets the default maximal size in bytes of the read buffer, 0 means unlimited.
     DLL_PUBLIC unsigned long long DLL_CC h5DataGetDefaultMaximumReadBufferBytes();
 
@@ -1242,6 +1255,24 @@ extern "C" {
     //! \return A boolean indicating the success of the operation.
     DLL_PUBLIC bool DLL_CC h5ScalarDataFetchIndexRange(H5ScalarDataHandle dataHandle, ScalarDataAppender collect, unsigned long long index, unsigned long long count);
 
+    //! Fetches a specified range of stored items downsampled for charting, computed in a single streaming pass over the range.
+    //! All items in the range are fetched if there are no more of them than the target points.
+    //! \param dataHandle The data handle.
+    //! \param collect A callback to fetch the chosen data into.
+    //! \param from A beginning date and time.
+    //! \param to An ending date and time.
+    //! \param targetPoints The maximal number of the fetched items: at least one for every n-th item, two for the envelope and three for the largest triangles.
+    //! \param method The downsampling method.
+    //! \return A boolean indicating the success of the operation.
+    DLL_PUBLIC bool DLL_CC h5ScalarDataFetchDownsampled(H5ScalarDataHandle dataHandle, ScalarDataAppender collect, long long from, long long to, unsigned long long targetPoints, DownsamplingMethod method);
+
+    //! Fetches the last stored items in a single locked call, reading only the chunks holding them.
+    //! \param dataHandle The data handle.
+    //! \param collect A callback to fetch data into.
+    //! \param count The number of the last items, all items if there are fewer of them.
+    //! \return A boolean indicating the success of the operation.
+    DLL_PUBLIC bool DLL_CC h5ScalarDataFetchLast(H5ScalarDataHandle dataHandle, ScalarDataAppender collect, unsigned long long count);
+
     //! Adds an array of scalar items to the data.
     //! \param dataHandle The data handle.
     //! \param input A pointer to an array of input scalar items.
@@ -1387,6 +1418,24 @@ extern "C" {
     //! \return A boolean indicating the success of the operation.
     DLL_PUBLIC bool DLL_CC h5TradeDataFetchIndexRange(H5TradeDataHandle dataHandle, TradeDataAppender collect, unsigned long long index, unsigned long long count);
 
+    //! Fetches a specified range of stored items downsampled for charting, computed in a single streaming pass over the range.
+    //! All items in the range are fetched if there are no more of them than the target points.
+    //! \param dataHandle The data handle.
+    //! \param collect A callback to fetch the chosen data into.
+    //! \param from A beginning date and time.
+    //! \param to An ending date and time.
+    //! \param targetPoints The maximal number of the fetched items: at least one for every n-th item, two for the envelope and three for the largest triangles.
+    //! \param method The downsampling method.
+    //! \return A boolean indicating the success of the operation.
+    DLL_PUBLIC bool DLL_CC h5TradeDataFetchDownsampled(H5TradeDataHandle dataHandle, TradeDataAppender collect, long long from, long long to, unsigned long long targetPoints, DownsamplingMethod method);
+
+    //! Fetches the last stored items in a single locked call, reading only the chunks holding them.
+    //! \param dataHandle The data handle.
+    //! \param collect A callback to fetch data into.
+    //! \param count The number of the last items, all items if there are fewer of them.
+    //! \return A boolean indicating the success of the operation.
+    DLL_PUBLIC bool DLL_CC h5TradeDataFetchLast(H5TradeDataHandle dataHandle, TradeDataAppender collect, unsigned long long count);
+
     //! Adds an array of trade items to the data.
     //! \param dataHandle The data handle.
     //! \param input A pointer to an array of input trade items.
@@ -1529,6 +1578,24 @@ extern "C" {
     //! \return A boolean indicating the success of the operation.
     DLL_PUBLIC bool DLL_CC h5TradePriceOnlyDataFetchIndexRange(H5TradePriceOnlyDataHandle dataHandle, TradePriceOnlyDataAppender collect, unsigned long long index, unsigned long long count);
 
+    //! Fetches a specified range of stored items downsampled for charting, computed in a single streaming pass over the range.
+    //! All items in the range are fetched if there are no more of them than the target points.
+    //! \param dataHandle The data handle.
+    //! \param collect A callback to fetch the chosen data into.
+    //! \param from A beginning date and time.
+    //! \param to An ending date and time.
+    //! \param targetPoints The maximal number of the fetched items: at least one for every n-th item, two for the envelope and three for the largest triangles.
+    //! \param method The downsampling method.
+    //! \return A boolean indicating the success of the operation.
+    DLL_PUBLIC bool DLL_CC h5TradePriceOnlyDataFetchDownsampled(H5TradePriceOnlyDataHandle dataHandle, TradePriceOnlyDataAppender collect, long long from, long long to, unsigned long long targetPoints, DownsamplingMethod method);
+
+    //! Fetches the last stored items in a single locked call, reading only the chunks holding them.
+    //! \param dataHandle The data handle.
+    //! \param collect A callback to fetch data into.
+    //! \param count The number of the last items, all items if there are fewer of them.
+    //! \return A boolean indicating the success of the operation.
+    DLL_PUBLIC bool DLL_CC h5TradePriceOnlyDataFetchLast(H5TradePriceOnlyDataHandle dataHandle, TradePriceOnlyDataAppender collect, unsigned long long count);
+
     //! Adds an array of price-only trade items to the data.
     //! \param dataHandle The data handle.
     //! \param input A pointer to an array of input price-only trade items.
@@ -1683,6 +1750,24 @@ extern "C" {
     //! \return A boolean indicating the success of the operation.
     DLL_PUBLIC bool DLL_CC h5OhlcvDataFetchIndexRange(H5OhlcvDataHandle dataHandle, OhlcvDataAppender collect, unsigned long long index, unsigned long long count);
 
+    //! Fetches a specified range of stored items downsampled for charting, computed in a single streaming pass over the range.
+    //! All items in the range are fetched if there are no more of them than the target points.
+    //! \param dataHandle The data handle.
+    //! \param collect A callback to fetch the chosen data into.
+    //! \param from A beginning date and time.
+    //! \param to An ending date and time.
+    //! \param targetPoints The maximal number of the fetched items: at least one for every n-th item, two for the envelope and three for the largest triangles.
+    //! \param method The downsampling method.
+    //! \return A boolean indicating the success of the operation.
+    DLL_PUBLIC bool DLL_CC h5OhlcvDataFetchDownsampled(H5OhlcvDataHandle dataHandle, OhlcvDataAppender collect, long long from, long long to, unsigned long long targetPoints, DownsamplingMethod method);
+
+    //! Fetches the last stored items in a single locked call, reading only the chunks holding them.
+    //! \param dataHandle The data handle.
+    //! \param collect A callback to fetch data into.
+    //! \param count The number of the last items, all items if there are fewer of them.
+    //! \return A boolean indicating the success of the operation.
+    DLL_PUBLIC bool DLL_CC h5OhlcvDataFetchLast(H5OhlcvDataHandle dataHandle, OhlcvDataAppender collect, unsigned long long count);
+
     //! Adds an array of ohlcv items to the data.
     //! \param dataHandle The data handle.
     //! \param input A pointer to an array of input ohlcv items.
@@ -1834,6 +1919,24 @@ extern "C" {
     //! \return A boolean indicating the success of the operation.
     DLL_PUBLIC bool DLL_CC h5OhlcvPriceOnlyDataFetchIndexRange(H5OhlcvPriceOnlyDataHandle dataHandle, OhlcvPriceOnlyDataAppender collect, unsigned long long index, unsigned long long count);
 
+    //! Fetches a specified range of stored items downsampled for charting, computed in a single streaming pass over the range.
+    //! All items in the range are fetched if there are no more of them than the target points.
+    //! \param dataHandle The data handle.
+    //! \param collect A callback to fetch the chosen data into.
+    //! \param from A beginning date and time.
+    //! \param to An ending date and time.
+    //! \param targetPoints The maximal number of the fetched items: at least one for every n-th item, two for the envelope and three for the largest triangles.
+    //! \param method The downsampling method.
+    //! \return A boolean indicating the success of the operation.
+    DLL_PUBLIC bool DLL_CC h5OhlcvPriceOnlyDataFetchDownsampled(H5OhlcvPriceOnlyDataHandle dataHandle, OhlcvPriceOnlyDataAppender collect, long long from, long long to, unsigned long long targetPoints, DownsamplingMethod method);
+
+    //! Fetches the last stored items in a single locked call, reading only the chunks holding them.
+    //! \param dataHandle The data handle.
+    //! \param collect A callback to fetch data into.
+    //! \param count The number of the last items, all items if there are fewer of them.
+    //! \return A boolean indicating the success of the operation.
+    DLL_PUBLIC bool DLL_CC h5OhlcvPriceOnlyDataFetchLast(H5OhlcvPriceOnlyDataHandle dataHandle, OhlcvPriceOnlyDataAppender collect, unsigned long long count);
+
     //! Adds an array of price-only ohlcv items to the data.
     //! \param dataHandle The data handle.
     //! \param input A pointer to an array of input price-only ohlcv items.
@@ -1986,6 +2089,24 @@ extern "C" {
     //! \return A boolean indicating the success of the operation.
     DLL_PUBLIC bool DLL_CC h5QuoteDataFetchIndexRange(H5QuoteDataHandle dataHandle, QuoteDataAppender collect, unsigned long long index, unsigned long long count);
 
+    //! Fetches a specified range of stored items downsampled for charting, computed in a single streaming pass over the range.
+    //! All items in the range are fetched if there are no more of them than the target points.
+    //! \param dataHandle The data handle.
+    //! \param collect A callback to fetch the chosen data into.
+    //! \param from A beginning date and time.
+    //! \param to An ending date and time.
+    //! \param targetPoints The maximal number of the fetched items: at least one for every n-th item, two for the envelope and three for the largest triangles.
+    //! \param method The downsampling method.
+    //! \return A boolean indicating the success of the operation.
+    DLL_PUBLIC bool DLL_CC h5QuoteDataFetchDownsampled(H5QuoteDataHandle dataHandle, QuoteDataAppender collect, long long from, long long to, unsigned long long targetPoints, DownsamplingMethod method);
+
+    //! Fetches the last stored items in a single locked call, reading only the chunks holding them.
+    //! \param dataHandle The data handle.
+    //! \param collect A callback to fetch data into.
+    //! \param count The number of the last items, all items if there are fewer of them.
+    //! \return A boolean indicating the success of the operation.
+    DLL_PUBLIC bool DLL_CC h5QuoteDataFetchLast(H5QuoteDataHandle dataHandle, QuoteDataAppender collect, unsigned long long count);
+
     //! Adds an array of quote items to the data.
     //! \param dataHandle The data handle.
     //! \param input A pointer to an array of input quote items.
@@ -2131,6 +2252,24 @@ extern "C" {
     //! \return A boolean indicating the success of the operation.
     DLL_PUBLIC bool DLL_CC h5QuotePriceOnlyDataFetchIndexRange(H5QuotePriceOnlyDataHandle dataHandle, QuotePriceOnlyDataAppender collect, unsigned long long index, unsigned long long count);
 
+    //! Fetches a specified range of stored items downsampled for charting, computed in a single streaming pass over the range.
+    //! All items in the range are fetched if there are no more of them than the target points.
+    //! \param dataHandle The data handle.
+    //! \param collect A callback to fetch the chosen data into.
+    //! \param from A beginning date and time.
+    //! \param to An ending date and time.
+    //! \param targetPoints The maximal number of the fetched items: at least one for every n-th item, two for the envelope and three for the largest triangles.
+    //! \param method The downsampling method.
+    //! \return A boolean indicating the success of the operation.
+    DLL_PUBLIC bool DLL_CC h5QuotePriceOnlyDataFetchDownsampled(H5QuotePriceOnlyDataHandle dataHandle, QuotePriceOnlyDataAppender collect, long long from, long long to, unsigned long long targetPoints, DownsamplingMethod method);
+
+    //! Fetches the last stored items in a single locked call, reading only the chunks holding them.
+    //! \param dataHandle The data handle.
+    //! \param collect A callback to fetch data into.
+    //! \param count The number of the last items, all items if there are fewer of them.
+    //! \return A boolean indicating the success of the operation.
+    DLL_PUBLIC bool DLL_CC h5QuotePriceOnlyDataFetchLast(H5QuotePriceOnlyDataHandle dataHandle, QuotePriceOnlyDataAppender collect, unsigned long long count);
+
     //! Adds an array of price-only quote items to the data.
     //! \param dataHandle The data handle.
     //! \param input A pointer to an array of input price-only quote items.
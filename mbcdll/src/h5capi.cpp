@@ -508,6 +508,26 @@ extern "C" {
         }, index, count);
     }
 
+    DLL_PUBLIC bool DLL_CC h5ScalarDataFetchDownsampled(H5ScalarDataHandle dataHandle, ScalarDataAppender collect, long long from, long long to, unsigned long long targetPoints, DownsamplingMethod method)
+    {
+        const auto dp = castFromScalarDataHandle(dataHandle);
+        return dp == nullptr ? false : (*dp)->fetchDownsampled([collect](const mbc::h5::Scalar* data, hsize_t dataCount)
+        {
+            for (hsize_t i = 0; i < dataCount; ++i, ++data)
+                collect(data->ticks_, data->value_);
+        }, from, to, static_cast<hsize_t>(targetPoints), static_cast<mbc::h5::DownsamplingMethod>(method));
+    }
+
+    DLL_PUBLIC bool DLL_CC h5ScalarDataFetchLast(H5ScalarDataHandle dataHandle, ScalarDataAppender collect, unsigned long long count)
+    {
+        const auto dp = castFromScalarDataHandle(dataHandle);
+        return dp == nullptr ? false : (*dp)->fetchLast([collect](const mbc::h5::Scalar* data, hsize_t dataCount)
+        {
+            for (hsize_t i = 0; i < dataCount; ++i, ++data)
+                collect(data->ticks_, data->value_);
+        }, static_cast<hsize_t>(count));
+    }
+
     DLL_PUBLIC bool DLL_CC h5ScalarDataAdd(H5ScalarDataHandle dataHandle, const Scalar* input, unsigned long long inputCount, DuplicateTimeTicks duplicateTimeTicks, bool verbose)
     {
         const auto dp = castFromScalarDataHandle(dataHandle);
@@ -673,6 +693,26 @@ extern "C" {
         }, index, count);
     }
 
+    DLL_PUBLIC bool DLL_CC h5TradeDataFetchDownsampled(H5TradeDataHandle dataHandle, TradeDataAppender collect, long long from, long long to, unsigned long long targetPoints, DownsamplingMethod method)
+    {
+        const auto dp = castFromTradeDataHandle(dataHandle);
+        return dp == nullptr ? false : (*dp)->fetchDownsampled([collect](const mbc::h5::Trade* data, hsize_t dataCount)
+        {
+            for (hsize_t i = 0; i < dataCount; ++i, ++data)
+                collect(data->ticks_, data->price_, data->volume_);
+        }, from, to, static_cast<hsize_t>(targetPoints), static_cast<mbc::h5::DownsamplingMethod>(method));
+    }
+
+    DLL_PUBLIC bool DLL_CC h5TradeDataFetchLast(H5TradeDataHandle dataHandle, TradeDataAppender collect, unsigned long long count)
+    {
+        const auto dp = castFromTradeDataHandle(dataHandle);
+        return dp == nullptr ? false : (*dp)->fetchLast([collect](const mbc::h5::Trade* data, hsize_t dataCount)
+        {
+            for (hsize_t i = 0; i < dataCount; ++i, ++data)
+                collect(data->ticks_, data->price_, data->volume_);
+        }, static_cast<hsize_t>(count));
+    }
+
     DLL_PUBLIC bool DLL_CC h5TradeDataAdd(H5TradeDataHandle dataHandle, const Trade* input, unsigned long long inputCount, DuplicateTimeTicks duplicateTimeTicks, bool verbose)
     {
         const auto dp = castFromTradeDataHandle(dataHandle);
@@ -838,6 +878,26 @@ extern "C" {
         }, index, count);
     }
 
+    DLL_PUBLIC bool DLL_CC h5TradePriceOnlyDataFetchDownsampled(H5TradePriceOnlyDataHandle dataHandle, TradePriceOnlyDataAppender collect, long long from, long long to, unsigned long long targetPoints, DownsamplingMethod method)
+    {
+        const auto dp = castFromTradePriceOnlyDataHandle(dataHandle);
+        return dp == nullptr ? false : (*dp)->fetchDownsampled([collect](const mbc::h5::TradePriceOnly* data, hsize_t dataCount)
+        {
+            for (hsize_t i = 0; i < dataCount; ++i, ++data)
+                collect(data->ticks_, data->price_);
+        }, from, to, static_cast<hsize_t>(targetPoints), static_cast<mbc::h5::DownsamplingMethod>(method));
+    }
+
+    DLL_PUBLIC bool DLL_CC h5TradePriceOnlyDataFetchLast(H5TradePriceOnlyDataHandle dataHandle, TradePriceOnlyDataAppender collect, unsigned long long count)
+    {
+        const auto dp = castFromTradePriceOnlyDataHandle(dataHandle);
+        return dp == nullptr ? false : (*dp)->fetchLast([collect](const mbc::h5::TradePriceOnly* data, hsize_t dataCount)
+        {
+            for (hsize_t i = 0; i < dataCount; ++i, ++data)
+                collect(data->ticks_, data->price_);
+        }, static_cast<hsize_t>(count));
+    }
+
     DLL_PUBLIC bool DLL_CC h5TradePriceOnlyDataAdd(H5TradePriceOnlyDataHandle dataHandle, const TradePriceOnly* input, unsigned long long inputCount, DuplicateTimeTicks duplicateTimeTicks, bool verbose)
     {
         const auto dp = castFromTradePriceOnlyDataHandle(dataHandle);
@@ -1003,6 +1063,26 @@ extern "C" {
         }, index, count);
     }
 
+    DLL_PUBLIC bool DLL_CC h5OhlcvDataFetchDownsampled(H5OhlcvDataHandle dataHandle, OhlcvDataAppender collect, long long from, long long to, unsigned long long targetPoints, DownsamplingMethod method)
+    {
+        const auto dp = castFromOhlcvDataHandle(dataHandle);
+        return dp == nullptr ? false : (*dp)->fetchDownsampled([collect](const mbc::h5::Ohlcv* data, hsize_t dataCount)
+        {
+            for (hsize_t i = 0; i < dataCount; ++i, ++data)
+                collect(data->ticks_, data->open_, data->high_, data->low_, data->close_, data->volume_);
+        }, from, to, static_cast<hsize_t>(targetPoints), static_cast<mbc::h5::DownsamplingMethod>(method));
+    }
+
+    DLL_PUBLIC bool DLL_CC h5OhlcvDataFetchLast(H5OhlcvDataHandle dataHandle, OhlcvDataAppender collect, unsigned long long count)
+    {
+        const auto dp = castFromOhlcvDataHandle(dataHandle);
+        return dp == nullptr ? false : (*dp)->fetchLast([collect](const mbc::h5::Ohlcv* data, hsize_t dataCount)
+        {
+            for (hsize_t i = 0; i < dataCount; ++i, ++data)
+                collect(data->ticks_, data->open_, data->high_, data->low_, data->close_, data->volume_);
+        }, static_cast<hsize_t>(count));
+    }
+
     DLL_PUBLIC bool DLL_CC h5OhlcvDataAdd(H5OhlcvDataHandle dataHandle, const Ohlcv* input, unsigned long long inputCount, DuplicateTimeTicks duplicateTimeTicks, bool verbose)
     {
         const auto dp = castFromOhlcvDataHandle(dataHandle);
@@ -1168,6 +1248,26 @@ extern "C" {
         }, index, count);
     }
 
+    DLL_PUBLIC bool DLL_CC h5OhlcvPriceOnlyDataFetchDownsampled(H5OhlcvPriceOnlyDataHandle dataHandle, OhlcvPriceOnlyDataAppender collect, long long from, long long to, unsigned long long targetPoints, DownsamplingMethod method)
+    {
+        const auto dp = castFromOhlcvPriceOnlyDataHandle(dataHandle);
+        return dp == nullptr ? false : (*dp)->fetchDownsampled([collect](const mbc::h5::OhlcvPriceOnly* data, hsize_t dataCount)
+        {
+            for (hsize_t i = 0; i < dataCount; ++i, ++data)
+                collect(data->ticks_, data->open_, data->high_, data->low_, data->close_);
+        }, from, to, static_cast<hsize_t>(targetPoints), static_cast<mbc::h5::DownsamplingMethod>(method));
+    }
+
+    DLL_PUBLIC bool DLL_CC h5OhlcvPriceOnlyDataFetchLast(H5OhlcvPriceOnlyDataHandle dataHandle, OhlcvPriceOnlyDataAppender collect, unsigned long long count)
+    {
+        const auto dp = castFromOhlcvPriceOnlyDataHandle(dataHandle);
+        return dp == nullptr ? false : (*dp)->fetchLast([collect](const mbc::h5::OhlcvPriceOnly* data, hsize_t dataCount)
+        {
+            for (hsize_t i = 0; i < dataCount; ++i, ++data)
+                collect(data->ticks_, data->open_, data->high_, data->low_, data->close_);
+        }, static_cast<hsize_t>(count));
+    }
+
     DLL_PUBLIC bool DLL_CC h5OhlcvPriceOnlyDataAdd(H5OhlcvPriceOnlyDataHandle dataHandle, const OhlcvPriceOnly* input, unsigned long long inputCount, DuplicateTimeTicks duplicateTimeTicks, bool verbose)
     {
         const auto dp = castFromOhlcvPriceOnlyDataHandle(dataHandle);
@@ -1333,6 +1433,26 @@ extern "C" {
         }, index, count);
     }
 
+    DLL_PUBLIC bool DLL_CC h5QuoteDataFetchDownsampled(H5QuoteDataHandle dataHandle, QuoteDataAppender collect, long long from, long long to, unsigned long long targetPoints, DownsamplingMethod method)
+    {
+        const auto dp = castFromQuoteDataHandle(dataHandle);
+        return dp == nullptr ? false : (*dp)->fetchDownsampled([collect](const mbc::h5::Quote* data, hsize_t dataCount)
+        {
+            for (hsize_t i = 0; i < dataCount; ++i, ++data)
+                collect(data->ticks_, data->askPrice_, data->bidPrice_, data->askSize_, data->bidSize_);
+        }, from, to, static_cast<hsize_t>(targetPoints), static_cast<mbc::h5::DownsamplingMethod>(method));
+    }
+
+    DLL_PUBLIC bool DLL_CC h5QuoteDataFetchLast(H5QuoteDataHandle dataHandle, QuoteDataAppender collect, unsigned long long count)
+    {
+        const auto dp = castFromQuoteDataHandle(dataHandle);
+        return dp == nullptr ? false : (*dp)->fetchLast([collect](const mbc::h5::Quote* data, hsize_t dataCount)
+        {
+            for (hsize_t i = 0; i < dataCount; ++i, ++data)
+                collect(data->ticks_, data->askPrice_, data->bidPrice_, data->askSize_, data->bidSize_);
+        }, static_cast<hsize_t>(count));
+    }
+
     DLL_PUBLIC bool DLL_CC h5QuoteDataAdd(H5QuoteDataHandle dataHandle, const Quote* input, unsigned long long inputCount, DuplicateTimeTicks duplicateTimeTicks, bool verbose)
     {
         const auto dp = castFromQuoteDataHandle(dataHandle);
@@ -1498,6 +1618,26 @@ extern "C" {
         }, index, count);
     }
 
+    DLL_PUBLIC bool DLL_CC h5QuotePriceOnlyDataFetchDownsampled(H5QuotePriceOnlyDataHandle dataHandle, QuotePriceOnlyDataAppender collect, long long from, long long to, unsigned long long targetPoints, DownsamplingMethod method)
+    {
+        const auto dp = castFromQuotePriceOnlyDataHandle(dataHandle);
+        return dp == nullptr ? false : (*dp)->fetchDownsampled([collect](const mbc::h5::QuotePriceOnly* data, hsize_t dataCount)
+        {
+            for (hsize_t i = 0; i < dataCount; ++i, ++data)
+                collect(data->ticks_, data->askPrice_, data->bidPrice_);
+        }, from, to, static_cast<hsize_t>(targetPoints), static_cast<mbc::h5::DownsamplingMethod>(method));
+    }
+
+    DLL_PUBLIC bool DLL_CC h5QuotePriceOnlyDataFetchLast(H5QuotePriceOnlyDataHandle dataHandle, QuotePriceOnlyDataAppender collect, unsigned long long count)
+    {
+        const auto dp = castFromQuotePriceOnlyDataHandle(dataHandle);
+        return dp == nullptr ? false : (*dp)->fetchLast([collect](const mbc::h5::QuotePriceOnly* data, hsize_t dataCount)
+        {
+            for (hsize_t i = 0; i < dataCount; ++i, ++data)
+                collect(data->ticks_, data->askPrice_, data->bidPrice_);
+        }, static_cast<hsize_t>(count));
+    }
+
     DLL_PUBLIC bool DLL_CC h5QuotePriceOnlyDataAdd(H5QuotePriceOnlyDataHandle dataHandle, const QuotePriceOnly* input, unsigned long long inputCount, DuplicateTimeTicks duplicateTimeTicks, bool verbose)
     {
         const auto dp = castFromQuotePriceOnlyDataHandle(dataHandle);
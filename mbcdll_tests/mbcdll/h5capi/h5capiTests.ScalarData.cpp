@@ -1109,6 +1109,109 @@ TESTGROUP("h5 capi scalar data")
         dataVector.clear();
     }
 
+    // ---------------------------------------------------------------------------
+    // Fetch downsampled
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("fetches downsampled range correctly with every n-th item")
+    {
+        const char* fileName{ "capi_scalar_data_fetches_downsampled_range_correctly_with_every_nth_item.h5" };
+        remove(fileName);
+
+        static std::vector<Scalar> dataVector;
+        const H5FileHandle file = h5FileOpenReadWrite(fileName, true);
+        const H5InstrumentHandle instrument = h5FileOpenInstrument(file, dataInstrument, true);
+        const H5ScalarDataHandle data = h5InstrumentOpenScalarData(instrument, DataTimeFrame::Minute3, true);
+
+        std::vector<Scalar> vec{
+            {2L, 1.2},
+            {3L, 1.3},
+            {4L, 1.4},
+            {5L, 1.5},
+            {6L, 1.6}
+        };
+        const bool statusAdd = h5ScalarDataAdd(data, vec.data(), vec.size(), DuplicateTimeTicks::Update, false);
+
+        const bool statusFetch = h5ScalarDataFetchDownsampled(data, [](long long ticks, double value) noexcept
+        {
+            try
+            {
+                const Scalar item{ ticks, value };
+                dataVector.push_back(item);
+            }
+            catch (...)
+            {
+            }
+        }, 2L, 6L, 3UL, DownsamplingMethod::EveryNth);
+
+        h5ScalarDataFlush(data);
+        h5ScalarDataClose(data);
+        h5InstrumentFlush(instrument);
+        h5InstrumentClose(instrument);
+        h5FileClose(file);
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)                   << ": status add should be true";
+        ASSERT_IS_TRUE(statusFetch)                 << ": status fetch should be true";
+        ASSERT_EQUAL(3UL, dataVector.size())        << ": data count should have expected value";
+        ASSERT_IS_TRUE(1.2 == dataVector[0].value_) << ": data[0] should have expected value";
+        ASSERT_IS_TRUE(1.4 == dataVector[1].value_) << ": data[1] should have expected value";
+        ASSERT_IS_TRUE(1.6 == dataVector[2].value_) << ": data[2] should have expected value";
+        dataVector.clear();
+    }
+
+    // ---------------------------------------------------------------------------
+    // Fetch last
+    // ---------------------------------------------------------------------------
+
+    TESTCASE("fetches last items correctly")
+    {
+        const char* fileName{ "capi_scalar_data_fetches_last_items_correctly.h5" };
+        remove(fileName);
+
+        static std::vector<Scalar> dataVector;
+        const H5FileHandle file = h5FileOpenReadWrite(fileName, true);
+        const H5InstrumentHandle instrument = h5FileOpenInstrument(file, dataInstrument, true);
+        const H5ScalarDataHandle data = h5InstrumentOpenScalarData(instrument, DataTimeFrame::Minute3, true);
+
+        std::vector<Scalar> vec{
+            {2L, 1.2},
+            {3L, 1.3},
+            {4L, 1.4},
+            {5L, 1.5},
+            {6L, 1.6}
+        };
+        const bool statusAdd = h5ScalarDataAdd(data, vec.data(), vec.size(), DuplicateTimeTicks::Update, false);
+
+        const bool statusFetch = h5ScalarDataFetchLast(data, [](long long ticks, double value) noexcept
+        {
+            try
+            {
+                const Scalar item{ ticks, value };
+                dataVector.push_back(item);
+            }
+            catch (...)
+            {
+            }
+        }, 2UL);
+
+        h5ScalarDataFlush(data);
+        h5ScalarDataClose(data);
+        h5InstrumentFlush(instrument);
+        h5InstrumentClose(instrument);
+        h5FileClose(file);
+
+        remove(fileName);
+
+        ASSERT_IS_TRUE(statusAdd)                   << ": status add should be true";
+        ASSERT_IS_TRUE(statusFetch)                 << ": status fetch should be true";
+        ASSERT_EQUAL(2UL, dataVector.size())        << ": data count should have expected value";
+        ASSERT_IS_TRUE(1.5 == dataVector[0].value_) << ": data[0] should have expected value";
+        ASSERT_IS_TRUE(1.6 == dataVector[1].value_) << ": data[1] should have expected value";
+        dataVector.clear();
+    }
+
     // ---------------------------------------------------------------------------
     // Ticks index
     // ---------------------------------------------------------------------------